@@ -0,0 +1,49 @@
+// ShaderW0Instanced.hlsl
+// ShaderW0 variant for instanced primitives: the world matrix comes from the
+// per-instance vertex stream, the constant buffer only holds the camera.
+cbuffer ViewConstants : register(b0)
+{
+    row_major float4x4 ViewProjection;
+}
+
+struct VS_INPUT
+{
+    float4 position : POSITION; // Input position from vertex buffer
+    float4 color : COLOR; // Input color from vertex buffer
+
+    // Per-instance data (input slot 1)
+    float4 world0 : WORLD0; // World matrix rows
+    float4 world1 : WORLD1;
+    float4 world2 : WORLD2;
+    float4 world3 : WORLD3;
+    float4 instanceColor : INSTANCECOLOR;
+};
+
+struct PS_INPUT
+{
+    float4 position : SV_POSITION; // Transformed position to pass to the pixel shader
+    float4 color : COLOR; // Color to pass to the pixel shader
+};
+
+PS_INPUT mainVS(VS_INPUT input)
+{
+    PS_INPUT output;
+
+    input.position.w = 1.0f;
+
+    float4x4 world = float4x4(input.world0, input.world1, input.world2, input.world3);
+
+    // v, m, vp
+    output.position = mul(mul(input.position, world), ViewProjection);
+
+    // Tint the mesh color per instance (white leaves it unchanged)
+    output.color = input.color * input.instanceColor;
+
+    return output;
+}
+
+float4 mainPS(PS_INPUT input) : SV_TARGET
+{
+    // Output the color directly
+    return input.color;
+}
@@ -99,6 +99,7 @@ void UWildEditor::Render()
     SetupControlWindow();
     SetupPropertyWindow();
     SetupConsoleWindow();
+    SetupStatWindow();
 
     UEditorDesigner::Get().Render();
 
@@ -236,6 +237,10 @@ void UWildEditor::LoadScene(FString SceneName)
         uint32 NextUUID = Scene["NextUUID"].ToInt();
         json::JSON Primitives = Scene["Primitives"];
 
+        // 부모가 나중에 로드될 수 있으므로 부착은 전부 생성한 뒤에 처리
+        TMap<uint32, USceneComponent*> LoadedComponents;
+        TArray<TPair<USceneComponent*, uint32>> PendingAttachments;
+
         for (auto it = Primitives.ObjectRange().begin(); it != Primitives.ObjectRange().end(); ++it)
         {
             uint32 UUID = std::stoi(it->first);
@@ -244,32 +249,60 @@ void UWildEditor::LoadScene(FString SceneName)
             FVector Location = json::JSONToFVector(Primitive["Location"]);
             FVector Rotation = json::JSONToFVector(Primitive["Rotation"]);
             FVector Scale = json::JSONToFVector(Primitive["Scale"]);
+            USceneComponent* Loaded = nullptr;
             if (!Type.compare("Sphere"))
             {
                 USphereComponent* Sphere = new USphereComponent(Renderer);
                 Sphere->UUID = UUID;
-                Sphere->RelativeLocation = Location;
-                Sphere->RelativeRotation = Rotation;
-                Sphere->RelativeScale3D = Scale;
+                Sphere->SetRelativeLocation(Location);
+                Sphere->SetRelativeRotation(Rotation);
+                Sphere->SetRelativeScale3D(Scale);
+                Loaded = Sphere;
             }
             else if (!Type.compare("Cube"))
             {
                 UCubeComponent* Cube = new UCubeComponent(Renderer);
                 Cube->UUID = UUID;
-                Cube->RelativeLocation = Location;
-                Cube->RelativeRotation = Rotation;
-                Cube->RelativeScale3D = Scale;
+                Cube->SetRelativeLocation(Location);
+                Cube->SetRelativeRotation(Rotation);
+                Cube->SetRelativeScale3D(Scale);
+                Loaded = Cube;
             }
             else if (!Type.compare("Triangle"))
             {
                 UTriangleComponent* Triangle = new UTriangleComponent(Renderer);
                 Triangle->UUID = UUID;
-                Triangle->RelativeLocation = Location;
-                Triangle->RelativeRotation = Rotation;
-                Triangle->RelativeScale3D = Scale;
+                Triangle->SetRelativeLocation(Location);
+                Triangle->SetRelativeRotation(Rotation);
+                Triangle->SetRelativeScale3D(Scale);
+                Loaded = Triangle;
+            }
+
+            if (Loaded)
+            {
+                // 저장된 레벨 지오메트리는 기본적으로 정적이며 로드 후 병합된다
+                const bool bMovable = Primitive.hasKey("Mobility") && Primitive["Mobility"].ToString() == "Movable";
+                static_cast<UPrimitiveComponent*>(Loaded)->Mobility = bMovable ? EComponentMobility::Movable : EComponentMobility::Static;
+
+                LoadedComponents[UUID] = Loaded;
+                if (Primitive.hasKey("Parent"))
+                {
+                    PendingAttachments.push_back({ Loaded, static_cast<uint32>(Primitive["Parent"].ToInt()) });
+                }
             }
         }
 
+        for (const TPair<USceneComponent*, uint32>& Attachment : PendingAttachments)
+        {
+            auto Parent = LoadedComponents.find(Attachment.second);
+            if (Parent != LoadedComponents.end())
+            {
+                Attachment.first->AttachToComponent(Parent->second);
+            }
+        }
+
+        this->Scene->RequestMergeStaticMeshes();
+
     }
     else {
     }
@@ -284,9 +317,7 @@ void UWildEditor::SetupPropertyWindow()
         if (PropertyWindow* Property = dynamic_cast<PropertyWindow*>(Window.get()))
         {
             if (Scene->GetSelectedObject() != nullptr) {
-                Property->SetLocation(Scene->GetSelectedObject()->RelativeLocation);
-                Property->SetRotation(Scene->GetSelectedObject()->RelativeRotation);
-                Property->SetScale(Scene->GetSelectedObject()->RelativeScale3D);
+                Property->SetFocusComponent(Scene->GetSelectedObject());
 
                 Property->SetUUID(Scene->GetSelectedObject()->UUID);
 
@@ -312,6 +343,19 @@ void UWildEditor::SetupConsoleWindow()
     }
 }
 
+void UWildEditor::SetupStatWindow()
+{
+    auto Window = UEditorDesigner::Get().GetWindow("StatWindow");
+    if (Window)
+    {
+        if (StatWindow* Stat = dynamic_cast<StatWindow*>(Window.get()))
+        {
+            Stat->SetDrawSortStats(Scene->GetDrawSortStats());
+            Stat->SetOcclusionStats(Scene->IsOcclusionCulling(), Scene->GetOcclusionStats());
+        }
+    }
+}
+
 void UWildEditor::SaveScene(FString SceneName)
 {
     uint32 Version = 1;
@@ -329,11 +373,19 @@ void UWildEditor::SaveScene(FString SceneName)
         {
             UPrimitiveComponent* Primitive = static_cast<UPrimitiveComponent*>(GUObjectArray[i]);
             FString key = std::to_string(GUObjectArray[i]->UUID);
-            Scene["Primitives"][key]["Location"] = json::FVectorToJSON(Primitive->RelativeLocation);
-            Scene["Primitives"][key]["Rotation"] = json::FVectorToJSON(Primitive->RelativeRotation);
-            Scene["Primitives"][key]["Scale"] = json::FVectorToJSON(Primitive->RelativeScale3D);
+            Scene["Primitives"][key]["Location"] = json::FVectorToJSON(Primitive->GetRelativeLocation());
+            Scene["Primitives"][key]["Rotation"] = json::FVectorToJSON(Primitive->GetRelativeRotation());
+            Scene["Primitives"][key]["Scale"] = json::FVectorToJSON(Primitive->GetRelativeScale3D());
             FString RawTypeName = Primitive->GetInstanceClass()->ClassName;
             Scene["Primitives"][key]["Type"] = CleanTypeName(RawTypeName);
+            if (USceneComponent* Parent = Primitive->GetAttachParent())
+            {
+                Scene["Primitives"][key]["Parent"] = Parent->UUID;
+            }
+            if (Primitive->Mobility == EComponentMobility::Movable)
+            {
+                Scene["Primitives"][key]["Mobility"] = "Movable";
+            }
         }
     }
 
@@ -38,6 +38,8 @@ private:
 
 	void SetupConsoleWindow();
 
+	void SetupStatWindow();
+
 private:
 	URenderer* Renderer;
 	UScene* Scene;
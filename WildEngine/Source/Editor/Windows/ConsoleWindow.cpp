@@ -12,6 +12,9 @@
 #include "Components/CubeComponent.h"
 #include "Components/SphereComponent.h"
 #include "Components/TriangleComponent.h"
+#include "World.h"
+#include "Scene.h"
+#include "Object/ObjectManager.h"
 
 ConsoleWindow::ConsoleWindow()
 {
@@ -29,6 +32,12 @@ ConsoleWindow::ConsoleWindow()
     Commands.push_back("save");
     Commands.push_back("load");
     Commands.push_back("spawn");
+    Commands.push_back("worldsave");
+    Commands.push_back("mergestatic");
+    Commands.push_back("showbounds");
+    Commands.push_back("showpickray");
+    Commands.push_back("occlusion");
+    Commands.push_back("meshlod");
 
     AutoScroll = true;
     ScrollToBottom = false;
@@ -446,6 +455,67 @@ void ConsoleWindow::ExecCommand(const char* CommandLine)
         }
     }
 
+    else if (Stricmp(CommandLine, "mergestatic") == 0)
+    {
+        //  Ʈ     ū    ģ (̸ ڵ и)
+        MainRenderer->GetPrimaryScene()->RequestMergeStaticMeshes();
+        AddLog("Merging static primitives on the next frame\n");
+    }
+
+    else if (Stricmp(CommandLine, "showbounds") == 0)
+    {
+        // ̴ Ƽ ٿ带   ǥ
+        UScene* Scene = MainRenderer->GetPrimaryScene();
+        Scene->SetShowBounds(!Scene->IsShowingBounds());
+        AddLog("Show bounds: %s\n", Scene->IsShowingBounds() ? "on" : "off");
+    }
+
+    else if (Stricmp(CommandLine, "showpickray") == 0)
+    {
+        //  Ŭ ŷ  ǥ ( ,  )
+        UScene* Scene = MainRenderer->GetPrimaryScene();
+        Scene->SetShowPickRay(!Scene->IsShowingPickRay());
+        AddLog("Show pick ray: %s\n", Scene->IsShowingPickRay() ? "on" : "off");
+    }
+
+    else if (Stricmp(CommandLine, "occlusion") == 0)
+    {
+        //  ø  Ʈ Ŭ ø ( stat â)
+        UScene* Scene = MainRenderer->GetPrimaryScene();
+        Scene->SetOcclusionCulling(!Scene->IsOcclusionCulling());
+        AddLog("Occlusion culling: %s\n", Scene->IsOcclusionCulling() ? "on" : "off");
+    }
+
+    else if (Stricmp(CommandLine, "meshlod") == 0)
+    {
+        // ȭ鿡  ũ LOD  ( ׻  ޽)
+        UScene* Scene = MainRenderer->GetPrimaryScene();
+        Scene->SetMeshLOD(!Scene->IsUsingMeshLOD());
+        AddLog("Mesh LOD: %s\n", Scene->IsUsingMeshLOD() ? "on" : "off");
+    }
+
+    else if (Strnicmp(CommandLine, "worldsave ", 10) == 0)
+    {
+        //  Ʈ    Ϸ   (  -world=<name>  Ʈ)
+        char worldName[128] = {};
+        float cellSize = 0.0f;
+        if (sscanf_s(CommandLine + 10, "%127s %f", worldName, static_cast<unsigned>(sizeof(worldName)), &cellSize) == 2 && cellSize > 0.0f)
+        {
+            if (UWorld::SaveWorld(worldName, cellSize, UObjectManager::GetInst().GetObjectsArray()))
+            {
+                AddLog("Saved world '%s' (cell size %.1f)\n", worldName, cellSize);
+            }
+            else
+            {
+                AddLog("Failed to save world '%s'\n", worldName);
+            }
+        }
+        else
+        {
+            AddLog("Usage: worldsave <name> <cellsize>\n");
+        }
+    }
+
     else if (Strncmp(CommandLine, "UE_LOG(", 7) == 0)
     {
         // UE_LOG(  ڿ 
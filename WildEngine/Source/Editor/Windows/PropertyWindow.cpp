@@ -9,9 +9,7 @@ PropertyWindow::PropertyWindow()
 {
 	bIsFocused = false;
 
-	Translation = nullptr;
-	Rotation = nullptr;
-	Scale = nullptr;
+	FocusComponent = nullptr;
 
 	ObjectUUID = -1;
 }
@@ -30,31 +28,25 @@ void PropertyWindow::Render()
 
 	ImGui::Begin("Property Panel", nullptr, ImGuiWindowFlags_NoResize);
 
-	if (bIsFocused)
+	if (bIsFocused && FocusComponent)
 	{
-		UpdateVectorToFloat(Translation, ObjectTranslation);
+		UpdateVectorToFloat(FocusComponent->GetRelativeLocation(), ObjectTranslation);
 
 		if (ImGui::DragFloat3("Location", ObjectTranslation))
 		{
-			Translation->X = ObjectTranslation[0];
-			Translation->Y = ObjectTranslation[1];
-			Translation->Z = ObjectTranslation[2];
+			FocusComponent->SetRelativeLocation(GetLocation());
 		}
 		
-		UpdateVectorToFloat(Rotation, ObjectRotation);
+		UpdateVectorToFloat(FocusComponent->GetRelativeRotation(), ObjectRotation);
 		if (ImGui::DragFloat3("Rotation", ObjectRotation))
 		{
-			Rotation->X = ObjectRotation[0];
-			Rotation->Y = ObjectRotation[1];
-			Rotation->Z = ObjectRotation[2];
+			FocusComponent->SetRelativeRotation(GetRotation());
 		}
 
-		UpdateVectorToFloat(Scale, ObjectScale);
+		UpdateVectorToFloat(FocusComponent->GetRelativeScale3D(), ObjectScale);
 		if (ImGui::DragFloat3("Scale", ObjectScale))
 		{
-			Scale->X = ObjectScale[0];
-			Scale->Y = ObjectScale[1];
-			Scale->Z = ObjectScale[2];
+			FocusComponent->SetRelativeScale3D(GetScale());
 		}
 
 		ImGui::Text("GUID : %d", ObjectUUID);
@@ -83,29 +75,14 @@ FVector PropertyWindow::GetScale()
 	return FVector(ObjectScale[0], ObjectScale[1], ObjectScale[2]);
 }
 
-void PropertyWindow::SetLocation(FVector& Vector)
-{
-	Translation = &Vector;
-}
-
-void PropertyWindow::SetRotation(FVector& Vector)
-{
-	Rotation = &Vector;
-}
-
-void PropertyWindow::SetScale(FVector& Vector)
-{
-	Scale = &Vector;
-}
-
 void PropertyWindow::SetUUID(uint32 UUID)
 {
 	ObjectUUID = UUID;
 }
 
-void PropertyWindow::UpdateVectorToFloat(FVector* v, float f[])
+void PropertyWindow::UpdateVectorToFloat(const FVector& v, float f[])
 {
-	f[0] = v->X;
-	f[1] = v->Y;
-	f[2] = v->Z;
+	f[0] = v.X;
+	f[1] = v.Y;
+	f[2] = v.Z;
 }
\ No newline at end of file
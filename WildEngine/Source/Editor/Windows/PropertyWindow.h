@@ -4,6 +4,7 @@
 #include "Types/Types.h"
 
 class UScene;
+class USceneComponent;
 
 class PropertyWindow : public UEditorWindow
 {
@@ -17,9 +18,7 @@ public:
 	FVector GetRotation();
 	FVector GetScale();
 
-	void SetLocation(FVector& Vector);
-	void SetRotation(FVector& Vector);
-	void SetScale(FVector& Vector);
+	void SetFocusComponent(USceneComponent* InComponent) { FocusComponent = InComponent; }
 	void SetFocusObject(bool NewState) { bIsFocused = NewState; };
 
 	void SetUUID(uint32 UUID);
@@ -27,9 +26,8 @@ public:
 private:
 	bool bIsFocused;
 
-	FVector* Translation;
-	FVector* Rotation;
-	FVector* Scale;
+	// Transform values live in FEntityStore and can move, so edit through the component
+	USceneComponent* FocusComponent;
 
 	float ObjectTranslation[3] = {0, 0, 0};
 	float ObjectRotation[3] = { 0, 0, 0 };
@@ -38,6 +36,6 @@ private:
 	INT32 ObjectUUID;
 
 private:
-	void UpdateVectorToFloat(FVector*, float f[]);
+	void UpdateVectorToFloat(const FVector&, float f[]);
 };
 
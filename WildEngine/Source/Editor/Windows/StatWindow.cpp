@@ -44,6 +44,16 @@ void StatWindow::Render()
     
     ImGui::Text(u8"Memory Usage: %d bytes", UObjectManager::GetInst().GetTotalAllocationBytes());
 
+    ImGui::Text("Draws: %u, Batches: %u", DrawSortStats.NumDraws, DrawSortStats.NumStateChanges);
+
+    ImGui::Text("State Changes Avoided: %u", DrawSortStats.GetNumStateChangesAvoided());
+
+    if (bOcclusionCulling)
+    {
+        ImGui::Text("Occluded: %u / %u", OcclusionStats.NumOccluded, OcclusionStats.NumTested);
+        ImGui::Text("Occluders: %u (%u tris)", OcclusionStats.NumOccluders, OcclusionStats.NumOccluderTriangles);
+    }
+
     ImGui::SameLine(0, 5.0f);
 
     ImGui::End();
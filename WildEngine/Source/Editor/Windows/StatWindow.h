@@ -2,6 +2,8 @@
 
 #include "Editor/EditorWindow.h"
 #include "Interface/ISwitchable.h"
+#include "DrawSortKey.h"
+#include "SceneSoftwareOcclusion.h"
 
 class StatWindow : public UEditorWindow, public ISwitchable
 {
@@ -15,8 +17,16 @@ public:
 	void OnResize(UINT32 Width, UINT32 Height) override;
 
 	void Toggle() override;
+
+	void SetDrawSortStats(const FDrawSortStats& InStats) { DrawSortStats = InStats; }
+	void SetOcclusionStats(bool bInOcclusionCulling, const FSoftwareOcclusionStats& InStats) { bOcclusionCulling = bInOcclusionCulling; OcclusionStats = InStats; }
 private:
 	
 	bool bWasOpen;
+
+	FDrawSortStats DrawSortStats;
+
+	bool bOcclusionCulling = false;
+	FSoftwareOcclusionStats OcclusionStats;
 };
 
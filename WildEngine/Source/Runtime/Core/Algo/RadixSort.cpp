@@ -0,0 +1,54 @@
+#include "Algo/RadixSort.h"
+
+void RadixSort64(TArray<uint64>& Keys, TArray<uint32>& Values, TArray<uint64>& TempKeys, TArray<uint32>& TempValues)
+{
+    const uint32 Num = static_cast<uint32>(Keys.size());
+    if (Num < 2)
+    {
+        return;
+    }
+
+    // 8비트 자리 8개의 히스토그램을 한 번의 순회로 만든다
+    uint32 Histograms[8][256] = {};
+    for (uint32 Index = 0; Index < Num; ++Index)
+    {
+        const uint64 Key = Keys[Index];
+        for (uint32 Digit = 0; Digit < 8; ++Digit)
+        {
+            ++Histograms[Digit][(Key >> (Digit * 8)) & 0xFF];
+        }
+    }
+
+    TempKeys.resize(Num);
+    TempValues.resize(Num);
+
+    for (uint32 Digit = 0; Digit < 8; ++Digit)
+    {
+        uint32* Histogram = Histograms[Digit];
+        const uint32 Shift = Digit * 8;
+
+        // 모든 키가 이 자리에서 같으면 순서가 바뀌지 않으므로 건너뛴다
+        if (Histogram[(Keys[0] >> Shift) & 0xFF] == Num)
+        {
+            continue;
+        }
+
+        uint32 Offset = 0;
+        for (uint32 Bucket = 0; Bucket < 256; ++Bucket)
+        {
+            const uint32 Count = Histogram[Bucket];
+            Histogram[Bucket] = Offset;
+            Offset += Count;
+        }
+
+        for (uint32 Index = 0; Index < Num; ++Index)
+        {
+            const uint32 Destination = Histogram[(Keys[Index] >> Shift) & 0xFF]++;
+            TempKeys[Destination] = Keys[Index];
+            TempValues[Destination] = Values[Index];
+        }
+
+        Keys.swap(TempKeys);
+        Values.swap(TempValues);
+    }
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "HAL/PlatformTypes.h"
+#include "Templates/UnrealTypes.h"
+
+/**
+ * Sorts Keys ascending with a stable LSD radix sort (8 bit digits) and applies
+ * the same permutation to Values.
+ *
+ * Digits on which every key agrees are skipped, so keys that only use a few of
+ * their 64 bits cost only a few passes. TempKeys and TempValues are scratch
+ * space; pass the same arrays every frame to avoid reallocating.
+ */
+void RadixSort64(TArray<uint64>& Keys, TArray<uint32>& Values, TArray<uint64>& TempKeys, TArray<uint32>& TempValues);
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+
+#include "Async/TaskPool.h"
+
+/**
+ * Calls Body(Index) for every Index in [0, Num), split into contiguous batches
+ * across the task pool. Ranges smaller than MinBatchSize run inline.
+ *
+ * Body must be safe to call concurrently for different indices.
+ */
+template <typename FunctionType>
+void ParallelFor(uint32 Num, const FunctionType& Body, uint32 MinBatchSize = 64)
+{
+    if (Num == 0)
+    {
+        return;
+    }
+
+    MinBatchSize = std::max(MinBatchSize, 1u);
+
+    // 워커 수보다 조금 잘게 나눠서 배치 크기 편차를 흡수한다
+    const uint32 MaxBatches = (FTaskPool::Get().GetNumWorkers() + 1) * 4;
+    const uint32 NumBatches = std::min(MaxBatches, (Num + MinBatchSize - 1) / MinBatchSize);
+
+    if (NumBatches <= 1)
+    {
+        for (uint32 Index = 0; Index < Num; ++Index)
+        {
+            Body(Index);
+        }
+        return;
+    }
+
+    const uint32 BatchSize = (Num + NumBatches - 1) / NumBatches;
+    FTaskPool::Get().Dispatch(NumBatches, [&Body, Num, BatchSize](uint32 BatchIndex)
+    {
+        const uint32 Begin = BatchIndex * BatchSize;
+        const uint32 End = std::min(Num, Begin + BatchSize);
+        for (uint32 Index = Begin; Index < End; ++Index)
+        {
+            Body(Index);
+        }
+    });
+}
@@ -0,0 +1,130 @@
+#include "TaskPool.h"
+
+namespace
+{
+    thread_local bool GIsTaskPoolWorker = false;
+}
+
+FTaskPool& FTaskPool::Get()
+{
+    static FTaskPool Instance;
+    return Instance;
+}
+
+FTaskPool::FTaskPool()
+{
+    // 호출한 스레드도 배치를 처리하므로 코어 하나는 남겨둔다
+    const uint32 NumCores = std::thread::hardware_concurrency();
+    const uint32 NumWorkers = NumCores > 1 ? NumCores - 1 : 0;
+
+    Workers.reserve(NumWorkers);
+    for (uint32 i = 0; i < NumWorkers; ++i)
+    {
+        Workers.emplace_back(&FTaskPool::WorkerMain, this);
+    }
+}
+
+FTaskPool::~FTaskPool()
+{
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        bShutdown = true;
+    }
+    WakeCondition.notify_all();
+
+    for (std::thread& Worker : Workers)
+    {
+        Worker.join();
+    }
+}
+
+bool FTaskPool::IsWorkerThread()
+{
+    return GIsTaskPoolWorker;
+}
+
+void FTaskPool::Dispatch(uint32 NumBatches, const std::function<void(uint32)>& Task)
+{
+    if (NumBatches == 0)
+    {
+        return;
+    }
+
+    if (NumBatches == 1 || Workers.empty() || GIsTaskPoolWorker)
+    {
+        for (uint32 i = 0; i < NumBatches; ++i)
+        {
+            Task(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> DispatchLock(DispatchMutex);
+
+    uint32 DispatchGeneration;
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        DispatchGeneration = ++Generation;
+        CurrentTask = &Task;
+        TotalBatches = NumBatches;
+        CompletedBatches = 0;
+        // 커서를 마지막에 열어야 늦게 깨어난 워커가 이전 세대의 배치를 집어가지 않는다
+        WorkCursor = static_cast<uint64>(DispatchGeneration) << 32;
+    }
+    WakeCondition.notify_all();
+
+    RunBatches(DispatchGeneration);
+
+    std::unique_lock<std::mutex> Lock(Mutex);
+    DoneCondition.wait(Lock, [this]() { return CompletedBatches == TotalBatches; });
+    CurrentTask = nullptr;
+}
+
+void FTaskPool::RunBatches(uint32 InGeneration)
+{
+    while (true)
+    {
+        // TotalBatches는 커서보다 먼저 읽어야 다음 세대의 값과 섞이지 않는다
+        const uint32 NumBatches = TotalBatches;
+
+        // 세대를 확인한 뒤에만 커서를 올린다. 먼저 올리면 이전 세대를 떠나는 워커가 다음 세대의 배치를 집어 버리고 실행하지 않는다
+        uint64 Cursor = WorkCursor.load();
+        do
+        {
+            if (static_cast<uint32>(Cursor >> 32) != InGeneration || static_cast<uint32>(Cursor) >= NumBatches)
+            {
+                return;
+            }
+        } while (!WorkCursor.compare_exchange_weak(Cursor, Cursor + 1));
+        const uint32 BatchIndex = static_cast<uint32>(Cursor);
+
+        (*CurrentTask)(BatchIndex);
+
+        if (CompletedBatches.fetch_add(1) + 1 == NumBatches)
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            DoneCondition.notify_all();
+        }
+    }
+}
+
+void FTaskPool::WorkerMain()
+{
+    GIsTaskPoolWorker = true;
+
+    uint32 SeenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> Lock(Mutex);
+            WakeCondition.wait(Lock, [this, SeenGeneration]() { return bShutdown || Generation != SeenGeneration; });
+            if (bShutdown)
+            {
+                return;
+            }
+            SeenGeneration = Generation;
+        }
+
+        RunBatches(SeenGeneration);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "HAL/PlatformTypes.h"
+#include "Templates/UnrealTypes.h"
+
+/**
+ * Persistent worker threads that execute batched jobs.
+ *
+ * Dispatch() hands out batch indices to the workers and the calling thread
+ * until every batch is done. Only one dispatch runs at a time; a dispatch
+ * issued from inside a worker runs inline so nested ParallelFor calls are safe.
+ */
+class FTaskPool
+{
+public:
+    static FTaskPool& Get();
+
+    FTaskPool(const FTaskPool&) = delete;
+    FTaskPool& operator=(const FTaskPool&) = delete;
+
+    /** @return The number of background workers (the calling thread is not counted). */
+    uint32 GetNumWorkers() const { return static_cast<uint32>(Workers.size()); }
+
+    /** Runs Task(BatchIndex) for every BatchIndex in [0, NumBatches) and waits for completion. */
+    void Dispatch(uint32 NumBatches, const std::function<void(uint32)>& Task);
+
+    /** @return Whether the calling thread is one of the pool workers. */
+    static bool IsWorkerThread();
+
+private:
+    FTaskPool();
+    ~FTaskPool();
+
+    void WorkerMain();
+    void RunBatches(uint32 InGeneration);
+
+private:
+    TArray<std::thread> Workers;
+
+    std::mutex DispatchMutex;
+    std::mutex Mutex;
+    std::condition_variable WakeCondition;
+    std::condition_variable DoneCondition;
+
+    const std::function<void(uint32)>* CurrentTask = nullptr;
+    std::atomic<uint32> TotalBatches = 0;
+    std::atomic<uint32> CompletedBatches = 0;
+
+    /** Generation in the high 32 bits, next batch index in the low 32 bits. */
+    std::atomic<uint64> WorkCursor = 0;
+    uint32 Generation = 0;
+    bool bShutdown = false;
+};
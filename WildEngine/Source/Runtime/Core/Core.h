@@ -17,4 +17,6 @@
  * Includes
  */
 #include "Math/UnrealMath.h"
-#include "D3D11RHI/D3D11Resources.h"
\ No newline at end of file
+#ifdef _WIN32
+#include "D3D11RHI/D3D11Resources.h"
+#endif
\ No newline at end of file
@@ -169,6 +169,25 @@ struct FGenericPlatformMath
 		return 31 - FloorLog2(Value);
 	}
 
+	/**
+	 * Counts the number of trailing zeros in the bit representation of the value
+	 *
+	 * @param Value the value to determine the number of trailing zeros for
+	 *
+	 * @return the number of zeros after the last "on" bit
+	 */
+	static FORCEINLINE uint32 CountTrailingZeros(uint32 Value)
+	{
+		if (Value == 0) return 32;
+		uint32 Result = 0;
+		while ((Value & 1) == 0)
+		{
+			Value >>= 1;
+			++Result;
+		}
+		return Result;
+	}
+
 	/**
 	 * Returns smallest N such that (1<<N)>=Arg.
 	 * Note: CeilLogTwo(0)=0 because (1<<0)=1 >= 0.
@@ -271,7 +290,7 @@ struct FGenericPlatformMath
 	template< class T > 
 	static CONSTEXPR FORCEINLINE T Abs( const T A )
 	{
-		return (A>=const_cast<T>(0)) ? A : -A;
+		return (A>=static_cast<T>(0)) ? A : -A;
 	}
 
 	/** Returns 1, 0, or -1 depending on relation of T to 0 */
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <utility>
+
+/**
+ * Smart pointer to an object with intrusive AddRef/Release (FRHIResource, COM objects).
+ * What happens on the last Release is up to the object; RHI resources defer their deletion.
+ */
+template<typename ReferencedType>
+class TRefCountPtr
+{
+public:
+    TRefCountPtr() = default;
+
+    TRefCountPtr(ReferencedType* InReference, bool bAddRef = true)
+        : Reference(InReference)
+    {
+        if (Reference && bAddRef)
+        {
+            Reference->AddRef();
+        }
+    }
+
+    TRefCountPtr(const TRefCountPtr& Other)
+        : TRefCountPtr(Other.Reference)
+    {
+    }
+
+    TRefCountPtr(TRefCountPtr&& Other) noexcept
+        : Reference(Other.Reference)
+    {
+        Other.Reference = nullptr;
+    }
+
+    ~TRefCountPtr()
+    {
+        if (Reference)
+        {
+            Reference->Release();
+        }
+    }
+
+    TRefCountPtr& operator=(ReferencedType* InReference)
+    {
+        // 자기 대입에도 안전하도록 새 참조를 먼저 올린다
+        ReferencedType* OldReference = Reference;
+        Reference = InReference;
+        if (Reference)
+        {
+            Reference->AddRef();
+        }
+        if (OldReference)
+        {
+            OldReference->Release();
+        }
+        return *this;
+    }
+
+    TRefCountPtr& operator=(const TRefCountPtr& Other)
+    {
+        return *this = Other.Reference;
+    }
+
+    TRefCountPtr& operator=(TRefCountPtr&& Other) noexcept
+    {
+        if (this != &Other)
+        {
+            ReferencedType* OldReference = Reference;
+            Reference = Other.Reference;
+            Other.Reference = nullptr;
+            if (OldReference)
+            {
+                OldReference->Release();
+            }
+        }
+        return *this;
+    }
+
+    ReferencedType* operator->() const { return Reference; }
+    ReferencedType& operator*() const { return *Reference; }
+    operator ReferencedType*() const { return Reference; }
+
+    ReferencedType* GetReference() const { return Reference; }
+    bool IsValid() const { return Reference != nullptr; }
+
+    void SafeRelease() { *this = nullptr; }
+
+private:
+    ReferencedType* Reference = nullptr;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstring>
+
+#include "HAL/PlatformTypes.h"
+
+/**
+ * Combines two hash values to get a third (Bob Jenkins' 96 bit mix).
+ * Not commutative: HashCombine(A, B) != HashCombine(B, A).
+ */
+inline uint32 HashCombine(uint32 A, uint32 C)
+{
+    uint32 B = 0x9e3779b9;
+    A += B;
+
+    A -= B; A -= C; A ^= (C >> 13);
+    B -= C; B -= A; B ^= (A << 8);
+    C -= A; C -= B; C ^= (B >> 13);
+    A -= B; A -= C; A ^= (C >> 12);
+    B -= C; B -= A; B ^= (A << 16);
+    C -= A; C -= B; C ^= (B >> 5);
+    A -= B; A -= C; A ^= (C >> 3);
+    B -= C; B -= A; B ^= (A << 10);
+    C -= A; C -= B; C ^= (B >> 15);
+
+    return C;
+}
+
+inline uint32 GetTypeHash(uint32 Value)
+{
+    return Value;
+}
+
+inline uint32 GetTypeHash(int32 Value)
+{
+    return static_cast<uint32>(Value);
+}
+
+inline uint32 GetTypeHash(bool Value)
+{
+    return Value ? 1u : 0u;
+}
+
+inline uint32 GetTypeHash(float Value)
+{
+    // 0.0f == -0.0f 이므로 같은 해시가 나와야 한다
+    if (Value == 0.0f)
+    {
+        return 0;
+    }
+    uint32 Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+}
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <vector>
+#include <list>
 #include <unordered_map>
 #include <unordered_set>
 #include <queue>
@@ -33,4 +34,7 @@ template <typename T1, typename T2>
 using TPair = std::pair<T1, T2>;
 
 using FString = std::string;
-using FWString = std::wstring;
\ No newline at end of file
+using FWString = std::wstring;
+
+// 컨테이너 인덱스가 없음을 나타내는 값
+enum { INDEX_NONE = -1 };
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdio>
+
+#include "HAL/PlatformTypes.h"
+
+/**
+ * Checks shared by the tests in each module's Tests folder. Every test is a
+ * standalone executable whose main runs its test functions and returns
+ * ReportTestResults, so a failing test exits non zero.
+ */
+
+/** Checks that failed so far in this executable. */
+inline int32 GNumTestFailures = 0;
+
+/** Reports Description as failed unless bCondition holds. */
+inline void Check(bool bCondition, const char* Description)
+{
+	if (!bCondition)
+	{
+		std::printf("FAILED: %s\n", Description);
+		++GNumTestFailures;
+	}
+}
+
+/** Prints whether TestName passed. @return The number of failed checks, for main to return. */
+inline int32 ReportTestResults(const char* TestName)
+{
+	std::printf("%s: %s\n", TestName, GNumTestFailures == 0 ? "passed" : "failed");
+	return GNumTestFailures;
+}
@@ -7,7 +7,7 @@ UCubeComponent::UCubeComponent()
 UCubeComponent::UCubeComponent(URenderer* InRenderer, FVector InLocation)
 {
     Renderer = InRenderer;
-    RelativeLocation = InLocation;
+    SetRelativeLocation(InLocation);
     Initialize();
 }
 UCubeComponent::UCubeComponent(URenderer* InRenderer)
@@ -24,8 +24,8 @@ UCubeComponent::~UCubeComponent()
 }
 void UCubeComponent::Initialize()
 {
-    NumVertices = sizeof(cube_vertices) / sizeof(FVertexType);
-    VertexBuffer = Renderer->CreateVertexBuffer(cube_vertices, sizeof(cube_vertices));
+    //  ޽ νϽ  ϳ Ѵ
+    SetStaticMesh(cube_vertices, sizeof(cube_vertices) / sizeof(FVertexType));
 }
 
 UClass* UCubeComponent::GetClass()
@@ -93,8 +93,9 @@ bool UCubeComponent::CheckRayIntersection(FVector RayOrigin, FVector RayDirectio
    // OutHitResult.HitLocation = WorldHitPos;
    // OutHitResult.HitObject = this;
 
-    FVector SphereCenter = RelativeLocation; //   ǥ
-    float SphereRadius = RelativeScale3D.X; //  
+    const FMatrix WorldTransform = GetWorldTransform();
+    FVector SphereCenter = FVector(WorldTransform.M[3][0], WorldTransform.M[3][1], WorldTransform.M[3][2]); //   ǥ
+    float SphereRadius = WorldTransform.GetMaximumAxisScale(); // θ ϱ ݿ    ū  
 
     FVector L = SphereCenter - RayOrigin;
     float tca = L.Dot(RayDirection);
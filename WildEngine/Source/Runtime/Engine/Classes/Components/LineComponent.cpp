@@ -1,4 +1,5 @@
 #include "LineComponent.h"
+#include "DynamicRHI.h"
 
 ULineComponent::ULineComponent()
 {
@@ -7,7 +8,7 @@ ULineComponent::ULineComponent()
 ULineComponent::ULineComponent(URenderer* InRenderer, FVector InLocation)
 {
 	Renderer = InRenderer;
-	RelativeLocation = InLocation;
+	SetRelativeLocation(InLocation);
 	Initialize();
 }
 
@@ -43,20 +44,19 @@ bool ULineComponent::CheckRayIntersection(FVector RayOrigin, FVector RayDirectio
 
 void ULineComponent::Render(FMatrix WorldMatrix, FMatrix ViewMatrix, FMatrix ProjectionMatrix)
 {
-	FMatrix Translation = FMatrix::Translation(RelativeLocation.X, RelativeLocation.Y, RelativeLocation.Z);
-	FMatrix Rotation = FMatrix::CreateRotationRollPitchYaw(RelativeRotation.X, RelativeRotation.Y, RelativeRotation.Z);
-	FMatrix Scaling = FMatrix::Scaling(RelativeScale3D.X, RelativeScale3D.Y, RelativeScale3D.Z);
-
-	WorldTransform = Scaling * Rotation * Translation; // ϸ * ȸ * ̵
+	// WorldTransform UScene  ſ θ ȯ ݿǾ ä
 
 	// ̴   Ʈ
-	Renderer->UpdateShaderParameters(WorldTransform, ViewMatrix, ProjectionMatrix);
+	const FMatrix MVP = GetWorldTransform() * ViewMatrix * ProjectionMatrix;
+	RHISetShaderConstants(0, &MVP, sizeof(FMatrix));
 
-	Renderer->RenderPrimitive(VertexBuffer, NumVertices);
+	RHISetStreamSource(0, GetStaticMesh()->GetVertexBuffer(), sizeof(FVertexType), 0);
+	RHIDrawPrimitive(PT_LineList, GetStaticMesh()->GetFirstVertex(), NumVertices / 2, 1);
 }
 
 void ULineComponent::Initialize()
 {
-	NumVertices = sizeof(grid_vertices) / sizeof(FVertexType);
-	VertexBuffer = Renderer->CreateVertexBuffer(grid_vertices, sizeof(grid_vertices));
+	//    ޽ø νϽ ġ  ޽ÿ  ʰ   ׸
+	bLineList = true;
+	SetStaticMesh(grid_vertices, sizeof(grid_vertices) / sizeof(FVertexType));
 }
@@ -1,32 +1,88 @@
 #include "PrimitiveComponent.h"
+#include "DynamicRHI.h"
+#include <algorithm>
 
 UPrimitiveComponent::UPrimitiveComponent()
 {
-	RelativeLocation = FVector(0.0f, 0.0f, 0.0f);
-	RelativeRotation = FVector(0.0f, 0.0f, 0.0f);
-	RelativeScale3D = FVector(1.0f, 1.0f, 1.0f);
+	// Ǵ Ʈ Bounds  ִ ŰŸ ű
+	FEntityStore::GetInst().SetEntityColumns(EntityId, EntityColumns_Primitive);
 }
 
 UPrimitiveComponent::UPrimitiveComponent(const UPrimitiveComponent&)
 {
+	FEntityStore::GetInst().SetEntityColumns(EntityId, EntityColumns_Primitive);
 }
 
 UPrimitiveComponent::~UPrimitiveComponent()
 {
+    FStaticMeshCache::GetInst().Release(StaticMesh);
+
+    if (bRenderStateDirty)
+    {
+        TArray<UPrimitiveComponent*>& DirtyList = GetRenderStateDirtyList();
+        DirtyList.erase(std::remove(DirtyList.begin(), DirtyList.end(), this), DirtyList.end());
+    }
+}
+
+void UPrimitiveComponent::SetStaticMesh(const FVertexType* Vertices, uint32 InNumVertices, const TArray<FStaticMeshLODDesc>& LODDescs)
+{
+    const FStaticMesh* OldMesh = StaticMesh;
+    StaticMesh = FStaticMeshCache::GetInst().Acquire(Vertices, InNumVertices, LODDescs);
+    FStaticMeshCache::GetInst().Release(OldMesh);
+
+    NumVertices = StaticMesh->NumVertices;
+    SetLocalBounds(StaticMesh->LocalBounds);
+
+    if (OldMesh && OldMesh != StaticMesh)
+    {
+        MarkRenderStateDirty();
+    }
+}
+
+void UPrimitiveComponent::SetVisibility(bool bNewVisible)
+{
+    if (bVisible != bNewVisible)
+    {
+        bVisible = bNewVisible;
+        MarkRenderStateDirty();
+    }
+}
+
+void UPrimitiveComponent::MarkRenderStateDirty()
+{
+    if (!bRenderStateDirty)
+    {
+        bRenderStateDirty = true;
+        GetRenderStateDirtyList().push_back(this);
+    }
+}
+
+void UPrimitiveComponent::ConsumeRenderStateDirtyList(TArray<UPrimitiveComponent*>& OutComponents)
+{
+    OutComponents.clear();
+    OutComponents.swap(GetRenderStateDirtyList());
+    for (UPrimitiveComponent* Component : OutComponents)
+    {
+        Component->bRenderStateDirty = false;
+    }
+}
+
+TArray<UPrimitiveComponent*>& UPrimitiveComponent::GetRenderStateDirtyList()
+{
+    static TArray<UPrimitiveComponent*> DirtyList;
+    return DirtyList;
 }
 
 void UPrimitiveComponent::Render(FMatrix WorldMatrix, FMatrix ViewMatrix, FMatrix ProjectionMatrix)
 {
-    FMatrix Translation = FMatrix::Translation(RelativeLocation.X, RelativeLocation.Y, RelativeLocation.Z);
-    FMatrix Rotation = FMatrix::CreateRotationRollPitchYaw(RelativeRotation.X, RelativeRotation.Y, RelativeRotation.Z);
-    FMatrix Scaling = FMatrix::Scaling(RelativeScale3D.X, RelativeScale3D.Y, RelativeScale3D.Z);
+    // WorldTransform UScene  ſ θ ȯ ݿǾ ä
 
-    WorldTransform = Scaling * Rotation * Translation; // ϸ * ȸ * ̵
-    
     // ̴   Ʈ
-    Renderer->UpdateShaderParameters(WorldTransform, ViewMatrix, ProjectionMatrix);
+    const FMatrix MVP = GetWorldTransform() * ViewMatrix * ProjectionMatrix;
+    RHISetShaderConstants(0, &MVP, sizeof(FMatrix));
 
-    Renderer->RenderPrimitive(VertexBuffer, NumVertices);
+    RHISetStreamSource(0, StaticMesh->GetVertexBuffer(), sizeof(FVertexType), 0);
+    RHIDrawPrimitive(PT_TriangleList, StaticMesh->GetFirstVertex(), NumVertices / 3, 1);
 }
 
 UClass* UPrimitiveComponent::GetClass()
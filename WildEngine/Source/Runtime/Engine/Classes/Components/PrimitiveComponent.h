@@ -2,6 +2,17 @@
 #include "SceneComponent.h"
 #include "Primitive.h"
 #include "Renderer/URenderer.h"
+#include "PrimitiveSceneProxy.h"
+#include "StaticMeshCache.h"
+
+class FRHIVertexBuffer;
+
+/** Whether a primitive may be baked into merged static geometry. */
+enum class EComponentMobility : uint8
+{
+	Static,
+	Movable,
+};
 
 class UPrimitiveComponent : public USceneComponent
 {
@@ -12,21 +23,58 @@ public:
 
 	void Render(FMatrix WorldMatrix, FMatrix ViewMatrix, FMatrix ProjectionMatrix);
 
-	// ��ġ, ȸ��, ������ ���� ������ �� �ִ� setter �Լ���
-	void SetRelativeLocation(const FVector& NewLocation) { RelativeLocation = NewLocation; }
-	void SetRelativeRotation(const FVector& NewRotation) { RelativeRotation = NewRotation; }
-	void SetRelativeScale3D(const FVector& NewScale3D) { RelativeScale3D = NewScale3D; }
-
 	static UClass* GetClass();
 
 	UClass* GetInstanceClass() const override;
 
 	virtual bool CheckRayIntersection(FVector RayOrigin, FVector RayDirection, FHitResult& OutHitResult) = 0;
 
+	/* Render proxy */
+	void SetVisibility(bool bNewVisible);
+	bool IsVisible() const { return bVisible; }
+
+	/** Queues this component so the scene refreshes its proxy (mesh, bounds, flags) next frame. */
+	void MarkRenderStateDirty();
+
+	uint32 GetSceneProxyFlags() const { return (bVisible ? PSF_Visible : PSF_None) | (bLineList ? PSF_LineList : PSF_None); }
+
+	/** Moves every component marked since the last call into OutComponents and clears their marks. */
+	static void ConsumeRenderStateDirtyList(TArray<UPrimitiveComponent*>& OutComponents);
+
+	/** Switches to the shared cached mesh built from Vertices, with LODDescs as its coarser levels, and takes its bounds as the local bounds. */
+	void SetStaticMesh(const FVertexType* Vertices, uint32 InNumVertices, const TArray<FStaticMeshLODDesc>& LODDescs = {});
+	const FStaticMesh* GetStaticMesh() const { return StaticMesh; }
+
 	URenderer* Renderer;
 
+	/** Copied from StaticMesh. Its vertex buffer and first vertex are read through GetStaticMesh, since the vertex buffer arena may move the range. */
 	UINT NumVertices;
-	ID3D11Buffer* VertexBuffer;
+
+	/** Bounds of the mesh in component space, set when the mesh is created. Stored in the entity's Bounds column. */
+	const FPrimitiveBounds& GetLocalBounds() const { return FEntityStore::GetInst().Get<EEntityColumn::Bounds>(EntityId); }
+	void SetLocalBounds(const FPrimitiveBounds& NewBounds) { FEntityStore::GetInst().Get<EEntityColumn::Bounds>(EntityId) = NewBounds; }
+
+	/** Index into the owning scene's proxy arrays, INDEX_NONE while unregistered. */
+	int32 SceneProxyId = INDEX_NONE;
+
+	/** Static primitives are merged when the scene bakes; moving or editing one splits it out and makes it Movable. */
+	EComponentMobility Mobility = EComponentMobility::Movable;
+
+	/** Merged static mesh group holding this component, INDEX_NONE when drawn on its own. */
+	int32 MergedGroupId = INDEX_NONE;
+	uint32 MergedMemberIndex = 0;
 
 	float rot;
+
+protected:
+	/** Set by components whose mesh is a line list, which the triangle list batches cannot draw. */
+	bool bLineList = false;
+
+private:
+	static TArray<UPrimitiveComponent*>& GetRenderStateDirtyList();
+
+	bool bVisible = true;
+	bool bRenderStateDirty = false;
+
+	const FStaticMesh* StaticMesh = nullptr;
 };
\ No newline at end of file
@@ -1,10 +1,36 @@
 #include "SceneComponent.h"
+#include <algorithm>
+
+uint32 USceneComponent::HierarchyVersion = 0;
 
 USceneComponent::USceneComponent()
 {
-	RelativeLocation = FVector(0.0f, 0.0f, 0.0f);
-	RelativeRotation = FVector(0.0f, 0.0f, 0.0f);
-	RelativeScale3D = FVector(1.0f, 1.0f, 1.0f);
+	// 상대 변환은 0 / 0 / 1 로 초기화되어 있다
+	EntityId = FEntityStore::GetInst().CreateEntity(EntityColumns_Transform, this);
+
+	++HierarchyVersion;
+}
+
+USceneComponent::USceneComponent(URenderer* InRenderer, const FVector& InLocation)
+	: USceneComponent()
+{
+	SetRelativeLocation(InLocation);
+}
+
+USceneComponent::~USceneComponent()
+{
+	DetachFromComponent();
+
+	// Children survive their parent as new roots
+	for (USceneComponent* Child : AttachChildren)
+	{
+		Child->AttachParent = nullptr;
+	}
+	AttachChildren.clear();
+
+	FEntityStore::GetInst().DestroyEntity(EntityId);
+
+	++HierarchyVersion;
 }
 
 UClass* USceneComponent::GetClass()
@@ -17,3 +43,63 @@ UClass* USceneComponent::GetInstanceClass() const
 {
 	return GetClass();
 }
+
+FMatrix USceneComponent::GetRelativeTransform() const
+{
+	return MakeRelativeTransform(GetRelativeLocation(), GetRelativeRotation(), GetRelativeScale3D());
+}
+
+FMatrix USceneComponent::MakeRelativeTransform(const FVector& Location, const FVector& Rotation, const FVector& Scale3D)
+{
+	FMatrix TranslationMatrix = FMatrix::Translation(Location.X, Location.Y, Location.Z);
+	FMatrix RotationMatrix = FMatrix::CreateRotationRollPitchYaw(Rotation.X, Rotation.Y, Rotation.Z);
+	FMatrix ScalingMatrix = FMatrix::Scaling(Scale3D.X, Scale3D.Y, Scale3D.Z);
+
+	return ScalingMatrix * RotationMatrix * TranslationMatrix;
+}
+
+bool USceneComponent::AttachToComponent(USceneComponent* InParent)
+{
+	if (InParent == AttachParent)
+	{
+		return true;
+	}
+
+	// Reject cycles: InParent must not be this component or live below it
+	for (USceneComponent* Ancestor = InParent; Ancestor; Ancestor = Ancestor->AttachParent)
+	{
+		if (Ancestor == this)
+		{
+			return false;
+		}
+	}
+
+	DetachFromComponent();
+
+	if (InParent)
+	{
+		AttachParent = InParent;
+		InParent->AttachChildren.push_back(this);
+		++HierarchyVersion;
+	}
+
+	return true;
+}
+
+void USceneComponent::DetachFromComponent()
+{
+	if (!AttachParent)
+	{
+		return;
+	}
+
+	TArray<USceneComponent*>& Siblings = AttachParent->AttachChildren;
+	auto It = std::find(Siblings.begin(), Siblings.end(), this);
+	if (It != Siblings.end())
+	{
+		Siblings.erase(It);
+	}
+
+	AttachParent = nullptr;
+	++HierarchyVersion;
+}
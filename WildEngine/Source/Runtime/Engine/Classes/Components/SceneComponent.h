@@ -2,6 +2,7 @@
 
 #include "Object/Object.h"
 #include "Math/Matrix.h"
+#include "EntityStore.h"
 
 class URenderer;
 
@@ -9,17 +10,53 @@ class USceneComponent : public UObject
 {
 public:
 	USceneComponent();
-	USceneComponent(URenderer* InRenderer, const FVector& InLocation){};
-
-	FVector RelativeLocation;
-	FVector RelativeRotation;
-	FVector RelativeScale3D;
-
-	FMatrix WorldTransform;
+	USceneComponent(URenderer* InRenderer, const FVector& InLocation);
+	USceneComponent(const USceneComponent&) = delete;
+	USceneComponent& operator=(const USceneComponent&) = delete;
+	~USceneComponent() override;
 
 	static UClass* GetClass();
 	UClass* GetInstanceClass() const override;
 
 public:
-	virtual FMatrix GetWorldTransform() { return WorldTransform; };
-};
\ No newline at end of file
+	/* Transform, stored in FEntityStore columns */
+	const FVector& GetRelativeLocation() const { return FEntityStore::GetInst().Get<EEntityColumn::Location>(EntityId); }
+	const FVector& GetRelativeRotation() const { return FEntityStore::GetInst().Get<EEntityColumn::Rotation>(EntityId); }
+	const FVector& GetRelativeScale3D() const { return FEntityStore::GetInst().Get<EEntityColumn::Scale>(EntityId); }
+
+	void SetRelativeLocation(const FVector& NewLocation) { FEntityStore::GetInst().Get<EEntityColumn::Location>(EntityId) = NewLocation; }
+	void SetRelativeRotation(const FVector& NewRotation) { FEntityStore::GetInst().Get<EEntityColumn::Rotation>(EntityId) = NewRotation; }
+	void SetRelativeScale3D(const FVector& NewScale3D) { FEntityStore::GetInst().Get<EEntityColumn::Scale>(EntityId) = NewScale3D; }
+
+	/** World transform resolved by the scene hierarchy (parent transforms included). */
+	virtual FMatrix GetWorldTransform() { return FEntityStore::GetInst().Get<EEntityColumn::WorldMatrix>(EntityId); };
+	void SetWorldTransform(const FMatrix& NewWorldTransform) { FEntityStore::GetInst().Get<EEntityColumn::WorldMatrix>(EntityId) = NewWorldTransform; }
+
+	FEntityId GetEntityId() const { return EntityId; }
+
+	/** Scale * Rotation * Translation built from the relative location, rotation and scale. */
+	FMatrix GetRelativeTransform() const;
+	static FMatrix MakeRelativeTransform(const FVector& Location, const FVector& Rotation, const FVector& Scale3D);
+
+	/**
+	 * Attaches this component under InParent. Fails (returns false) when InParent
+	 * is this component or one of its descendants.
+	 */
+	bool AttachToComponent(USceneComponent* InParent);
+	void DetachFromComponent();
+
+	USceneComponent* GetAttachParent() const { return AttachParent; }
+	const TArray<USceneComponent*>& GetAttachChildren() const { return AttachChildren; }
+
+	/** Bumped whenever a scene component is created, destroyed, attached or detached. */
+	static uint32 GetHierarchyVersion() { return HierarchyVersion; }
+
+protected:
+	FEntityId EntityId;
+
+	USceneComponent* AttachParent = nullptr;
+	TArray<USceneComponent*> AttachChildren;
+
+private:
+	static uint32 HierarchyVersion;
+};
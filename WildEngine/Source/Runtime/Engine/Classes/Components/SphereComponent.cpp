@@ -1,6 +1,71 @@
 #include "SphereComponent.h"
 #include "Renderer/URenderer.h"
 
+#include <cmath>
+
+namespace
+{
+    /** Segments around and stacks down the coarser spheres; sphere_vertices itself has 20. */
+    const uint32 SphereLODSegments[] = { 14, 10, 7, 5 };
+
+    /** How far, in pixels, a LOD's facets may pull the silhouette in. */
+    constexpr float SphereLODMaxErrorPixels = 1.0f;
+
+    /** Builds a unit sphere laid out like sphere_vertices: a triangle list, colored by position. */
+    void BuildSphereVertices(uint32 NumSegments, TArray<FVertexType>& OutVertices)
+    {
+        const float Pi = 3.14159265f;
+        auto GetVertex = [&](uint32 Stack, uint32 Segment)
+        {
+            const float Phi = Pi * Stack / NumSegments;
+            const float Theta = 2.0f * Pi * Segment / NumSegments;
+            FVertexType Vertex;
+            Vertex.x = std::sin(Phi) * std::cos(Theta);
+            Vertex.y = std::cos(Phi);
+            Vertex.z = std::sin(Phi) * std::sin(Theta);
+            Vertex.r = Vertex.x * 0.5f + 0.5f;
+            Vertex.g = Vertex.y * 0.5f + 0.5f;
+            Vertex.b = Vertex.z * 0.5f + 0.5f;
+            Vertex.a = 1.0f;
+            return Vertex;
+        };
+
+        OutVertices.clear();
+        OutVertices.reserve(NumSegments * NumSegments * 6);
+        for (uint32 Stack = 0; Stack < NumSegments; ++Stack)
+        {
+            for (uint32 Segment = 0; Segment < NumSegments; ++Segment)
+            {
+                OutVertices.push_back(GetVertex(Stack, Segment));
+                OutVertices.push_back(GetVertex(Stack + 1, Segment));
+                OutVertices.push_back(GetVertex(Stack + 1, Segment + 1));
+                OutVertices.push_back(GetVertex(Stack, Segment));
+                OutVertices.push_back(GetVertex(Stack + 1, Segment + 1));
+                OutVertices.push_back(GetVertex(Stack, Segment + 1));
+            }
+        }
+    }
+
+    /** The sphere's LOD chain, built once; the vertex arrays live as long as the program like sphere_vertices. */
+    const TArray<FStaticMeshLODDesc>& GetSphereLODs()
+    {
+        static TArray<FVertexType> Vertices[sizeof(SphereLODSegments) / sizeof(SphereLODSegments[0])];
+        static TArray<FStaticMeshLODDesc> LODs;
+        if (LODs.empty())
+        {
+            for (uint32 Level = 0; Level < sizeof(SphereLODSegments) / sizeof(SphereLODSegments[0]); ++Level)
+            {
+                BuildSphereVertices(SphereLODSegments[Level], Vertices[Level]);
+
+                // N각형 실루엣은 반지름 r 픽셀에서 r * (1 - cos(pi / N)) 만큼 안으로 들어간다
+                const float MaxScreenRadius = SphereLODMaxErrorPixels / (1.0f - std::cos(3.14159265f / SphereLODSegments[Level]));
+                LODs.push_back({ Vertices[Level].data(), static_cast<uint32>(Vertices[Level].size()), MaxScreenRadius });
+            }
+        }
+        return LODs;
+    }
+}
+
 USphereComponent::USphereComponent()
 {
 }
@@ -13,7 +78,7 @@ USphereComponent::USphereComponent(Renderer* InRenderer)
 USphereComponent::USphereComponent(Renderer* InRenderer, const FVector& InLocation)
 {
     Renderer = InRenderer;
-    RelativeLocation = InLocation;
+    SetRelativeLocation(InLocation);
     Initialize();
 }
 USphereComponent::USphereComponent(const USphereComponent&)
@@ -37,8 +102,9 @@ UClass* USphereComponent::GetInstanceClass() const
 
 bool USphereComponent::CheckRayIntersection(FVector RayOrigin, FVector RayDirection, FHitResult& OutHitResult)
 {
-    FVector SphereCenter = RelativeLocation; // ���� ���� ��ǥ
-    float SphereRadius = RelativeScale3D.X; // ���� ������
+    const FMatrix WorldTransform = GetWorldTransform();
+    FVector SphereCenter = FVector(WorldTransform.M[3][0], WorldTransform.M[3][1], WorldTransform.M[3][2]); // ���� ���� ��ǥ
+    float SphereRadius = WorldTransform.GetMaximumAxisScale(); // 부모 스케일까지 반영된 월드 행렬의 가장 큰 축 스케일
 
     FVector L = SphereCenter - RayOrigin;
     float tca = L.Dot(RayDirection);
@@ -64,6 +130,6 @@ bool USphereComponent::CheckRayIntersection(FVector RayOrigin, FVector RayDirect
 }
 void USphereComponent::Initialize()
 {
-    NumVertices = sizeof(sphere_vertices) / sizeof(FVertexType);
-    VertexBuffer = Renderer->CreateVertexBuffer(sphere_vertices, sizeof(sphere_vertices));
+    // 같은 메시의 인스턴스는 버퍼 하나를 공유한다. 작게 보이면 씬이 더 성긴 LOD로 그린다
+    SetStaticMesh(sphere_vertices, sizeof(sphere_vertices) / sizeof(FVertexType), GetSphereLODs());
 }
\ No newline at end of file
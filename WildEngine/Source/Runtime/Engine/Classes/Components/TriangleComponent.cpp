@@ -12,7 +12,7 @@ UTriangleComponent::UTriangleComponent(Renderer* InRenderer)
 UTriangleComponent::UTriangleComponent(Renderer* InRenderer, const FVector& InLocation)
 {
     Renderer = InRenderer;
-    RelativeLocation = InLocation;
+    SetRelativeLocation(InLocation);
     Initialize();
 }
 UTriangleComponent::UTriangleComponent(const UTriangleComponent&)
@@ -91,9 +91,9 @@ bool UTriangleComponent::CheckRayIntersection(FVector RayOrigin, FVector RayDire
     FVector v2_local = FVector(-1.0f, -1.0f, 0.0f);
 
     // �� ��ȯ ��� ���� (������ -> ȸ�� -> �̵� ����)
-    FMatrix Scaling = FMatrix::Scaling(RelativeScale3D.X, RelativeScale3D.Y, RelativeScale3D.Z);
-    FMatrix Rotation = FMatrix::CreateRotationRollPitchYaw(RelativeRotation.X, RelativeRotation.Y, RelativeRotation.Z);
-    FMatrix Translation = FMatrix::Translation(RelativeLocation.X, RelativeLocation.Y, RelativeLocation.Z);
+    FMatrix Scaling = FMatrix::Scaling(GetRelativeScale3D().X, GetRelativeScale3D().Y, GetRelativeScale3D().Z);
+    FMatrix Rotation = FMatrix::CreateRotationRollPitchYaw(GetRelativeRotation().X, GetRelativeRotation().Y, GetRelativeRotation().Z);
+    FMatrix Translation = FMatrix::Translation(GetRelativeLocation().X, GetRelativeLocation().Y, GetRelativeLocation().Z);
     FMatrix ModelMatrix = Scaling * Rotation * Translation;
 
     // ���� �������� ��ȯ�� �ﰢ�� ������
@@ -124,6 +124,6 @@ bool UTriangleComponent::CheckRayIntersection(FVector RayOrigin, FVector RayDire
 
 void UTriangleComponent::Initialize()
 {
-    NumVertices = sizeof(triangle_vertices) / sizeof(FVertexType);
-    VertexBuffer = Renderer->CreateVertexBuffer(triangle_vertices, sizeof(triangle_vertices));
+    // 같은 메시의 인스턴스는 버퍼 하나를 공유한다
+    SetStaticMesh(triangle_vertices, sizeof(triangle_vertices) / sizeof(FVertexType));
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "D3D11SceneRenderer.h"
+
+#include "Renderer/URenderer.h"
+
+namespace
+{
+	const wchar_t* ObjectShaderFile = L"Shaders/ShaderW0.hlsl";
+}
+
+FD3D11SceneRenderer::FD3D11SceneRenderer(URenderer* InRenderer)
+	: Renderer(InRenderer)
+{
+	StateCache.SetContext(Renderer->GetDeviceContext());
+	InstancedMeshRenderer.Initialize(Renderer->GetDevice());
+	DebugDrawRenderer.Initialize(Renderer->GetDevice());
+	InitializeObjectPipeline();
+}
+
+bool FD3D11SceneRenderer::InitializeObjectPipeline()
+{
+	const D3D11_INPUT_ELEMENT_DESC Layout[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 0,  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	};
+	return ObjectShaderState.Initialize(Renderer->GetDevice(), ObjectShaderFile, Layout, ARRAYSIZE(Layout));
+}
+
+void FD3D11SceneRenderer::Render(const FFramePacket& Packet)
+{
+	const FFrameView& View = Packet.View;
+
+	// 씬 프리미티브는 메시당 인스턴스 드로우 한 번
+	if (InstancedMeshRenderer.IsInitialized())
+	{
+		InstancedMeshRenderer.Render(StateCache, View, Packet.MeshBatches, Packet.Instances);
+	}
+
+	// 나머지(인스턴싱 불가 시의 배치, 기즈모)는 오브젝트마다 MVP가 필요하다
+	GatherObjectDraws(Packet, !InstancedMeshRenderer.IsInitialized());
+	RenderObjectDraws(View);
+
+	if (DebugDrawRenderer.IsInitialized())
+	{
+		DebugDrawRenderer.Render(StateCache, View, Packet.DebugVertices);
+	}
+}
+
+void FD3D11SceneRenderer::RenderObjectDraws(const FFrameView& View)
+{
+	ObjectConstantStats = FObjectConstantStats();
+	ObjectConstantStats.NumDraws = static_cast<uint32>(ObjectDraws.size());
+	if (ObjectDraws.empty() || !ObjectShaderState.IsInitialized())
+	{
+		return;
+	}
+
+	const FMatrix ViewProjection = View.ViewMatrix * View.ProjectionMatrix;
+
+	// 셰이더와 입력 레이아웃만 여기서 걸고 상수, 스트림, 깊이, 드로우는 커맨드 리스트가 RHI로 건다.
+	// 렌더러 파이프라인을 쓰는 이후 드로우를 위해 바꾼 상태는 스코프가 되돌린다
+	FD3D11StateScope StateScope(StateCache);
+	ObjectShaderState.Bind(StateCache);
+
+	RecordAndExecute(ObjectConstantStats.NumDraws, [this, &ViewProjection](uint32 Begin, uint32 End, FRHICommandList& CommandList)
+	{
+		return RecordObjectDraws(ObjectDraws, ViewProjection, Begin, End, CommandList);
+	});
+}
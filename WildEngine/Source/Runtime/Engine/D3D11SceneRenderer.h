@@ -0,0 +1,40 @@
+#pragma once
+
+#include "D3D11RHI/D3D11BoundShaderState.h"
+#include "D3D11RHI/D3D11State.h"
+#include "DebugDrawRenderer.h"
+#include "InstancedMeshRenderer.h"
+#include "SceneRenderer.h"
+
+class URenderer;
+
+/**
+ * The windowed scene renderer, drawing into URenderer's device.
+ *
+ * Mesh batches go through the instanced pass and debug geometry through the
+ * debug draw pass, both D3D11 specific. The remaining object draws are
+ * recorded into command lists like the headless path and executed on the
+ * D3D11 RHI with ShaderW0 bound.
+ */
+class FD3D11SceneRenderer : public FSceneRenderer
+{
+public:
+	explicit FD3D11SceneRenderer(URenderer* InRenderer);
+
+	void Render(const FFramePacket& Packet) override;
+
+private:
+	/** Compiles ShaderW0 for the object draws. @return false when it is unavailable; object draws are then skipped. */
+	bool InitializeObjectPipeline();
+
+	/** Draws ObjectDraws with the object pipeline bound, recorded into command lists and executed on GDynamicRHI. */
+	void RenderObjectDraws(const FFrameView& View);
+
+private:
+	URenderer* Renderer = nullptr;
+	FInstancedMeshRenderer InstancedMeshRenderer;
+	FDebugDrawRenderer DebugDrawRenderer;
+
+	FD3D11StateCache StateCache;
+	FD3D11BoundShaderState ObjectShaderState;
+};
@@ -0,0 +1,120 @@
+#include "DebugDraw.h"
+
+#include <cmath>
+#include <utility>
+
+#include "PrimitiveSceneProxy.h"
+
+namespace
+{
+	constexpr float DebugDrawPi = 3.14159265358979f;
+
+	/** Corner I of a box: bit 0 picks +X, bit 1 +Y, bit 2 +Z. */
+	FVector GetBoxCorner(const FVector& Center, const FVector& Extent, uint32 Index)
+	{
+		return FVector(
+			Center.X + ((Index & 1) ? Extent.X : -Extent.X),
+			Center.Y + ((Index & 2) ? Extent.Y : -Extent.Y),
+			Center.Z + ((Index & 4) ? Extent.Z : -Extent.Z));
+	}
+}
+
+void FDebugDrawQueue::AddVertex(EDebugDrawTopology Topology, const FVector& Position, const FVector& Color)
+{
+	Vertices[static_cast<uint32>(Topology)].push_back({ Position.X, Position.Y, Position.Z, { Color.X, Color.Y, Color.Z, 1.0f } });
+}
+
+void FDebugDrawQueue::AddLine(const FVector& Start, const FVector& End, const FVector& Color)
+{
+	AddVertex(EDebugDrawTopology::LineList, Start, Color);
+	AddVertex(EDebugDrawTopology::LineList, End, Color);
+}
+
+void FDebugDrawQueue::AddTriangle(const FVector& A, const FVector& B, const FVector& C, const FVector& Color)
+{
+	AddVertex(EDebugDrawTopology::TriangleList, A, Color);
+	AddVertex(EDebugDrawTopology::TriangleList, B, Color);
+	AddVertex(EDebugDrawTopology::TriangleList, C, Color);
+}
+
+void FDebugDrawQueue::MoveToPacket(FFramePacket& Packet)
+{
+	// 패킷 배열은 Reset으로 비어 있으므로 맞바꾸면 양쪽 할당이 번갈아 재사용된다
+	for (uint32 Topology = 0; Topology < static_cast<uint32>(EDebugDrawTopology::Num); ++Topology)
+	{
+		std::swap(Vertices[Topology], Packet.DebugVertices[Topology]);
+		Vertices[Topology].clear();
+	}
+}
+
+void DrawDebugLine(const FVector& Start, const FVector& End, const FVector& Color)
+{
+	FDebugDrawQueue::GetInst().AddLine(Start, End, Color);
+}
+
+void DrawDebugBox(const FVector& Center, const FVector& Extent, const FVector& Color)
+{
+	FDebugDrawQueue& Queue = FDebugDrawQueue::GetInst();
+
+	// 모서리 12개: 한 축 비트만 다른 꼭짓점 쌍
+	for (uint32 Corner = 0; Corner < 8; ++Corner)
+	{
+		for (uint32 AxisBit = 1; AxisBit < 8; AxisBit <<= 1)
+		{
+			if ((Corner & AxisBit) == 0)
+			{
+				Queue.AddLine(GetBoxCorner(Center, Extent, Corner), GetBoxCorner(Center, Extent, Corner | AxisBit), Color);
+			}
+		}
+	}
+}
+
+void DrawDebugBounds(const FPrimitiveBounds& Bounds, const FVector& Color)
+{
+	DrawDebugBox(Bounds.Origin, Bounds.BoxExtent, Color);
+}
+
+void DrawDebugSolidBox(const FVector& Center, const FVector& Extent, const FVector& Color)
+{
+	FDebugDrawQueue& Queue = FDebugDrawQueue::GetInst();
+
+	// 면마다 꼭짓점 네 개 (GetBoxCorner 인덱스), 바깥에서 봤을 때 시계 방향
+	static const uint32 Faces[6][4] =
+	{
+		{ 0, 4, 6, 2 }, { 1, 3, 7, 5 }, // -X, +X
+		{ 0, 1, 5, 4 }, { 2, 6, 7, 3 }, // -Y, +Y
+		{ 0, 2, 3, 1 }, { 4, 5, 7, 6 }, // -Z, +Z
+	};
+
+	for (const uint32 (&Face)[4] : Faces)
+	{
+		const FVector A = GetBoxCorner(Center, Extent, Face[0]);
+		const FVector B = GetBoxCorner(Center, Extent, Face[1]);
+		const FVector C = GetBoxCorner(Center, Extent, Face[2]);
+		const FVector D = GetBoxCorner(Center, Extent, Face[3]);
+		Queue.AddTriangle(A, B, C, Color);
+		Queue.AddTriangle(A, C, D, Color);
+	}
+}
+
+void DrawDebugSphere(const FVector& Center, float Radius, const FVector& Color, uint32 NumSegments)
+{
+	FDebugDrawQueue& Queue = FDebugDrawQueue::GetInst();
+	NumSegments = NumSegments >= 3 ? NumSegments : 3;
+
+	const float Step = 2.0f * DebugDrawPi / static_cast<float>(NumSegments);
+	float PrevCos = Radius;
+	float PrevSin = 0.0f;
+	for (uint32 Segment = 1; Segment <= NumSegments; ++Segment)
+	{
+		const float Cos = Radius * std::cos(Step * static_cast<float>(Segment));
+		const float Sin = Radius * std::sin(Step * static_cast<float>(Segment));
+
+		Queue.AddLine(Center + FVector(PrevCos, PrevSin, 0.0f), Center + FVector(Cos, Sin, 0.0f), Color);
+		Queue.AddLine(Center + FVector(PrevCos, 0.0f, PrevSin), Center + FVector(Cos, 0.0f, Sin), Color);
+		Queue.AddLine(Center + FVector(0.0f, PrevCos, PrevSin), Center + FVector(0.0f, Cos, Sin), Color);
+
+		PrevCos = Cos;
+		PrevSin = Sin;
+	}
+}
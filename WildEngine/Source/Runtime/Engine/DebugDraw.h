@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Math/Matrix.h"
+#include "Templates/UnrealTypes.h"
+#include "Interface/ISingleton.h"
+#include "FramePacket.h"
+
+struct FPrimitiveBounds;
+
+/**
+ * Game thread collector for immediate mode debug geometry.
+ *
+ * The DrawDebug* functions only append vertices here. UScene::BuildFramePacket
+ * hands everything queued during the frame to the packet, and the render
+ * thread streams it through a transient vertex ring with one draw per
+ * topology, so a debug line costs two vertices rather than a buffer and a draw.
+ * Geometry lives for exactly one frame; callers redraw every tick.
+ *
+ * Game thread only.
+ */
+class FDebugDrawQueue : public ISingleton<FDebugDrawQueue>
+{
+public:
+	void AddLine(const FVector& Start, const FVector& End, const FVector& Color);
+	void AddTriangle(const FVector& A, const FVector& B, const FVector& C, const FVector& Color);
+
+	/** Moves the queued vertices into Packet and leaves the queue empty, keeping both sides' allocations. */
+	void MoveToPacket(FFramePacket& Packet);
+
+	uint32 GetNumVertices(EDebugDrawTopology Topology) const { return static_cast<uint32>(Vertices[static_cast<uint32>(Topology)].size()); }
+
+private:
+	friend class ISingleton<FDebugDrawQueue>;
+	FDebugDrawQueue() = default;
+
+	void AddVertex(EDebugDrawTopology Topology, const FVector& Position, const FVector& Color);
+
+	TArray<FDebugVertex> Vertices[static_cast<uint32>(EDebugDrawTopology::Num)];
+};
+
+void DrawDebugLine(const FVector& Start, const FVector& End, const FVector& Color);
+
+/** Wireframe axis aligned box. */
+void DrawDebugBox(const FVector& Center, const FVector& Extent, const FVector& Color);
+
+/** Wireframe box of world space bounds. */
+void DrawDebugBounds(const FPrimitiveBounds& Bounds, const FVector& Color);
+
+void DrawDebugSolidBox(const FVector& Center, const FVector& Extent, const FVector& Color);
+
+/** Three great circles, one per axis plane. */
+void DrawDebugSphere(const FVector& Center, float Radius, const FVector& Color, uint32 NumSegments = 16);
@@ -0,0 +1,103 @@
+#include "DebugDrawRenderer.h"
+
+#include <cstring>
+
+namespace
+{
+	const wchar_t* DebugDrawShaderFile = L"Shaders/ShaderW0.hlsl";
+
+	const D3D11_PRIMITIVE_TOPOLOGY DebugDrawTopologies[] =
+	{
+		D3D11_PRIMITIVE_TOPOLOGY_LINELIST,     // EDebugDrawTopology::LineList
+		D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST, // EDebugDrawTopology::TriangleList
+	};
+	static_assert(ARRAYSIZE(DebugDrawTopologies) == static_cast<uint32>(EDebugDrawTopology::Num), "One D3D topology per EDebugDrawTopology");
+}
+
+bool FDebugDrawRenderer::Initialize(ID3D11Device* InDevice)
+{
+	const D3D11_INPUT_ELEMENT_DESC Layout[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 0,  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+	};
+	static_assert(sizeof(FDebugVertex) == 28, "FDebugVertex must match the POSITION/COLOR input layout");
+
+	if (!ShaderState.Initialize(InDevice, DebugDrawShaderFile, Layout, ARRAYSIZE(Layout)))
+	{
+		return false;
+	}
+
+	D3D11_BUFFER_DESC ConstantBufferDesc = {};
+	ConstantBufferDesc.ByteWidth = sizeof(FMatrix);
+	ConstantBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	ConstantBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	ConstantBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	if (FAILED(InDevice->CreateBuffer(&ConstantBufferDesc, nullptr, ViewConstantBuffer.GetAddressOf())))
+	{
+		return false;
+	}
+
+	return VertexRing.Initialize(InDevice, D3D11_BIND_VERTEX_BUFFER, sizeof(FDebugVertex), 64 * 1024);
+}
+
+void FDebugDrawRenderer::Render(FD3D11StateCache& StateCache, const FFrameView& View, const TArray<FDebugVertex> (&Vertices)[static_cast<uint32>(EDebugDrawTopology::Num)])
+{
+	constexpr uint32 NumTopologies = static_cast<uint32>(EDebugDrawTopology::Num);
+
+	uint32 TotalVertices = 0;
+	for (const TArray<FDebugVertex>& TopologyVertices : Vertices)
+	{
+		TotalVertices += static_cast<uint32>(TopologyVertices.size());
+	}
+	if (TotalVertices == 0)
+	{
+		return;
+	}
+
+	ID3D11DeviceContext* Context = StateCache.GetContext();
+
+	// 모든 토폴로지의 정점을 링의 연속 구간에 한 번에 복사
+	uint32 FirstVertex = 0;
+	uint8* Dest = static_cast<uint8*>(VertexRing.Map(Context, TotalVertices, FirstVertex));
+	if (Dest == nullptr)
+	{
+		return;
+	}
+	uint32 TopologyFirstVertex[NumTopologies];
+	uint32 Offset = FirstVertex;
+	for (uint32 Topology = 0; Topology < NumTopologies; ++Topology)
+	{
+		const TArray<FDebugVertex>& TopologyVertices = Vertices[Topology];
+		std::memcpy(Dest, TopologyVertices.data(), TopologyVertices.size() * sizeof(FDebugVertex));
+		Dest += TopologyVertices.size() * sizeof(FDebugVertex);
+		TopologyFirstVertex[Topology] = Offset;
+		Offset += static_cast<uint32>(TopologyVertices.size());
+	}
+	VertexRing.Unmap(Context);
+
+	D3D11_MAPPED_SUBRESOURCE Mapped;
+	if (FAILED(Context->Map(ViewConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &Mapped)))
+	{
+		return;
+	}
+	const FMatrix ViewProjection = View.ViewMatrix * View.ProjectionMatrix;
+	std::memcpy(Mapped.pData, &ViewProjection, sizeof(FMatrix));
+	Context->Unmap(ViewConstantBuffer.Get(), 0);
+
+	FD3D11StateScope StateScope(StateCache);
+	ShaderState.Bind(StateCache);
+	StateCache.SetVSConstantBuffer(0, ViewConstantBuffer.Get());
+	StateCache.SetStreamSource(0, VertexRing.GetBuffer(), sizeof(FDebugVertex), 0);
+
+	// 토폴로지마다 드로우 한 번
+	for (uint32 Topology = 0; Topology < NumTopologies; ++Topology)
+	{
+		if (Vertices[Topology].empty())
+		{
+			continue;
+		}
+		StateCache.SetPrimitiveTopology(DebugDrawTopologies[Topology]);
+		Context->Draw(static_cast<UINT>(Vertices[Topology].size()), TopologyFirstVertex[Topology]);
+	}
+}
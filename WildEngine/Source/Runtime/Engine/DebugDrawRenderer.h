@@ -0,0 +1,34 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+
+#include "FramePacket.h"
+#include "D3D11RHI/D3D11BoundShaderState.h"
+#include "D3D11RHI/D3D11BufferRing.h"
+#include "D3D11RHI/D3D11State.h"
+
+/**
+ * Render thread half of the DrawDebug* API.
+ *
+ * Copies every topology's debug vertices of a frame into a transient vertex
+ * ring with one map and issues one Draw per topology. Vertices are already in
+ * world space, so ShaderW0 runs with the view projection as its MVP.
+ */
+class FDebugDrawRenderer
+{
+public:
+	/** Compiles the shaders and creates the ring. @return false when debug drawing is unavailable. */
+	bool Initialize(ID3D11Device* InDevice);
+
+	bool IsInitialized() const { return VertexRing.IsInitialized(); }
+
+	/** Draws the packet's debug geometry through StateCache. Restores the pipeline state it changed. */
+	void Render(FD3D11StateCache& StateCache, const FFrameView& View, const TArray<FDebugVertex> (&Vertices)[static_cast<uint32>(EDebugDrawTopology::Num)]);
+
+private:
+	FD3D11BoundShaderState ShaderState;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> ViewConstantBuffer;
+
+	FD3D11BufferRing VertexRing;
+};
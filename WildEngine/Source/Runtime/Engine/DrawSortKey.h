@@ -0,0 +1,71 @@
+#pragma once
+
+#include "HAL/Platform.h"
+
+/** Coarsest sort criterion: all opaque draws go before all translucent ones. */
+enum class EDrawPass : uint8
+{
+	Opaque,
+	Translucent,
+};
+
+/**
+ * 64 bit key that orders draws for submission.
+ *
+ * Opaque:      | pass:2 | shader:6 | mesh:16 | depth:24 (front to back) | unused:16 |
+ * Translucent: | pass:2 | depth:24 (back to front) | shader:6 | mesh:16  | unused:16 |
+ *
+ * Opaque draws are grouped by state first so equal meshes end up adjacent
+ * (one instanced batch each) and only then by depth, which still draws near
+ * instances first within a batch. Translucent draws must blend in order, so
+ * depth outranks state there.
+ */
+struct FDrawSortKey
+{
+	static constexpr uint32 DepthBits = 24;
+	static constexpr uint32 MaxShaderId = (1u << 6) - 1;
+	static constexpr uint32 MaxMeshId = (1u << 16) - 1;
+
+	/** @param NormalizedDepth View depth scaled to [0, 1]; clamped. */
+	static uint64 Make(EDrawPass Pass, uint32 ShaderId, uint32 MeshId, float NormalizedDepth)
+	{
+		const float ClampedDepth = NormalizedDepth < 0.0f ? 0.0f : (NormalizedDepth > 1.0f ? 1.0f : NormalizedDepth);
+		uint64 Depth = static_cast<uint64>(ClampedDepth * static_cast<float>((1u << DepthBits) - 1));
+
+		const uint64 State = (static_cast<uint64>(ShaderId & MaxShaderId) << 16) | (MeshId & MaxMeshId);
+		if (Pass == EDrawPass::Opaque)
+		{
+			return (static_cast<uint64>(Pass) << 62) | (State << 40) | (Depth << 16);
+		}
+
+		Depth = ((1u << DepthBits) - 1) - Depth;
+		return (static_cast<uint64>(Pass) << 62) | (Depth << 38) | (State << 16);
+	}
+
+	static EDrawPass GetPass(uint64 Key) { return static_cast<EDrawPass>(Key >> 62); }
+
+	/** Pass, shader and mesh: the part of the key that decides pipeline and buffer state. */
+	static uint64 GetStateBits(uint64 Key)
+	{
+		return GetPass(Key) == EDrawPass::Opaque ? (Key >> 40) : ((Key >> 62) << 22) | ((Key >> 16) & 0x3FFFFF);
+	}
+
+	static uint32 GetMeshId(uint64 Key)
+	{
+		return static_cast<uint32>((GetPass(Key) == EDrawPass::Opaque ? (Key >> 40) : (Key >> 16)) & MaxMeshId);
+	}
+};
+
+/** What sorting the draws of the last frame bought. */
+struct FDrawSortStats
+{
+	uint32 NumDraws = 0;
+
+	/** Pass, shader or mesh switches between consecutive draws in submission (sorted) order. */
+	uint32 NumStateChanges = 0;
+
+	/** The same count for the unsorted scene order. */
+	uint32 NumStateChangesUnsorted = 0;
+
+	uint32 GetNumStateChangesAvoided() const { return NumStateChangesUnsorted > NumStateChanges ? NumStateChangesUnsorted - NumStateChanges : 0; }
+};
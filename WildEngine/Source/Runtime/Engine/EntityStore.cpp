@@ -0,0 +1,254 @@
+#include "EntityStore.h"
+
+#include <cstring>
+#include <new>
+
+namespace
+{
+	constexpr uint32 NumEntityColumns = static_cast<uint32>(EEntityColumn::Num);
+
+	constexpr FEntityColumnMask EntityColumns_Always = EntityColumnBit(EEntityColumn::EntityId) | EntityColumnBit(EEntityColumn::Owner);
+
+	constexpr uint32 ColumnAlignment = 16;
+
+	uint32 GetColumnElementSize(EEntityColumn Column)
+	{
+		switch (Column)
+		{
+		case EEntityColumn::EntityId:    return sizeof(TEntityColumnType<EEntityColumn::EntityId>::Type);
+		case EEntityColumn::Owner:       return sizeof(TEntityColumnType<EEntityColumn::Owner>::Type);
+		case EEntityColumn::Location:    return sizeof(TEntityColumnType<EEntityColumn::Location>::Type);
+		case EEntityColumn::Rotation:    return sizeof(TEntityColumnType<EEntityColumn::Rotation>::Type);
+		case EEntityColumn::Scale:       return sizeof(TEntityColumnType<EEntityColumn::Scale>::Type);
+		case EEntityColumn::WorldMatrix: return sizeof(TEntityColumnType<EEntityColumn::WorldMatrix>::Type);
+		case EEntityColumn::Bounds:      return sizeof(TEntityColumnType<EEntityColumn::Bounds>::Type);
+		default:                         return 0;
+		}
+	}
+
+	void ConstructElement(EEntityColumn Column, uint8* Element)
+	{
+		switch (Column)
+		{
+		case EEntityColumn::EntityId:    new (Element) FEntityId(0); break;
+		case EEntityColumn::Owner:       new (Element) USceneComponent*(nullptr); break;
+		case EEntityColumn::Location:    new (Element) FVector(0.0f, 0.0f, 0.0f); break;
+		case EEntityColumn::Rotation:    new (Element) FVector(0.0f, 0.0f, 0.0f); break;
+		case EEntityColumn::Scale:       new (Element) FVector(1.0f, 1.0f, 1.0f); break;
+		case EEntityColumn::WorldMatrix: new (Element) FMatrix(FMatrix::Identity()); break;
+		case EEntityColumn::Bounds:      new (Element) FPrimitiveBounds(); break;
+		default: break;
+		}
+	}
+
+	uint32 AlignUp(uint32 Value, uint32 Alignment)
+	{
+		return (Value + Alignment - 1) & ~(Alignment - 1);
+	}
+}
+
+FEntityArchetype::FEntityArchetype(FEntityColumnMask InColumns)
+	: Columns(InColumns | EntityColumns_Always)
+{
+	uint32 RowSize = 0;
+	for (uint32 Column = 0; Column < NumEntityColumns; ++Column)
+	{
+		if (Columns & (1u << Column))
+		{
+			ColumnSizes[Column] = GetColumnElementSize(static_cast<EEntityColumn>(Column));
+			RowSize += ColumnSizes[Column];
+		}
+	}
+
+	// 열마다 정렬 패딩이 붙으므로 들어갈 때까지 용량을 줄인다
+	ChunkCapacity = FEntityChunk::Size / RowSize;
+	while (ChunkCapacity > 0)
+	{
+		uint32 Offset = 0;
+		for (uint32 Column = 0; Column < NumEntityColumns; ++Column)
+		{
+			if (Columns & (1u << Column))
+			{
+				Offset = AlignUp(Offset, ColumnAlignment);
+				ColumnOffsets[Column] = Offset;
+				Offset += ColumnSizes[Column] * ChunkCapacity;
+			}
+		}
+
+		if (Offset <= FEntityChunk::Size)
+		{
+			break;
+		}
+		--ChunkCapacity;
+	}
+}
+
+FEntityChunkView FEntityArchetype::GetChunkView(uint32 ChunkIndex) const
+{
+	const uint32 First = ChunkIndex * ChunkCapacity;
+	const uint32 Count = NumEntities - First < ChunkCapacity ? NumEntities - First : ChunkCapacity;
+	return FEntityChunkView(this, Chunks[ChunkIndex].get(), Count);
+}
+
+uint32 FEntityArchetype::AddRow()
+{
+	const uint32 Index = NumEntities++;
+	const uint32 ChunkIndex = Index / ChunkCapacity;
+	const uint32 Row = Index % ChunkCapacity;
+
+	if (ChunkIndex == Chunks.size())
+	{
+		Chunks.push_back(std::make_unique<FEntityChunk>());
+	}
+
+	for (uint32 Column = 0; Column < NumEntityColumns; ++Column)
+	{
+		if (Columns & (1u << Column))
+		{
+			ConstructElement(static_cast<EEntityColumn>(Column), GetElement(ChunkIndex, Row, static_cast<EEntityColumn>(Column)));
+		}
+	}
+
+	return Index;
+}
+
+void FEntityArchetype::RemoveRowSwap(uint32 Index)
+{
+	const uint32 LastIndex = --NumEntities;
+
+	if (Index != LastIndex)
+	{
+		for (uint32 Column = 0; Column < NumEntityColumns; ++Column)
+		{
+			if (Columns & (1u << Column))
+			{
+				const EEntityColumn ColumnId = static_cast<EEntityColumn>(Column);
+				std::memcpy(
+					GetElement(Index / ChunkCapacity, Index % ChunkCapacity, ColumnId),
+					GetElement(LastIndex / ChunkCapacity, LastIndex % ChunkCapacity, ColumnId),
+					ColumnSizes[Column]);
+			}
+		}
+	}
+
+	// 마지막 청크가 비면 반납
+	if (NumEntities % ChunkCapacity == 0 && Chunks.size() > NumEntities / ChunkCapacity)
+	{
+		Chunks.pop_back();
+	}
+}
+
+FEntityId FEntityStore::CreateEntity(FEntityColumnMask Columns, USceneComponent* Owner)
+{
+	FEntityId Entity;
+	if (!FreeIds.empty())
+	{
+		Entity = FreeIds.back();
+		FreeIds.pop_back();
+	}
+	else
+	{
+		Entity = static_cast<FEntityId>(Records.size());
+		Records.emplace_back();
+	}
+
+	FEntityRecord& Record = Records[Entity];
+	Record.Archetype = FindOrCreateArchetype(Columns | EntityColumns_Always);
+
+	FEntityArchetype& Archetype = *Archetypes[Record.Archetype];
+	const uint32 Index = Archetype.AddRow();
+	Record.Chunk = Index / Archetype.GetChunkCapacity();
+	Record.Row = Index % Archetype.GetChunkCapacity();
+
+	Get<EEntityColumn::EntityId>(Entity) = Entity;
+	Get<EEntityColumn::Owner>(Entity) = Owner;
+
+	return Entity;
+}
+
+void FEntityStore::DestroyEntity(FEntityId Entity)
+{
+	RemoveFromArchetype(Entity);
+	FreeIds.push_back(Entity);
+}
+
+void FEntityStore::SetEntityColumns(FEntityId Entity, FEntityColumnMask NewColumns)
+{
+	const uint32 NewArchetypeIndex = FindOrCreateArchetype(NewColumns | EntityColumns_Always);
+	const FEntityRecord OldRecord = Records[Entity];
+	if (NewArchetypeIndex == OldRecord.Archetype)
+	{
+		return;
+	}
+
+	FEntityArchetype& OldArchetype = *Archetypes[OldRecord.Archetype];
+	FEntityArchetype& NewArchetype = *Archetypes[NewArchetypeIndex];
+
+	const uint32 Index = NewArchetype.AddRow();
+	const uint32 NewChunk = Index / NewArchetype.GetChunkCapacity();
+	const uint32 NewRow = Index % NewArchetype.GetChunkCapacity();
+
+	// 양쪽에 모두 있는 열만 복사하고 나머지는 기본값
+	const FEntityColumnMask Shared = OldArchetype.GetColumns() & NewArchetype.GetColumns();
+	for (uint32 Column = 0; Column < NumEntityColumns; ++Column)
+	{
+		if (Shared & (1u << Column))
+		{
+			const EEntityColumn ColumnId = static_cast<EEntityColumn>(Column);
+			std::memcpy(
+				NewArchetype.GetElement(NewChunk, NewRow, ColumnId),
+				OldArchetype.GetElement(OldRecord.Chunk, OldRecord.Row, ColumnId),
+				GetColumnElementSize(ColumnId));
+		}
+	}
+
+	RemoveFromArchetype(Entity);
+
+	FEntityRecord& Record = Records[Entity];
+	Record.Archetype = NewArchetypeIndex;
+	Record.Chunk = NewChunk;
+	Record.Row = NewRow;
+}
+
+void FEntityStore::GetChunks(FEntityColumnMask Required, TArray<FEntityChunkView>& OutChunks) const
+{
+	OutChunks.clear();
+	ForEachChunk(Required, [&OutChunks](const FEntityChunkView& Chunk)
+	{
+		OutChunks.push_back(Chunk);
+	});
+}
+
+uint32 FEntityStore::FindOrCreateArchetype(FEntityColumnMask Columns)
+{
+	for (uint32 Index = 0; Index < Archetypes.size(); ++Index)
+	{
+		if (Archetypes[Index]->GetColumns() == Columns)
+		{
+			return Index;
+		}
+	}
+
+	Archetypes.push_back(std::make_unique<FEntityArchetype>(Columns));
+	return static_cast<uint32>(Archetypes.size()) - 1;
+}
+
+void FEntityStore::RemoveFromArchetype(FEntityId Entity)
+{
+	const FEntityRecord& Record = Records[Entity];
+	FEntityArchetype& Archetype = *Archetypes[Record.Archetype];
+
+	const uint32 Index = Record.Chunk * Archetype.GetChunkCapacity() + Record.Row;
+	const uint32 LastIndex = Archetype.Num() - 1;
+
+	// 마지막 행이 빈자리로 옮겨지므로 그 엔티티의 위치를 갱신
+	if (Index != LastIndex)
+	{
+		const FEntityId Moved = *reinterpret_cast<const FEntityId*>(
+			Archetype.GetElement(LastIndex / Archetype.GetChunkCapacity(), LastIndex % Archetype.GetChunkCapacity(), EEntityColumn::EntityId));
+		Records[Moved].Chunk = Record.Chunk;
+		Records[Moved].Row = Record.Row;
+	}
+
+	Archetype.RemoveRowSwap(Index);
+}
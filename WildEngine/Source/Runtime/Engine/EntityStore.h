@@ -0,0 +1,204 @@
+#pragma once
+
+#include <memory>
+
+#include "Math/Matrix.h"
+#include "Templates/UnrealTypes.h"
+#include "Interface/ISingleton.h"
+#include "PrimitiveSceneProxy.h"
+
+class USceneComponent;
+
+/** Stable handle to an entity; survives the entity moving between chunks. */
+using FEntityId = uint32;
+
+/** Data columns an archetype can carry. Every archetype also has EntityId and Owner. */
+enum class EEntityColumn : uint8
+{
+	EntityId,
+	Owner,
+	Location,
+	Rotation,
+	Scale,
+	WorldMatrix,
+	Bounds,
+
+	Num,
+};
+
+using FEntityColumnMask = uint32;
+
+constexpr FEntityColumnMask EntityColumnBit(EEntityColumn Column) { return 1u << static_cast<uint32>(Column); }
+
+/** Columns of a plain USceneComponent. */
+constexpr FEntityColumnMask EntityColumns_Transform =
+	EntityColumnBit(EEntityColumn::Location) | EntityColumnBit(EEntityColumn::Rotation) |
+	EntityColumnBit(EEntityColumn::Scale) | EntityColumnBit(EEntityColumn::WorldMatrix);
+
+/** Columns of a UPrimitiveComponent. */
+constexpr FEntityColumnMask EntityColumns_Primitive = EntityColumns_Transform | EntityColumnBit(EEntityColumn::Bounds);
+
+template<EEntityColumn Column> struct TEntityColumnType;
+template<> struct TEntityColumnType<EEntityColumn::EntityId>    { using Type = FEntityId; };
+template<> struct TEntityColumnType<EEntityColumn::Owner>       { using Type = USceneComponent*; };
+template<> struct TEntityColumnType<EEntityColumn::Location>    { using Type = FVector; };
+template<> struct TEntityColumnType<EEntityColumn::Rotation>    { using Type = FVector; };
+template<> struct TEntityColumnType<EEntityColumn::Scale>       { using Type = FVector; };
+template<> struct TEntityColumnType<EEntityColumn::WorldMatrix> { using Type = FMatrix; };
+template<> struct TEntityColumnType<EEntityColumn::Bounds>      { using Type = FPrimitiveBounds; };
+
+/** Fixed size block holding up to Capacity entities of one archetype, one column after another. */
+struct alignas(64) FEntityChunk
+{
+	static constexpr uint32 Size = 16 * 1024;
+
+	uint8 Data[Size];
+};
+
+class FEntityArchetype;
+
+/** One chunk as seen by a query: a row count plus typed column pointers. */
+class FEntityChunkView
+{
+public:
+	FEntityChunkView(const FEntityArchetype* InArchetype, FEntityChunk* InChunk, uint32 InNum)
+		: Archetype(InArchetype), Chunk(InChunk), NumEntities(InNum)
+	{
+	}
+
+	uint32 Num() const { return NumEntities; }
+
+	/** @return The Column array of this chunk, nullptr when the archetype does not have it. */
+	template<EEntityColumn Column>
+	typename TEntityColumnType<Column>::Type* Get() const;
+
+private:
+	const FEntityArchetype* Archetype;
+	FEntityChunk* Chunk;
+	uint32 NumEntities;
+};
+
+/** All entities sharing one set of columns, packed densely into chunks. */
+class FEntityArchetype
+{
+public:
+	explicit FEntityArchetype(FEntityColumnMask InColumns);
+
+	FEntityColumnMask GetColumns() const { return Columns; }
+	bool HasColumns(FEntityColumnMask Required) const { return (Columns & Required) == Required; }
+
+	/** Entities per chunk. */
+	uint32 GetChunkCapacity() const { return ChunkCapacity; }
+	uint32 GetNumChunks() const { return static_cast<uint32>(Chunks.size()); }
+	uint32 Num() const { return NumEntities; }
+
+	FEntityChunkView GetChunkView(uint32 ChunkIndex) const;
+
+	uint8* GetElement(uint32 ChunkIndex, uint32 Row, EEntityColumn Column) const
+	{
+		return Chunks[ChunkIndex]->Data + ColumnOffsets[static_cast<uint32>(Column)] + Row * ColumnSizes[static_cast<uint32>(Column)];
+	}
+
+	uint32 GetColumnOffset(EEntityColumn Column) const { return ColumnOffsets[static_cast<uint32>(Column)]; }
+
+private:
+	friend class FEntityStore;
+
+	/** Appends a default-initialized row and returns its global index (Chunk * Capacity + Row). */
+	uint32 AddRow();
+
+	/** Fills the hole at Index with the last row and drops the last row. */
+	void RemoveRowSwap(uint32 Index);
+
+private:
+	FEntityColumnMask Columns;
+	uint32 ChunkCapacity = 0;
+	uint32 NumEntities = 0;
+
+	uint32 ColumnOffsets[static_cast<uint32>(EEntityColumn::Num)] = {};
+	uint32 ColumnSizes[static_cast<uint32>(EEntityColumn::Num)] = {};
+
+	TArray<std::unique_ptr<FEntityChunk>> Chunks;
+};
+
+template<EEntityColumn Column>
+typename TEntityColumnType<Column>::Type* FEntityChunkView::Get() const
+{
+	if (!Archetype->HasColumns(EntityColumnBit(Column)))
+	{
+		return nullptr;
+	}
+	return reinterpret_cast<typename TEntityColumnType<Column>::Type*>(Chunk->Data + Archetype->GetColumnOffset(Column));
+}
+
+/**
+ * Data-oriented storage for scene component state.
+ *
+ * Entities with the same column set share an archetype, and each archetype
+ * stores its entities in 16 KB chunks as structure of arrays. Components keep
+ * only their FEntityId and read and write their fields through the store, so
+ * passes that touch every entity (transforms, bounds, saving) walk chunks with
+ * ForEachChunk instead of visiting heap objects one at a time.
+ *
+ * Rows move when entities are removed or change archetype; only FEntityId is stable.
+ */
+class FEntityStore : public ISingleton<FEntityStore>
+{
+public:
+	FEntityId CreateEntity(FEntityColumnMask Columns, USceneComponent* Owner);
+	void DestroyEntity(FEntityId Entity);
+
+	/** Moves Entity to the archetype with NewColumns, keeping the values of shared columns. */
+	void SetEntityColumns(FEntityId Entity, FEntityColumnMask NewColumns);
+
+	template<EEntityColumn Column>
+	typename TEntityColumnType<Column>::Type& Get(FEntityId Entity) const
+	{
+		const FEntityRecord& Record = Records[Entity];
+		return *reinterpret_cast<typename TEntityColumnType<Column>::Type*>(
+			Archetypes[Record.Archetype]->GetElement(Record.Chunk, Record.Row, Column));
+	}
+
+	/** Calls Func(const FEntityChunkView&) for every non-empty chunk whose archetype has all Required columns. */
+	template<typename FuncType>
+	void ForEachChunk(FEntityColumnMask Required, FuncType&& Func) const
+	{
+		for (const std::unique_ptr<FEntityArchetype>& Archetype : Archetypes)
+		{
+			if (!Archetype->HasColumns(Required))
+			{
+				continue;
+			}
+			for (uint32 ChunkIndex = 0; ChunkIndex < Archetype->GetNumChunks(); ++ChunkIndex)
+			{
+				Func(Archetype->GetChunkView(ChunkIndex));
+			}
+		}
+	}
+
+	/** Collects the chunks ForEachChunk would visit, e.g. to process them with ParallelFor. */
+	void GetChunks(FEntityColumnMask Required, TArray<FEntityChunkView>& OutChunks) const;
+
+	/** Upper bound of every live FEntityId, for tables indexed by entity. */
+	uint32 GetMaxEntityId() const { return static_cast<uint32>(Records.size()); }
+
+	uint32 GetNumEntities() const { return static_cast<uint32>(Records.size() - FreeIds.size()); }
+
+private:
+	friend class ISingleton<FEntityStore>;
+	FEntityStore() = default;
+
+	uint32 FindOrCreateArchetype(FEntityColumnMask Columns);
+	void RemoveFromArchetype(FEntityId Entity);
+
+	struct FEntityRecord
+	{
+		uint32 Archetype = 0;
+		uint32 Chunk = 0;
+		uint32 Row = 0;
+	};
+
+	TArray<std::unique_ptr<FEntityArchetype>> Archetypes;
+	TArray<FEntityRecord> Records;
+	TArray<FEntityId> FreeIds;
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Math/Matrix.h"
+#include "Templates/UnrealTypes.h"
+
+class FRHIVertexBuffer;
+
+/** Which renderer entry point a draw goes through. */
+enum class EMeshDrawType : uint8
+{
+	Primitive,
+	Gizmo,
+};
+
+/** Debug primitive kinds; each is flushed with one draw call per frame. */
+enum class EDebugDrawTopology : uint8
+{
+	LineList,
+	TriangleList,
+
+	Num,
+};
+
+/** World space debug vertex; layout matches FVertexType so ShaderW0 can draw it. */
+struct FDebugVertex
+{
+	float X, Y, Z;
+	float Color[4];
+};
+
+/** A single draw, fully resolved on the game thread. */
+struct FMeshDrawCommand
+{
+	FMatrix WorldMatrix;
+	FRHIVertexBuffer* VertexBuffer = nullptr;
+	uint32 FirstVertex = 0;
+	uint32 NumVertices = 0;
+	EMeshDrawType Type = EMeshDrawType::Primitive;
+};
+
+/** Per-instance vertex stream of the instanced path; layout matches ShaderW0Instanced.hlsl. */
+struct FPrimitiveInstance
+{
+	FMatrix WorldMatrix;
+	float Color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+};
+
+/** Every visible instance of one mesh, drawn with a single instanced call. */
+struct FMeshDrawBatch
+{
+	FRHIVertexBuffer* VertexBuffer = nullptr;
+	uint32 FirstVertex = 0;
+	uint32 NumVertices = 0;
+
+	/** Range of FFramePacket::Instances. */
+	uint32 FirstInstance = 0;
+	uint32 NumInstances = 0;
+};
+
+/** Camera state the frame was built with. */
+struct FFrameView
+{
+	FMatrix ViewMatrix;
+	FMatrix ProjectionMatrix;
+};
+
+/**
+ * Everything the render thread needs to draw one frame.
+ *
+ * The game thread fills a packet and hands it over; after that the render
+ * thread owns it until the frame is submitted, so nothing in here may point
+ * back to game thread state that changes between frames.
+ */
+struct FFramePacket
+{
+	uint64 FrameNumber = 0;
+	FFrameView View;
+
+	/** Scene primitives grouped by mesh. Drawn first. */
+	TArray<FMeshDrawBatch> MeshBatches;
+	TArray<FPrimitiveInstance> Instances;
+
+	/** Individual draws (gizmo), drawn after the batches in order. */
+	TArray<FMeshDrawCommand> DrawCommands;
+
+	/** Immediate mode debug geometry of this frame, per topology. Drawn last. */
+	TArray<FDebugVertex> DebugVertices[static_cast<uint32>(EDebugDrawTopology::Num)];
+
+	/** Clears the draw lists but keeps their allocations for the next frame. */
+	void Reset()
+	{
+		MeshBatches.clear();
+		Instances.clear();
+		DrawCommands.clear();
+		for (TArray<FDebugVertex>& Vertices : DebugVertices)
+		{
+			Vertices.clear();
+		}
+	}
+};
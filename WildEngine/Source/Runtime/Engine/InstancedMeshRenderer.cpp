@@ -0,0 +1,97 @@
+#include "InstancedMeshRenderer.h"
+
+#include <cstring>
+
+#include "FramePacket.h"
+#include "D3D11RHI/D3D11DynamicRHI.h"
+#include "Types/CommonTypes.h"
+
+namespace
+{
+	const wchar_t* InstancedShaderFile = L"Shaders/ShaderW0Instanced.hlsl";
+
+	constexpr uint32 MinInstanceBufferCapacity = 1024;
+}
+
+bool FInstancedMeshRenderer::Initialize(ID3D11Device* InDevice)
+{
+	// 슬롯 0: 메시 정점 (FVertexType), 슬롯 1: 인스턴스마다 한 번씩 진행 (FPrimitiveInstance)
+	const D3D11_INPUT_ELEMENT_DESC Layout[] =
+	{
+		{ "POSITION",      0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 0,  D3D11_INPUT_PER_VERTEX_DATA,   0 },
+		{ "COLOR",         0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA,   0 },
+		{ "WORLD",         0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+		{ "WORLD",         1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+		{ "WORLD",         2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+		{ "WORLD",         3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+		{ "INSTANCECOLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 64, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+	};
+	static_assert(sizeof(FPrimitiveInstance) == 80, "FPrimitiveInstance must match the WORLD/INSTANCECOLOR input layout");
+
+	if (!ShaderState.Initialize(InDevice, InstancedShaderFile, Layout, ARRAYSIZE(Layout)))
+	{
+		return false;
+	}
+
+	D3D11_BUFFER_DESC ConstantBufferDesc = {};
+	ConstantBufferDesc.ByteWidth = sizeof(FMatrix);
+	ConstantBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	ConstantBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	ConstantBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	if (FAILED(InDevice->CreateBuffer(&ConstantBufferDesc, nullptr, ViewConstantBuffer.GetAddressOf())))
+	{
+		return false;
+	}
+
+	return InstanceRing.Initialize(InDevice, D3D11_BIND_VERTEX_BUFFER, sizeof(FPrimitiveInstance), MinInstanceBufferCapacity);
+}
+
+void FInstancedMeshRenderer::Render(FD3D11StateCache& StateCache, const FFrameView& View, const TArray<FMeshDrawBatch>& Batches, const TArray<FPrimitiveInstance>& Instances)
+{
+	if (Batches.empty() || Instances.empty())
+	{
+		return;
+	}
+
+	ID3D11DeviceContext* Context = StateCache.GetContext();
+
+	// 프레임의 모든 인스턴스를 한 번에 업로드. 배치의 인스턴스 구간은 링 안의 시작 위치만큼 민다
+	uint32 FirstInstance = 0;
+	void* Dest = InstanceRing.Map(Context, static_cast<uint32>(Instances.size()), FirstInstance);
+	if (Dest == nullptr)
+	{
+		return;
+	}
+	std::memcpy(Dest, Instances.data(), Instances.size() * sizeof(FPrimitiveInstance));
+	InstanceRing.Unmap(Context);
+
+	D3D11_MAPPED_SUBRESOURCE Mapped;
+	if (FAILED(Context->Map(ViewConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &Mapped)))
+	{
+		return;
+	}
+	const FMatrix ViewProjection = View.ViewMatrix * View.ProjectionMatrix;
+	std::memcpy(Mapped.pData, &ViewProjection, sizeof(FMatrix));
+	Context->Unmap(ViewConstantBuffer.Get(), 0);
+
+	// 이후의 기즈모 드로우가 기존 파이프라인을 그대로 쓰도록 바꾼 상태는 스코프가 되돌린다
+	FD3D11StateScope StateScope(StateCache);
+	ShaderState.Bind(StateCache);
+	StateCache.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	StateCache.SetVSConstantBuffer(0, ViewConstantBuffer.Get());
+	StateCache.SetStreamSource(1, InstanceRing.GetBuffer(), sizeof(FPrimitiveInstance), 0);
+
+	// 아레나 버퍼를 함께 쓰는 메시들은 구간만 달라 상태 캐시가 다시 바인딩하지 않는다
+	for (const FMeshDrawBatch& Batch : Batches)
+	{
+		if (!Batch.VertexBuffer)
+		{
+			continue;
+		}
+
+		StateCache.SetStreamSource(0, FD3D11DynamicRHI::ResourceCast(Batch.VertexBuffer)->Resource, sizeof(FVertexType), 0);
+		Context->DrawInstanced(Batch.NumVertices, Batch.NumInstances, Batch.FirstVertex, FirstInstance + Batch.FirstInstance);
+	}
+
+	StateCache.SetStreamSource(1, nullptr, 0, 0);
+}
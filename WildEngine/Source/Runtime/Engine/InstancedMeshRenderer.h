@@ -0,0 +1,41 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+
+#include "Templates/UnrealTypes.h"
+#include "D3D11RHI/D3D11BoundShaderState.h"
+#include "D3D11RHI/D3D11BufferRing.h"
+#include "D3D11RHI/D3D11State.h"
+
+struct FFrameView;
+struct FMeshDrawBatch;
+struct FPrimitiveInstance;
+
+/**
+ * Draws FMeshDrawBatch groups with one DrawInstanced call each.
+ *
+ * All instances of a frame are uploaded with one map into an instance ring
+ * (input slot 1) and each batch selects its range with StartInstanceLocation,
+ * so the per-object cost is a 80 byte copy instead of a constant buffer
+ * update plus a draw call. Uses Shaders/ShaderW0Instanced.hlsl.
+ */
+class FInstancedMeshRenderer
+{
+public:
+	/** Compiles the shaders and creates the input layout. @return false when the instanced path is unavailable. */
+	bool Initialize(ID3D11Device* InDevice);
+
+	bool IsInitialized() const { return ShaderState.IsInitialized() && InstanceRing.IsInitialized(); }
+
+	/** Uploads Instances and draws every batch through StateCache. Restores the pipeline state it changed. */
+	void Render(FD3D11StateCache& StateCache, const FFrameView& View, const TArray<FMeshDrawBatch>& Batches, const TArray<FPrimitiveInstance>& Instances);
+
+	uint32 GetInstanceBufferCapacity() const { return InstanceRing.GetCapacity(); }
+
+private:
+	FD3D11BoundShaderState ShaderState;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> ViewConstantBuffer;
+
+	FD3D11BufferRing InstanceRing;
+};
@@ -1 +1,222 @@
 ﻿#include "Level.h"
+
+#include <fstream>
+
+#include "json.hpp"
+#include "Components/CubeComponent.h"
+#include "Components/SphereComponent.h"
+#include "Components/TriangleComponent.h"
+
+ULevel::ULevel(int32 InCellX, int32 InCellY, const FString& InFileName)
+    : CellX(InCellX), CellY(InCellY), FileName(InFileName)
+{
+}
+
+ULevel::~ULevel()
+{
+    Unload();
+}
+
+void ULevel::BeginLoad()
+{
+    if (State != ELevelStreamingState::Unloaded)
+    {
+        return;
+    }
+
+    // 파일 읽기와 JSON 파싱은 엔진 오브젝트를 건드리지 않으므로 백그라운드에서 수행
+    const FString File = FileName;
+    ParseResult = std::async(std::launch::async, [File]()
+    {
+        TArray<FLevelObjectDesc> Objects;
+        ParseLevelFile(File, Objects);
+        return Objects;
+    });
+
+    State = ELevelStreamingState::Parsing;
+}
+
+bool ULevel::TickLoad(URenderer* Renderer, std::chrono::steady_clock::time_point EndTime)
+{
+    if (State == ELevelStreamingState::Parsing)
+    {
+        if (ParseResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return false;
+        }
+
+        PendingObjects = ParseResult.get();
+        NumCreated = 0;
+        Components.reserve(PendingObjects.size());
+        State = ELevelStreamingState::Creating;
+    }
+
+    if (State != ELevelStreamingState::Creating)
+    {
+        return State == ELevelStreamingState::Loaded;
+    }
+
+    // 예산 안에서만 생성하고 나머지는 다음 프레임으로 넘긴다 (최소 1개는 진행)
+    do
+    {
+        if (NumCreated >= PendingObjects.size())
+        {
+            break;
+        }
+
+        const FLevelObjectDesc& Desc = PendingObjects[NumCreated++];
+        if (USceneComponent* Component = CreateComponentOfType(Desc.Type, Renderer))
+        {
+            Component->UUID = Desc.UUID;
+            Component->SetRelativeLocation(Desc.Location);
+            Component->SetRelativeRotation(Desc.Rotation);
+            Component->SetRelativeScale3D(Desc.Scale);
+            if (UPrimitiveComponent* Primitive = dynamic_cast<UPrimitiveComponent*>(Component))
+            {
+                Primitive->Mobility = Desc.bMovable ? EComponentMobility::Movable : EComponentMobility::Static;
+            }
+            Components.push_back(Component);
+        }
+    } while (std::chrono::steady_clock::now() < EndTime);
+
+    if (NumCreated < PendingObjects.size())
+    {
+        return false;
+    }
+
+    ResolveAttachments();
+
+    PendingObjects.clear();
+    PendingObjects.shrink_to_fit();
+    State = ELevelStreamingState::Loaded;
+    return true;
+}
+
+void ULevel::Unload()
+{
+    if (State == ELevelStreamingState::Parsing)
+    {
+        ParseResult.wait();
+        ParseResult = {};
+    }
+
+    // 자식부터 지워도 되고 부모부터 지워도 된다 (소멸자가 부착을 정리)
+    for (USceneComponent* Component : Components)
+    {
+        delete Component;
+    }
+    Components.clear();
+
+    PendingObjects.clear();
+    NumCreated = 0;
+    State = ELevelStreamingState::Unloaded;
+}
+
+void ULevel::ResolveAttachments()
+{
+    // 부모가 나중에 생성될 수 있으므로 레벨 안의 오브젝트가 모두 만들어진 뒤 부착
+    TMap<uint32, USceneComponent*> ComponentsByUUID;
+    for (USceneComponent* Component : Components)
+    {
+        ComponentsByUUID[Component->UUID] = Component;
+    }
+
+    for (const FLevelObjectDesc& Desc : PendingObjects)
+    {
+        if (Desc.ParentUUID == 0)
+        {
+            continue;
+        }
+
+        auto Child = ComponentsByUUID.find(Desc.UUID);
+        auto Parent = ComponentsByUUID.find(Desc.ParentUUID);
+        if (Child != ComponentsByUUID.end() && Parent != ComponentsByUUID.end())
+        {
+            Child->second->AttachToComponent(Parent->second);
+        }
+    }
+}
+
+bool ULevel::IsParseFinished() const
+{
+    return ParseResult.valid() && ParseResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+bool ULevel::OwnsComponent(const USceneComponent* Component) const
+{
+    for (const USceneComponent* Owned : Components)
+    {
+        if (Owned == Component)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ULevel::ParseLevelFile(const FString& FileName, TArray<FLevelObjectDesc>& OutObjects)
+{
+    std::ifstream inFile(FileName);
+    if (!inFile.is_open())
+    {
+        return false;
+    }
+
+    FString jsonData((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    json::JSON Level = json::JSON::Load(jsonData);
+    json::JSON Primitives = Level["Primitives"];
+
+    for (auto it = Primitives.ObjectRange().begin(); it != Primitives.ObjectRange().end(); ++it)
+    {
+        json::JSON Primitive = it->second;
+
+        FLevelObjectDesc Desc;
+        Desc.UUID = std::stoi(it->first);
+        Desc.Type = Primitive["Type"].ToString();
+        Desc.Location = json::JSONToFVector(Primitive["Location"]);
+        Desc.Rotation = json::JSONToFVector(Primitive["Rotation"]);
+        Desc.Scale = json::JSONToFVector(Primitive["Scale"]);
+        if (Primitive.hasKey("Parent"))
+        {
+            Desc.ParentUUID = static_cast<uint32>(Primitive["Parent"].ToInt());
+        }
+        Desc.bMovable = Primitive.hasKey("Mobility") && Primitive["Mobility"].ToString() == "Movable";
+        OutObjects.push_back(Desc);
+    }
+
+    return true;
+}
+
+USceneComponent* ULevel::CreateComponentOfType(const FString& Type, URenderer* Renderer)
+{
+    if (!Type.compare("Sphere"))
+    {
+        return new USphereComponent(Renderer);
+    }
+    if (!Type.compare("Cube"))
+    {
+        return new UCubeComponent(Renderer);
+    }
+    if (!Type.compare("Triangle"))
+    {
+        return new UTriangleComponent(Renderer);
+    }
+    return nullptr;
+}
+
+FString ULevel::GetComponentTypeName(USceneComponent* Component)
+{
+    if (dynamic_cast<USphereComponent*>(Component))
+    {
+        return "Sphere";
+    }
+    if (dynamic_cast<UCubeComponent*>(Component))
+    {
+        return "Cube";
+    }
+    if (dynamic_cast<UTriangleComponent*>(Component))
+    {
+        return "Triangle";
+    }
+    return FString();
+}
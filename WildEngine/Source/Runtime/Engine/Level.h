@@ -1,7 +1,98 @@
 ﻿#pragma once
 
-class Level
+#include <chrono>
+#include <future>
+
+#include "Math/Vector.h"
+#include "Templates/UnrealTypes.h"
+
+class URenderer;
+class USceneComponent;
+
+/** One object of a level file, parsed off the game thread. */
+struct FLevelObjectDesc
+{
+    uint32 UUID = 0;
+    uint32 ParentUUID = 0;
+    FString Type;
+    FVector Location;
+    FVector Rotation;
+    FVector Scale;
+
+    /** Level geometry is static (merged after loading) unless saved as "Mobility": "Movable". */
+    bool bMovable = false;
+};
+
+enum class ELevelStreamingState : uint8
+{
+    Unloaded,
+    Parsing,   // 백그라운드 스레드에서 파일을 읽고 파싱하는 중
+    Creating,  // 게임 스레드에서 시간 분할로 오브젝트 생성 중
+    Loaded,
+};
+
+/**
+ * A streaming cell of a UWorld.
+ *
+ * A level owns the components created from its file. Loading is split into a
+ * background parse that produces plain FLevelObjectDesc records and a game
+ * thread phase that constructs a few objects per frame within a time budget.
+ */
+class ULevel
 {
 public:
-    
+    ULevel(int32 InCellX, int32 InCellY, const FString& InFileName);
+    ULevel(const ULevel&) = delete;
+    ULevel& operator=(const ULevel&) = delete;
+    ~ULevel();
+
+    /** Starts parsing the level file on a background thread. */
+    void BeginLoad();
+
+    /**
+     * Advances an in-progress load: picks up a finished parse and creates objects
+     * until EndTime. @return true when the level is fully loaded.
+     */
+    bool TickLoad(URenderer* Renderer, std::chrono::steady_clock::time_point EndTime);
+
+    /** Destroys every component of the level. A parse still in flight is waited for and dropped. */
+    void Unload();
+
+    /** Parses a level file. Thread safe; touches no engine objects. */
+    static bool ParseLevelFile(const FString& FileName, TArray<FLevelObjectDesc>& OutObjects);
+
+    /** Creates a component for a saved type name ("Cube", "Sphere", "Triangle"). */
+    static USceneComponent* CreateComponentOfType(const FString& Type, URenderer* Renderer);
+
+    /** @return The saved type name of Component, empty when it is not a streamable primitive. */
+    static FString GetComponentTypeName(USceneComponent* Component);
+
+    ELevelStreamingState GetState() const { return State; }
+    bool IsParsing() const { return State == ELevelStreamingState::Parsing; }
+
+    /** @return true when the background parse has completed, so Unload will not block. */
+    bool IsParseFinished() const;
+
+    int32 GetCellX() const { return CellX; }
+    int32 GetCellY() const { return CellY; }
+    const FString& GetFileName() const { return FileName; }
+
+    bool OwnsComponent(const USceneComponent* Component) const;
+    const TArray<USceneComponent*>& GetComponents() const { return Components; }
+
+private:
+    void ResolveAttachments();
+
+private:
+    int32 CellX;
+    int32 CellY;
+    FString FileName;
+
+    ELevelStreamingState State = ELevelStreamingState::Unloaded;
+
+    std::future<TArray<FLevelObjectDesc>> ParseResult;
+    TArray<FLevelObjectDesc> PendingObjects;
+    uint32 NumCreated = 0;
+
+    TArray<USceneComponent*> Components;
 };
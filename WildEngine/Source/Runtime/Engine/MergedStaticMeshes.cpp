@@ -0,0 +1,251 @@
+#include "MergedStaticMeshes.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "ResourceUploadQueue.h"
+#include "Types/CommonTypes.h"
+#include "Components/PrimitiveComponent.h"
+
+namespace
+{
+	/** Edge of the XY cells used to keep merged groups spatially compact, so they still cull well. */
+	constexpr float MergeCellSize = 64.0f;
+
+	uint64 GetMergeCellKey(const FMatrix& WorldMatrix)
+	{
+		const int32 CellX = static_cast<int32>(std::floor(WorldMatrix.M[3][0] / MergeCellSize));
+		const int32 CellY = static_cast<int32>(std::floor(WorldMatrix.M[3][1] / MergeCellSize));
+		return (static_cast<uint64>(static_cast<uint32>(CellX)) << 32) | static_cast<uint32>(CellY);
+	}
+}
+
+FMergedStaticMeshes::~FMergedStaticMeshes()
+{
+	Release();
+}
+
+void FMergedStaticMeshes::Merge(TArray<FMergeCandidate>& Candidates)
+{
+	// 같은 셀끼리 모아서 한 그룹이 화면 전체에 흩어지지 않게 한다
+	std::sort(Candidates.begin(), Candidates.end(), [](const FMergeCandidate& A, const FMergeCandidate& B)
+	{
+		return GetMergeCellKey(A.WorldMatrix) < GetMergeCellKey(B.WorldMatrix);
+	});
+
+	// 재질이 하나뿐이므로 그룹은 정점 수 상한으로만 나뉜다
+	uint32 Begin = 0;
+	uint32 NumVertices = 0;
+	for (uint32 Index = 0; Index < Candidates.size(); ++Index)
+	{
+		const uint32 CandidateVertices = Candidates[Index].Component->GetStaticMesh()->NumVertices;
+		if (NumVertices > 0 && NumVertices + CandidateVertices > MaxVerticesPerGroup)
+		{
+			BuildGroup(Candidates, Begin, Index, NumVertices);
+			Begin = Index;
+			NumVertices = 0;
+		}
+		NumVertices += CandidateVertices;
+	}
+
+	if (NumVertices > 0)
+	{
+		BuildGroup(Candidates, Begin, static_cast<uint32>(Candidates.size()), NumVertices);
+	}
+}
+
+void FMergedStaticMeshes::BuildGroup(const TArray<FMergeCandidate>& Candidates, uint32 Begin, uint32 End, uint32 NumVertices)
+{
+	const int32 GroupId = static_cast<int32>(Groups.size());
+	Groups.emplace_back();
+	FGroup& Group = Groups.back();
+
+	TArray<FVertexType> Vertices(NumVertices);
+	float Min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float Max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	uint32 FirstVertex = 0;
+	for (uint32 Index = Begin; Index < End; ++Index)
+	{
+		const FMergeCandidate& Candidate = Candidates[Index];
+		const FStaticMesh* Mesh = Candidate.Component->GetStaticMesh();
+		const float (&M)[4][4] = Candidate.WorldMatrix.M;
+
+		// 정점을 월드 공간으로 미리 변환 (행 벡터 * 행렬), 색은 그대로
+		for (uint32 VertexIndex = 0; VertexIndex < Mesh->NumVertices; ++VertexIndex)
+		{
+			const FVertexType& Source = Mesh->SourceVertices[VertexIndex];
+			FVertexType& Destination = Vertices[FirstVertex + VertexIndex];
+			Destination = Source;
+			Destination.x = Source.x * M[0][0] + Source.y * M[1][0] + Source.z * M[2][0] + M[3][0];
+			Destination.y = Source.x * M[0][1] + Source.y * M[1][1] + Source.z * M[2][1] + M[3][1];
+			Destination.z = Source.x * M[0][2] + Source.y * M[1][2] + Source.z * M[2][2] + M[3][2];
+
+			const float P[3] = { Destination.x, Destination.y, Destination.z };
+			for (int Axis = 0; Axis < 3; ++Axis)
+			{
+				Min[Axis] = std::min(Min[Axis], P[Axis]);
+				Max[Axis] = std::max(Max[Axis], P[Axis]);
+			}
+		}
+
+		FMember Member;
+		Member.Component = Candidate.Component;
+		Member.BakedWorldMatrix = Candidate.WorldMatrix;
+		Member.FirstVertex = FirstVertex;
+		Member.NumVertices = Mesh->NumVertices;
+
+		Candidate.Component->MergedGroupId = GroupId;
+		Candidate.Component->MergedMemberIndex = static_cast<uint32>(Group.Members.size());
+		Group.Members.push_back(Member);
+
+		FirstVertex += Mesh->NumVertices;
+	}
+
+	// 구운 정점은 큐의 스테이징 링에 복사되므로 Vertices는 바로 버려도 된다
+	Group.VertexBuffer = FResourceUploadQueue::GetInst().CreateVertexBuffer(Vertices.data(), static_cast<uint32>(Vertices.size() * sizeof(FVertexType)));
+
+	Group.Bounds.Origin = FVector((Min[0] + Max[0]) * 0.5f, (Min[1] + Max[1]) * 0.5f, (Min[2] + Max[2]) * 0.5f);
+	Group.Bounds.BoxExtent = FVector((Max[0] - Min[0]) * 0.5f, (Max[1] - Min[1]) * 0.5f, (Max[2] - Min[2]) * 0.5f);
+	Group.Bounds.SphereRadius = std::sqrt(
+		Group.Bounds.BoxExtent.X * Group.Bounds.BoxExtent.X +
+		Group.Bounds.BoxExtent.Y * Group.Bounds.BoxExtent.Y +
+		Group.Bounds.BoxExtent.Z * Group.Bounds.BoxExtent.Z);
+
+	NumMergedComponents += End - Begin;
+	RebuildRuns(Group);
+}
+
+void FMergedStaticMeshes::SplitOut(UPrimitiveComponent* Component)
+{
+	if (Component->MergedGroupId == INDEX_NONE)
+	{
+		return;
+	}
+
+	RemoveMember(Groups[Component->MergedGroupId], Component->MergedMemberIndex);
+	Component->MergedGroupId = INDEX_NONE;
+	Component->MergedMemberIndex = 0;
+}
+
+void FMergedStaticMeshes::RemoveDestroyedMembers(const TArray<UPrimitiveComponent*>& LiveComponents)
+{
+	// 살아 있는 컴포넌트가 가리키는 멤버만 남긴다 (포인터 재사용된 새 컴포넌트는 그룹 id가 없으므로 섞이지 않음)
+	TArray<TArray<uint8>> bClaimed(Groups.size());
+	for (uint32 GroupId = 0; GroupId < Groups.size(); ++GroupId)
+	{
+		bClaimed[GroupId].assign(Groups[GroupId].Members.size(), 0);
+	}
+
+	for (UPrimitiveComponent* Component : LiveComponents)
+	{
+		const int32 GroupId = Component->MergedGroupId;
+		if (GroupId >= 0 && GroupId < static_cast<int32>(Groups.size()) &&
+			Component->MergedMemberIndex < Groups[GroupId].Members.size() &&
+			Groups[GroupId].Members[Component->MergedMemberIndex].Component == Component)
+		{
+			bClaimed[GroupId][Component->MergedMemberIndex] = 1;
+		}
+	}
+
+	for (uint32 GroupId = 0; GroupId < Groups.size(); ++GroupId)
+	{
+		FGroup& Group = Groups[GroupId];
+		for (uint32 MemberIndex = 0; MemberIndex < Group.Members.size(); ++MemberIndex)
+		{
+			if (Group.Members[MemberIndex].bLive && !bClaimed[GroupId][MemberIndex])
+			{
+				RemoveMember(Group, MemberIndex);
+			}
+		}
+	}
+}
+
+bool FMergedStaticMeshes::IsAtBakedTransform(const UPrimitiveComponent* Component, const FMatrix& WorldMatrix) const
+{
+	if (Component->MergedGroupId == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FMember& Member = Groups[Component->MergedGroupId].Members[Component->MergedMemberIndex];
+	return std::memcmp(&Member.BakedWorldMatrix, &WorldMatrix, sizeof(FMatrix)) == 0;
+}
+
+void FMergedStaticMeshes::GatherDraws(const FViewFrustum& Frustum, TArray<FMeshDrawBatch>& OutBatches, TArray<FPrimitiveInstance>& OutInstances) const
+{
+	for (const FGroup& Group : Groups)
+	{
+		if (Group.Runs.empty() || !Group.VertexBuffer || !Frustum.Intersects(Group.Bounds))
+		{
+			continue;
+		}
+
+		// 정점이 이미 월드 공간이므로 단위 행렬 인스턴스 하나를 모든 구간이 공유
+		const uint32 InstanceIndex = static_cast<uint32>(OutInstances.size());
+		OutInstances.emplace_back();
+		OutInstances.back().WorldMatrix = FMatrix::Identity();
+
+		for (const TPair<uint32, uint32>& Run : Group.Runs)
+		{
+			FMeshDrawBatch Batch;
+			Batch.VertexBuffer = Group.VertexBuffer;
+			Batch.FirstVertex = Run.first;
+			Batch.NumVertices = Run.second;
+			Batch.FirstInstance = InstanceIndex;
+			Batch.NumInstances = 1;
+			OutBatches.push_back(Batch);
+		}
+	}
+}
+
+void FMergedStaticMeshes::Release()
+{
+	// 멤버 컴포넌트는 이미 파괴되었을 수 있으므로 건드리지 않는다
+	Groups.clear();
+	NumMergedComponents = 0;
+}
+
+void FMergedStaticMeshes::RemoveMember(FGroup& Group, uint32 MemberIndex)
+{
+	FMember& Member = Group.Members[MemberIndex];
+	if (!Member.bLive)
+	{
+		return;
+	}
+
+	Member.bLive = false;
+	Member.Component = nullptr;
+	--NumMergedComponents;
+	RebuildRuns(Group);
+
+	// 대량 삭제로 그룹이 비면 버퍼를 지연 삭제 큐에 넘긴다 (그룹 id는 유지)
+	if (Group.Runs.empty())
+	{
+		Group.VertexBuffer.SafeRelease();
+	}
+}
+
+void FMergedStaticMeshes::RebuildRuns(FGroup& Group)
+{
+	// 인접한 살아 있는 멤버를 이어 붙인 구간마다 드로우 하나
+	Group.Runs.clear();
+	for (const FMember& Member : Group.Members)
+	{
+		if (!Member.bLive)
+		{
+			continue;
+		}
+
+		if (!Group.Runs.empty() && Group.Runs.back().first + Group.Runs.back().second == Member.FirstVertex)
+		{
+			Group.Runs.back().second += Member.NumVertices;
+		}
+		else
+		{
+			Group.Runs.push_back({ Member.FirstVertex, Member.NumVertices });
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Math/Matrix.h"
+#include "Templates/UnrealTypes.h"
+#include "Templates/RefCounting.h"
+#include "PrimitiveSceneProxy.h"
+#include "FramePacket.h"
+
+class UPrimitiveComponent;
+class FRHIVertexBuffer;
+
+/** A static primitive to bake, with the world transform it is baked at. */
+struct FMergeCandidate
+{
+	UPrimitiveComponent* Component = nullptr;
+	FMatrix WorldMatrix;
+};
+
+/**
+ * Static primitives pre-transformed into world space and concatenated into a
+ * few large vertex buffers.
+ *
+ * Each group is one buffer; its members occupy consecutive vertex ranges. A
+ * group is culled as a whole and drawn as one draw per run of live members,
+ * so a freshly baked group is a single draw. Splitting a member out (it moved,
+ * was edited or destroyed) only cuts its range out of the runs; the buffer is
+ * not rebuilt, so nothing the render thread may still be reading changes.
+ * Once a group has no live member left, its buffer goes to the RHI deferred
+ * delete queue and is freed when the frames that drew it have retired.
+ */
+class FMergedStaticMeshes
+{
+public:
+	/** Upper bound on the vertices of one group buffer. */
+	static constexpr uint32 MaxVerticesPerGroup = 1 << 18;
+
+	FMergedStaticMeshes() = default;
+	FMergedStaticMeshes(const FMergedStaticMeshes&) = delete;
+	FMergedStaticMeshes& operator=(const FMergedStaticMeshes&) = delete;
+	~FMergedStaticMeshes();
+
+	/** Bakes Candidates into new groups, nearby candidates together. Sets MergedGroupId on every merged component. */
+	void Merge(TArray<FMergeCandidate>& Candidates);
+
+	/** Removes Component from its group; it is drawn on its own from now on. */
+	void SplitOut(UPrimitiveComponent* Component);
+
+	/**
+	 * Drops members whose component no longer exists. LiveComponents holds every
+	 * live component that still claims a group (MergedGroupId != INDEX_NONE).
+	 */
+	void RemoveDestroyedMembers(const TArray<UPrimitiveComponent*>& LiveComponents);
+
+	/** @return true when WorldMatrix is the transform Component was baked with. */
+	bool IsAtBakedTransform(const UPrimitiveComponent* Component, const FMatrix& WorldMatrix) const;
+
+	/** Appends one batch per live run of every group inside Frustum (instance: identity). */
+	void GatherDraws(const FViewFrustum& Frustum, TArray<FMeshDrawBatch>& OutBatches, TArray<FPrimitiveInstance>& OutInstances) const;
+
+	/** Drops every group and its buffer (deferred). Only call when no component is still merged. */
+	void Release();
+
+	uint32 GetNumGroups() const { return static_cast<uint32>(Groups.size()); }
+	uint32 GetNumMergedComponents() const { return NumMergedComponents; }
+
+private:
+	struct FMember
+	{
+		UPrimitiveComponent* Component = nullptr;
+		FMatrix BakedWorldMatrix;
+		uint32 FirstVertex = 0;
+		uint32 NumVertices = 0;
+		bool bLive = true;
+	};
+
+	struct FGroup
+	{
+		/** Null once every member is gone. */
+		TRefCountPtr<FRHIVertexBuffer> VertexBuffer;
+		FPrimitiveBounds Bounds;
+		TArray<FMember> Members;
+
+		/** Contiguous live vertex ranges: (FirstVertex, NumVertices). */
+		TArray<TPair<uint32, uint32>> Runs;
+	};
+
+	void BuildGroup(const TArray<FMergeCandidate>& Candidates, uint32 Begin, uint32 End, uint32 NumVertices);
+	void RemoveMember(FGroup& Group, uint32 MemberIndex);
+	static void RebuildRuns(FGroup& Group);
+
+private:
+	TArray<FGroup> Groups;
+	uint32 NumMergedComponents = 0;
+};
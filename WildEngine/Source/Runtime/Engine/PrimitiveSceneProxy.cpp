@@ -0,0 +1,195 @@
+#include "PrimitiveSceneProxy.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Async/ParallelFor.h"
+#include "Types/CommonTypes.h"
+
+FPrimitiveBounds FPrimitiveBounds::FromVertices(const FVertexType* Vertices, uint32 NumVertices)
+{
+	FPrimitiveBounds Result;
+	if (NumVertices == 0)
+	{
+		return Result;
+	}
+
+	float Min[3] = { Vertices[0].x, Vertices[0].y, Vertices[0].z };
+	float Max[3] = { Vertices[0].x, Vertices[0].y, Vertices[0].z };
+	for (uint32 i = 1; i < NumVertices; ++i)
+	{
+		const float P[3] = { Vertices[i].x, Vertices[i].y, Vertices[i].z };
+		for (int Axis = 0; Axis < 3; ++Axis)
+		{
+			Min[Axis] = P[Axis] < Min[Axis] ? P[Axis] : Min[Axis];
+			Max[Axis] = P[Axis] > Max[Axis] ? P[Axis] : Max[Axis];
+		}
+	}
+
+	Result.Origin = FVector((Min[0] + Max[0]) * 0.5f, (Min[1] + Max[1]) * 0.5f, (Min[2] + Max[2]) * 0.5f);
+	Result.BoxExtent = FVector((Max[0] - Min[0]) * 0.5f, (Max[1] - Min[1]) * 0.5f, (Max[2] - Min[2]) * 0.5f);
+
+	float MaxDistSq = 0.0f;
+	for (uint32 i = 0; i < NumVertices; ++i)
+	{
+		const float DX = Vertices[i].x - Result.Origin.X;
+		const float DY = Vertices[i].y - Result.Origin.Y;
+		const float DZ = Vertices[i].z - Result.Origin.Z;
+		const float DistSq = DX * DX + DY * DY + DZ * DZ;
+		MaxDistSq = DistSq > MaxDistSq ? DistSq : MaxDistSq;
+	}
+	Result.SphereRadius = std::sqrt(MaxDistSq);
+
+	return Result;
+}
+
+FPrimitiveBounds FPrimitiveBounds::TransformBy(const FMatrix& Matrix) const
+{
+	const float (&M)[4][4] = Matrix.M;
+
+	FPrimitiveBounds Result;
+
+	// Origin은 점 변환 (행 벡터 * 행렬)
+	Result.Origin = FVector(
+		Origin.X * M[0][0] + Origin.Y * M[1][0] + Origin.Z * M[2][0] + M[3][0],
+		Origin.X * M[0][1] + Origin.Y * M[1][1] + Origin.Z * M[2][1] + M[3][1],
+		Origin.X * M[0][2] + Origin.Y * M[1][2] + Origin.Z * M[2][2] + M[3][2]);
+
+	// Extent는 |M| 으로 변환해야 회전된 박스를 감싸는 AABB가 된다
+	Result.BoxExtent = FVector(
+		BoxExtent.X * std::fabs(M[0][0]) + BoxExtent.Y * std::fabs(M[1][0]) + BoxExtent.Z * std::fabs(M[2][0]),
+		BoxExtent.X * std::fabs(M[0][1]) + BoxExtent.Y * std::fabs(M[1][1]) + BoxExtent.Z * std::fabs(M[2][1]),
+		BoxExtent.X * std::fabs(M[0][2]) + BoxExtent.Y * std::fabs(M[1][2]) + BoxExtent.Z * std::fabs(M[2][2]));
+
+	float MaxAxisScaleSq = 0.0f;
+	for (int Row = 0; Row < 3; ++Row)
+	{
+		const float ScaleSq = M[Row][0] * M[Row][0] + M[Row][1] * M[Row][1] + M[Row][2] * M[Row][2];
+		MaxAxisScaleSq = ScaleSq > MaxAxisScaleSq ? ScaleSq : MaxAxisScaleSq;
+	}
+	Result.SphereRadius = SphereRadius * std::sqrt(MaxAxisScaleSq);
+
+	return Result;
+}
+
+void FPrimitiveSceneProxies::Reset()
+{
+	WorldMatrices.clear();
+	MeshIds.clear();
+	Bounds.clear();
+	LocalBounds.clear();
+	Flags.clear();
+	LODLevels.clear();
+	Components.clear();
+}
+
+int32 FPrimitiveSceneProxies::Add(UPrimitiveComponent* InComponent, uint32 InMeshId, const FPrimitiveBounds& InLocalBounds, uint32 InFlags)
+{
+	const int32 ProxyId = static_cast<int32>(Num());
+
+	WorldMatrices.push_back(FMatrix::Identity());
+	MeshIds.push_back(InMeshId);
+	Bounds.push_back(InLocalBounds);
+	LocalBounds.push_back(InLocalBounds);
+	Flags.push_back(InFlags);
+	LODLevels.push_back(0);
+	Components.push_back(InComponent);
+
+	return ProxyId;
+}
+
+void FPrimitiveSceneProxies::UpdateTransform(int32 ProxyId, const FMatrix& InWorldMatrix)
+{
+	WorldMatrices[ProxyId] = InWorldMatrix;
+	Bounds[ProxyId] = LocalBounds[ProxyId].TransformBy(InWorldMatrix);
+}
+
+void FPrimitiveSceneProxies::UpdateRenderState(int32 ProxyId, uint32 InMeshId, const FPrimitiveBounds& InLocalBounds, uint32 InFlags)
+{
+	MeshIds[ProxyId] = InMeshId;
+	LocalBounds[ProxyId] = InLocalBounds;
+	Bounds[ProxyId] = InLocalBounds.TransformBy(WorldMatrices[ProxyId]);
+	Flags[ProxyId] = InFlags;
+	LODLevels[ProxyId] = 0;
+}
+
+FViewFrustum::FViewFrustum(const FMatrix& ViewProjection)
+{
+	// 행 벡터 규약(clip = v * M)에서 절두체 평면은 열 조합으로 얻는다
+	const float (&M)[4][4] = ViewProjection.M;
+	for (int Row = 0; Row < 4; ++Row)
+	{
+		Planes[0][Row] = M[Row][3] + M[Row][0]; // Left
+		Planes[1][Row] = M[Row][3] - M[Row][0]; // Right
+		Planes[2][Row] = M[Row][3] + M[Row][1]; // Bottom
+		Planes[3][Row] = M[Row][3] - M[Row][1]; // Top
+		Planes[4][Row] = M[Row][2];             // Near (D3D: 0 <= z)
+		Planes[5][Row] = M[Row][3] - M[Row][2]; // Far
+	}
+	for (float (&Plane)[4] : Planes)
+	{
+		const float Length = std::sqrt(Plane[0] * Plane[0] + Plane[1] * Plane[1] + Plane[2] * Plane[2]);
+		if (Length > 0.0f)
+		{
+			for (float& Element : Plane)
+			{
+				Element /= Length;
+			}
+		}
+	}
+}
+
+bool FViewFrustum::Intersects(const FPrimitiveBounds& Box) const
+{
+	for (const float (&Plane)[4] : Planes)
+	{
+		const float Distance = Plane[0] * Box.Origin.X + Plane[1] * Box.Origin.Y + Plane[2] * Box.Origin.Z + Plane[3];
+		const float PushOut = std::fabs(Plane[0]) * Box.BoxExtent.X + std::fabs(Plane[1]) * Box.BoxExtent.Y + std::fabs(Plane[2]) * Box.BoxExtent.Z;
+		if (Distance + PushOut < 0.0f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FPrimitiveSceneProxies::ComputeViewVisibility(const TArray<FViewFrustum>& Frusta, TArray<uint32>& OutViewMasks) const
+{
+	const uint32 NumProxies = Num();
+	const uint32 NumViews = std::min(static_cast<uint32>(Frusta.size()), MaxCullingViews);
+	OutViewMasks.assign(NumProxies, 0);
+
+	ParallelFor(NumProxies, [&](uint32 ProxyId)
+	{
+		if ((Flags[ProxyId] & PSF_Visible) == 0)
+		{
+			return;
+		}
+
+		// 바운드는 한 번만 읽어 두고 모든 뷰의 평면에 대어 본다
+		const FPrimitiveBounds Box = Bounds[ProxyId];
+		uint32 Mask = 0;
+		for (uint32 ViewIndex = 0; ViewIndex < NumViews; ++ViewIndex)
+		{
+			if (Frusta[ViewIndex].Intersects(Box))
+			{
+				Mask |= 1u << ViewIndex;
+			}
+		}
+		OutViewMasks[ProxyId] = Mask;
+	}, 256);
+}
+
+void FPrimitiveSceneProxies::GetVisibleProxies(const TArray<uint32>& ViewMasks, uint32 ViewBit, TArray<uint32>& OutVisibleProxies)
+{
+	OutVisibleProxies.clear();
+
+	const uint32 Bit = 1u << ViewBit;
+	for (uint32 ProxyId = 0; ProxyId < ViewMasks.size(); ++ProxyId)
+	{
+		if (ViewMasks[ProxyId] & Bit)
+		{
+			OutVisibleProxies.push_back(ProxyId);
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Math/Matrix.h"
+#include "Templates/UnrealTypes.h"
+
+struct FVertexType;
+class UPrimitiveComponent;
+
+/** Per-proxy render flags. */
+enum EPrimitiveSceneFlags : uint32
+{
+	PSF_None    = 0,
+	PSF_Visible = 1 << 0,
+	PSF_Translucent = 1 << 1, // Sorted back to front after every opaque draw
+	PSF_Merged      = 1 << 2, // Drawn as part of a merged static mesh, not on its own
+	PSF_LineList    = 1 << 3, // Line list mesh, drawn as debug lines; never instanced, merged or used as an occluder
+};
+
+/** Axis aligned box plus enclosing sphere, sharing one origin. */
+struct FPrimitiveBounds
+{
+	FVector Origin;
+	FVector BoxExtent;
+	float SphereRadius = 0.0f;
+
+	/** Builds local bounds from a raw vertex array. */
+	static FPrimitiveBounds FromVertices(const FVertexType* Vertices, uint32 NumVertices);
+
+	/** @return These bounds moved into the space of Matrix (row vector convention). */
+	FPrimitiveBounds TransformBy(const FMatrix& Matrix) const;
+};
+
+/** The six clip planes of a view, for testing bounds without going through the proxies. */
+struct FViewFrustum
+{
+	/** Normalized planes (a, b, c, d); a point is inside when a*x + b*y + c*z + d >= 0 for all six. */
+	float Planes[6][4];
+
+	explicit FViewFrustum(const FMatrix& ViewProjection);
+
+	bool Intersects(const FPrimitiveBounds& InBounds) const;
+};
+
+/** Views one culling sweep can test; each gets one bit of a proxy's view mask. */
+constexpr uint32 MaxCullingViews = 32;
+
+/**
+ * Render-side state of every primitive in a UScene, packed as structure of arrays.
+ *
+ * A UPrimitiveComponent only keeps its proxy id; culling and draw submission walk
+ * these columns and never touch the component objects. Columns are written when
+ * a component actually changes (transform, visibility, mesh).
+ */
+class FPrimitiveSceneProxies
+{
+public:
+	void Reset();
+
+	/** Appends a proxy for InComponent and returns its id. */
+	int32 Add(UPrimitiveComponent* InComponent, uint32 InMeshId, const FPrimitiveBounds& InLocalBounds, uint32 InFlags);
+
+	void UpdateTransform(int32 ProxyId, const FMatrix& InWorldMatrix);
+	void UpdateRenderState(int32 ProxyId, uint32 InMeshId, const FPrimitiveBounds& InLocalBounds, uint32 InFlags);
+	void SetFlags(int32 ProxyId, uint32 InFlags) { Flags[ProxyId] = InFlags; }
+
+	/** Level of the mesh's LOD chain drawn last frame, 0 for the mesh itself; kept for hysteresis. Reset when the mesh changes. */
+	uint32 GetLODLevel(uint32 ProxyId) const { return LODLevels[ProxyId]; }
+	void SetLODLevel(uint32 ProxyId, uint32 InLODLevel) { LODLevels[ProxyId] = static_cast<uint8>(InLODLevel); }
+
+	/**
+	 * Frustum culls every visible proxy against all of Frusta (at most MaxCullingViews) in one sweep,
+	 * so each proxy's bounds are read once however many views there are.
+	 * @param OutViewMasks Receives one mask per proxy; bit i is set when the proxy intersects Frusta[i].
+	 */
+	void ComputeViewVisibility(const TArray<FViewFrustum>& Frusta, TArray<uint32>& OutViewMasks) const;
+
+	/** Collects the ids of the proxies whose mask has bit ViewBit set, in id order. */
+	static void GetVisibleProxies(const TArray<uint32>& ViewMasks, uint32 ViewBit, TArray<uint32>& OutVisibleProxies);
+
+	uint32 Num() const { return static_cast<uint32>(WorldMatrices.size()); }
+
+	const FMatrix& GetWorldMatrix(uint32 ProxyId) const { return WorldMatrices[ProxyId]; }
+	uint32 GetMeshId(uint32 ProxyId) const { return MeshIds[ProxyId]; }
+	const FPrimitiveBounds& GetBounds(uint32 ProxyId) const { return Bounds[ProxyId]; }
+	uint32 GetFlags(uint32 ProxyId) const { return Flags[ProxyId]; }
+
+	/** Owning component, for game-side queries such as picking. Never read while rendering. */
+	UPrimitiveComponent* GetComponent(uint32 ProxyId) const { return Components[ProxyId]; }
+
+private:
+	TArray<FMatrix> WorldMatrices;
+	TArray<uint32> MeshIds;
+	TArray<FPrimitiveBounds> Bounds;
+	TArray<FPrimitiveBounds> LocalBounds;
+	TArray<uint32> Flags;
+	TArray<uint8> LODLevels;
+
+	TArray<UPrimitiveComponent*> Components;
+};
@@ -0,0 +1,414 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+
+#include "DynamicRHI.h"
+
+FRHITexture2D* FRenderGraphTexturePool::Acquire(const FRenderGraphTextureDesc& Desc)
+{
+	for (FPooledTexture& Pooled : Textures)
+	{
+		if (!Pooled.bInUse && Pooled.Desc.IsCompatible(Desc))
+		{
+			Pooled.bInUse = true;
+			Pooled.LastUsedFrame = FrameCounter;
+			return Pooled.Texture;
+		}
+	}
+
+	FRHITexture2D* Texture = RHICreateTexture2D(Desc.Width, Desc.Height, Desc.Format, Desc.Flags);
+	if (!Texture)
+	{
+		return nullptr;
+	}
+
+	FPooledTexture& Pooled = *Textures.emplace(Textures.end());
+	Pooled.Texture = Texture;
+	Pooled.Desc = Desc;
+	Pooled.bInUse = true;
+	Pooled.LastUsedFrame = FrameCounter;
+	return Texture;
+}
+
+void FRenderGraphTexturePool::Release(FRHITexture2D* Texture)
+{
+	for (FPooledTexture& Pooled : Textures)
+	{
+		if (Pooled.Texture == Texture)
+		{
+			Pooled.bInUse = false;
+			return;
+		}
+	}
+}
+
+void FRenderGraphTexturePool::Tick(uint32 MaxUnusedFrames)
+{
+	++FrameCounter;
+
+	// 마지막 참조가 풀려도 지연 삭제 큐가 GPU에서 끝난 뒤에 지운다
+	Textures.erase(std::remove_if(Textures.begin(), Textures.end(), [this, MaxUnusedFrames](const FPooledTexture& Pooled)
+	{
+		return !Pooled.bInUse && FrameCounter - Pooled.LastUsedFrame > MaxUnusedFrames;
+	}), Textures.end());
+}
+
+FRenderGraphPassBuilder& FRenderGraphPassBuilder::Read(FRenderGraphTextureRef Texture)
+{
+	Graph.AddAccess(PassIndex, Texture, false);
+	return *this;
+}
+
+FRenderGraphPassBuilder& FRenderGraphPassBuilder::Write(FRenderGraphTextureRef Texture)
+{
+	Graph.AddAccess(PassIndex, Texture, true);
+	return *this;
+}
+
+FRenderGraphPassBuilder& FRenderGraphPassBuilder::SetRenderTargets(FRenderGraphTextureRef Color, FRenderGraphTextureRef Depth)
+{
+	FRenderGraphRenderTargets& RenderTargets = Graph.Passes[PassIndex].RenderTargets;
+	RenderTargets.Color = Color;
+	RenderTargets.Depth = Depth;
+	Graph.AddAccess(PassIndex, Color, true);
+	Graph.AddAccess(PassIndex, Depth, true);
+	return *this;
+}
+
+FRenderGraph::FRenderGraph(FRenderGraphTexturePool& InPool)
+	: Pool(InPool)
+{
+}
+
+void FRenderGraph::Reset()
+{
+	Textures.clear();
+	Passes.clear();
+	ExecutionOrder.clear();
+	Stats = FRenderGraphStats();
+}
+
+FRenderGraphTextureRef FRenderGraph::RegisterExternalTexture(const char* Name, const FRenderGraphTextureDesc& Desc, FRHITexture2D* Resource)
+{
+	FRenderGraphTexture& Texture = *Textures.emplace(Textures.end());
+	Texture.Name = Name;
+	Texture.Desc = Desc;
+	Texture.bExternal = true;
+	Texture.Resource = Resource;
+	return { static_cast<int32>(Textures.size()) - 1 };
+}
+
+FRenderGraphTextureRef FRenderGraph::CreateTexture(const char* Name, const FRenderGraphTextureDesc& Desc)
+{
+	FRenderGraphTexture& Texture = *Textures.emplace(Textures.end());
+	Texture.Name = Name;
+	Texture.Desc = Desc;
+	return { static_cast<int32>(Textures.size()) - 1 };
+}
+
+FRenderGraphPassBuilder FRenderGraph::AddPass(const char* Name, FExecuteFunction Execute, uint32 Flags)
+{
+	FPass& Pass = *Passes.emplace(Passes.end());
+	Pass.Name = Name;
+	Pass.Flags = Flags;
+	Pass.Execute = std::move(Execute);
+	return FRenderGraphPassBuilder(*this, static_cast<uint32>(Passes.size()) - 1);
+}
+
+void FRenderGraph::AddAccess(uint32 PassIndex, FRenderGraphTextureRef Texture, bool bWrite)
+{
+	if (!Texture.IsValid())
+	{
+		return;
+	}
+
+	TArray<FRenderGraphTextureRef>& Accesses = bWrite ? Passes[PassIndex].Writes : Passes[PassIndex].Reads;
+	if (std::find(Accesses.begin(), Accesses.end(), Texture) == Accesses.end())
+	{
+		Accesses.push_back(Texture);
+	}
+}
+
+void FRenderGraph::Execute(const FBindRenderTargetsFunction& BindRenderTargets)
+{
+	Stats = FRenderGraphStats();
+	Stats.NumPasses = static_cast<uint32>(Passes.size());
+
+	BuildDependencies();
+	CullPasses();
+	SortPasses();
+	ComputeLifetimes();
+
+	Written.assign(Textures.size(), 0);
+	TArray<FRHITexture2D*> PooledTextures;
+
+	FRenderGraphRenderTargets BoundTargets;
+	bool bTargetsBound = false;
+	for (uint32 Position = 0; Position < ExecutionOrder.size(); ++Position)
+	{
+		const FPass& Pass = Passes[ExecutionOrder[Position]];
+
+		// 이 패스에서 수명이 시작되는 임시 텍스처는 이전 패스에서 수명이 끝난 것을 재사용할 수 있다
+		for (uint32 Index = 0; Index < Textures.size(); ++Index)
+		{
+			if (Lifetimes[Index].FirstPass == static_cast<int32>(Position))
+			{
+				Textures[Index].Resource = Pool.Acquire(Textures[Index].Desc);
+				if (Textures[Index].Resource && std::find(PooledTextures.begin(), PooledTextures.end(), Textures[Index].Resource) == PooledTextures.end())
+				{
+					PooledTextures.push_back(Textures[Index].Resource);
+				}
+			}
+		}
+
+		// 프레임에서 처음 쓰는 타깃만 지우고, 이미 바인딩된 타깃이면 다시 바인딩하지 않는다
+		if (Pass.RenderTargets.Color.IsValid() || Pass.RenderTargets.Depth.IsValid())
+		{
+			FRenderGraphRenderTargets Targets = Pass.RenderTargets;
+			auto ResolveLoadAction = [this](FRenderGraphTextureRef Texture)
+			{
+				if (!Texture.IsValid())
+				{
+					return ERenderTargetLoadAction::NoAction;
+				}
+				if (Written[Texture.Index])
+				{
+					return ERenderTargetLoadAction::Load;
+				}
+				return Textures[Texture.Index].Desc.bClear ? ERenderTargetLoadAction::Clear : ERenderTargetLoadAction::NoAction;
+			};
+			Targets.ColorLoadAction = ResolveLoadAction(Targets.Color);
+			Targets.DepthLoadAction = ResolveLoadAction(Targets.Depth);
+
+			const uint32 NumClears = (Targets.ColorLoadAction == ERenderTargetLoadAction::Clear ? 1 : 0) + (Targets.DepthLoadAction == ERenderTargetLoadAction::Clear ? 1 : 0);
+			if (!bTargetsBound || NumClears > 0 || Targets.Color != BoundTargets.Color || Targets.Depth != BoundTargets.Depth)
+			{
+				BindRenderTargets(*this, Targets);
+				BoundTargets = Targets;
+				bTargetsBound = true;
+				++Stats.NumRenderTargetBinds;
+				Stats.NumClears += NumClears;
+			}
+		}
+
+		for (FRenderGraphTextureRef Texture : Pass.Writes)
+		{
+			Written[Texture.Index] = 1;
+		}
+
+		if (Pass.Execute)
+		{
+			Pass.Execute(*this);
+		}
+
+		for (uint32 Index = 0; Index < Textures.size(); ++Index)
+		{
+			if (Lifetimes[Index].LastPass == static_cast<int32>(Position) && Textures[Index].Resource)
+			{
+				Pool.Release(Textures[Index].Resource);
+				Textures[Index].Resource = nullptr;
+			}
+		}
+	}
+
+	Stats.NumPooledTextures = static_cast<uint32>(PooledTextures.size());
+}
+
+void FRenderGraph::GetExecutedPassNames(TArray<const char*>& OutNames) const
+{
+	OutNames.clear();
+	for (uint32 PassIndex : ExecutionOrder)
+	{
+		OutNames.push_back(Passes[PassIndex].Name);
+	}
+}
+
+void FRenderGraph::BuildDependencies()
+{
+	// 선언 순서가 텍스처마다의 접근 순서: 읽기는 직전 쓰기 뒤에, 쓰기는 직전 쓰기와 그 뒤의 읽기들 뒤에
+	LastWriters.assign(Textures.size(), INDEX_NONE);
+	ReadersSinceWrite.resize(Textures.size());
+	for (TArray<uint32>& Readers : ReadersSinceWrite)
+	{
+		Readers.clear();
+	}
+
+	int32 LastSideEffectPass = INDEX_NONE;
+	for (uint32 PassIndex = 0; PassIndex < Passes.size(); ++PassIndex)
+	{
+		FPass& Pass = Passes[PassIndex];
+		Pass.Producers.clear();
+		Pass.Dependencies.clear();
+
+		for (FRenderGraphTextureRef Texture : Pass.Reads)
+		{
+			if (LastWriters[Texture.Index] != INDEX_NONE)
+			{
+				Pass.Producers.push_back(LastWriters[Texture.Index]);
+			}
+		}
+
+		for (FRenderGraphTextureRef Texture : Pass.Writes)
+		{
+			// 렌더 타깃에 이어 그리는 패스는 앞선 결과를 Load 하므로 앞선 쓰기도 생산자다
+			if (LastWriters[Texture.Index] != INDEX_NONE)
+			{
+				Pass.Producers.push_back(LastWriters[Texture.Index]);
+			}
+			for (uint32 Reader : ReadersSinceWrite[Texture.Index])
+			{
+				if (Reader != PassIndex)
+				{
+					Pass.Dependencies.push_back(Reader);
+				}
+			}
+		}
+
+		// 그래프 밖 부작용이 있는 패스끼리는 선언 순서를 지킨다
+		if (Pass.Flags & RGPF_NeverCull)
+		{
+			if (LastSideEffectPass != INDEX_NONE)
+			{
+				Pass.Dependencies.push_back(LastSideEffectPass);
+			}
+			LastSideEffectPass = static_cast<int32>(PassIndex);
+		}
+
+		Pass.Dependencies.insert(Pass.Dependencies.end(), Pass.Producers.begin(), Pass.Producers.end());
+
+		for (FRenderGraphTextureRef Texture : Pass.Reads)
+		{
+			ReadersSinceWrite[Texture.Index].push_back(PassIndex);
+		}
+		for (FRenderGraphTextureRef Texture : Pass.Writes)
+		{
+			LastWriters[Texture.Index] = static_cast<int32>(PassIndex);
+			ReadersSinceWrite[Texture.Index].clear();
+		}
+	}
+}
+
+void FRenderGraph::CullPasses()
+{
+	// 외부 텍스처를 쓰거나 부작용이 있는 패스에서 시작해 생산자를 거꾸로 따라가며 살린다
+	TArray<uint32> Stack;
+	for (uint32 PassIndex = 0; PassIndex < Passes.size(); ++PassIndex)
+	{
+		FPass& Pass = Passes[PassIndex];
+		Pass.bCulled = true;
+
+		bool bRoot = (Pass.Flags & RGPF_NeverCull) != 0;
+		for (FRenderGraphTextureRef Texture : Pass.Writes)
+		{
+			bRoot |= Textures[Texture.Index].bExternal;
+		}
+		if (bRoot)
+		{
+			Pass.bCulled = false;
+			Stack.push_back(PassIndex);
+		}
+	}
+
+	while (!Stack.empty())
+	{
+		const uint32 PassIndex = Stack.back();
+		Stack.pop_back();
+		for (uint32 Producer : Passes[PassIndex].Producers)
+		{
+			if (Passes[Producer].bCulled)
+			{
+				Passes[Producer].bCulled = false;
+				Stack.push_back(Producer);
+			}
+		}
+	}
+
+	for (const FPass& Pass : Passes)
+	{
+		Stats.NumCulledPasses += Pass.bCulled ? 1 : 0;
+	}
+}
+
+void FRenderGraph::SortPasses()
+{
+	// 위상 정렬. 준비된 패스 중 가장 최근에 실행된 생산자를 가진 것을 먼저 골라
+	// 임시 텍스처를 만든 패스 바로 뒤에서 소비해 수명을 줄인다 (같으면 선언 순서)
+	ExecutionOrder.clear();
+	TArray<int32> Positions(Passes.size(), INDEX_NONE);
+	const uint32 NumToSchedule = static_cast<uint32>(Passes.size()) - Stats.NumCulledPasses;
+	while (ExecutionOrder.size() < NumToSchedule)
+	{
+		int32 BestPass = INDEX_NONE;
+		int32 BestProducerPosition = INDEX_NONE;
+		for (uint32 PassIndex = 0; PassIndex < Passes.size(); ++PassIndex)
+		{
+			const FPass& Pass = Passes[PassIndex];
+			if (Pass.bCulled || Positions[PassIndex] != INDEX_NONE)
+			{
+				continue;
+			}
+
+			bool bReady = true;
+			for (uint32 Dependency : Pass.Dependencies)
+			{
+				bReady &= Passes[Dependency].bCulled || Positions[Dependency] != INDEX_NONE;
+			}
+			if (!bReady)
+			{
+				continue;
+			}
+
+			int32 ProducerPosition = INDEX_NONE;
+			for (uint32 Producer : Pass.Producers)
+			{
+				ProducerPosition = std::max(ProducerPosition, Positions[Producer]);
+			}
+			if (BestPass == INDEX_NONE || ProducerPosition > BestProducerPosition)
+			{
+				BestPass = static_cast<int32>(PassIndex);
+				BestProducerPosition = ProducerPosition;
+			}
+		}
+
+		// 의존은 항상 앞서 선언된 패스를 향하므로 순환은 없다
+		Positions[BestPass] = static_cast<int32>(ExecutionOrder.size());
+		ExecutionOrder.push_back(static_cast<uint32>(BestPass));
+	}
+}
+
+void FRenderGraph::ComputeLifetimes()
+{
+	Lifetimes.assign(Textures.size(), FTextureLifetime());
+	for (uint32 Position = 0; Position < ExecutionOrder.size(); ++Position)
+	{
+		const FPass& Pass = Passes[ExecutionOrder[Position]];
+		auto Extend = [this, Position](FRenderGraphTextureRef Texture)
+		{
+			if (Textures[Texture.Index].bExternal)
+			{
+				return;
+			}
+
+			FTextureLifetime& Lifetime = Lifetimes[Texture.Index];
+			if (Lifetime.FirstPass == INDEX_NONE)
+			{
+				Lifetime.FirstPass = static_cast<int32>(Position);
+			}
+			Lifetime.LastPass = static_cast<int32>(Position);
+		};
+
+		for (FRenderGraphTextureRef Texture : Pass.Reads)
+		{
+			Extend(Texture);
+		}
+		for (FRenderGraphTextureRef Texture : Pass.Writes)
+		{
+			Extend(Texture);
+		}
+	}
+
+	for (const FTextureLifetime& Lifetime : Lifetimes)
+	{
+		Stats.NumTransientTextures += Lifetime.FirstPass != INDEX_NONE ? 1 : 0;
+	}
+}
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <functional>
+
+#include "RHI.h"
+#include "Templates/RefCounting.h"
+#include "Templates/UnrealTypes.h"
+
+class FRenderGraph;
+
+/** What happens to a render target's previous contents when a pass binds it. */
+enum class ERenderTargetLoadAction : uint8
+{
+	NoAction,
+	Load,
+	Clear,
+};
+
+/** Per-pass flags. */
+enum ERenderGraphPassFlags : uint32
+{
+	RGPF_None      = 0,
+	RGPF_NeverCull = 1 << 0, // Has side effects outside the graph (readback, present)
+};
+
+/** Size, format and clear value of a graph texture. */
+struct FRenderGraphTextureDesc
+{
+	uint32 Width = 0;
+	uint32 Height = 0;
+	EPixelFormat Format = PF_Unknown;
+	uint32 Flags = TexCreate_None; // ETextureCreateFlags
+
+	/** Applied by the first pass that writes the texture in a frame; later writers load it. */
+	bool bClear = true;
+	float ClearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	float ClearDepth = 1.0f;
+
+	/** @return Whether a pooled texture created for Other can hold this one. */
+	bool IsCompatible(const FRenderGraphTextureDesc& Other) const
+	{
+		return Width == Other.Width && Height == Other.Height && Format == Other.Format && Flags == Other.Flags;
+	}
+};
+
+/** Handle of a texture in one FRenderGraph. */
+struct FRenderGraphTextureRef
+{
+	int32 Index = INDEX_NONE;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	bool operator==(const FRenderGraphTextureRef& Other) const { return Index == Other.Index; }
+	bool operator!=(const FRenderGraphTextureRef& Other) const { return Index != Other.Index; }
+};
+
+/** Color and depth targets of a pass, with the load actions the graph resolved for this frame. */
+struct FRenderGraphRenderTargets
+{
+	FRenderGraphTextureRef Color;
+	FRenderGraphTextureRef Depth;
+	ERenderTargetLoadAction ColorLoadAction = ERenderTargetLoadAction::NoAction;
+	ERenderTargetLoadAction DepthLoadAction = ERenderTargetLoadAction::NoAction;
+};
+
+/** A texture as seen by the passes of one frame. */
+struct FRenderGraphTexture
+{
+	const char* Name = nullptr;
+	FRenderGraphTextureDesc Desc;
+
+	/** Imported textures outlive the graph and count as its outputs. */
+	bool bExternal = false;
+
+	/**
+	 * The texture behind it while a pass using it executes. External textures
+	 * may have none (the swap chain back buffer belongs to URenderer).
+	 */
+	FRHITexture2D* Resource = nullptr;
+};
+
+/** What the last FRenderGraph::Execute did. */
+struct FRenderGraphStats
+{
+	uint32 NumPasses = 0;
+	uint32 NumCulledPasses = 0;
+
+	/** Transient textures the passes declared, and how many pooled textures backed them. */
+	uint32 NumTransientTextures = 0;
+	uint32 NumPooledTextures = 0;
+
+	uint32 NumClears = 0;
+	uint32 NumRenderTargetBinds = 0;
+};
+
+/**
+ * Render targets shared by every graph, kept across frames.
+ *
+ * Transient graph textures are acquired when their first pass runs and handed
+ * back after their last one, so textures with disjoint lifetimes and the same
+ * description alias one RHI texture. Textures no frame has used for a while
+ * are released through the deferred delete queue.
+ */
+class FRenderGraphTexturePool
+{
+public:
+	/** Rendering thread. @return A free texture matching Desc, created on first use. Null if the RHI fails. */
+	FRHITexture2D* Acquire(const FRenderGraphTextureDesc& Desc);
+
+	/** Makes a texture returned by Acquire available to later passes. */
+	void Release(FRHITexture2D* Texture);
+
+	/** Ends a frame: frees textures unused for MaxUnusedFrames frames (e.g. the old size after a resize). */
+	void Tick(uint32 MaxUnusedFrames = 30);
+
+	/** Drops every pooled texture, e.g. before the RHI shuts down. */
+	void Empty() { Textures.clear(); }
+
+	uint32 Num() const { return static_cast<uint32>(Textures.size()); }
+
+private:
+	struct FPooledTexture
+	{
+		TRefCountPtr<FRHITexture2D> Texture;
+		FRenderGraphTextureDesc Desc;
+		bool bInUse = false;
+		uint64 LastUsedFrame = 0;
+	};
+
+	TArray<FPooledTexture> Textures;
+	uint64 FrameCounter = 0;
+};
+
+/** Declares what a pass reads and writes; returned by FRenderGraph::AddPass. */
+class FRenderGraphPassBuilder
+{
+public:
+	FRenderGraphPassBuilder(FRenderGraph& InGraph, uint32 InPassIndex)
+		: Graph(InGraph)
+		, PassIndex(InPassIndex)
+	{
+	}
+
+	/** The pass samples or copies from Texture. */
+	FRenderGraphPassBuilder& Read(FRenderGraphTextureRef Texture);
+
+	/** The pass writes Texture other than as a render target (copy, clear). */
+	FRenderGraphPassBuilder& Write(FRenderGraphTextureRef Texture);
+
+	/** The pass draws into Color and Depth (either may be invalid); both count as writes. */
+	FRenderGraphPassBuilder& SetRenderTargets(FRenderGraphTextureRef Color, FRenderGraphTextureRef Depth);
+
+private:
+	FRenderGraph& Graph;
+	uint32 PassIndex;
+};
+
+/**
+ * The passes of one frame, declared up front and then compiled and run at once.
+ *
+ * Passes declare the textures they read and write instead of touching
+ * device state directly. From that the graph derives what depends on what,
+ * culls passes whose results never reach an external texture, orders the
+ * rest, gives transient textures pooled memory only for the span of passes
+ * that use them, and binds and clears render targets only when the bound
+ * targets actually change. Binding itself is API specific and done by the
+ * callback given to Execute.
+ *
+ * Rebuilt every frame on the rendering thread; Reset keeps the allocations.
+ */
+class FRenderGraph
+{
+public:
+	using FExecuteFunction = std::function<void(const FRenderGraph&)>;
+	using FBindRenderTargetsFunction = std::function<void(const FRenderGraph&, const FRenderGraphRenderTargets&)>;
+
+	explicit FRenderGraph(FRenderGraphTexturePool& InPool);
+
+	/** Forgets the passes and textures of the previous frame. */
+	void Reset();
+
+	/** Adds a texture owned outside the graph; passes writing it are never culled. */
+	FRenderGraphTextureRef RegisterExternalTexture(const char* Name, const FRenderGraphTextureDesc& Desc, FRHITexture2D* Resource = nullptr);
+
+	/** Adds a texture that only lives between its first and last pass of this frame. */
+	FRenderGraphTextureRef CreateTexture(const char* Name, const FRenderGraphTextureDesc& Desc);
+
+	/** Adds a pass; declare its accesses on the returned builder. Execute runs in the derived order. */
+	FRenderGraphPassBuilder AddPass(const char* Name, FExecuteFunction Execute, uint32 Flags = RGPF_None);
+
+	/** Compiles the graph and runs the passes that survive culling. */
+	void Execute(const FBindRenderTargetsFunction& BindRenderTargets);
+
+	const FRenderGraphTexture& GetTexture(FRenderGraphTextureRef Texture) const { return Textures[Texture.Index]; }
+
+	/** Pass names in execution order, after Execute. */
+	void GetExecutedPassNames(TArray<const char*>& OutNames) const;
+
+	const FRenderGraphStats& GetStats() const { return Stats; }
+
+private:
+	friend class FRenderGraphPassBuilder;
+
+	struct FPass
+	{
+		const char* Name = nullptr;
+		uint32 Flags = RGPF_None;
+		FExecuteFunction Execute;
+
+		TArray<FRenderGraphTextureRef> Reads;
+		TArray<FRenderGraphTextureRef> Writes;
+		FRenderGraphRenderTargets RenderTargets;
+
+		/** Passes whose writes this one consumes (culling) and every pass it must run after (ordering). */
+		TArray<uint32> Producers;
+		TArray<uint32> Dependencies;
+		bool bCulled = true;
+	};
+
+	/** Lifetime of a transient texture over the execution order. */
+	struct FTextureLifetime
+	{
+		int32 FirstPass = INDEX_NONE;
+		int32 LastPass = INDEX_NONE;
+	};
+
+	void AddAccess(uint32 PassIndex, FRenderGraphTextureRef Texture, bool bWrite);
+
+	void BuildDependencies();
+	void CullPasses();
+	void SortPasses();
+	void ComputeLifetimes();
+
+private:
+	FRenderGraphTexturePool& Pool;
+
+	TArray<FRenderGraphTexture> Textures;
+	TArray<FPass> Passes;
+
+	/** Reused every frame to avoid reallocating. */
+	TArray<uint32> ExecutionOrder;
+	TArray<FTextureLifetime> Lifetimes;
+	TArray<int32> LastWriters;
+	TArray<TArray<uint32>> ReadersSinceWrite;
+	TArray<uint8> Written;
+
+	FRenderGraphStats Stats;
+};
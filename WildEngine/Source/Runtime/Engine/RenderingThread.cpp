@@ -0,0 +1,111 @@
+#include "RenderingThread.h"
+
+#include "RHI.h"
+
+FRenderingThread::~FRenderingThread()
+{
+	Stop();
+}
+
+void FRenderingThread::Start(const FRenderingThreadSettings& InSettings, FRenderFunction InRenderFunction)
+{
+	Stop();
+
+	Settings = InSettings;
+	Settings.MaxFramesInFlight = Settings.MaxFramesInFlight > 0 ? Settings.MaxFramesInFlight : 1;
+	RenderFunction = std::move(InRenderFunction);
+
+	Packets.clear();
+	Packets.resize(Settings.MaxFramesInFlight + 1);
+	WriteIndex = 0;
+	ReadIndex = 0;
+	NumPending = 0;
+	bStopRequested = false;
+
+	if (!Settings.bSingleThreaded)
+	{
+		Thread = std::thread(&FRenderingThread::Run, this);
+	}
+}
+
+void FRenderingThread::Stop()
+{
+	if (!Thread.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		bStopRequested = true;
+	}
+	FrameQueuedCondition.notify_one();
+
+	Thread.join();
+}
+
+FFramePacket& FRenderingThread::BeginFrame()
+{
+	{
+		// 렌더 스레드에 MaxFramesInFlight 개를 넘게 쌓아두지 않는다 (그래야 쓰기 슬롯이 비어 있다)
+		std::unique_lock<std::mutex> Lock(Mutex);
+		FrameDoneCondition.wait(Lock, [this] { return NumPending <= Settings.MaxFramesInFlight; });
+	}
+
+	FFramePacket& Packet = Packets[WriteIndex];
+	Packet.Reset();
+	Packet.FrameNumber = ++FrameCounter;
+
+	// 이제부터 해제되는 RHI 리소스는 이 프레임이 GPU에서 끝날 때까지 살아 있어야 한다
+	FRHIResource::BeginFrame(Packet.FrameNumber);
+	return Packet;
+}
+
+void FRenderingThread::EndFrame()
+{
+	if (!IsThreaded())
+	{
+		RenderFunction(Packets[WriteIndex]);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		WriteIndex = (WriteIndex + 1) % Packets.size();
+		++NumPending;
+	}
+	FrameQueuedCondition.notify_one();
+}
+
+void FRenderingThread::Flush()
+{
+	std::unique_lock<std::mutex> Lock(Mutex);
+	FrameDoneCondition.wait(Lock, [this] { return NumPending == 0; });
+}
+
+void FRenderingThread::Run()
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> Lock(Mutex);
+			FrameQueuedCondition.wait(Lock, [this] { return NumPending > 0 || bStopRequested; });
+
+			// 종료 요청이 와도 이미 넘겨받은 프레임은 마저 그린다
+			if (NumPending == 0)
+			{
+				return;
+			}
+		}
+
+		// 이 슬롯은 NumPending을 줄이기 전까지 게임 스레드가 건드리지 않는다
+		RenderFunction(Packets[ReadIndex]);
+
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+			ReadIndex = (ReadIndex + 1) % Packets.size();
+			--NumPending;
+		}
+		FrameDoneCondition.notify_all();
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "HAL/Platform.h"
+#include "FramePacket.h"
+
+/** Startup options for FRenderingThread. */
+struct FRenderingThreadSettings
+{
+	/** How many older frames may still be queued or drawing while the game thread builds the next one. */
+	uint32 MaxFramesInFlight = 1;
+
+	/** Renders every frame inline on the game thread (debugging aid, -onethread). */
+	bool bSingleThreaded = false;
+};
+
+/**
+ * Dedicated thread that submits frame packets built by the game thread.
+ *
+ * Packets live in a ring of MaxFramesInFlight + 1 slots (double buffered with
+ * the default of one frame in flight): the game thread fills one slot while
+ * the render thread draws the older ones, so frame N + 1 simulation overlaps
+ * with frame N submission. BeginFrame blocks while more than MaxFramesInFlight
+ * frames are still waiting on the render thread.
+ */
+class FRenderingThread
+{
+public:
+	using FRenderFunction = std::function<void(const FFramePacket&)>;
+
+	FRenderingThread() = default;
+	FRenderingThread(const FRenderingThread&) = delete;
+	FRenderingThread& operator=(const FRenderingThread&) = delete;
+	~FRenderingThread();
+
+	/** Sets up the packet ring and, unless single threaded, starts the thread. */
+	void Start(const FRenderingThreadSettings& InSettings, FRenderFunction InRenderFunction);
+
+	/** Renders whatever is still queued and joins the thread. */
+	void Stop();
+
+	/** @return A cleared packet for the next frame. Waits while too many frames are in flight. */
+	FFramePacket& BeginFrame();
+
+	/** Hands the packet returned by BeginFrame to the render thread (or renders it now when single threaded). */
+	void EndFrame();
+
+	/** Waits until every handed-off frame has been rendered, e.g. before touching the device context on the game thread. */
+	void Flush();
+
+	bool IsThreaded() const { return Thread.joinable(); }
+	const FRenderingThreadSettings& GetSettings() const { return Settings; }
+
+private:
+	void Run();
+
+private:
+	FRenderingThreadSettings Settings;
+	FRenderFunction RenderFunction;
+
+	TArray<FFramePacket> Packets;
+	uint32 WriteIndex = 0;
+	uint32 ReadIndex = 0;
+
+	/** Frames handed off and not yet finished by the render thread. */
+	uint32 NumPending = 0;
+	uint64 FrameCounter = 0;
+
+	std::thread Thread;
+	std::mutex Mutex;
+	std::condition_variable FrameQueuedCondition;
+	std::condition_variable FrameDoneCondition;
+	bool bStopRequested = false;
+};
@@ -0,0 +1,158 @@
+#include "ResourceUploadQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "DynamicRHI.h"
+
+TRefCountPtr<FRHIVertexBuffer> FResourceUploadQueue::CreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage)
+{
+	if (Size == 0)
+	{
+		return nullptr;
+	}
+
+	// 디바이스는 건드리지 않는다. 버퍼 객체만 먼저 만들어 바로 참조할 수 있게 한다
+	TRefCountPtr<FRHIVertexBuffer> VertexBuffer = RHIAllocVertexBuffer(Size, InUsage);
+
+	FRequest Request;
+	Request.VertexBuffer = VertexBuffer;
+	Request.bCreate = true;
+	Request.Size = Size;
+
+	std::lock_guard<std::mutex> Lock(Mutex);
+	if (Data)
+	{
+		StageData(Request, Data);
+	}
+	PendingRequests.push_back(std::move(Request));
+	return VertexBuffer;
+}
+
+void FResourceUploadQueue::UpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size)
+{
+	if (!VertexBuffer || !Data || Size == 0)
+	{
+		return;
+	}
+
+	FRequest Request;
+	Request.VertexBuffer = VertexBuffer;
+	Request.Offset = Offset;
+	Request.Size = Size;
+
+	std::lock_guard<std::mutex> Lock(Mutex);
+	StageData(Request, Data);
+	PendingRequests.push_back(std::move(Request));
+}
+
+void FResourceUploadQueue::StageData(FRequest& Request, const void* Data)
+{
+	// 복사까지 락 안에서 한다. 요청 순서와 링 구간 순서가 같아야 Flush가 어디까지 비울지 안다
+	uint8* Destination = ReserveStaging(Request.Size);
+	if (!Destination)
+	{
+		Request.OverflowData = std::make_unique<uint8[]>(Request.Size);
+		Destination = Request.OverflowData.get();
+		Stats.OverflowBytes += Request.Size;
+		PendingOverflowBytes += Request.Size;
+	}
+	std::memcpy(Destination, Data, Request.Size);
+	Request.Data = Destination;
+}
+
+uint8* FResourceUploadQueue::ReserveStaging(uint32 Size)
+{
+	if (Staging.empty())
+	{
+		Staging.resize(InitialStagingSize);
+		Stats.StagingSize = Staging.size();
+	}
+
+	const uint64 Capacity = Staging.size();
+	if (Size > Capacity)
+	{
+		return nullptr;
+	}
+
+	// 링 끝에 통째로 들어가지 않으면 끝을 버리고 처음부터 쓴다
+	uint64 Start = WriteCursor;
+	const uint64 Position = Start % Capacity;
+	if (Position + Size > Capacity)
+	{
+		Start += Capacity - Position;
+	}
+	if (Start + Size - ReadCursor > Capacity)
+	{
+		return nullptr;
+	}
+
+	WriteCursor = Start + Size;
+	return Staging.data() + Start % Capacity;
+}
+
+void FResourceUploadQueue::Flush()
+{
+	uint64 BatchEnd = 0;
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		FlushingRequests.swap(PendingRequests);
+		BatchEnd = WriteCursor;
+	}
+
+	// 락 밖에서 실행한다. 다른 스레드는 그동안 링의 나머지 구간에 이어 쓴다
+	for (const FRequest& Request : FlushingRequests)
+	{
+		if (Request.bCreate)
+		{
+			RHIInitVertexBuffer(Request.VertexBuffer, Request.Data);
+		}
+		else
+		{
+			RHIUpdateVertexBuffer(Request.VertexBuffer, Request.Offset, Request.Data, Request.Size);
+		}
+	}
+
+	std::lock_guard<std::mutex> Lock(Mutex);
+	for (const FRequest& Request : FlushingRequests)
+	{
+		if (Request.bCreate)
+		{
+			++Stats.NumBuffersCreated;
+		}
+		else
+		{
+			++Stats.NumUpdates;
+		}
+		Stats.UploadedBytes += Request.Data ? Request.Size : 0;
+	}
+	++Stats.NumFlushes;
+	Stats.LargestBatch = std::max(Stats.LargestBatch, static_cast<uint32>(FlushingRequests.size()));
+
+	// 마지막 참조였던 버퍼는 지연 삭제 큐로 넘어간다
+	FlushingRequests.clear();
+	ReadCursor = BatchEnd;
+
+	// 넘친 만큼 링을 키운다. 비어 있을 때만 옮길 데이터가 없다
+	if (PendingOverflowBytes > 0 && ReadCursor == WriteCursor)
+	{
+		uint64 NewSize = Staging.size();
+		while (NewSize < Staging.size() + PendingOverflowBytes)
+		{
+			NewSize *= 2;
+		}
+		Staging.clear();
+		Staging.shrink_to_fit();
+		Staging.resize(NewSize);
+		ReadCursor = 0;
+		WriteCursor = 0;
+		PendingOverflowBytes = 0;
+		Stats.StagingSize = Staging.size();
+	}
+}
+
+FResourceUploadQueueStats FResourceUploadQueue::GetStats() const
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+	return Stats;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include "RHI.h"
+#include "Templates/RefCounting.h"
+#include "Templates/UnrealTypes.h"
+#include "Interface/ISingleton.h"
+
+/** What the upload queue did since startup, for stats output and sizing the staging ring. */
+struct FResourceUploadQueueStats
+{
+	uint64 NumBuffersCreated = 0;
+	uint64 NumUpdates = 0;
+	uint64 UploadedBytes = 0;
+
+	uint64 NumFlushes = 0;
+
+	/** The most requests one flush carried out. */
+	uint32 LargestBatch = 0;
+
+	uint64 StagingSize = 0;
+
+	/** Bytes that did not fit the staging ring and got an allocation of their own. */
+	uint64 OverflowBytes = 0;
+};
+
+/**
+ * Vertex buffer creation and writes, recorded by any thread and carried out
+ * in one batch by the rendering thread at the start of each frame.
+ *
+ * CreateVertexBuffer returns a buffer that has no device memory yet, so
+ * callers can hand it to components and the scene right away; the device
+ * buffer is created by the next Flush, before the frame that first draws it.
+ * Data is copied into a staging ring when the request is made, so callers may
+ * free it immediately and never touch the device. Requests are carried out in
+ * the order they were made: a buffer is always created before it is updated.
+ *
+ * Requests that do not fit the ring get an allocation of their own; the ring
+ * grows by the overflow once a flush leaves it empty.
+ */
+class FResourceUploadQueue : public ISingleton<FResourceUploadQueue>
+{
+public:
+	static constexpr uint32 InitialStagingSize = 4 * 1024 * 1024;
+
+	/**
+	 * Any thread. @return A vertex buffer of Size bytes holding a copy of Data (null leaves it for UpdateVertexBuffer), drawable once the next Flush ran.
+	 * Returned already referenced: a Flush on another thread may drop the request's reference before the caller could take one.
+	 */
+	TRefCountPtr<FRHIVertexBuffer> CreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage = BUF_Static);
+
+	/** Any thread. Writes a copy of Size bytes of Data to Offset of a BUF_Static buffer created without data, with the next Flush. */
+	void UpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size);
+
+	/** Rendering thread, at frame start. Carries out every request made since the last call, in order. */
+	void Flush();
+
+	FResourceUploadQueueStats GetStats() const;
+
+private:
+	friend class ISingleton<FResourceUploadQueue>;
+	FResourceUploadQueue() = default;
+
+	struct FRequest
+	{
+		/** Held so a buffer its creator dropped right away still exists when the request runs. */
+		TRefCountPtr<FRHIVertexBuffer> VertexBuffer;
+		bool bCreate = false;
+		uint32 Offset = 0;
+		uint32 Size = 0;
+
+		/** In the staging ring or OverflowData; null for a buffer created without data. */
+		const uint8* Data = nullptr;
+		std::unique_ptr<uint8[]> OverflowData;
+	};
+
+	/** Copies Data into the ring, or into an allocation of Request's own when the ring is full. Expects Mutex held. */
+	void StageData(FRequest& Request, const void* Data);
+
+	/** @return Size contiguous bytes of the ring, or null when they would overwrite data not flushed yet. Expects Mutex held. */
+	uint8* ReserveStaging(uint32 Size);
+
+private:
+	/** Guards everything below except FlushingRequests. */
+	mutable std::mutex Mutex;
+
+	TArray<FRequest> PendingRequests;
+
+	/** Rendering thread only; kept to reuse its allocation. */
+	TArray<FRequest> FlushingRequests;
+
+	/**
+	 * Staging ring. The cursors count bytes since the ring was last resized;
+	 * everything between ReadCursor and WriteCursor is still needed by a
+	 * pending or flushing request.
+	 */
+	TArray<uint8> Staging;
+	uint64 ReadCursor = 0;
+	uint64 WriteCursor = 0;
+
+	/** Overflow bytes since the ring last grew. */
+	uint64 PendingOverflowBytes = 0;
+
+	FResourceUploadQueueStats Stats;
+};
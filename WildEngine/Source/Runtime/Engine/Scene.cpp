@@ -1,7 +1,7 @@
 ﻿#include "Scene.h"
 
-#include "DirectXMath.h"
-#include "Renderer/URenderer.h"
+#include <algorithm>
+#include <cmath>
 
 #include "Components/CameraComponent.h"
 #include "Components/CubeComponent.h"
@@ -12,10 +12,14 @@
 #include "Math/Matrix.h"
 #include "Types/CommonTypes.h"
 #include "Object/ObjectFactory.h"
+#include "Algo/RadixSort.h"
+#include "DebugDraw.h"
+#include "VertexBufferArena.h"
 
-UScene::UScene(Renderer* InRenderer)
+UScene::UScene(URenderer* InRenderer, const FSceneViewport& InViewport)
 {
     Renderer = InRenderer;
+    Viewport = InViewport;
     Initialize();
 }
 
@@ -33,8 +37,30 @@ void UScene::OnMouseClink(int32 ScreenX, int32 ScreenY)
     FVector RayOrigin = PrimaryCamera->GetPosition();
     FVector RayDirection = PrimaryCamera->GetRayDirection(ScreenX, ScreenY);
 
+    // 선택된 오브젝트의 기즈모 핸들이 먼저: 맞으면 선택은 그대로 두고 축만 잡는다
+    if (SelectedObject)
+    {
+        float GizmoDistance = 0.0f;
+        const EGizmoAxis Axis = SceneGizmo->PickAxis(SelectedObject->GetWorldTransform(), RayOrigin, RayDirection, GizmoDistance);
+        SceneGizmo->SetActiveAxis(Axis);
+        if (Axis != EGizmoAxis::None)
+        {
+            LastPickRayOrigin = RayOrigin;
+            LastPickRayEnd = RayOrigin + RayDirection * GizmoDistance;
+            bLastPickRayHit = true;
+            return;
+        }
+    }
+
     FHitResult HitResult;
-    if (RayCast(RayOrigin, RayDirection, HitResult))
+    const bool bHit = RayCast(RayOrigin, RayDirection, HitResult);
+
+    // 피킹 광선 시각화용으로 보관 (맞지 않았으면 적당히 멀리까지)
+    LastPickRayOrigin = RayOrigin;
+    LastPickRayEnd = RayOrigin + RayDirection * (bHit ? HitResult.Distance : 1000.0f);
+    bLastPickRayHit = bHit;
+
+    if (bHit)
     {
         // 선택된 오브젝트 설정
         SelectedObject = HitResult.HitObject;
@@ -66,7 +92,11 @@ void UScene::Initialize()
             FDebugConsole::DebugPrint("CameraComponent class selected!");
         }
     }
-    PrimaryCamera->SetViewportSize(Renderer->ViewportInfo.Width, Renderer->ViewportInfo.Height);
+    PrimaryCamera->SetViewportSize(Viewport.Width, Viewport.Height);
+
+    // 뷰 0은 주 카메라. 행렬은 Tick마다 채운다
+    Views.emplace_back();
+    Views[0].bActive = true;
 
      //Test Cube
     if (Cube1 == nullptr)
@@ -81,14 +111,14 @@ void UScene::Initialize()
     if (Cube2 == nullptr)
     {
         Cube2 = new UCubeComponent(Renderer);
-        Cube2->RelativeLocation = FVector(5.f, 0.f, 0.f);
-        Cube2->RelativeScale3D = FVector(2.f, 2.f, 2.f);
+        Cube2->SetRelativeLocation(FVector(5.f, 0.f, 0.f));
+        Cube2->SetRelativeScale3D(FVector(2.f, 2.f, 2.f));
     }
 
     if (Triangle1 == nullptr)
     {
         Triangle1 = new UTriangleComponent(Renderer);
-        Triangle1->RelativeLocation = FVector(-2.f, 0.f, 0.f);
+        Triangle1->SetRelativeLocation(FVector(-2.f, 0.f, 0.f));
     }
 
     // Test Sphere
@@ -96,9 +126,9 @@ void UScene::Initialize()
     {
         //Sphere1 = ObjFactory.ConstructObject<USphereComponent>(USphereComponent::GetClass(), Renderer);
 		Sphere1 = new USphereComponent(Renderer);
-        Sphere1->RelativeLocation = FVector(10.0f, 0.0f, 0.0f);
-        Sphere1->RelativeRotation = FVector(0.f, 0.f, 0.f);
-        Sphere1->RelativeScale3D = FVector(1.f, 1.f, 1.f);
+        Sphere1->SetRelativeLocation(FVector(10.0f, 0.0f, 0.0f));
+        Sphere1->SetRelativeRotation(FVector(0.f, 0.f, 0.f));
+        Sphere1->SetRelativeScale3D(FVector(1.f, 1.f, 1.f));
     }
     
     if (SceneGizmo == nullptr)
@@ -119,17 +149,28 @@ void UScene::Initialize()
     OrthoMatrix = CreateOrthogonalView(); // XMMatrixOrthographicLH((float)screenWidth, (float)screenHeight, screenNear, screenDepth);
 }
 
+void UScene::SetViewport(const FSceneViewport& InViewport)
+{
+    // 최소화된 창은 0x0으로 오므로 이전 크기를 유지한다
+    if (InViewport.Width <= 0.0f || InViewport.Height <= 0.0f)
+    {
+        return;
+    }
+
+    Viewport = InViewport;
+    PrimaryCamera->SetViewportSize(Viewport.Width, Viewport.Height);
+    OrthoMatrix = CreateOrthogonalView();
+}
+
 FMatrix UScene::CreateProjectionView()
 {
-    D3D11_VIEWPORT ViewPort = Renderer->ViewportInfo;
-    float ScreenAspect = ViewPort.Width / ViewPort.Height; // 화면 비율 ex 1280x1080 = 1.18...
+    float ScreenAspect = Viewport.Width / Viewport.Height; // 화면 비율 ex 1280x1080 = 1.18...
     float FarZ = PrimaryCamera->FarZ;
     float NearZ = PrimaryCamera->NearZ;
 
-    float SinFov;
-    float CosFov;
-    float ToRadian = DirectX::XMConvertToRadians(0.5 * PrimaryCamera->FieldOfView);
-    DirectX::XMScalarSinCos(&SinFov, &CosFov, ToRadian);
+    float ToRadian = FMath::DegreesToRadians(0.5f * PrimaryCamera->FieldOfView);
+    float SinFov = std::sin(ToRadian);
+    float CosFov = std::cos(ToRadian);
 
     // 0~1 사이의 정규화된 값으로 Height와 width가 표현되어야함
     float Height = CosFov / SinFov; // tan(0.5*FOV);
@@ -150,10 +191,8 @@ FMatrix UScene::CreateProjectionView()
 
 FMatrix UScene::CreateOrthogonalView()
 {
-    D3D11_VIEWPORT ViewPort = Renderer->ViewportInfo;
-
-    float Width = ViewPort.Width;
-    float Height = ViewPort.Height;
+    float Width = Viewport.Width;
+    float Height = Viewport.Height;
 
     float FarZ = PrimaryCamera->FarZ;
     float NearZ = PrimaryCamera->NearZ;
@@ -177,22 +216,19 @@ bool UScene::RayCast(FVector RayOrigin, FVector RayDirection, FHitResult& OutHit
 
     OutHitResult = FHitResult();
 
-    // 모든 Primitive를 순회하며 충돌 검사
-    for (uint32 i = 0; i < GUObjectArray.size(); i++)
+    // 씬에 등록된 Primitive만 순회하며 충돌 검사
+    for (uint32 ProxyId = 0; ProxyId < PrimitiveProxies.Num(); ProxyId++)
     {
         FHitResult TempHit;
-        if (UPrimitiveComponent* Primitive = dynamic_cast<UPrimitiveComponent*>(GUObjectArray[i]))
+        if (UPrimitiveComponent* Primitive = PrimitiveProxies.GetComponent(ProxyId))
         {
-            if (Primitive)
+            if(Primitive->CheckRayIntersection(RayOrigin, RayDirection, TempHit))
             {
-                if(Primitive->CheckRayIntersection(RayOrigin, RayDirection, TempHit))
+                if (TempHit.Distance < MinDistance)
                 {
-                    if (TempHit.Distance < MinDistance)
-                    {
-                        MinDistance = TempHit.Distance;
-                        OutHitResult = TempHit;
-                        bHasHit = true;
-                    }
+                    MinDistance = TempHit.Distance;
+                    OutHitResult = TempHit;
+                    bHasHit = true;
                 }
             }
         }
@@ -240,8 +276,261 @@ bool UScene::RayCast(FVector RayOrigin, FVector RayDirection, FHitResult& OutHit
     //  return bHasHit;
 }
 
-void UScene::Render()
+void UScene::UpdateHierarchy()
+{
+    // 생성/삭제/부착이 있었던 프레임에만 레벨 순서와 프록시 배열을 다시 만든다
+    if (Hierarchy.IsDirty())
+    {
+        Hierarchy.Rebuild(GUObjectArray);
+        RebuildPrimitiveProxies();
+    }
+
+    Hierarchy.UpdateTransforms();
+    DefragmentMeshBuffers();
+    UpdatePrimitiveProxies();
+}
+
+uint32 UScene::AcquireMesh(const FStaticMesh* StaticMesh)
+{
+    auto It = MeshIdsByAllocation.find(StaticMesh->Allocation.GetReference());
+    if (It != MeshIdsByAllocation.end())
+    {
+        ++Meshes[It->second].NumRefs;
+        return It->second;
+    }
+
+    // 참조가 모두 빠진 메시의 id를 다시 써서 Meshes가 계속 자라지 않게 한다
+    uint32 MeshId = static_cast<uint32>(Meshes.size());
+    if (!FreeMeshIds.empty())
+    {
+        MeshId = FreeMeshIds.back();
+        FreeMeshIds.pop_back();
+    }
+    else
+    {
+        Meshes.emplace_back();
+    }
+    Meshes[MeshId] = { StaticMesh->GetVertexBuffer(), StaticMesh->GetFirstVertex(), StaticMesh->NumVertices, StaticMesh->SourceVertices };
+    Meshes[MeshId].Allocation = StaticMesh->Allocation.GetReference();
+    Meshes[MeshId].NumRefs = 1;
+    MeshIdsByAllocation[Meshes[MeshId].Allocation] = MeshId;
+
+    // LOD도 씬 메시로, 이 메시가 참조를 하나씩 잡는다. 등록하면서 Meshes가 커질 수 있으므로 모은 뒤에 넣는다
+    TArray<FSceneMeshLOD> LODs;
+    for (const FStaticMeshLOD& LOD : StaticMesh->LODs)
+    {
+        LODs.push_back({ AcquireMesh(LOD.Mesh), LOD.MaxScreenRadius });
+    }
+    Meshes[MeshId].LODs = std::move(LODs);
+    return MeshId;
+}
+
+void UScene::ReleaseMesh(uint32 MeshId)
+{
+    FSceneMesh& Mesh = Meshes[MeshId];
+    if (--Mesh.NumRefs > 0)
+    {
+        return;
+    }
+
+    MeshIdsByAllocation.erase(Mesh.Allocation);
+    const TArray<FSceneMeshLOD> LODs = std::move(Mesh.LODs);
+    Mesh = FSceneMesh();
+    FreeMeshIds.push_back(MeshId);
+    for (const FSceneMeshLOD& LOD : LODs)
+    {
+        ReleaseMesh(LOD.MeshId);
+    }
+}
+
+uint32 FSceneMesh::SelectLOD(float ScreenRadius, uint32 CurrentLevel) const
 {
+    // 반지름이 임계값보다 작은 LOD 중 가장 성긴 것
+    uint32 TargetLevel = 0;
+    while (TargetLevel < LODs.size() && ScreenRadius < LODs[TargetLevel].MaxScreenRadius)
+    {
+        ++TargetLevel;
+    }
+    if (TargetLevel == CurrentLevel || CurrentLevel > LODs.size())
+    {
+        return TargetLevel;
+    }
+
+    // 현재 레벨의 반지름 구간을 조금 넓혀서 그 안이면 바꾸지 않는다
+    const float Lower = CurrentLevel < LODs.size() ? LODs[CurrentLevel].MaxScreenRadius : 0.0f;
+    const bool bAboveLower = ScreenRadius >= Lower * (1.0f - LODHysteresis);
+    const bool bBelowUpper = CurrentLevel == 0 || ScreenRadius < LODs[CurrentLevel - 1].MaxScreenRadius * (1.0f + LODHysteresis);
+    return bAboveLower && bBelowUpper ? CurrentLevel : TargetLevel;
+}
+
+void UScene::DefragmentMeshBuffers()
+{
+    // 조각화는 천천히 쌓이므로 매 프레임 검사할 필요가 없다
+    if (++FramesSinceMeshDefragment < MeshDefragmentInterval)
+    {
+        return;
+    }
+    FramesSinceMeshDefragment = 0;
+
+    MovedMeshAllocations.clear();
+    FVertexBufferArena::GetInst().Defragment(MovedMeshAllocations);
+
+    // 프록시는 메시 id로 그리므로 옮겨진 씬 메시만 새 구간을 가리키면 된다. 컴포넌트를 더티로 만들지 않아 병합된 프리미티브도 그대로다
+    // 옛 구간은 이전 프레임들이 끝난 뒤 풀린다
+    for (const FVertexBufferAllocation* Allocation : MovedMeshAllocations)
+    {
+        auto It = MeshIdsByAllocation.find(Allocation);
+        if (It != MeshIdsByAllocation.end())
+        {
+            Meshes[It->second].VertexBuffer = Allocation->GetVertexBuffer();
+            Meshes[It->second].FirstVertex = Allocation->GetFirstVertex();
+        }
+    }
+}
+
+void UScene::RebuildPrimitiveProxies()
+{
+    PrimitiveProxies.Reset();
+    Meshes.clear();
+    FreeMeshIds.clear();
+    MeshIdsByAllocation.clear();
+
+    // 재구성 시 모든 컴포넌트 상태를 새로 읽으므로 대기 중인 갱신은 버린다
+    UPrimitiveComponent::ConsumeRenderStateDirtyList(RenderStateUpdates);
+
+    NodeProxyIds.assign(Hierarchy.Num(), INDEX_NONE);
+    for (uint32 Node = 0; Node < Hierarchy.Num(); ++Node)
+    {
+        UPrimitiveComponent* Primitive = dynamic_cast<UPrimitiveComponent*>(Hierarchy.GetComponent(Node));
+        if (!Primitive)
+        {
+            continue;
+        }
+
+        const uint32 MeshId = AcquireMesh(Primitive->GetStaticMesh());
+        Primitive->SceneProxyId = PrimitiveProxies.Add(Primitive, MeshId, Primitive->GetLocalBounds(), Primitive->GetSceneProxyFlags());
+        NodeProxyIds[Node] = Primitive->SceneProxyId;
+
+        if (Primitive->MergedGroupId != INDEX_NONE)
+        {
+            MergedPrimitives.push_back(Primitive);
+        }
+    }
+
+    // 파괴된 컴포넌트를 병합 그룹에서 빼고, 남은 멤버는 개별로 그리지 않도록 표시
+    MergedStaticMeshes.RemoveDestroyedMembers(MergedPrimitives);
+    for (UPrimitiveComponent* Primitive : MergedPrimitives)
+    {
+        if (Primitive->MergedGroupId != INDEX_NONE)
+        {
+            PrimitiveProxies.SetFlags(Primitive->SceneProxyId, Primitive->GetSceneProxyFlags() | PSF_Merged);
+        }
+    }
+    MergedPrimitives.clear();
+}
+
+void UScene::MergeStaticMeshes()
+{
+    bMergeStaticMeshesRequested = false;
+
+    // 보이는 정적 프리미티브 중 아직 병합되지 않은 것만, 현재 월드 행렬로 굽는다
+    MergeCandidates.clear();
+    for (uint32 ProxyId = 0; ProxyId < PrimitiveProxies.Num(); ++ProxyId)
+    {
+        UPrimitiveComponent* Primitive = PrimitiveProxies.GetComponent(ProxyId);
+        if (Primitive->Mobility == EComponentMobility::Static && Primitive->MergedGroupId == INDEX_NONE &&
+            Primitive->IsVisible() && Primitive->GetStaticMesh() && !(PrimitiveProxies.GetFlags(ProxyId) & PSF_LineList))
+        {
+            MergeCandidates.push_back({ Primitive, PrimitiveProxies.GetWorldMatrix(ProxyId) });
+        }
+    }
+
+    if (MergeCandidates.empty())
+    {
+        return;
+    }
+
+    MergedStaticMeshes.Merge(MergeCandidates);
+    for (const FMergeCandidate& Candidate : MergeCandidates)
+    {
+        PrimitiveProxies.SetFlags(Candidate.Component->SceneProxyId, PrimitiveProxies.GetFlags(Candidate.Component->SceneProxyId) | PSF_Merged);
+    }
+}
+
+void UScene::DrawLineListProxy(uint32 ProxyId)
+{
+    const FSceneMesh& Mesh = Meshes[PrimitiveProxies.GetMeshId(ProxyId)];
+    if (!Mesh.SourceVertices)
+    {
+        return;
+    }
+
+    // 정점 두 개가 선 하나. 선 색은 시작 정점의 색
+    const FMatrix& LineWorldMatrix = PrimitiveProxies.GetWorldMatrix(ProxyId);
+    for (uint32 Index = 0; Index + 1 < Mesh.NumVertices; Index += 2)
+    {
+        const FVertexType& Start = Mesh.SourceVertices[Index];
+        const FVertexType& End = Mesh.SourceVertices[Index + 1];
+        DrawDebugLine(LineWorldMatrix.TransformPosition(FVector(Start.x, Start.y, Start.z)), LineWorldMatrix.TransformPosition(FVector(End.x, End.y, End.z)), FVector(Start.r, Start.g, Start.b));
+    }
+}
+
+void UScene::SplitOutMergedPrimitive(UPrimitiveComponent* Primitive)
+{
+    // 한 번 움직이거나 편집된 오브젝트는 다시 병합하지 않는다
+    MergedStaticMeshes.SplitOut(Primitive);
+    Primitive->Mobility = EComponentMobility::Movable;
+    PrimitiveProxies.SetFlags(Primitive->SceneProxyId, Primitive->GetSceneProxyFlags());
+}
+
+void UScene::UpdatePrimitiveProxies()
+{
+    // 월드 행렬이 실제로 바뀐 노드만 프록시에 복사
+    for (uint32 Node : Hierarchy.GetChangedNodes())
+    {
+        const int32 ProxyId = NodeProxyIds[Node];
+        if (ProxyId != INDEX_NONE)
+        {
+            PrimitiveProxies.UpdateTransform(ProxyId, Hierarchy.GetWorldTransform(Node));
+
+            // 재구성 직후에는 모든 노드가 바뀐 것으로 보고되므로 구운 행렬과 비교해 실제로 움직였을 때만 분리
+            UPrimitiveComponent* Primitive = PrimitiveProxies.GetComponent(ProxyId);
+            if (Primitive->MergedGroupId != INDEX_NONE && !MergedStaticMeshes.IsAtBakedTransform(Primitive, Hierarchy.GetWorldTransform(Node)))
+            {
+                SplitOutMergedPrimitive(Primitive);
+            }
+        }
+    }
+
+    // 가시성/메시가 바뀐 컴포넌트
+    UPrimitiveComponent::ConsumeRenderStateDirtyList(RenderStateUpdates);
+    for (UPrimitiveComponent* Primitive : RenderStateUpdates)
+    {
+        if (Primitive->SceneProxyId != INDEX_NONE)
+        {
+            if (Primitive->MergedGroupId != INDEX_NONE)
+            {
+                SplitOutMergedPrimitive(Primitive);
+            }
+
+            // 같은 메시면 놓았다 다시 등록하지 않도록 새 메시를 먼저 잡는다
+            const uint32 MeshId = AcquireMesh(Primitive->GetStaticMesh());
+            ReleaseMesh(PrimitiveProxies.GetMeshId(Primitive->SceneProxyId));
+            PrimitiveProxies.UpdateRenderState(Primitive->SceneProxyId, MeshId, Primitive->GetLocalBounds(), Primitive->GetSceneProxyFlags());
+        }
+    }
+}
+
+void UScene::Tick()
+{
+    // 부모-자식 관계를 반영한 월드 행렬 갱신 (피킹, 렌더링 전에 수행)
+    UpdateHierarchy();
+
+    if (bMergeStaticMeshesRequested)
+    {
+        MergeStaticMeshes();
+    }
+
     // 카메라 위치에서 뷰 행렬 생성
     PrimaryCamera->Render();
 
@@ -251,6 +540,9 @@ void UScene::Render()
     // 투영 행렬 가져오기 (ortho or pers)
     ProjectionMatrix = PrimaryCamera->bIsOrthogonal ? CreateOrthogonalView() : CreateProjectionView();
 
+    Views[0].ViewMatrix = ViewMatrix;
+    Views[0].ProjectionMatrix = ProjectionMatrix;
+
     // 마우스 클릭시 오브젝트 선택
     if (FInputManager::GetInst().GetKey(VK_LBUTTON) == EKeyState::Pressed ||
         FInputManager::GetInst().GetKey(VK_LBUTTON) == EKeyState::Held)
@@ -258,25 +550,150 @@ void UScene::Render()
         OnMouseClink(FInputManager::GetInst().GetMouseX(), FInputManager::GetInst().GetMouseY());
     }
 
-    // 선택된 오브젝트가 있는 경우
+    SceneGizmo->Tick();
+}
+
+void UScene::BuildFramePacket(FFramePacket& OutPacket)
+{
+    OutPacket.View.ViewMatrix = ViewMatrix;
+    OutPacket.View.ProjectionMatrix = ProjectionMatrix;
+
+    // 활성 뷰의 절두체를 모아 한 번에 컬링한다. 프록시 바운드는 뷰 수와 상관없이 한 번만 읽는다 (UObject 메모리는 건드리지 않음)
+    ViewFrusta.clear();
+    for (FSceneView& View : Views)
+    {
+        View.CullingBit = INDEX_NONE;
+        if (View.bActive && ViewFrusta.size() < MaxCullingViews)
+        {
+            View.CullingBit = static_cast<int32>(ViewFrusta.size());
+            ViewFrusta.emplace_back(View.ViewMatrix * View.ProjectionMatrix);
+        }
+    }
+    PrimitiveProxies.ComputeViewVisibility(ViewFrusta, ProxyViewMasks);
+
+    // 이 패킷은 주 카메라가 보는 프록시만 그린다
+    FPrimitiveSceneProxies::GetVisibleProxies(ProxyViewMasks, Views[0].CullingBit, VisibleProxies);
+
+    // 가까운 큰 불투명 프록시를 CPU 깊이 버퍼에 그려서 그 뒤에 완전히 가려진 프록시를 뺀다
+    if (bOcclusionCulling)
+    {
+        SoftwareOcclusion.Process(PrimitiveProxies, Meshes, ViewMatrix, ViewMatrix * ProjectionMatrix, VisibleProxies);
+    }
+
+    // 드로우마다 정렬 키를 만들고 기수 정렬: 상태(패스/셰이더/메시)가 같은 드로우가 붙고 그 안에서는 앞에서 뒤로
+    auto GetViewDepth = [this](const FVector& Location)
+    {
+        return Location.X * ViewMatrix.M[0][2] + Location.Y * ViewMatrix.M[1][2] + Location.Z * ViewMatrix.M[2][2] + ViewMatrix.M[3][2];
+    };
+
+    // 바운드 구가 화면에서 차지하는 반지름(픽셀). 원근이면 w가 깊이, 직교면 1이다
+    const float PixelsPerUnit = ProjectionMatrix.M[1][1] * 0.5f * Viewport.Height;
+    auto GetScreenRadius = [this, PixelsPerUnit](const FPrimitiveBounds& Bounds, float ViewDepth)
+    {
+        const float W = ViewDepth * ProjectionMatrix.M[2][3] + ProjectionMatrix.M[3][3];
+        return W > 0.0f ? Bounds.SphereRadius * PixelsPerUnit / W : 0.0f;
+    };
+
+    float MaxDepth = 0.0f;
+    for (uint32 ProxyId : VisibleProxies)
+    {
+        MaxDepth = std::max(MaxDepth, GetViewDepth(PrimitiveProxies.GetBounds(ProxyId).Origin));
+    }
+    const float InvMaxDepth = MaxDepth > 0.0f ? 1.0f / MaxDepth : 0.0f;
+
+    // 병합된 정적 메시는 그룹 단위로 컬링해서 먼저 그린다
+    MergedStaticMeshes.GatherDraws(ViewFrusta[Views[0].CullingBit], OutPacket.MeshBatches, OutPacket.Instances);
+    const uint32 NumMergedBatches = static_cast<uint32>(OutPacket.MeshBatches.size());
+    const uint32 InstanceBase = static_cast<uint32>(OutPacket.Instances.size());
+
+    DrawSortKeys.clear();
+    SortedProxies.clear();
+    DrawSortStats = FDrawSortStats();
+    uint64 PreviousState = ~0ull;
+    for (uint32 ProxyId : VisibleProxies)
+    {
+        if (PrimitiveProxies.GetFlags(ProxyId) & PSF_Merged)
+        {
+            continue;
+        }
+
+        // 선 목록 메시는 삼각형 목록으로 그리는 배치에 넣지 않는다
+        if (PrimitiveProxies.GetFlags(ProxyId) & PSF_LineList)
+        {
+            DrawLineListProxy(ProxyId);
+            continue;
+        }
+
+        const EDrawPass Pass = (PrimitiveProxies.GetFlags(ProxyId) & PSF_Translucent) ? EDrawPass::Translucent : EDrawPass::Opaque;
+        const FPrimitiveBounds& Bounds = PrimitiveProxies.GetBounds(ProxyId);
+        const float ViewDepth = GetViewDepth(Bounds.Origin);
+
+        // 작게 보이는 메시는 성긴 LOD로 그린다. 같은 LOD끼리 한 배치로 묶인다
+        uint32 MeshId = PrimitiveProxies.GetMeshId(ProxyId);
+        const FSceneMesh& Mesh = Meshes[MeshId];
+        if (bMeshLOD && !Mesh.LODs.empty())
+        {
+            const uint32 LODLevel = ViewDepth > 0.0f ? Mesh.SelectLOD(GetScreenRadius(Bounds, ViewDepth), PrimitiveProxies.GetLODLevel(ProxyId)) : 0;
+            PrimitiveProxies.SetLODLevel(ProxyId, LODLevel);
+            MeshId = Mesh.GetLODMeshId(MeshId, LODLevel);
+        }
+
+        const uint64 Key = FDrawSortKey::Make(Pass, 0, MeshId, ViewDepth * InvMaxDepth);
+
+        // 정렬하지 않았을 때의 상태 변경 수 (통계용)
+        if (FDrawSortKey::GetStateBits(Key) != PreviousState)
+        {
+            PreviousState = FDrawSortKey::GetStateBits(Key);
+            ++DrawSortStats.NumStateChangesUnsorted;
+        }
+
+        DrawSortKeys.push_back(Key);
+        SortedProxies.push_back(ProxyId);
+    }
+
+    RadixSort64(DrawSortKeys, SortedProxies, DrawSortKeysTemp, SortedProxiesTemp);
+
+    // 키 순서대로 인스턴스를 채우고 상태가 같은 구간마다 배치 하나
+    OutPacket.Instances.resize(InstanceBase + SortedProxies.size());
+    PreviousState = ~0ull;
+    for (uint32 Index = 0; Index < SortedProxies.size(); ++Index)
+    {
+        const uint32 ProxyId = SortedProxies[Index];
+        OutPacket.Instances[InstanceBase + Index].WorldMatrix = PrimitiveProxies.GetWorldMatrix(ProxyId);
+
+        const uint64 State = FDrawSortKey::GetStateBits(DrawSortKeys[Index]);
+        if (State != PreviousState)
+        {
+            PreviousState = State;
+            const FSceneMesh& Mesh = Meshes[FDrawSortKey::GetMeshId(DrawSortKeys[Index])];
+            OutPacket.MeshBatches.push_back({ Mesh.VertexBuffer, Mesh.FirstVertex, Mesh.NumVertices, InstanceBase + Index, 0 });
+        }
+        ++OutPacket.MeshBatches.back().NumInstances;
+    }
+
+    DrawSortStats.NumDraws = static_cast<uint32>(SortedProxies.size());
+    DrawSortStats.NumStateChanges = static_cast<uint32>(OutPacket.MeshBatches.size()) - NumMergedBatches;
+
+    // 선택된 오브젝트가 있는 경우 기즈모는 마지막에 그린다
     if (SelectedObject)
     {
-        // 기즈모 렌더링
-        SceneGizmo->Render(SelectedObject->GetWorldTransform(), ViewMatrix, ProjectionMatrix);
+        SceneGizmo->GatherDrawCommands(SelectedObject->GetWorldTransform(), OutPacket);
     }
 
-    // Object array 렌더링
-    for (uint32 i = 0; i < GUObjectArray.size(); i++)
+    if (bShowBounds)
     {
-        if (UPrimitiveComponent* Primitive = dynamic_cast<UPrimitiveComponent*>(GUObjectArray[i]))
+        for (uint32 ProxyId : VisibleProxies)
         {
-            if (Primitive)
-            {
-                Primitive->Render(WorldMatrix, ViewMatrix, ProjectionMatrix);
-            }
+            DrawDebugBounds(PrimitiveProxies.GetBounds(ProxyId), FVector(0.0f, 1.0f, 0.0f));
         }
     }
+    if (bShowPickRay)
+    {
+        DrawDebugLine(LastPickRayOrigin, LastPickRayEnd, bLastPickRayHit ? FVector(1.0f, 0.0f, 0.0f) : FVector(1.0f, 1.0f, 0.0f));
+    }
 
+    // 이번 프레임에 쌓인 DrawDebug* 정점을 패킷으로 넘긴다
+    FDebugDrawQueue::GetInst().MoveToPacket(OutPacket);
 }
 
 USceneComponent* UScene::GetSelectedObject()
@@ -307,6 +724,66 @@ UCameraComponent* UScene::GetPrimaryCamera()
     return PrimaryCamera;
 }
 
+int32 UScene::AddView(const FMatrix& InViewMatrix, const FMatrix& InProjectionMatrix)
+{
+    // 지운 뷰 자리를 다시 써서 다른 뷰의 인덱스는 그대로 둔다
+    int32 ViewIndex = INDEX_NONE;
+    for (int32 Index = 1; Index < static_cast<int32>(Views.size()); ++Index)
+    {
+        if (!Views[Index].bActive)
+        {
+            ViewIndex = Index;
+            break;
+        }
+    }
+    if (ViewIndex == INDEX_NONE)
+    {
+        // 마스크 한 비트에 뷰 하나
+        if (Views.size() >= MaxCullingViews)
+        {
+            return INDEX_NONE;
+        }
+        ViewIndex = static_cast<int32>(Views.size());
+        Views.emplace_back();
+    }
+
+    FSceneView& View = Views[ViewIndex];
+    View.ViewMatrix = InViewMatrix;
+    View.ProjectionMatrix = InProjectionMatrix;
+    View.bActive = true;
+    View.CullingBit = INDEX_NONE;
+    return ViewIndex;
+}
+
+void UScene::SetView(int32 ViewIndex, const FMatrix& InViewMatrix, const FMatrix& InProjectionMatrix)
+{
+    // 뷰 0은 Tick이 주 카메라에서 채운다
+    if (ViewIndex > 0 && ViewIndex < static_cast<int32>(Views.size()) && Views[ViewIndex].bActive)
+    {
+        Views[ViewIndex].ViewMatrix = InViewMatrix;
+        Views[ViewIndex].ProjectionMatrix = InProjectionMatrix;
+    }
+}
+
+void UScene::RemoveView(int32 ViewIndex)
+{
+    if (ViewIndex > 0 && ViewIndex < static_cast<int32>(Views.size()))
+    {
+        Views[ViewIndex].bActive = false;
+        Views[ViewIndex].CullingBit = INDEX_NONE;
+    }
+}
+
+void UScene::GetVisibleProxies(int32 ViewIndex, TArray<uint32>& OutVisibleProxies) const
+{
+    if (ViewIndex < 0 || ViewIndex >= static_cast<int32>(Views.size()) || Views[ViewIndex].CullingBit == INDEX_NONE)
+    {
+        OutVisibleProxies.clear();
+        return;
+    }
+    FPrimitiveSceneProxies::GetVisibleProxies(ProxyViewMasks, static_cast<uint32>(Views[ViewIndex].CullingBit), OutVisibleProxies);
+}
+
 void UScene::CreateNewObject(FString ObjectType, int Count)
 {
     if (Count <= 0) return;
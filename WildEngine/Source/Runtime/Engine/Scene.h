@@ -3,6 +3,12 @@
 #include "Math/Matrix.h"
 #include "Interface/IScene.h"
 #include "Object/ObjectManager.h"
+#include "SceneHierarchy.h"
+#include "PrimitiveSceneProxy.h"
+#include "FramePacket.h"
+#include "DrawSortKey.h"
+#include "MergedStaticMeshes.h"
+#include "SceneSoftwareOcclusion.h"
 
 class URenderer;
 class UObject;
@@ -11,21 +17,93 @@ class UCubeComponent;
 class USphereComponent;
 class UTriangleComponent;
 class UGizmoComponent;
+class UPrimitiveComponent;
 struct FHitResult;
+class FRHIVertexBuffer;
+class FVertexBufferAllocation;
+struct FVertexType;
+struct FStaticMesh;
+
+/** A coarser level of a scene mesh, itself a scene mesh. */
+struct FSceneMeshLOD
+{
+	uint32 MeshId = 0;
+
+	/** Projected radius, in pixels, below which this level is drawn. */
+	float MaxScreenRadius = 0.0f;
+};
+
+/** GPU mesh referenced by proxy mesh ids: a vertex range, usually of a buffer shared with other meshes. */
+struct FSceneMesh
+{
+	FRHIVertexBuffer* VertexBuffer = nullptr;
+	uint32 FirstVertex = 0;
+	uint32 NumVertices = 0;
+
+	/** CPU copy of the vertices for software occlusion; null when the mesh has none. */
+	const FVertexType* SourceVertices = nullptr;
+
+	/** Coarser levels, finest first; empty when the mesh has none. */
+	TArray<FSceneMeshLOD> LODs;
+
+	/** Arena range the mesh draws from, to find it again when defragmentation moves the range. */
+	const FVertexBufferAllocation* Allocation = nullptr;
+
+	/** Proxies and finer meshes drawing this mesh; its id is reused once none are left. */
+	uint32 NumRefs = 0;
+
+	/** Fraction of a level's radius band the radius may leave it by before another level is picked, so objects near a threshold do not pop every frame. */
+	static constexpr float LODHysteresis = 0.1f;
+
+	/** @return The level to draw at ScreenRadius pixels (0 is the mesh itself), staying at CurrentLevel while within its band plus hysteresis. */
+	uint32 SelectLOD(float ScreenRadius, uint32 CurrentLevel) const;
+
+	/** @return Mesh id of Level, given this mesh's own id. */
+	uint32 GetLODMeshId(uint32 MeshId, uint32 Level) const { return Level == 0 ? MeshId : LODs[Level - 1].MeshId; }
+};
+
+/** Pixel rectangle the scene is drawn into; the API independent counterpart of D3D11_VIEWPORT. */
+struct FSceneViewport
+{
+	float TopLeftX = 0.0f;
+	float TopLeftY = 0.0f;
+	float Width = 0.0f;
+	float Height = 0.0f;
+};
+
+/** A view culled in the same sweep as the primary camera: a split viewport, a shadow or reflection view. */
+struct FSceneView
+{
+	FMatrix ViewMatrix;
+	FMatrix ProjectionMatrix;
+	bool bActive = false;
+
+	/** Bit of the view in the proxy view masks of the last BuildFramePacket; INDEX_NONE when it was not culled. */
+	int32 CullingBit = INDEX_NONE;
+};
 
 class UScene : public IScene
 {
 public:
-	UScene(URenderer* InRenderer);
+	UScene(URenderer* InRenderer, const FSceneViewport& InViewport);
 	UScene(const UScene&);
 	~UScene();
 
-	void Render();
+	/* Game thread: input, picking, hierarchy and proxy updates */
+	void Tick();
+
+	/* Game thread: culls the proxies and records this frame's view and draws */
+	void BuildFramePacket(FFramePacket& OutPacket);
+
 	URenderer* GetRenderer() const
 	{
 		return Renderer;
 	};
 
+	/* Back buffer rectangle the projection is built for; the platform layer sets it again on resize */
+	void SetViewport(const FSceneViewport& InViewport);
+	const FSceneViewport& GetViewport() const { return Viewport; }
+
 public:
 	//////////////////////
 	/* IScene Interface */
@@ -43,9 +121,42 @@ public:
 	/* Camera */
 	UCameraComponent* GetPrimaryCamera() override;
 
+	/* Views culled together with the primary camera. View 0 is the primary camera, updated by Tick; the rest keep their index until removed */
+	int32 AddView(const FMatrix& InViewMatrix, const FMatrix& InProjectionMatrix);
+	void SetView(int32 ViewIndex, const FMatrix& InViewMatrix, const FMatrix& InProjectionMatrix);
+	void RemoveView(int32 ViewIndex);
+	const FSceneView& GetView(int32 ViewIndex) const { return Views[ViewIndex]; }
+	uint32 GetNumViews() const { return static_cast<uint32>(Views.size()); }
+
+	/* Proxies inside the frustum of a view as of the last BuildFramePacket; occlusion culling only narrows the primary view's draws */
+	void GetVisibleProxies(int32 ViewIndex, TArray<uint32>& OutVisibleProxies) const;
+	const TArray<uint32>& GetProxyViewMasks() const { return ProxyViewMasks; }
+
 	/* Construct New Object */
 	void CreateNewObject(FString ObjectType, int Count) override;
 
+	/* Bakes every unmerged static primitive into merged meshes on the next Tick */
+	void RequestMergeStaticMeshes() { bMergeStaticMeshesRequested = true; }
+	const FMergedStaticMeshes& GetMergedStaticMeshes() const { return MergedStaticMeshes; }
+
+	/* Debug visualization through DrawDebug*, toggled from the console */
+	void SetShowBounds(bool bShow) { bShowBounds = bShow; }
+	bool IsShowingBounds() const { return bShowBounds; }
+	void SetShowPickRay(bool bShow) { bShowPickRay = bShow; }
+	bool IsShowingPickRay() const { return bShowPickRay; }
+
+	/* Sort statistics of the last BuildFramePacket */
+	const FDrawSortStats& GetDrawSortStats() const { return DrawSortStats; }
+
+	/* Software occlusion culling after the frustum test, toggled by the "occlusion" console command; the stat window shows GetOcclusionStats */
+	void SetOcclusionCulling(bool bEnable) { bOcclusionCulling = bEnable; }
+	bool IsOcclusionCulling() const { return bOcclusionCulling; }
+	const FSoftwareOcclusionStats& GetOcclusionStats() const { return SoftwareOcclusion.GetStats(); }
+
+	/* Drawing meshes with LOD chains at the level their projected size calls for, toggled by the "meshlod" console command */
+	void SetMeshLOD(bool bEnable) { bMeshLOD = bEnable; }
+	bool IsUsingMeshLOD() const { return bMeshLOD; }
+
 	/* Gizmo */
 	virtual UGizmoComponent* GetGizmo() { return SceneGizmo; };
 
@@ -58,8 +169,32 @@ private:
 
 	bool RayCast(FVector RayOrigin, FVector RayDirection, FHitResult& OutHitResult);
 
+	/* Resolves attachment and world transforms for every scene component */
+	void UpdateHierarchy();
+
+	/* Render proxies */
+	void RebuildPrimitiveProxies();
+	void UpdatePrimitiveProxies();
+
+	/* Returns the id of the scene mesh drawing StaticMesh, registered together with its LODs on first use, and takes a reference to it */
+	uint32 AcquireMesh(const FStaticMesh* StaticMesh);
+
+	/* Drops a reference taken by AcquireMesh; the last one frees the id and the references to the LODs */
+	void ReleaseMesh(uint32 MeshId);
+
+	/* Lets the vertex buffer arena compact a little every MeshDefragmentInterval frames and points the scene meshes it moved at their new range */
+	void DefragmentMeshBuffers();
+
+	/* Merged static geometry */
+	void MergeStaticMeshes();
+	void SplitOutMergedPrimitive(UPrimitiveComponent* Primitive);
+
+	/* Queues the lines of a line list proxy as debug lines, since the mesh batches draw triangle lists */
+	void DrawLineListProxy(uint32 ProxyId);
+
 private:
 	URenderer* Renderer = nullptr;
+	FSceneViewport Viewport;
 	UCameraComponent* PrimaryCamera = nullptr;
 	UCubeComponent* Cube1 = nullptr;
 	USphereComponent* Sphere1 = nullptr;
@@ -70,6 +205,41 @@ private:
     TArray<UObject*>& GUObjectArray = UObjectManager::GetInst().GetObjectsArray();
 	USceneComponent* SelectedObject = nullptr;
 
+	FSceneHierarchy Hierarchy;
+
+	FPrimitiveSceneProxies PrimitiveProxies;
+	TArray<int32> NodeProxyIds; // Hierarchy node -> proxy id
+	TArray<FSceneMesh> Meshes;
+	TArray<uint32> FreeMeshIds;
+	TMap<const FVertexBufferAllocation*, uint32> MeshIdsByAllocation;
+	TArray<const FVertexBufferAllocation*> MovedMeshAllocations;
+	static constexpr uint32 MeshDefragmentInterval = 30;
+	uint32 FramesSinceMeshDefragment = 0;
+	TArray<FSceneView> Views;
+	TArray<FViewFrustum> ViewFrusta;
+	TArray<uint32> ProxyViewMasks; // Proxy id -> bit per culled view
+	TArray<uint32> VisibleProxies;
+	TArray<uint64> DrawSortKeys;
+	TArray<uint32> SortedProxies;
+	TArray<uint64> DrawSortKeysTemp;
+	TArray<uint32> SortedProxiesTemp;
+	FDrawSortStats DrawSortStats;
+	FSceneSoftwareOcclusion SoftwareOcclusion;
+	bool bOcclusionCulling = true;
+	bool bMeshLOD = true;
+
+	FMergedStaticMeshes MergedStaticMeshes;
+	TArray<FMergeCandidate> MergeCandidates;
+	TArray<UPrimitiveComponent*> MergedPrimitives;
+	bool bMergeStaticMeshesRequested = false;
+	TArray<UPrimitiveComponent*> RenderStateUpdates;
+
+	bool bShowBounds = false;
+	bool bShowPickRay = false;
+	FVector LastPickRayOrigin = FVector(0.0f, 0.0f, 0.0f);
+	FVector LastPickRayEnd = FVector(0.0f, 0.0f, 0.0f);
+	bool bLastPickRayHit = false;
+
 	FMatrix WorldMatrix;
 	FMatrix ViewMatrix;
 	FMatrix ProjectionMatrix;
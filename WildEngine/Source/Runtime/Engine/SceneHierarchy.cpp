@@ -0,0 +1,155 @@
+#include "SceneHierarchy.h"
+
+#include <cstring>
+
+#include "Async/ParallelFor.h"
+#include "Components/SceneComponent.h"
+
+void FSceneHierarchy::Rebuild(const TArray<UObject*>& Objects)
+{
+	Components.clear();
+	ParentIndices.clear();
+	LevelStarts.clear();
+
+	// Level 0: 부모가 없는 루트 컴포넌트
+	for (UObject* Object : Objects)
+	{
+		USceneComponent* Component = dynamic_cast<USceneComponent*>(Object);
+		if (Component && Component->GetAttachParent() == nullptr)
+		{
+			Components.push_back(Component);
+			ParentIndices.push_back(INDEX_NONE);
+		}
+	}
+
+	// 이전 레벨의 자식들을 이어 붙이며 너비 우선으로 펼친다
+	uint32 LevelBegin = 0;
+	while (LevelBegin < Components.size())
+	{
+		const uint32 LevelEnd = static_cast<uint32>(Components.size());
+		LevelStarts.push_back(LevelBegin);
+
+		for (uint32 ParentIndex = LevelBegin; ParentIndex < LevelEnd; ++ParentIndex)
+		{
+			for (USceneComponent* Child : Components[ParentIndex]->GetAttachChildren())
+			{
+				Components.push_back(Child);
+				ParentIndices.push_back(static_cast<int32>(ParentIndex));
+			}
+		}
+
+		LevelBegin = LevelEnd;
+	}
+	LevelStarts.push_back(static_cast<uint32>(Components.size()));
+
+	NodeOfEntity.assign(FEntityStore::GetInst().GetMaxEntityId(), INDEX_NONE);
+	for (uint32 Index = 0; Index < Components.size(); ++Index)
+	{
+		NodeOfEntity[Components[Index]->GetEntityId()] = static_cast<int32>(Index);
+	}
+
+	LocalTransforms.resize(Components.size());
+	WorldTransforms.resize(Components.size());
+	PreviousWorldTransforms.resize(Components.size());
+	ChangedMask.resize(Components.size());
+
+	// 순서가 바뀌었으므로 다음 갱신에서는 모든 노드를 변경된 것으로 본다
+	bForceChanged = true;
+
+	BuiltVersion = USceneComponent::GetHierarchyVersion();
+	bEverBuilt = true;
+}
+
+bool FSceneHierarchy::IsDirty() const
+{
+	return !bEverBuilt || BuiltVersion != USceneComponent::GetHierarchyVersion();
+}
+
+void FSceneHierarchy::UpdateTransforms()
+{
+	ChangedNodes.clear();
+
+	const uint32 NumNodes = Num();
+	if (NumNodes == 0)
+	{
+		return;
+	}
+
+	// 이전 프레임 결과와 비교해서 바뀐 노드만 컴포넌트/프록시에 반영한다
+	WorldTransforms.swap(PreviousWorldTransforms);
+
+	FEntityStore& Store = FEntityStore::GetInst();
+
+	// 로컬 행렬은 노드끼리 독립적이므로 엔티티 청크를 통째로 훑으며 계산
+	Store.GetChunks(EntityColumns_Transform, Chunks);
+	ParallelFor(static_cast<uint32>(Chunks.size()), [this](uint32 ChunkIndex)
+	{
+		const FEntityChunkView& Chunk = Chunks[ChunkIndex];
+		const FEntityId* EntityIds = Chunk.Get<EEntityColumn::EntityId>();
+		const FVector* Locations = Chunk.Get<EEntityColumn::Location>();
+		const FVector* Rotations = Chunk.Get<EEntityColumn::Rotation>();
+		const FVector* Scales = Chunk.Get<EEntityColumn::Scale>();
+
+		for (uint32 Row = 0; Row < Chunk.Num(); ++Row)
+		{
+			const int32 Node = NodeOfEntity[EntityIds[Row]];
+			if (Node != INDEX_NONE)
+			{
+				LocalTransforms[Node] = USceneComponent::MakeRelativeTransform(Locations[Row], Rotations[Row], Scales[Row]);
+			}
+		}
+	}, 1);
+
+	// 루트 레벨은 로컬이 곧 월드
+	const uint32 RootEnd = LevelStarts[1];
+	for (uint32 Index = 0; Index < RootEnd; ++Index)
+	{
+		WorldTransforms[Index] = LocalTransforms[Index];
+	}
+
+	// 나머지 레벨은 바로 위 레벨이 끝난 뒤 Local * ParentWorld 로 일괄 계산
+	for (uint32 Level = 1; Level < GetNumLevels(); ++Level)
+	{
+		const uint32 Begin = LevelStarts[Level];
+		const uint32 Count = LevelStarts[Level + 1] - Begin;
+
+		ParallelFor(Count, [this, Begin](uint32 Offset)
+		{
+			const uint32 Index = Begin + Offset;
+			WorldTransforms[Index] = LocalTransforms[Index] * WorldTransforms[ParentIndices[Index]];
+		});
+	}
+
+	const bool bAllChanged = bForceChanged;
+	ParallelFor(NumNodes, [this, bAllChanged](uint32 Index)
+	{
+		const bool bChanged = bAllChanged || std::memcmp(&WorldTransforms[Index], &PreviousWorldTransforms[Index], sizeof(FMatrix)) != 0;
+		ChangedMask[Index] = bChanged ? 1 : 0;
+	});
+	bForceChanged = false;
+
+	// 바뀐 월드 행렬만 엔티티의 WorldMatrix 열에 기록
+	ParallelFor(static_cast<uint32>(Chunks.size()), [this](uint32 ChunkIndex)
+	{
+		const FEntityChunkView& Chunk = Chunks[ChunkIndex];
+		const FEntityId* EntityIds = Chunk.Get<EEntityColumn::EntityId>();
+		FMatrix* WorldMatrices = Chunk.Get<EEntityColumn::WorldMatrix>();
+
+		for (uint32 Row = 0; Row < Chunk.Num(); ++Row)
+		{
+			const int32 Node = NodeOfEntity[EntityIds[Row]];
+			if (Node != INDEX_NONE && ChangedMask[Node])
+			{
+				WorldMatrices[Row] = WorldTransforms[Node];
+			}
+		}
+	}, 1);
+
+	for (uint32 Index = 0; Index < NumNodes; ++Index)
+	{
+		if (ChangedMask[Index])
+		{
+			ChangedNodes.push_back(Index);
+		}
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Math/Matrix.h"
+#include "Templates/UnrealTypes.h"
+#include "EntityStore.h"
+
+class UObject;
+class USceneComponent;
+
+/**
+ * Flattened attachment hierarchy stored in breadth-first level order.
+ *
+ * Every level is a contiguous range and a parent always sits in an earlier
+ * level than its children, so world transforms are resolved one level at a
+ * time with a single Local * ParentWorld multiply per node and no recursion.
+ * Nodes within a level are independent and are processed in parallel.
+ *
+ * Relative transforms are read and world transforms written by streaming the
+ * FEntityStore chunks, mapping each entity back to its node.
+ */
+class FSceneHierarchy
+{
+public:
+	/** Rebuilds the level order from every scene component in Objects. */
+	void Rebuild(const TArray<UObject*>& Objects);
+
+	/** @return true when components were created, destroyed or re-attached since the last Rebuild. */
+	bool IsDirty() const;
+
+	/**
+	 * Recomputes every world transform. Only nodes whose world transform actually
+	 * changed are written back to their component and reported by GetChangedNodes().
+	 */
+	void UpdateTransforms();
+
+	/** Nodes whose world transform changed in the last UpdateTransforms (all nodes after a Rebuild). */
+	const TArray<uint32>& GetChangedNodes() const { return ChangedNodes; }
+
+	uint32 Num() const { return static_cast<uint32>(Components.size()); }
+	uint32 GetNumLevels() const { return LevelStarts.empty() ? 0 : static_cast<uint32>(LevelStarts.size()) - 1; }
+
+	USceneComponent* GetComponent(uint32 Index) const { return Components[Index]; }
+	int32 GetParentIndex(uint32 Index) const { return ParentIndices[Index]; }
+	const FMatrix& GetWorldTransform(uint32 Index) const { return WorldTransforms[Index]; }
+
+private:
+	/** Components in breadth-first order. */
+	TArray<USceneComponent*> Components;
+
+	/** Index of each node's parent in Components, INDEX_NONE for roots. */
+	TArray<int32> ParentIndices;
+
+	/** Level L occupies [LevelStarts[L], LevelStarts[L + 1]). */
+	TArray<uint32> LevelStarts;
+
+	/** Node of each FEntityId, INDEX_NONE for entities outside the hierarchy. */
+	TArray<int32> NodeOfEntity;
+
+	/** Scratch list of store chunks visited by the transform passes. */
+	TArray<FEntityChunkView> Chunks;
+
+	TArray<FMatrix> LocalTransforms;
+	TArray<FMatrix> WorldTransforms;
+	TArray<FMatrix> PreviousWorldTransforms;
+
+	TArray<uint8> ChangedMask;
+	TArray<uint32> ChangedNodes;
+
+	uint32 BuiltVersion = 0;
+	bool bEverBuilt = false;
+	bool bForceChanged = false;
+};
@@ -0,0 +1,160 @@
+#include "SceneRenderer.h"
+
+#include <cstring>
+#include <iterator>
+
+#include "Types/CommonTypes.h"
+
+namespace
+{
+	/** The RHI default: LESS with depth writes, like a null D3D11 depth stencil state. */
+	FDepthStencilStateInitializerRHI GetSceneDepthState()
+	{
+		return FDepthStencilStateInitializerRHI();
+	}
+
+	/** Gizmos are drawn over everything: no depth test, no depth writes. */
+	FDepthStencilStateInitializerRHI GetGizmoDepthState()
+	{
+		FDepthStencilStateInitializerRHI Initializer;
+		Initializer.bEnableDepthWrite = false;
+		Initializer.DepthTest = CF_Always;
+		return Initializer;
+	}
+}
+
+void FSceneRenderer::Render(const FFramePacket& Packet)
+{
+	static_assert(sizeof(FPrimitiveInstance) == sizeof(FRHIInstanceData), "Instance constants must match FPrimitiveInstance");
+
+	const FFrameView& View = Packet.View;
+	const FMatrix ViewProjection = View.ViewMatrix * View.ProjectionMatrix;
+
+	// 배치는 인스턴스 상수로 그리므로 개별 드로우만 모은다
+	GatherObjectDraws(Packet, false);
+	ObjectConstantStats = FObjectConstantStats();
+	ObjectConstantStats.NumDraws = static_cast<uint32>(ObjectDraws.size());
+
+	// 배치와 개별 드로우를 이어진 구간으로 나눠 워커마다 커맨드 리스트 하나씩 기록한다
+	const uint32 NumBatches = static_cast<uint32>(Packet.MeshBatches.size());
+	RecordAndExecute(NumBatches + ObjectConstantStats.NumDraws, [this, &Packet, &ViewProjection, NumBatches](uint32 Begin, uint32 End, FRHICommandList& CommandList)
+	{
+		RecordMeshBatches(Packet, ViewProjection, std::min(Begin, NumBatches), std::min(End, NumBatches), CommandList);
+		return RecordObjectDraws(ObjectDraws, ViewProjection, std::max(Begin, NumBatches) - NumBatches, std::max(End, NumBatches) - NumBatches, CommandList);
+	});
+
+	// 디버그 도형은 토폴로지마다 한 번
+	const EPrimitiveType DebugPrimitiveTypes[] = { PT_LineList, PT_TriangleList };
+	static_assert(std::size(DebugPrimitiveTypes) == static_cast<uint32>(EDebugDrawTopology::Num), "One primitive type per debug topology");
+	for (uint32 Topology = 0; Topology < static_cast<uint32>(EDebugDrawTopology::Num); ++Topology)
+	{
+		const TArray<FDebugVertex>& Vertices = Packet.DebugVertices[Topology];
+		if (Vertices.empty())
+		{
+			continue;
+		}
+
+		const EPrimitiveType PrimitiveType = DebugPrimitiveTypes[Topology];
+		RHISetShaderConstants(SCS_Transform, &ViewProjection, sizeof(FMatrix));
+		RHIDrawPrimitiveUP(PrimitiveType, static_cast<uint32>(Vertices.size()) / GetVertexCountForPrimitiveCount(1, PrimitiveType), Vertices.data(), sizeof(FDebugVertex));
+	}
+}
+
+void FSceneRenderer::GatherObjectDraws(const FFramePacket& Packet, bool bIncludeBatches)
+{
+	ObjectDraws.clear();
+
+	if (bIncludeBatches)
+	{
+		for (const FMeshDrawBatch& Batch : Packet.MeshBatches)
+		{
+			for (uint32 Index = Batch.FirstInstance; Index < Batch.FirstInstance + Batch.NumInstances; ++Index)
+			{
+				ObjectDraws.push_back({ &Packet.Instances[Index].WorldMatrix, Batch.VertexBuffer, Batch.FirstVertex, Batch.NumVertices, EMeshDrawType::Primitive });
+			}
+		}
+	}
+
+	for (const FMeshDrawCommand& Command : Packet.DrawCommands)
+	{
+		ObjectDraws.push_back({ &Command.WorldMatrix, Command.VertexBuffer, Command.FirstVertex, Command.NumVertices, Command.Type });
+	}
+}
+
+void FSceneRenderer::RecordMeshBatches(const FFramePacket& Packet, const FMatrix& ViewProjection, uint32 Begin, uint32 End, FRHICommandList& CommandList)
+{
+	if (Begin >= End)
+	{
+		return;
+	}
+
+	// 아레나 버퍼를 함께 쓰는 메시는 구간만 달라 스트림을 다시 설정하지 않는다
+	FRHIVertexBuffer* StreamSource = nullptr;
+
+	// 인스턴스 경로처럼 뷰 상수 한 번, 배치마다 인스턴스 드로우 한 번. 뷰 상수는 첫 배치를 기록하는 리스트만 올린다
+	if (Begin == 0)
+	{
+		CommandList.SetShaderConstants(SCS_Transform, &ViewProjection, sizeof(FMatrix));
+	}
+	for (uint32 Index = Begin; Index < End; ++Index)
+	{
+		const FMeshDrawBatch& Batch = Packet.MeshBatches[Index];
+		if (Index == Begin || Batch.VertexBuffer != StreamSource)
+		{
+			CommandList.SetStreamSource(0, Batch.VertexBuffer, sizeof(FVertexType), 0);
+			StreamSource = Batch.VertexBuffer;
+		}
+
+		// 인스턴스 데이터는 상수 버퍼 하나에 들어가는 만큼씩 나눠 그린다
+		for (uint32 First = 0; First < Batch.NumInstances; First += RHIMaxInstancesPerDraw)
+		{
+			const uint32 NumInstances = std::min(Batch.NumInstances - First, RHIMaxInstancesPerDraw);
+			CommandList.SetShaderConstants(SCS_Instances, &Packet.Instances[Batch.FirstInstance + First], NumInstances * sizeof(FPrimitiveInstance));
+			CommandList.DrawPrimitive(PT_TriangleList, Batch.FirstVertex, Batch.NumVertices / 3, NumInstances);
+		}
+	}
+
+	// 마지막 배치를 기록한 리스트가 인스턴스 상수를 비워 이후 드로우가 인스턴싱되지 않게 한다
+	if (End == Packet.MeshBatches.size())
+	{
+		CommandList.SetShaderConstants(SCS_Instances, nullptr, 0);
+	}
+}
+
+uint32 FSceneRenderer::RecordObjectDraws(const TArray<FObjectDraw>& Draws, const FMatrix& ViewProjection, uint32 Begin, uint32 End, FRHICommandList& CommandList)
+{
+	uint32 NumConstantUpdates = 0;
+
+	// 리스트는 씬 깊이 상태로 시작하고 끝나므로 순서대로 실행해도 섞이지 않는다
+	bool bGizmoDepth = false;
+	for (uint32 Index = Begin; Index < End; ++Index)
+	{
+		const FObjectDraw& Draw = Draws[Index];
+		const bool bGizmo = Draw.Type == EMeshDrawType::Gizmo;
+		if (bGizmo != bGizmoDepth)
+		{
+			CommandList.SetDepthStencilState(bGizmo ? GetGizmoDepthState() : GetSceneDepthState());
+			bGizmoDepth = bGizmo;
+		}
+
+		// 직전 드로우와 월드 행렬이 같으면 (기즈모 세 축 등) 걸려 있는 MVP를 그대로 쓴다
+		const FObjectDraw* PrevDraw = Index > Begin ? &Draws[Index - 1] : nullptr;
+		if (PrevDraw == nullptr || std::memcmp(PrevDraw->WorldMatrix, Draw.WorldMatrix, sizeof(FMatrix)) != 0)
+		{
+			const FMatrix MVP = *Draw.WorldMatrix * ViewProjection;
+			CommandList.SetShaderConstants(SCS_Transform, &MVP, sizeof(FMatrix));
+			++NumConstantUpdates;
+		}
+		if (PrevDraw == nullptr || PrevDraw->VertexBuffer != Draw.VertexBuffer)
+		{
+			CommandList.SetStreamSource(0, Draw.VertexBuffer, sizeof(FVertexType), 0);
+		}
+		CommandList.DrawPrimitive(PT_TriangleList, Draw.FirstVertex, Draw.NumVertices / 3, 1);
+	}
+	if (bGizmoDepth)
+	{
+		CommandList.SetDepthStencilState(GetSceneDepthState());
+	}
+
+	return NumConstantUpdates;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+
+#include "Async/ParallelFor.h"
+#include "FramePacket.h"
+#include "RHICommandList.h"
+
+/** Per-object constant updates of the last frame's object draws. */
+struct FObjectConstantStats
+{
+	uint32 NumDraws = 0;
+
+	/** Updates actually recorded; a draw whose world matrix matches the previous draw of its command list keeps the bound MVP. */
+	uint32 NumConstantUpdates = 0;
+
+	uint32 GetNumUpdatesSkipped() const { return NumDraws - NumConstantUpdates; }
+};
+
+/**
+ * Render thread side of the scene: turns a frame packet into draw calls.
+ * Only reads the packet, never the scene or its components.
+ *
+ * Submits every draw through GDynamicRHI as API independent calls, which is
+ * all the headless RHIs (-nullrhi, -softwarerhi) need and keeps this header
+ * free of D3D11. The windowed renderer is FD3D11SceneRenderer.
+ */
+class FSceneRenderer
+{
+public:
+	virtual ~FSceneRenderer() = default;
+
+	virtual void Render(const FFramePacket& Packet);
+
+	const FObjectConstantStats& GetObjectConstantStats() const { return ObjectConstantStats; }
+
+protected:
+	/** A draw that needs its own MVP: uninstanced batch members and gizmo parts. */
+	struct FObjectDraw
+	{
+		const FMatrix* WorldMatrix = nullptr;
+		FRHIVertexBuffer* VertexBuffer = nullptr;
+		uint32 FirstVertex = 0;
+		uint32 NumVertices = 0;
+		EMeshDrawType Type = EMeshDrawType::Primitive;
+	};
+
+	/** Fewer draws than this per command list cost more to hand out than to record inline. */
+	static constexpr uint32 MinDrawsPerCommandList = 256;
+
+	/** Collects DrawCommands into ObjectDraws, preceded by every batch member when bIncludeBatches (no instanced path). */
+	void GatherObjectDraws(const FFramePacket& Packet, bool bIncludeBatches);
+
+	/**
+	 * Splits NumDraws into contiguous slices, one command list each, records slice [Begin, End) with
+	 * Record(Begin, End, CommandList) on the task pool and executes the lists in slice order on GDynamicRHI.
+	 * Record returns the object constant updates it recorded; their sum goes into ObjectConstantStats.
+	 */
+	template<typename RecordFunctionType>
+	void RecordAndExecute(uint32 NumDraws, const RecordFunctionType& Record);
+
+	/** Records mesh batches [Begin, End) of the packet as instanced draws into CommandList. */
+	static void RecordMeshBatches(const FFramePacket& Packet, const FMatrix& ViewProjection, uint32 Begin, uint32 End, FRHICommandList& CommandList);
+
+	/**
+	 * Records Draws [Begin, End) into CommandList, one MVP per change of world matrix and gizmos without depth test.
+	 * The list starts and ends in the scene depth state. @return The constant updates recorded.
+	 */
+	static uint32 RecordObjectDraws(const TArray<FObjectDraw>& Draws, const FMatrix& ViewProjection, uint32 Begin, uint32 End, FRHICommandList& CommandList);
+
+protected:
+	/** Reused every frame to avoid reallocating. */
+	TArray<FObjectDraw> ObjectDraws;
+
+	/** One per slice of the frame's draws, recorded on the task pool and executed in order. */
+	TArray<FRHICommandList> CommandLists;
+	TArray<uint32> CommandListConstantUpdates;
+
+	FObjectConstantStats ObjectConstantStats;
+};
+
+template<typename RecordFunctionType>
+void FSceneRenderer::RecordAndExecute(uint32 NumDraws, const RecordFunctionType& Record)
+{
+	const uint32 MaxCommandLists = FTaskPool::Get().GetNumWorkers() + 1;
+	const uint32 NumCommandLists = std::max(1u, std::min(MaxCommandLists, (NumDraws + MinDrawsPerCommandList - 1) / MinDrawsPerCommandList));
+	const uint32 DrawsPerCommandList = (NumDraws + NumCommandLists - 1) / NumCommandLists;
+
+	if (CommandLists.size() < NumCommandLists)
+	{
+		CommandLists.resize(NumCommandLists);
+		CommandListConstantUpdates.resize(NumCommandLists);
+	}
+
+	ParallelFor(NumCommandLists, [&](uint32 ListIndex)
+	{
+		FRHICommandList& CommandList = CommandLists[ListIndex];
+		CommandList.Reset();
+
+		const uint32 Begin = std::min(NumDraws, ListIndex * DrawsPerCommandList);
+		const uint32 End = std::min(NumDraws, Begin + DrawsPerCommandList);
+		CommandListConstantUpdates[ListIndex] = Record(Begin, End, CommandList);
+	}, 1);
+
+	// 기록 순서대로 실행하므로 한 스레드가 전부 기록한 것과 같은 명령열이 된다
+	for (uint32 ListIndex = 0; ListIndex < NumCommandLists; ++ListIndex)
+	{
+		CommandLists[ListIndex].Execute(*GDynamicRHI);
+		ObjectConstantStats.NumConstantUpdates += CommandListConstantUpdates[ListIndex];
+	}
+}
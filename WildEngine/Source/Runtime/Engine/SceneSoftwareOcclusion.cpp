@@ -0,0 +1,259 @@
+#include "SceneSoftwareOcclusion.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Async/ParallelFor.h"
+#include "Scene.h"
+#include "Types/CommonTypes.h"
+
+namespace
+{
+	/** Occluders rasterized per frame, largest on screen first. */
+	constexpr uint32 MaxOccluders = 32;
+
+	/** Meshes with more triangles cost more to rasterize than they usually save. */
+	constexpr uint32 MaxTrianglesPerOccluder = 1024;
+
+	/** Bounding sphere radius over view depth below which a proxy is too small to hide much. */
+	constexpr float MinOccluderScreenSize = 0.05f;
+
+	constexpr uint32 NumHiZTilesX = FSceneSoftwareOcclusion::BufferWidth / FSceneSoftwareOcclusion::HiZTileWidth;
+	constexpr uint32 NumHiZTilesY = FSceneSoftwareOcclusion::BufferHeight / FSceneSoftwareOcclusion::HiZTileHeight;
+}
+
+FSceneSoftwareOcclusion::FSceneSoftwareOcclusion()
+	: ViewProjection(FMatrix::Identity())
+	, Depth(BufferWidth * BufferHeight, 1.0f)
+	, HiZ(NumHiZTilesX * NumHiZTilesY, 1.0f)
+	, RowMaxDepth(BufferWidth * BufferHeight, 1.0f)
+{
+	Rasterizer.Resize(BufferWidth, BufferHeight);
+	Rasterizer.SetDepthOnly(true);
+}
+
+void FSceneSoftwareOcclusion::Process(const FPrimitiveSceneProxies& Proxies, const TArray<FSceneMesh>& Meshes, const FMatrix& ViewMatrix, const FMatrix& InViewProjection, TArray<uint32>& InOutVisibleProxies)
+{
+	Stats = FSoftwareOcclusionStats();
+	ViewProjection = InViewProjection;
+
+	SelectOccluders(Proxies, Meshes, ViewMatrix, InOutVisibleProxies);
+	if (Occluders.empty())
+	{
+		return;
+	}
+
+	RasterizeOccluders(Proxies, Meshes);
+	BuildHiZ();
+
+	// 가림체도 함께 검사한다: 바운드의 가장 가까운 깊이가 자기 표면보다 앞이라 스스로를 가리지는 않는다
+	const uint32 NumVisible = static_cast<uint32>(InOutVisibleProxies.size());
+	OccludedMask.assign(NumVisible, 0);
+	ParallelFor(NumVisible, [&](uint32 Index)
+	{
+		OccludedMask[Index] = IsOccluded(Proxies.GetBounds(InOutVisibleProxies[Index])) ? 1 : 0;
+	}, 256);
+
+	uint32 NumKept = 0;
+	for (uint32 Index = 0; Index < NumVisible; ++Index)
+	{
+		if (!OccludedMask[Index])
+		{
+			InOutVisibleProxies[NumKept++] = InOutVisibleProxies[Index];
+		}
+	}
+
+	Stats.NumTested = NumVisible;
+	Stats.NumOccluded = NumVisible - NumKept;
+	InOutVisibleProxies.resize(NumKept);
+}
+
+bool FSceneSoftwareOcclusion::IsOccluded(const FPrimitiveBounds& Bounds) const
+{
+	const float (&M)[4][4] = ViewProjection.M;
+
+	// 박스 8개 꼭짓점을 투영해 화면 사각형과 가장 가까운 깊이를 구한다
+	float MinX = 1.0f, MinY = 1.0f, MaxX = -1.0f, MaxY = -1.0f;
+	float MinDepth = 1.0f;
+	for (uint32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const float X = Bounds.Origin.X + ((Corner & 1) ? Bounds.BoxExtent.X : -Bounds.BoxExtent.X);
+		const float Y = Bounds.Origin.Y + ((Corner & 2) ? Bounds.BoxExtent.Y : -Bounds.BoxExtent.Y);
+		const float Z = Bounds.Origin.Z + ((Corner & 4) ? Bounds.BoxExtent.Z : -Bounds.BoxExtent.Z);
+
+		const float ClipX = X * M[0][0] + Y * M[1][0] + Z * M[2][0] + M[3][0];
+		const float ClipY = X * M[0][1] + Y * M[1][1] + Z * M[2][1] + M[3][1];
+		const float ClipZ = X * M[0][2] + Y * M[1][2] + Z * M[2][2] + M[3][2];
+		const float ClipW = X * M[0][3] + Y * M[1][3] + Z * M[2][3] + M[3][3];
+
+		// 근평면에 걸치면 화면 사각형이 뒤집히므로 보이는 것으로 둔다
+		if (ClipZ <= 0.0f || ClipW <= 0.0f)
+		{
+			return false;
+		}
+
+		const float InvW = 1.0f / ClipW;
+		MinX = std::min(MinX, ClipX * InvW);
+		MaxX = std::max(MaxX, ClipX * InvW);
+		MinY = std::min(MinY, ClipY * InvW);
+		MaxY = std::max(MaxY, ClipY * InvW);
+		MinDepth = std::min(MinDepth, ClipZ * InvW);
+	}
+
+	// 픽셀 중심 기준으로 사각형이 걸치는 픽셀을 모두 포함하도록 넓게 잡는다
+	const int32 PixelMinX = std::max(0, static_cast<int32>(std::floor((MinX * 0.5f + 0.5f) * BufferWidth)));
+	const int32 PixelMaxX = std::min(static_cast<int32>(BufferWidth) - 1, static_cast<int32>(std::ceil((MaxX * 0.5f + 0.5f) * BufferWidth)));
+	const int32 PixelMinY = std::max(0, static_cast<int32>(std::floor((0.5f - MaxY * 0.5f) * BufferHeight)));
+	const int32 PixelMaxY = std::min(static_cast<int32>(BufferHeight) - 1, static_cast<int32>(std::ceil((0.5f - MinY * 0.5f) * BufferHeight)));
+	if (PixelMinX > PixelMaxX || PixelMinY > PixelMaxY)
+	{
+		return false;
+	}
+
+	for (int32 TileY = PixelMinY / static_cast<int32>(HiZTileHeight); TileY <= PixelMaxY / static_cast<int32>(HiZTileHeight); ++TileY)
+	{
+		for (int32 TileX = PixelMinX / static_cast<int32>(HiZTileWidth); TileX <= PixelMaxX / static_cast<int32>(HiZTileWidth); ++TileX)
+		{
+			// 타일 전체가 더 가까운 가림체로 덮였으면 픽셀을 볼 필요가 없다
+			if (HiZ[TileY * NumHiZTilesX + TileX] < MinDepth)
+			{
+				continue;
+			}
+
+			const int32 StartX = std::max(PixelMinX, TileX * static_cast<int32>(HiZTileWidth));
+			const int32 EndX = std::min(PixelMaxX, (TileX + 1) * static_cast<int32>(HiZTileWidth) - 1);
+			const int32 StartY = std::max(PixelMinY, TileY * static_cast<int32>(HiZTileHeight));
+			const int32 EndY = std::min(PixelMaxY, (TileY + 1) * static_cast<int32>(HiZTileHeight) - 1);
+			for (int32 Y = StartY; Y <= EndY; ++Y)
+			{
+				for (int32 X = StartX; X <= EndX; ++X)
+				{
+					if (Depth[Y * BufferWidth + X] >= MinDepth)
+					{
+						return false;
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+void FSceneSoftwareOcclusion::SelectOccluders(const FPrimitiveSceneProxies& Proxies, const TArray<FSceneMesh>& Meshes, const FMatrix& ViewMatrix, const TArray<uint32>& VisibleProxies)
+{
+	Occluders.clear();
+
+	for (uint32 ProxyId : VisibleProxies)
+	{
+		if (Proxies.GetFlags(ProxyId) & (PSF_Translucent | PSF_LineList))
+		{
+			continue;
+		}
+
+		const FSceneMesh& Mesh = Meshes[Proxies.GetMeshId(ProxyId)];
+		if (!Mesh.SourceVertices || Mesh.NumVertices < 3 || Mesh.NumVertices / 3 > MaxTrianglesPerOccluder)
+		{
+			continue;
+		}
+
+		// 화면에서 차지하는 크기 ~ 반지름 / 뷰 깊이. 카메라가 구 안에 있으면 가장 큰 것으로 본다
+		const FPrimitiveBounds& Bounds = Proxies.GetBounds(ProxyId);
+		const float ViewDepth = Bounds.Origin.X * ViewMatrix.M[0][2] + Bounds.Origin.Y * ViewMatrix.M[1][2] + Bounds.Origin.Z * ViewMatrix.M[2][2] + ViewMatrix.M[3][2];
+		const float ScreenSize = ViewDepth > Bounds.SphereRadius ? Bounds.SphereRadius / ViewDepth : 1.0f;
+		if (ScreenSize >= MinOccluderScreenSize)
+		{
+			Occluders.push_back({ ProxyId, ScreenSize });
+		}
+	}
+
+	if (Occluders.size() > MaxOccluders)
+	{
+		std::partial_sort(Occluders.begin(), Occluders.begin() + MaxOccluders, Occluders.end(),
+			[](const FOccluderCandidate& A, const FOccluderCandidate& B) { return A.ScreenSize > B.ScreenSize; });
+		Occluders.resize(MaxOccluders);
+	}
+}
+
+void FSceneSoftwareOcclusion::RasterizeOccluders(const FPrimitiveSceneProxies& Proxies, const TArray<FSceneMesh>& Meshes)
+{
+	const float ClearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	Rasterizer.Clear(ClearColor);
+
+	for (const FOccluderCandidate& Occluder : Occluders)
+	{
+		const FSceneMesh& Mesh = Meshes[Proxies.GetMeshId(Occluder.ProxyId)];
+		const FMatrix WorldViewProjection = Proxies.GetWorldMatrix(Occluder.ProxyId) * ViewProjection;
+		const float (&M)[4][4] = WorldViewProjection.M;
+
+		const uint32 NumTriangles = Mesh.NumVertices / 3;
+		OccluderVertices.resize(NumTriangles * 3);
+		for (uint32 Index = 0; Index < NumTriangles * 3; ++Index)
+		{
+			const FVertexType& Vertex = Mesh.SourceVertices[Index];
+			FSoftwareRasterVertex& Output = OccluderVertices[Index];
+			for (uint32 Column = 0; Column < 4; ++Column)
+			{
+				Output.Position[Column] = Vertex.x * M[0][Column] + Vertex.y * M[1][Column] + Vertex.z * M[2][Column] + M[3][Column];
+				Output.Color[Column] = 0.0f;
+			}
+		}
+
+		Rasterizer.AddTriangles(OccluderVertices.data(), NumTriangles);
+		++Stats.NumOccluders;
+		Stats.NumOccluderTriangles += NumTriangles;
+	}
+
+	Rasterizer.Flush();
+
+	// 중심만 덮인 가장자리 픽셀을 가린 것으로 치지 않도록 3x3 이웃 중 가장 먼 깊이를 쓴다 (가로, 세로 두 번)
+	for (uint32 Y = 0; Y < BufferHeight; ++Y)
+	{
+		for (uint32 X = 0; X < BufferWidth; ++X)
+		{
+			float MaxDepth = Rasterizer.GetDepth(X, Y);
+			if (X > 0)
+			{
+				MaxDepth = std::max(MaxDepth, Rasterizer.GetDepth(X - 1, Y));
+			}
+			if (X + 1 < BufferWidth)
+			{
+				MaxDepth = std::max(MaxDepth, Rasterizer.GetDepth(X + 1, Y));
+			}
+			RowMaxDepth[Y * BufferWidth + X] = MaxDepth;
+		}
+	}
+	for (uint32 Y = 0; Y < BufferHeight; ++Y)
+	{
+		const uint32 MinY = Y > 0 ? Y - 1 : Y;
+		const uint32 MaxY = Y + 1 < BufferHeight ? Y + 1 : Y;
+		for (uint32 X = 0; X < BufferWidth; ++X)
+		{
+			float MaxDepth = RowMaxDepth[MinY * BufferWidth + X];
+			for (uint32 NeighborY = MinY + 1; NeighborY <= MaxY; ++NeighborY)
+			{
+				MaxDepth = std::max(MaxDepth, RowMaxDepth[NeighborY * BufferWidth + X]);
+			}
+			Depth[Y * BufferWidth + X] = MaxDepth;
+		}
+	}
+}
+
+void FSceneSoftwareOcclusion::BuildHiZ()
+{
+	for (uint32 TileY = 0; TileY < NumHiZTilesY; ++TileY)
+	{
+		for (uint32 TileX = 0; TileX < NumHiZTilesX; ++TileX)
+		{
+			float MaxDepth = 0.0f;
+			for (uint32 Y = TileY * HiZTileHeight; Y < (TileY + 1) * HiZTileHeight; ++Y)
+			{
+				for (uint32 X = TileX * HiZTileWidth; X < (TileX + 1) * HiZTileWidth; ++X)
+				{
+					MaxDepth = std::max(MaxDepth, Depth[Y * BufferWidth + X]);
+				}
+			}
+			HiZ[TileY * NumHiZTilesX + TileX] = MaxDepth;
+		}
+	}
+}
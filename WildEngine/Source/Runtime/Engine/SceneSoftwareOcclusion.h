@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Math/Matrix.h"
+#include "Templates/UnrealTypes.h"
+#include "PrimitiveSceneProxy.h"
+#include "SoftwareRasterizer.h"
+
+struct FSceneMesh;
+
+/** Occlusion counts of the last FSceneSoftwareOcclusion::Process. */
+struct FSoftwareOcclusionStats
+{
+	uint32 NumOccluders = 0;
+	uint32 NumOccluderTriangles = 0;
+
+	/** Frustum visible proxies tested against the depth buffer, and how many of them were hidden. */
+	uint32 NumTested = 0;
+	uint32 NumOccluded = 0;
+};
+
+/**
+ * Software occlusion culling between frustum culling and draw sorting.
+ *
+ * The largest nearby opaque proxies are rasterized, depth only, into a small
+ * CPU depth buffer with FSoftwareRasterizer. A max-depth hierarchy of 8x4
+ * pixel tiles is built on top, and every other visible proxy is tested with
+ * the screen rectangle and nearest depth of its bounding box: coarse tiles
+ * that are entirely nearer reject quickly, the remaining tiles are checked
+ * per pixel. A proxy is dropped only when its whole rectangle is covered by
+ * nearer occluder depth; anything crossing the near plane stays visible.
+ *
+ * The rasterizer covers a pixel when its center is inside, so occluder depth
+ * is eroded by a pixel (the farthest depth of each 3x3 neighborhood): a pixel
+ * counts as covered only when occluders cover all of it, and a proxy peeking
+ * out by less than a low resolution pixel is not culled.
+ */
+class FSceneSoftwareOcclusion
+{
+public:
+	static constexpr uint32 BufferWidth = 256;
+	static constexpr uint32 BufferHeight = 128;
+	static constexpr uint32 HiZTileWidth = 8;
+	static constexpr uint32 HiZTileHeight = 4;
+
+	FSceneSoftwareOcclusion();
+
+	/**
+	 * Picks occluders among InOutVisibleProxies, rasterizes them and removes the
+	 * proxies they hide, keeping the order of the rest.
+	 * @param ViewMatrix Used to rank occluders by distance.
+	 */
+	void Process(const FPrimitiveSceneProxies& Proxies, const TArray<FSceneMesh>& Meshes, const FMatrix& ViewMatrix, const FMatrix& ViewProjection, TArray<uint32>& InOutVisibleProxies);
+
+	/** @return Whether Bounds are hidden behind the occluders of the last Process. */
+	bool IsOccluded(const FPrimitiveBounds& Bounds) const;
+
+	const FSoftwareOcclusionStats& GetStats() const { return Stats; }
+
+	/** Depth of the last Process, e.g. to visualize it. */
+	float GetDepth(uint32 X, uint32 Y) const { return Depth[Y * BufferWidth + X]; }
+
+private:
+	struct FOccluderCandidate
+	{
+		uint32 ProxyId;
+		float ScreenSize;
+	};
+
+	void SelectOccluders(const FPrimitiveSceneProxies& Proxies, const TArray<FSceneMesh>& Meshes, const FMatrix& ViewMatrix, const TArray<uint32>& VisibleProxies);
+	void RasterizeOccluders(const FPrimitiveSceneProxies& Proxies, const TArray<FSceneMesh>& Meshes);
+	void BuildHiZ();
+
+private:
+	FSoftwareRasterizer Rasterizer;
+	FMatrix ViewProjection;
+
+	/** Eroded occluder depth per pixel (1 where nothing was drawn) and the farthest of it per HiZ tile. */
+	TArray<float> Depth;
+	TArray<float> HiZ;
+
+	/** Rasterized depth after the horizontal half of the erosion. */
+	TArray<float> RowMaxDepth;
+
+	/** Reused every frame to avoid reallocating. */
+	TArray<FOccluderCandidate> Occluders;
+	TArray<FSoftwareRasterVertex> OccluderVertices;
+	TArray<uint8> OccludedMask;
+
+	FSoftwareOcclusionStats Stats;
+};
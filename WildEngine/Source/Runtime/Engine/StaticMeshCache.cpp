@@ -0,0 +1,73 @@
+#include "StaticMeshCache.h"
+
+#include "Types/CommonTypes.h"
+
+FStaticMesh::FStaticMesh() = default;
+FStaticMesh::~FStaticMesh() = default;
+
+const FStaticMesh* FStaticMeshCache::Acquire(const FVertexType* Vertices, uint32 NumVertices)
+{
+	std::unique_ptr<FStaticMesh>& Mesh = Meshes[Vertices];
+	if (!Mesh)
+	{
+		// 첫 인스턴스에서만 구간 할당과 바운드 계산. 내용은 렌더 스레드가 처음 그리기 전에 올린다
+		Mesh = std::make_unique<FStaticMesh>();
+		Mesh->NumVertices = NumVertices;
+		Mesh->SourceVertices = Vertices;
+		Mesh->Allocation = FVertexBufferArena::GetInst().Allocate(Vertices, NumVertices, sizeof(FVertexType));
+		Mesh->LocalBounds = FPrimitiveBounds::FromVertices(Vertices, NumVertices);
+	}
+
+	++Mesh->NumRefs;
+	return Mesh.get();
+}
+
+const FStaticMesh* FStaticMeshCache::Acquire(const FVertexType* Vertices, uint32 NumVertices, const TArray<FStaticMeshLODDesc>& LODDescs)
+{
+	FStaticMesh* Mesh = const_cast<FStaticMesh*>(Acquire(Vertices, NumVertices));
+	if (Mesh->LODs.empty())
+	{
+		// LOD도 캐시된 메시다. 원본 메시가 참조를 하나씩 잡는다
+		for (const FStaticMeshLODDesc& Desc : LODDescs)
+		{
+			Mesh->LODs.push_back({ Acquire(Desc.Vertices, Desc.NumVertices), Desc.MaxScreenRadius });
+		}
+	}
+	return Mesh;
+}
+
+void FStaticMeshCache::Release(const FStaticMesh* Mesh)
+{
+	if (Mesh)
+	{
+		--const_cast<FStaticMesh*>(Mesh)->NumRefs;
+	}
+}
+
+void FStaticMeshCache::ReleaseUnusedMeshes()
+{
+	// 메시를 지우면 그 LOD의 참조가 빠지므로 더 지울 것이 없을 때까지 반복한다
+	bool bReleasedAny = true;
+	while (bReleasedAny)
+	{
+		bReleasedAny = false;
+		for (auto It = Meshes.begin(); It != Meshes.end();)
+		{
+			if (It->second->NumRefs == 0)
+			{
+				for (const FStaticMeshLOD& LOD : It->second->LODs)
+				{
+					Release(LOD.Mesh);
+				}
+
+				// 버퍼 구간은 지연 삭제 큐로 넘어가므로 렌더 스레드가 그리는 중이어도 된다
+				It = Meshes.erase(It);
+				bReleasedAny = true;
+			}
+			else
+			{
+				++It;
+			}
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <memory>
+
+#include "Templates/UnrealTypes.h"
+#include "Templates/RefCounting.h"
+#include "Interface/ISingleton.h"
+#include "PrimitiveSceneProxy.h"
+#include "VertexBufferArena.h"
+
+struct FVertexType;
+struct FStaticMesh;
+
+/** Describes a coarser version of a mesh, for FStaticMeshCache::Acquire. */
+struct FStaticMeshLODDesc
+{
+	const FVertexType* Vertices = nullptr;
+	uint32 NumVertices = 0;
+
+	/** Projected radius, in pixels, below which this level replaces the finer ones. */
+	float MaxScreenRadius = 0.0f;
+};
+
+/** A coarser version of a mesh; itself a cached mesh. */
+struct FStaticMeshLOD
+{
+	const FStaticMesh* Mesh = nullptr;
+	float MaxScreenRadius = 0.0f;
+};
+
+/** GPU data of one mesh, shared by every component that draws it. */
+struct FStaticMesh
+{
+	FStaticMesh();
+	~FStaticMesh();
+
+	/** Range of a shared arena buffer. Dropping the last reference defers the actual release until no frame in flight draws the mesh. */
+	TRefCountPtr<FVertexBufferAllocation> Allocation;
+	uint32 NumVertices = 0;
+	FPrimitiveBounds LocalBounds;
+
+	/** The static vertex data the buffer was built from, kept for CPU side baking. */
+	const FVertexType* SourceVertices = nullptr;
+
+	/** Components currently holding this mesh, plus the finer meshes using it as a LOD. */
+	uint32 NumRefs = 0;
+
+	/** Coarser levels, finest first (decreasing MaxScreenRadius); empty when the mesh has no LODs. Each holds a reference to its mesh. */
+	TArray<FStaticMeshLOD> LODs;
+
+	/** Where the mesh is drawn from; may change when the arena defragments. */
+	FRHIVertexBuffer* GetVertexBuffer() const { return Allocation ? Allocation->GetVertexBuffer() : nullptr; }
+	uint32 GetFirstVertex() const { return Allocation ? Allocation->GetFirstVertex() : 0; }
+};
+
+/**
+ * Refcounted cache of static meshes keyed by their source vertex array.
+ *
+ * Primitive components acquire their mesh here instead of creating a vertex
+ * buffer each, so N cubes share one range and one upload, and different
+ * meshes share the arena's buffers. A mesh whose last reference goes away
+ * stays cached until ReleaseUnusedMeshes. Ranges are freed through the RHI
+ * deferred delete queue, so that may run at any time on the game thread, even
+ * while the render thread is drawing older frames.
+ */
+class FStaticMeshCache : public ISingleton<FStaticMeshCache>
+{
+public:
+	/** @return The mesh built from Vertices, created and uploaded on first use. Never null. */
+	const FStaticMesh* Acquire(const FVertexType* Vertices, uint32 NumVertices);
+
+	/** Like Acquire, giving the mesh the coarser levels in LODDescs (finest first) if it has none yet. */
+	const FStaticMesh* Acquire(const FVertexType* Vertices, uint32 NumVertices, const TArray<FStaticMeshLODDesc>& LODDescs);
+
+	/** Drops one reference taken by Acquire. */
+	void Release(const FStaticMesh* Mesh);
+
+	/** Drops the meshes nobody references, and then their LODs; their buffers are freed once the frames using them retire. */
+	void ReleaseUnusedMeshes();
+
+	uint32 GetNumMeshes() const { return static_cast<uint32>(Meshes.size()); }
+
+private:
+	friend class ISingleton<FStaticMeshCache>;
+	FStaticMeshCache() = default;
+
+	/** Mesh identity is the address of its static vertex data. */
+	TMap<const FVertexType*, std::unique_ptr<FStaticMesh>> Meshes;
+};
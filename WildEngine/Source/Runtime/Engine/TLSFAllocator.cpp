@@ -0,0 +1,274 @@
+#include "TLSFAllocator.h"
+
+#include <algorithm>
+
+#include "HAL/PlatformIncludes.h"
+#include "Math/UnrealMathUtility.h"
+
+FTLSFAllocator::FTLSFAllocator(uint32 InSize)
+{
+	Reset(InSize);
+}
+
+void FTLSFAllocator::Reset(uint32 InSize)
+{
+	Size = InSize;
+	UsedSize = 0;
+	NumAllocations = 0;
+
+	Blocks.clear();
+	UnusedBlocks.clear();
+
+	FirstLevelBitmap = 0;
+	for (uint32 FirstLevel = 0; FirstLevel < FirstLevelCount; ++FirstLevel)
+	{
+		SecondLevelBitmaps[FirstLevel] = 0;
+		std::fill(FreeLists[FirstLevel], FreeLists[FirstLevel] + SecondLevelCount, INDEX_NONE);
+	}
+
+	if (Size > 0)
+	{
+		const int32 Handle = NewBlock();
+		Blocks[Handle].Size = Size;
+		InsertFreeBlock(Handle);
+	}
+}
+
+void FTLSFAllocator::MapInsert(uint32 InSize, uint32& OutFirstLevel, uint32& OutSecondLevel)
+{
+	if (InSize < SecondLevelCount)
+	{
+		// 작은 크기는 첫 단계 0에서 한 단위씩 나눈다
+		OutFirstLevel = 0;
+		OutSecondLevel = InSize;
+	}
+	else
+	{
+		const uint32 Log2 = FMath::FloorLog2(InSize);
+		OutFirstLevel = Log2 - SecondLevelLog2 + 1;
+		OutSecondLevel = (InSize >> (Log2 - SecondLevelLog2)) - SecondLevelCount;
+	}
+}
+
+bool FTLSFAllocator::MapSearch(uint32 InSize, uint32& OutFirstLevel, uint32& OutSecondLevel)
+{
+	// 다음 크기 구간으로 올림해야 그 목록의 어떤 블록이든 요청을 담는다
+	uint64 RoundedSize = InSize;
+	if (InSize >= SecondLevelCount)
+	{
+		RoundedSize += (1ull << (FMath::FloorLog2(InSize) - SecondLevelLog2)) - 1;
+		if (RoundedSize > UINT32_MAX)
+		{
+			return false;
+		}
+	}
+	MapInsert(static_cast<uint32>(RoundedSize), OutFirstLevel, OutSecondLevel);
+	return true;
+}
+
+bool FTLSFAllocator::FindFreeList(uint32& InOutFirstLevel, uint32& InOutSecondLevel) const
+{
+	uint32 SecondLevelMap = SecondLevelBitmaps[InOutFirstLevel] & (~0u << InOutSecondLevel);
+	if (SecondLevelMap == 0)
+	{
+		const uint32 FirstLevelMap = InOutFirstLevel + 1 < 32 ? FirstLevelBitmap & (~0u << (InOutFirstLevel + 1)) : 0;
+		if (FirstLevelMap == 0)
+		{
+			return false;
+		}
+		InOutFirstLevel = FMath::CountTrailingZeros(FirstLevelMap);
+		SecondLevelMap = SecondLevelBitmaps[InOutFirstLevel];
+	}
+	InOutSecondLevel = FMath::CountTrailingZeros(SecondLevelMap);
+	return true;
+}
+
+int32 FTLSFAllocator::Allocate(uint32 InSize)
+{
+	if (InSize == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	int32 Handle = INDEX_NONE;
+	uint32 FirstLevel = 0;
+	uint32 SecondLevel = 0;
+	if (MapSearch(InSize, FirstLevel, SecondLevel) && FirstLevel < FirstLevelCount && FindFreeList(FirstLevel, SecondLevel))
+	{
+		Handle = FreeLists[FirstLevel][SecondLevel];
+	}
+	else
+	{
+		// 올림한 구간 위로 블록이 없으면 요청 크기가 속한 목록에서 충분히 큰 블록을 찾는다 (남은 공간을 꽉 채우는 할당)
+		MapInsert(InSize, FirstLevel, SecondLevel);
+		for (int32 Candidate = FreeLists[FirstLevel][SecondLevel]; Candidate != INDEX_NONE; Candidate = Blocks[Candidate].NextFree)
+		{
+			if (Blocks[Candidate].Size >= InSize)
+			{
+				Handle = Candidate;
+				break;
+			}
+		}
+		if (Handle == INDEX_NONE)
+		{
+			return INDEX_NONE;
+		}
+	}
+	RemoveFreeBlock(Handle);
+
+	// 남는 뒷부분은 새 빈 블록으로 떼어 낸다
+	if (Blocks[Handle].Size > InSize)
+	{
+		const int32 Remainder = NewBlock();
+		FBlock& Block = Blocks[Handle];
+		FBlock& Rest = Blocks[Remainder];
+		Rest.Offset = Block.Offset + InSize;
+		Rest.Size = Block.Size - InSize;
+		Rest.PrevPhysical = Handle;
+		Rest.NextPhysical = Block.NextPhysical;
+		if (Block.NextPhysical != INDEX_NONE)
+		{
+			Blocks[Block.NextPhysical].PrevPhysical = Remainder;
+		}
+		Block.NextPhysical = Remainder;
+		Block.Size = InSize;
+		InsertFreeBlock(Remainder);
+	}
+
+	UsedSize += InSize;
+	++NumAllocations;
+	return Handle;
+}
+
+void FTLSFAllocator::Free(int32 Handle)
+{
+	if (Handle == INDEX_NONE || Blocks[Handle].bFree)
+	{
+		return;
+	}
+
+	UsedSize -= Blocks[Handle].Size;
+	--NumAllocations;
+
+	// 앞뒤 빈 블록과 바로 합쳐 조각이 쌓이지 않게 한다
+	const int32 Next = Blocks[Handle].NextPhysical;
+	if (Next != INDEX_NONE && Blocks[Next].bFree)
+	{
+		RemoveFreeBlock(Next);
+		Blocks[Handle].Size += Blocks[Next].Size;
+		Blocks[Handle].NextPhysical = Blocks[Next].NextPhysical;
+		if (Blocks[Next].NextPhysical != INDEX_NONE)
+		{
+			Blocks[Blocks[Next].NextPhysical].PrevPhysical = Handle;
+		}
+		DeleteBlock(Next);
+	}
+
+	int32 Merged = Handle;
+	const int32 Prev = Blocks[Handle].PrevPhysical;
+	if (Prev != INDEX_NONE && Blocks[Prev].bFree)
+	{
+		RemoveFreeBlock(Prev);
+		Blocks[Prev].Size += Blocks[Handle].Size;
+		Blocks[Prev].NextPhysical = Blocks[Handle].NextPhysical;
+		if (Blocks[Handle].NextPhysical != INDEX_NONE)
+		{
+			Blocks[Blocks[Handle].NextPhysical].PrevPhysical = Prev;
+		}
+		DeleteBlock(Handle);
+		Merged = Prev;
+	}
+
+	InsertFreeBlock(Merged);
+}
+
+uint32 FTLSFAllocator::GetLargestFreeBlock() const
+{
+	if (FirstLevelBitmap == 0)
+	{
+		return 0;
+	}
+
+	// 가장 높은 비어 있지 않은 목록에만 후보가 있다. 같은 목록 안의 크기는 조금씩 다르다
+	const uint32 FirstLevel = FMath::FloorLog2(FirstLevelBitmap);
+	const uint32 SecondLevel = FMath::FloorLog2(SecondLevelBitmaps[FirstLevel]);
+	uint32 Largest = 0;
+	for (int32 Handle = FreeLists[FirstLevel][SecondLevel]; Handle != INDEX_NONE; Handle = Blocks[Handle].NextFree)
+	{
+		Largest = std::max(Largest, Blocks[Handle].Size);
+	}
+	return Largest;
+}
+
+void FTLSFAllocator::InsertFreeBlock(int32 Handle)
+{
+	uint32 FirstLevel = 0;
+	uint32 SecondLevel = 0;
+	MapInsert(Blocks[Handle].Size, FirstLevel, SecondLevel);
+
+	FBlock& Block = Blocks[Handle];
+	Block.bFree = true;
+	Block.PrevFree = INDEX_NONE;
+	Block.NextFree = FreeLists[FirstLevel][SecondLevel];
+	if (Block.NextFree != INDEX_NONE)
+	{
+		Blocks[Block.NextFree].PrevFree = Handle;
+	}
+	FreeLists[FirstLevel][SecondLevel] = Handle;
+
+	FirstLevelBitmap |= 1u << FirstLevel;
+	SecondLevelBitmaps[FirstLevel] |= 1u << SecondLevel;
+}
+
+void FTLSFAllocator::RemoveFreeBlock(int32 Handle)
+{
+	uint32 FirstLevel = 0;
+	uint32 SecondLevel = 0;
+	MapInsert(Blocks[Handle].Size, FirstLevel, SecondLevel);
+
+	FBlock& Block = Blocks[Handle];
+	if (Block.PrevFree != INDEX_NONE)
+	{
+		Blocks[Block.PrevFree].NextFree = Block.NextFree;
+	}
+	else
+	{
+		FreeLists[FirstLevel][SecondLevel] = Block.NextFree;
+	}
+	if (Block.NextFree != INDEX_NONE)
+	{
+		Blocks[Block.NextFree].PrevFree = Block.PrevFree;
+	}
+	Block.PrevFree = INDEX_NONE;
+	Block.NextFree = INDEX_NONE;
+	Block.bFree = false;
+
+	if (FreeLists[FirstLevel][SecondLevel] == INDEX_NONE)
+	{
+		SecondLevelBitmaps[FirstLevel] &= ~(1u << SecondLevel);
+		if (SecondLevelBitmaps[FirstLevel] == 0)
+		{
+			FirstLevelBitmap &= ~(1u << FirstLevel);
+		}
+	}
+}
+
+int32 FTLSFAllocator::NewBlock()
+{
+	if (!UnusedBlocks.empty())
+	{
+		const int32 Handle = UnusedBlocks.back();
+		UnusedBlocks.pop_back();
+		Blocks[Handle] = FBlock();
+		return Handle;
+	}
+
+	Blocks.emplace_back();
+	return static_cast<int32>(Blocks.size() - 1);
+}
+
+void FTLSFAllocator::DeleteBlock(int32 Handle)
+{
+	Blocks[Handle] = FBlock();
+	UnusedBlocks.push_back(Handle);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "HAL/PlatformTypes.h"
+#include "Templates/UnrealTypes.h"
+
+/**
+ * Two level segregated fit allocator over an abstract range [0, Size).
+ *
+ * Manages offsets only; what they index (bytes, vertices) is up to the
+ * caller. Free blocks are kept in lists by size class: the first level is
+ * the power of two of the size, the second splits it linearly into
+ * SecondLevelCount classes. Two bitmaps say which lists are non-empty, so
+ * both Allocate and Free are constant time, and freed blocks are merged with
+ * free neighbours right away.
+ */
+class FTLSFAllocator
+{
+public:
+	explicit FTLSFAllocator(uint32 InSize = 0);
+
+	/** Forgets every allocation; the whole range becomes one free block. */
+	void Reset(uint32 InSize);
+
+	/** @return Handle of a block of exactly Size units, or INDEX_NONE when no free block is large enough. */
+	int32 Allocate(uint32 Size);
+
+	/** Frees a block returned by Allocate. */
+	void Free(int32 Handle);
+
+	uint32 GetOffset(int32 Handle) const { return Blocks[Handle].Offset; }
+	uint32 GetAllocationSize(int32 Handle) const { return Blocks[Handle].Size; }
+
+	uint32 GetSize() const { return Size; }
+	uint32 GetUsedSize() const { return UsedSize; }
+	uint32 GetFreeSize() const { return Size - UsedSize; }
+	uint32 GetNumAllocations() const { return NumAllocations; }
+	bool IsEmpty() const { return NumAllocations == 0; }
+
+	/** @return The size of the largest free block; GetFreeSize minus this is lost to fragmentation. */
+	uint32 GetLargestFreeBlock() const;
+
+private:
+	static constexpr uint32 SecondLevelLog2 = 4;
+	static constexpr uint32 SecondLevelCount = 1u << SecondLevelLog2;
+	static constexpr uint32 FirstLevelCount = 32 - SecondLevelLog2 + 1;
+
+	struct FBlock
+	{
+		uint32 Offset = 0;
+		uint32 Size = 0;
+
+		/** Neighbours in address order, for merging. */
+		int32 PrevPhysical = INDEX_NONE;
+		int32 NextPhysical = INDEX_NONE;
+
+		/** Neighbours in the free list of the block's size class. */
+		int32 PrevFree = INDEX_NONE;
+		int32 NextFree = INDEX_NONE;
+
+		bool bFree = false;
+	};
+
+	/** Size class a block of Size units is filed under. */
+	static void MapInsert(uint32 Size, uint32& OutFirstLevel, uint32& OutSecondLevel);
+
+	/** Smallest size class whose blocks all hold Size units. */
+	static bool MapSearch(uint32 Size, uint32& OutFirstLevel, uint32& OutSecondLevel);
+
+	/** @return A non-empty free list at or above the given class, or false. */
+	bool FindFreeList(uint32& InOutFirstLevel, uint32& InOutSecondLevel) const;
+
+	void InsertFreeBlock(int32 Handle);
+	void RemoveFreeBlock(int32 Handle);
+
+	int32 NewBlock();
+	void DeleteBlock(int32 Handle);
+
+private:
+	uint32 Size = 0;
+	uint32 UsedSize = 0;
+	uint32 NumAllocations = 0;
+
+	TArray<FBlock> Blocks;
+	TArray<int32> UnusedBlocks;
+
+	uint32 FirstLevelBitmap = 0;
+	uint32 SecondLevelBitmaps[FirstLevelCount] = {};
+	int32 FreeLists[FirstLevelCount][SecondLevelCount];
+};
@@ -0,0 +1,160 @@
+/*=============================================================================
+	RenderGraphTests.cpp: FRenderGraph culling, ordering and aliasing on the Null RHI.
+
+	Needs no device or Windows SDK. Build and run from Source/Runtime:
+		g++ -std=c++17 -ICore -IRHI -IEngine Engine/Tests/RenderGraphTests.cpp Engine/RenderGraph.cpp RHI/NullRHI.cpp RHI/RHI.cpp -o RenderGraphTests && ./RenderGraphTests
+	Exits with the number of failed checks.
+=============================================================================*/
+
+#include <cstring>
+
+#include "RenderGraph.h"
+#include "NullRHI.h"
+#include "Tests/TestHarness.h"
+
+namespace
+{
+	FRenderGraphTextureDesc MakeColorDesc()
+	{
+		FRenderGraphTextureDesc Desc;
+		Desc.Width = 64;
+		Desc.Height = 64;
+		Desc.Format = PF_B8G8R8A8;
+		Desc.Flags = TexCreate_RenderTargetable | TexCreate_ShaderResource;
+		return Desc;
+	}
+
+	/** @return Whether the graph executed exactly ExpectedNames, in that order. */
+	bool ExecutedInOrder(const FRenderGraph& Graph, std::initializer_list<const char*> ExpectedNames)
+	{
+		TArray<const char*> Names;
+		Graph.GetExecutedPassNames(Names);
+		if (Names.size() != ExpectedNames.size())
+		{
+			return false;
+		}
+
+		uint32 Index = 0;
+		for (const char* Expected : ExpectedNames)
+		{
+			if (std::strcmp(Names[Index++], Expected) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void BindNothing(const FRenderGraph&, const FRenderGraphRenderTargets&)
+	{
+	}
+
+	void TestDeadPassesAreCulled()
+	{
+		FRenderGraphTexturePool Pool;
+		FRenderGraph Graph(Pool);
+		const FRenderGraphTextureRef Output = Graph.RegisterExternalTexture("Output", MakeColorDesc());
+		const FRenderGraphTextureRef Unused = Graph.CreateTexture("Unused", MakeColorDesc());
+		const FRenderGraphTextureRef UnusedBlur = Graph.CreateTexture("UnusedBlur", MakeColorDesc());
+		const FRenderGraphTextureRef Readback = Graph.CreateTexture("Readback", MakeColorDesc());
+
+		// 아무도 읽지 않는 텍스처로 이어지는 사슬은 통째로 빠진다
+		bool bDeadPassRan = false;
+		Graph.AddPass("Dead", [&](const FRenderGraph&) { bDeadPassRan = true; }).SetRenderTargets(Unused, FRenderGraphTextureRef());
+		Graph.AddPass("DeadBlur", [&](const FRenderGraph&) { bDeadPassRan = true; }).Read(Unused).SetRenderTargets(UnusedBlur, FRenderGraphTextureRef());
+		Graph.AddPass("Scene", nullptr).SetRenderTargets(Output, FRenderGraphTextureRef());
+		Graph.AddPass("Readback", nullptr, RGPF_NeverCull).Write(Readback);
+		Graph.Execute(BindNothing);
+
+		Check(ExecutedInOrder(Graph, { "Scene", "Readback" }), "only passes reaching an external texture or marked never cull run");
+		Check(!bDeadPassRan, "culled passes do not execute");
+		Check(Graph.GetStats().NumCulledPasses == 2, "stats count the culled passes");
+	}
+
+	/**
+	 * Two blurs composited into the output, declared producers first:
+	 * DrawA, DrawB, CompositeA (reads A), CompositeB (reads B).
+	 */
+	struct FTwoBlurGraph
+	{
+		FRenderGraphTextureRef A;
+		FRenderGraphTextureRef B;
+		FRHITexture2D* ResourceA = nullptr;
+		FRHITexture2D* ResourceB = nullptr;
+
+		void Build(FRenderGraph& Graph)
+		{
+			const FRenderGraphTextureRef Output = Graph.RegisterExternalTexture("Output", MakeColorDesc());
+			A = Graph.CreateTexture("A", MakeColorDesc());
+			B = Graph.CreateTexture("B", MakeColorDesc());
+
+			Graph.AddPass("DrawA", nullptr).SetRenderTargets(A, FRenderGraphTextureRef());
+			Graph.AddPass("DrawB", nullptr).SetRenderTargets(B, FRenderGraphTextureRef());
+			Graph.AddPass("CompositeA", [this](const FRenderGraph& InGraph) { ResourceA = InGraph.GetTexture(A).Resource; })
+				.Read(A).SetRenderTargets(Output, FRenderGraphTextureRef());
+			Graph.AddPass("CompositeB", [this](const FRenderGraph& InGraph) { ResourceB = InGraph.GetTexture(B).Resource; })
+				.Read(B).SetRenderTargets(Output, FRenderGraphTextureRef());
+		}
+	};
+
+	void TestTopologicalOrder()
+	{
+		FRenderGraphTexturePool Pool;
+		FRenderGraph Graph(Pool);
+		FTwoBlurGraph TwoBlurs;
+		TwoBlurs.Build(Graph);
+		Graph.Execute(BindNothing);
+
+		// 생산자 뒤에 소비자가 오고, 소비자는 자기 생산자 바로 뒤로 당겨진다
+		Check(ExecutedInOrder(Graph, { "DrawA", "CompositeA", "DrawB", "CompositeB" }), "consumers run after their producers, as early as possible");
+
+		// 앞선 패스가 읽는 텍스처를 덮어쓰는 패스는 읽기가 끝난 뒤에 돈다
+		FRenderGraph WriteAfterRead(Pool);
+		const FRenderGraphTextureRef Output = WriteAfterRead.RegisterExternalTexture("Output", MakeColorDesc());
+		const FRenderGraphTextureRef History = WriteAfterRead.RegisterExternalTexture("History", MakeColorDesc());
+		WriteAfterRead.AddPass("ReadHistory", nullptr).Read(History).SetRenderTargets(Output, FRenderGraphTextureRef());
+		WriteAfterRead.AddPass("WriteHistory", nullptr).SetRenderTargets(History, FRenderGraphTextureRef());
+		WriteAfterRead.Execute(BindNothing);
+		Check(ExecutedInOrder(WriteAfterRead, { "ReadHistory", "WriteHistory" }), "a write waits for earlier reads of the same texture");
+	}
+
+	void TestDisjointTransientsShareOneTarget()
+	{
+		FRenderGraphTexturePool Pool;
+		FRenderGraph Graph(Pool);
+		FTwoBlurGraph TwoBlurs;
+		TwoBlurs.Build(Graph);
+		Graph.Execute(BindNothing);
+
+		Check(TwoBlurs.ResourceA && TwoBlurs.ResourceA == TwoBlurs.ResourceB, "transients with disjoint lifetimes alias one pooled texture");
+		Check(Graph.GetStats().NumTransientTextures == 2 && Graph.GetStats().NumPooledTextures == 1, "stats count two transients backed by one texture");
+		Check(Pool.Num() == 1, "the pool created a single texture");
+
+		// 수명이 겹치면 같은 텍스처를 나눠 쓸 수 없다
+		FRenderGraph Overlapping(Pool);
+		const FRenderGraphTextureRef Output = Overlapping.RegisterExternalTexture("Output", MakeColorDesc());
+		const FRenderGraphTextureRef A = Overlapping.CreateTexture("A", MakeColorDesc());
+		const FRenderGraphTextureRef B = Overlapping.CreateTexture("B", MakeColorDesc());
+		Overlapping.AddPass("DrawA", nullptr).SetRenderTargets(A, FRenderGraphTextureRef());
+		Overlapping.AddPass("DrawB", nullptr).SetRenderTargets(B, FRenderGraphTextureRef());
+		Overlapping.AddPass("Composite", nullptr).Read(A).Read(B).SetRenderTargets(Output, FRenderGraphTextureRef());
+		Overlapping.Execute(BindNothing);
+
+		Check(Overlapping.GetStats().NumPooledTextures == 2 && Pool.Num() == 2, "transients alive at the same time get separate textures");
+	}
+}
+
+int main()
+{
+	FNullDynamicRHI NullRHI;
+	GDynamicRHI = &NullRHI;
+
+	TestDeadPassesAreCulled();
+	TestTopologicalOrder();
+	TestDisjointTransientsShareOneTarget();
+
+	FRHIResource::FlushAllPendingDeletes();
+	GDynamicRHI = nullptr;
+
+	return ReportTestResults("RenderGraphTests");
+}
@@ -0,0 +1,113 @@
+/*=============================================================================
+	TLSFAllocatorTests.cpp: FTLSFAllocator allocation, freeing and merging.
+
+	Needs no device or Windows SDK. Build and run from Source/Runtime:
+		g++ -std=c++17 -ICore -IEngine Engine/Tests/TLSFAllocatorTests.cpp Engine/TLSFAllocator.cpp -o TLSFAllocatorTests && ./TLSFAllocatorTests
+	Exits with the number of failed checks.
+=============================================================================*/
+
+#include "TLSFAllocator.h"
+#include "Tests/TestHarness.h"
+
+namespace
+{
+	/** @return Whether the blocks lie inside the allocator's range without overlapping. */
+	bool AreDisjoint(const FTLSFAllocator& Allocator, const TArray<int32>& Handles)
+	{
+		for (uint32 Index = 0; Index < Handles.size(); ++Index)
+		{
+			const uint32 Begin = Allocator.GetOffset(Handles[Index]);
+			const uint32 End = Begin + Allocator.GetAllocationSize(Handles[Index]);
+			if (End > Allocator.GetSize())
+			{
+				return false;
+			}
+			for (uint32 OtherIndex = Index + 1; OtherIndex < Handles.size(); ++OtherIndex)
+			{
+				const uint32 OtherBegin = Allocator.GetOffset(Handles[OtherIndex]);
+				const uint32 OtherEnd = OtherBegin + Allocator.GetAllocationSize(Handles[OtherIndex]);
+				if (Begin < OtherEnd && OtherBegin < End)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void TestAllocateAndFree()
+	{
+		FTLSFAllocator Allocator(1024);
+		const TArray<int32> Handles = { Allocator.Allocate(100), Allocator.Allocate(200), Allocator.Allocate(300) };
+
+		Check(Handles[0] != INDEX_NONE && Handles[1] != INDEX_NONE && Handles[2] != INDEX_NONE, "blocks that fit are allocated");
+		Check(Allocator.GetAllocationSize(Handles[1]) == 200, "a block has exactly the requested size");
+		Check(AreDisjoint(Allocator, Handles), "blocks are inside the range and do not overlap");
+		Check(Allocator.GetUsedSize() == 600 && Allocator.GetNumAllocations() == 3, "used size and count follow the allocations");
+		Check(Allocator.Allocate(1024) == INDEX_NONE, "a block larger than any free block fails");
+
+		Allocator.Free(Handles[1]);
+		Check(Allocator.GetUsedSize() == 400 && Allocator.GetNumAllocations() == 2, "freeing gives the block back");
+		const int32 Refill = Allocator.Allocate(200);
+		Check(Refill != INDEX_NONE && Allocator.GetOffset(Refill) == Allocator.GetOffset(Handles[0]) + 100, "the freed block's range is handed out again");
+	}
+
+	void TestFreeMergesNeighbours()
+	{
+		FTLSFAllocator Allocator(1024);
+		const int32 First = Allocator.Allocate(256);
+		const int32 Second = Allocator.Allocate(256);
+		const int32 Third = Allocator.Allocate(256);
+
+		// 가운데만 풀면 양옆이 잡혀 있어 합칠 곳이 없다
+		Allocator.Free(Second);
+		Check(Allocator.GetLargestFreeBlock() == 256, "a freed block between used ones stays on its own");
+
+		// 세 번째를 풀면 가운데와 끝의 빈 공간이 하나로 합쳐진다
+		Allocator.Free(Third);
+		Check(Allocator.GetLargestFreeBlock() == 768, "a freed block merges with free neighbours on both sides");
+
+		Allocator.Free(First);
+		Check(Allocator.IsEmpty() && Allocator.GetLargestFreeBlock() == 1024, "freeing everything leaves one block of the whole range");
+		Check(Allocator.Allocate(1024) != INDEX_NONE, "the whole range can be allocated again");
+	}
+
+	void TestFragmentation()
+	{
+		FTLSFAllocator Allocator(1024);
+		TArray<int32> Handles;
+		for (uint32 Index = 0; Index < 8; ++Index)
+		{
+			Handles.push_back(Allocator.Allocate(128));
+		}
+		Check(Allocator.GetFreeSize() == 0 && Allocator.Allocate(1) == INDEX_NONE, "a full range has nothing left");
+
+		for (uint32 Index = 0; Index < Handles.size(); Index += 2)
+		{
+			Allocator.Free(Handles[Index]);
+		}
+		Check(Allocator.GetFreeSize() == 512 && Allocator.GetLargestFreeBlock() == 128, "every other block freed leaves only small holes");
+		Check(Allocator.Allocate(256) == INDEX_NONE, "no hole takes a block larger than itself");
+
+		const int32 Reused = Allocator.Allocate(128);
+		Check(Reused != INDEX_NONE && Allocator.GetOffset(Reused) % 256 == 0, "a hole of the right size is reused");
+	}
+
+	void TestReset()
+	{
+		FTLSFAllocator Allocator(64);
+		Allocator.Allocate(64);
+		Allocator.Reset(4096);
+		Check(Allocator.IsEmpty() && Allocator.GetSize() == 4096 && Allocator.GetLargestFreeBlock() == 4096, "Reset forgets every block");
+	}
+}
+
+int main()
+{
+	TestAllocateAndFree();
+	TestFreeMergesNeighbours();
+	TestFragmentation();
+	TestReset();
+
+	return ReportTestResults("TLSFAllocatorTests");
+}
@@ -0,0 +1,111 @@
+/*=============================================================================
+	VertexBufferArenaTests.cpp: FVertexBufferArena sub-allocation and defragmentation on the software RHI.
+
+	Needs no device or Windows SDK. Build and run from Source/Runtime:
+		g++ -std=c++17 -ICore -IRHI -IEngine Engine/Tests/VertexBufferArenaTests.cpp Engine/VertexBufferArena.cpp Engine/TLSFAllocator.cpp Engine/ResourceUploadQueue.cpp RHI/SoftwareRHI.cpp RHI/SoftwareRasterizer.cpp RHI/RHI.cpp Core/Async/TaskPool.cpp -lpthread -o VertexBufferArenaTests && ./VertexBufferArenaTests
+	Exits with the number of failed checks.
+=============================================================================*/
+
+#include <cstring>
+
+#include "VertexBufferArena.h"
+#include "ResourceUploadQueue.h"
+#include "SoftwareRHI.h"
+#include "Tests/TestHarness.h"
+
+namespace
+{
+	constexpr uint32 Stride = 16;
+	constexpr uint32 NumPageVertices = FVertexBufferArena::BufferSize / Stride;
+
+	/** Static vertex data stand-in: NumVertices vertices whose bytes are all Fill. */
+	TArray<uint8> MakeVertices(uint32 NumVertices, uint8 Fill)
+	{
+		return TArray<uint8>(static_cast<size_t>(NumVertices) * Stride, Fill);
+	}
+
+	/** Runs the uploads and the deferred deletes a frame would. */
+	void EndFrame()
+	{
+		FResourceUploadQueue::GetInst().Flush();
+		FRHIResource::FlushAllPendingDeletes();
+	}
+
+	/** @return Whether the allocation's range of its buffer holds Vertices. */
+	bool HoldsVertices(const FVertexBufferAllocation* Allocation, const TArray<uint8>& Vertices)
+	{
+		const FSoftwareVertexBuffer* Buffer = static_cast<const FSoftwareVertexBuffer*>(Allocation->GetVertexBuffer());
+		return Buffer && Allocation->GetOffset() + Allocation->GetSize() <= Buffer->Data.size() && Allocation->GetSize() == Vertices.size()
+			&& std::memcmp(Buffer->Data.data() + Allocation->GetOffset(), Vertices.data(), Vertices.size()) == 0;
+	}
+
+	void TestAllocationsShareABuffer()
+	{
+		const TArray<uint8> CubeVertices = MakeVertices(36, 0x11);
+		const TArray<uint8> SphereVertices = MakeVertices(960, 0x22);
+
+		TRefCountPtr<FVertexBufferAllocation> Cube = FVertexBufferArena::GetInst().Allocate(CubeVertices.data(), 36, Stride);
+		TRefCountPtr<FVertexBufferAllocation> Sphere = FVertexBufferArena::GetInst().Allocate(SphereVertices.data(), 960, Stride);
+		EndFrame();
+
+		Check(Cube && Sphere && Cube->GetVertexBuffer() == Sphere->GetVertexBuffer(), "small meshes are ranges of one buffer");
+		Check(Cube->GetFirstVertex() + 36 <= Sphere->GetFirstVertex() || Sphere->GetFirstVertex() + 960 <= Cube->GetFirstVertex(), "the ranges do not overlap");
+		Check(HoldsVertices(Cube, CubeVertices) && HoldsVertices(Sphere, SphereVertices), "each range is uploaded with its vertices");
+
+		Cube = nullptr;
+		Sphere = nullptr;
+		EndFrame();
+		Check(FVertexBufferArena::GetInst().GetStats().NumBuffers == 0, "the buffer is released with its last range");
+	}
+
+	void TestDefragmentMovesAndReportsAllocations()
+	{
+		// 첫 버퍼에 1/2과 1/4, 남은 1/4에 들어가지 않는 3/8은 두 번째 버퍼로 간다
+		const TArray<uint8> LargeVertices = MakeVertices(NumPageVertices / 2, 0x33);
+		const TArray<uint8> SmallVertices = MakeVertices(NumPageVertices / 4, 0x44);
+		const TArray<uint8> SpilledVertices = MakeVertices(NumPageVertices * 3 / 8, 0x55);
+
+		TRefCountPtr<FVertexBufferAllocation> Large = FVertexBufferArena::GetInst().Allocate(LargeVertices.data(), NumPageVertices / 2, Stride);
+		TRefCountPtr<FVertexBufferAllocation> Small = FVertexBufferArena::GetInst().Allocate(SmallVertices.data(), NumPageVertices / 4, Stride);
+		TRefCountPtr<FVertexBufferAllocation> Spilled = FVertexBufferArena::GetInst().Allocate(SpilledVertices.data(), NumPageVertices * 3 / 8, Stride);
+		EndFrame();
+		Check(FVertexBufferArena::GetInst().GetStats().NumBuffers == 2 && Spilled->GetVertexBuffer() != Small->GetVertexBuffer(), "a range that does not fit goes to a second buffer");
+
+		TArray<const FVertexBufferAllocation*> Moved;
+		Check(FVertexBufferArena::GetInst().Defragment(Moved) == 0 && Moved.empty(), "nothing moves while the free space is barely fragmented");
+
+		// 큰 메시를 풀면 첫 버퍼가 더 비어 있다. 작은 메시를 두 번째 버퍼로 옮겨 첫 버퍼를 돌려줄 수 있다
+		Large = nullptr;
+		EndFrame();
+
+		FRHIVertexBuffer* const OldBuffer = Small->GetVertexBuffer();
+		Check(FVertexBufferArena::GetInst().Defragment(Moved) == 1, "defragmenting moves the range out of the emptier buffer");
+		Check(Moved.size() == 1 && Moved[0] == Small.GetReference(), "the moved allocation is reported");
+		Check(Small->GetVertexBuffer() != OldBuffer && Small->GetVertexBuffer() == Spilled->GetVertexBuffer(), "the moved allocation reads back its new buffer");
+
+		EndFrame();
+		Check(HoldsVertices(Small, SmallVertices), "the new range is uploaded again from the source data");
+		Check(HoldsVertices(Spilled, SpilledVertices), "ranges that stayed keep their vertices");
+		Check(FVertexBufferArena::GetInst().GetStats().NumBuffers == 1, "the emptied buffer is released once its old range retires");
+
+		Small = nullptr;
+		Spilled = nullptr;
+		EndFrame();
+		Check(FVertexBufferArena::GetInst().GetStats().NumBuffers == 0, "every buffer is released with the last range");
+	}
+}
+
+int main()
+{
+	FSoftwareDynamicRHI SoftwareRHI(8, 8);
+	SoftwareRHI.Init();
+	GDynamicRHI = &SoftwareRHI;
+
+	TestAllocationsShareABuffer();
+	TestDefragmentMovesAndReportsAllocations();
+
+	FRHIResource::FlushAllPendingDeletes();
+	GDynamicRHI = nullptr;
+
+	return ReportTestResults("VertexBufferArenaTests");
+}
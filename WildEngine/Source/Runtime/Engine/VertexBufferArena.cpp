@@ -0,0 +1,253 @@
+#include "VertexBufferArena.h"
+
+#include <algorithm>
+
+#include "ResourceUploadQueue.h"
+
+FVertexBufferAllocation::~FVertexBufferAllocation()
+{
+	if (Arena)
+	{
+		Arena->Free(*this);
+	}
+}
+
+uint32 FVertexBufferAllocation::GetOffset() const
+{
+	return FirstVertex * Stride;
+}
+
+uint32 FVertexBufferAllocation::GetSize() const
+{
+	return NumVertices * Stride;
+}
+
+FVertexBufferAllocation* FVertexBufferArena::Allocate(const void* Data, uint32 NumVertices, uint32 Stride)
+{
+	if (NumVertices == 0 || Stride == 0)
+	{
+		return nullptr;
+	}
+
+	FVertexBufferAllocation* Allocation = new FVertexBufferAllocation();
+	Allocation->NumVertices = NumVertices;
+	Allocation->Stride = Stride;
+	Allocation->SourceData = Data;
+
+	std::lock_guard<std::mutex> Lock(Mutex);
+	if (!AllocateRange(*Allocation, INDEX_NONE, true))
+	{
+		delete Allocation;
+		return nullptr;
+	}
+	Allocation->Arena = this;
+
+	QueueUpload(*Allocation);
+	return Allocation;
+}
+
+bool FVertexBufferArena::AllocateRange(FVertexBufferAllocation& Allocation, int32 ExcludedPage, bool bAllowNewPage)
+{
+	// 앞쪽 페이지부터 채워 뒤쪽 페이지가 비워질 수 있게 한다
+	int32 Block = INDEX_NONE;
+	uint32 PageIndex = 0;
+	for (; PageIndex < Pages.size(); ++PageIndex)
+	{
+		FPage* Page = Pages[PageIndex].get();
+		if (Page && static_cast<int32>(PageIndex) != ExcludedPage && Page->Stride == Allocation.Stride)
+		{
+			Block = Page->Allocator.Allocate(Allocation.NumVertices);
+			if (Block != INDEX_NONE)
+			{
+				break;
+			}
+		}
+	}
+
+	if (Block == INDEX_NONE)
+	{
+		if (!bAllowNewPage)
+		{
+			return false;
+		}
+
+		// 페이지보다 큰 메시는 자기 크기의 버퍼를 따로 받는다
+		const uint32 NumPageVertices = std::max(BufferSize / Allocation.Stride, Allocation.NumVertices);
+		std::unique_ptr<FPage> Page = std::make_unique<FPage>();
+		Page->VertexBuffer = FResourceUploadQueue::GetInst().CreateVertexBuffer(nullptr, NumPageVertices * Allocation.Stride);
+		if (!Page->VertexBuffer)
+		{
+			return false;
+		}
+		Page->Stride = Allocation.Stride;
+		Page->Allocator.Reset(NumPageVertices);
+		Block = Page->Allocator.Allocate(Allocation.NumVertices);
+		if (Block == INDEX_NONE)
+		{
+			return false;
+		}
+
+		// 해제된 페이지 자리를 다시 쓴다
+		PageIndex = static_cast<uint32>(std::find(Pages.begin(), Pages.end(), nullptr) - Pages.begin());
+		if (PageIndex == Pages.size())
+		{
+			Pages.push_back(std::move(Page));
+		}
+		else
+		{
+			Pages[PageIndex] = std::move(Page);
+		}
+	}
+
+	FPage& Page = *Pages[PageIndex];
+	Allocation.VertexBuffer = Page.VertexBuffer;
+	Allocation.PageIndex = PageIndex;
+	Allocation.IndexInPage = static_cast<uint32>(Page.Allocations.size());
+	Allocation.Block = Block;
+	Allocation.FirstVertex = Page.Allocator.GetOffset(Block);
+	Page.Allocations.push_back(&Allocation);
+	return true;
+}
+
+void FVertexBufferArena::FreeRange(FVertexBufferAllocation& Allocation)
+{
+	FPage& Page = *Pages[Allocation.PageIndex];
+	Page.Allocator.Free(Allocation.Block);
+
+	FVertexBufferAllocation* Last = Page.Allocations.back();
+	Page.Allocations[Allocation.IndexInPage] = Last;
+	Last->IndexInPage = Allocation.IndexInPage;
+	Page.Allocations.pop_back();
+
+	if (Page.Allocator.IsEmpty())
+	{
+		// 버퍼도 지연 삭제 큐를 거친다
+		Pages[Allocation.PageIndex].reset();
+	}
+
+	Allocation.VertexBuffer = nullptr;
+	Allocation.Block = INDEX_NONE;
+}
+
+void FVertexBufferArena::Free(FVertexBufferAllocation& Allocation)
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+	FreeRange(Allocation);
+}
+
+void FVertexBufferArena::QueueUpload(const FVertexBufferAllocation& Allocation)
+{
+	if (Allocation.SourceData)
+	{
+		// 페이지 생성 요청 뒤에 쌓이므로 버퍼가 만들어진 다음에 채워진다
+		FResourceUploadQueue::GetInst().UpdateVertexBuffer(Allocation.VertexBuffer, Allocation.GetOffset(), Allocation.SourceData, Allocation.GetSize());
+		++NumUploads;
+		UploadedBytes += Allocation.GetSize();
+	}
+}
+
+uint32 FVertexBufferArena::Defragment(TArray<const FVertexBufferAllocation*>& OutMovedAllocations, uint32 MaxBytesToMove, float MinFragmentation)
+{
+	// 옮긴 뒤 남는 옛 구간들. 락 밖에서 놓아야 지연 삭제 큐로 넘어간다
+	TArray<TRefCountPtr<FVertexBufferAllocation>> OldRanges;
+	uint32 NumMoved = 0;
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+
+		// 가장 덜 찬 페이지를 비워 통째로 돌려준다
+		uint32 NumPages = 0;
+		uint64 FreeVertices = 0;
+		uint64 LargestFreeVertices = 0;
+		int32 SourcePage = INDEX_NONE;
+		for (uint32 PageIndex = 0; PageIndex < Pages.size(); ++PageIndex)
+		{
+			const FPage* Page = Pages[PageIndex].get();
+			if (!Page)
+			{
+				continue;
+			}
+			++NumPages;
+			FreeVertices += Page->Allocator.GetFreeSize();
+			LargestFreeVertices = std::max<uint64>(LargestFreeVertices, Page->Allocator.GetLargestFreeBlock());
+			if (SourcePage == INDEX_NONE || Page->Allocator.GetUsedSize() < Pages[SourcePage]->Allocator.GetUsedSize())
+			{
+				SourcePage = static_cast<int32>(PageIndex);
+			}
+		}
+
+		const float Fragmentation = FreeVertices > 0 ? 1.0f - static_cast<float>(LargestFreeVertices) / static_cast<float>(FreeVertices) : 0.0f;
+		if (NumPages < 2 || Fragmentation < MinFragmentation)
+		{
+			return 0;
+		}
+
+		// 다른 페이지에 다 들어가지 않으면 옮겨 봐야 페이지를 돌려줄 수 없다
+		FPage& Source = *Pages[SourcePage];
+		if (FreeVertices - Source.Allocator.GetFreeSize() < Source.Allocator.GetUsedSize())
+		{
+			return 0;
+		}
+
+		uint32 MovedBytes = 0;
+		for (uint32 Index = static_cast<uint32>(Source.Allocations.size()); Index-- > 0 && MovedBytes < MaxBytesToMove;)
+		{
+			FVertexBufferAllocation& Allocation = *Source.Allocations[Index];
+
+			// 이미 해제되어 지연 삭제를 기다리거나 다시 올릴 데이터가 없는 구간은 두고 간다
+			if (Allocation.GetRefCount() == 0 || !Allocation.SourceData)
+			{
+				continue;
+			}
+
+			// 새 자리를 잡은 임시 할당과 구간을 맞바꾼다. 옛 구간은 임시 할당과 함께 놓인다
+			TRefCountPtr<FVertexBufferAllocation> OldRange = new FVertexBufferAllocation();
+			OldRange->NumVertices = Allocation.NumVertices;
+			OldRange->Stride = Allocation.Stride;
+			if (!AllocateRange(*OldRange, SourcePage, false))
+			{
+				break;
+			}
+			OldRange->Arena = this;
+
+			FPage& Target = *Pages[OldRange->PageIndex];
+			std::swap(Allocation.VertexBuffer, OldRange->VertexBuffer);
+			std::swap(Allocation.PageIndex, OldRange->PageIndex);
+			std::swap(Allocation.IndexInPage, OldRange->IndexInPage);
+			std::swap(Allocation.Block, OldRange->Block);
+			std::swap(Allocation.FirstVertex, OldRange->FirstVertex);
+			Target.Allocations[Allocation.IndexInPage] = &Allocation;
+			Source.Allocations[OldRange->IndexInPage] = OldRange.GetReference();
+
+			QueueUpload(Allocation);
+			OldRanges.push_back(OldRange);
+			OutMovedAllocations.push_back(&Allocation);
+			MovedBytes += Allocation.GetSize();
+			++NumMoved;
+		}
+		NumMovedAllocations += NumMoved;
+	}
+
+	return NumMoved;
+}
+
+FVertexBufferArenaStats FVertexBufferArena::GetStats() const
+{
+	std::lock_guard<std::mutex> Lock(Mutex);
+
+	FVertexBufferArenaStats Stats;
+	for (const std::unique_ptr<FPage>& Page : Pages)
+	{
+		if (Page)
+		{
+			++Stats.NumBuffers;
+			Stats.NumAllocations += Page->Allocator.GetNumAllocations();
+			Stats.AllocatedBytes += static_cast<uint64>(Page->Allocator.GetUsedSize()) * Page->Stride;
+			Stats.FreeBytes += static_cast<uint64>(Page->Allocator.GetFreeSize()) * Page->Stride;
+			Stats.LargestFreeBytes = std::max<uint64>(Stats.LargestFreeBytes, static_cast<uint64>(Page->Allocator.GetLargestFreeBlock()) * Page->Stride);
+		}
+	}
+	Stats.NumMovedAllocations = NumMovedAllocations;
+	Stats.NumUploads = NumUploads;
+	Stats.UploadedBytes = UploadedBytes;
+	return Stats;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include "RHI.h"
+#include "Templates/RefCounting.h"
+#include "Templates/UnrealTypes.h"
+#include "Interface/ISingleton.h"
+#include "TLSFAllocator.h"
+
+class FVertexBufferArena;
+
+/**
+ * A range of vertices in one of the arena's vertex buffers.
+ *
+ * Refcounted like an RHI resource and released through the same deferred
+ * delete queue, so the range is only handed out again once no frame in
+ * flight can draw from it. Defragmentation may move it to another buffer;
+ * read the buffer and first vertex again when FVertexBufferArena::Defragment
+ * reports it moved.
+ */
+class FVertexBufferAllocation : public FRHIResource
+{
+public:
+	~FVertexBufferAllocation() override;
+
+	FRHIVertexBuffer* GetVertexBuffer() const { return VertexBuffer; }
+
+	/** The first vertex of the range, for BaseVertexIndex. */
+	uint32 GetFirstVertex() const { return FirstVertex; }
+	uint32 GetNumVertices() const { return NumVertices; }
+
+	/** The range in bytes. */
+	uint32 GetOffset() const;
+	uint32 GetSize() const;
+
+private:
+	friend class FVertexBufferArena;
+	FVertexBufferAllocation() = default;
+
+	FVertexBufferArena* Arena = nullptr;
+	FRHIVertexBuffer* VertexBuffer = nullptr;
+	uint32 Stride = 0;
+
+	/** Where the range lives in the arena. */
+	uint32 PageIndex = 0;
+	uint32 IndexInPage = 0;
+	int32 Block = INDEX_NONE;
+	uint32 FirstVertex = 0;
+	uint32 NumVertices = 0;
+
+	/** Kept to upload the range again when it moves. Must outlive the allocation. */
+	const void* SourceData = nullptr;
+};
+
+/** Memory of the arena at one point, for stats output and to decide when to defragment. */
+struct FVertexBufferArenaStats
+{
+	uint32 NumBuffers = 0;
+	uint32 NumAllocations = 0;
+	uint64 AllocatedBytes = 0;
+	uint64 FreeBytes = 0;
+
+	/** The largest range one allocation could still get without a new buffer. */
+	uint64 LargestFreeBytes = 0;
+
+	/** Totals since startup. */
+	uint64 NumMovedAllocations = 0;
+	uint64 NumUploads = 0;
+	uint64 UploadedBytes = 0;
+
+	/** @return The share of free bytes not in the largest free range, 0 (none) to 1. */
+	float GetFragmentation() const
+	{
+		return FreeBytes > 0 ? 1.0f - static_cast<float>(LargestFreeBytes) / static_cast<float>(FreeBytes) : 0.0f;
+	}
+};
+
+/**
+ * Static vertex data sub-allocated out of a few large vertex buffers.
+ *
+ * Each buffer is managed by a TLSF allocator in units of vertices, so a small
+ * mesh costs a range instead of a driver allocation of its own, and meshes
+ * that share a buffer are drawn without rebinding it. A mesh larger than a
+ * buffer gets a buffer of its own size.
+ *
+ * Allocate does not touch the device: new buffers and the contents of new
+ * ranges go through FResourceUploadQueue and exist before the frame that
+ * first draws them. The caller's vertex data must stay valid as long as the
+ * allocation does (static mesh data), to upload it again when the range
+ * moves. Freed ranges go back to their buffer on whichever thread flushes the
+ * deferred delete queue; a buffer is released when its last range is freed.
+ */
+class FVertexBufferArena : public ISingleton<FVertexBufferArena>
+{
+public:
+	/** Bytes of one arena buffer. */
+	static constexpr uint32 BufferSize = 1024 * 1024;
+
+	/** Any thread. @return A range holding NumVertices vertices of Stride bytes, filled with Data before the next frame. Null if the RHI fails. */
+	FVertexBufferAllocation* Allocate(const void* Data, uint32 NumVertices, uint32 Stride);
+
+	/**
+	 * Game thread. Moves allocations out of the emptiest buffer into the
+	 * others, at most MaxBytesToMove bytes per call, so that buffer can be
+	 * released. Only runs while fragmentation is above MinFragmentation.
+	 * Moved ranges are uploaded again from their source data and the old
+	 * ones freed once no frame in flight uses them.
+	 * @param OutMovedAllocations Gets the moved allocations appended; their holders must pick up the new buffer and first vertex.
+	 * @return The number of allocations moved.
+	 */
+	uint32 Defragment(TArray<const FVertexBufferAllocation*>& OutMovedAllocations, uint32 MaxBytesToMove = 256 * 1024, float MinFragmentation = 0.25f);
+
+	FVertexBufferArenaStats GetStats() const;
+
+private:
+	friend class ISingleton<FVertexBufferArena>;
+	friend class FVertexBufferAllocation;
+	FVertexBufferArena() = default;
+
+	struct FPage
+	{
+		TRefCountPtr<FRHIVertexBuffer> VertexBuffer;
+		uint32 Stride = 0;
+		FTLSFAllocator Allocator;
+
+		/** Allocations living in this page, for Defragment. */
+		TArray<FVertexBufferAllocation*> Allocations;
+	};
+
+	/**
+	 * Places Allocation (NumVertices and Stride set) in a page of its stride
+	 * other than ExcludedPage, creating a page if bAllowNewPage. Expects Mutex held.
+	 */
+	bool AllocateRange(FVertexBufferAllocation& Allocation, int32 ExcludedPage, bool bAllowNewPage);
+
+	/** Takes Allocation out of its page; the page is released once it is empty. Expects Mutex held. */
+	void FreeRange(FVertexBufferAllocation& Allocation);
+
+	/** Rendering thread, from the deferred delete queue. */
+	void Free(FVertexBufferAllocation& Allocation);
+
+	/** Queues the range's contents for upload. Expects Mutex held. */
+	void QueueUpload(const FVertexBufferAllocation& Allocation);
+
+private:
+	/** Guards everything below; Free comes from the deferred delete queue on the rendering thread. */
+	mutable std::mutex Mutex;
+
+	/** Released pages stay null so page indices of live allocations keep pointing at the right page. */
+	TArray<std::unique_ptr<FPage>> Pages;
+
+	uint64 NumMovedAllocations = 0;
+	uint64 NumUploads = 0;
+	uint64 UploadedBytes = 0;
+};
@@ -1 +1,276 @@
 ﻿#include "World.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "json.hpp"
+#include "Scene.h"
+#include "Components/PrimitiveComponent.h"
+
+UWorld::UWorld(URenderer* InRenderer, UScene* InScene)
+    : Renderer(InRenderer), Scene(InScene)
+{
+}
+
+UWorld::~UWorld()
+{
+    CloseWorld();
+}
+
+bool UWorld::OpenWorld(const FString& WorldName)
+{
+    CloseWorld();
+
+    std::ifstream inFile(WorldName + ".World");
+    if (!inFile.is_open())
+    {
+        return false;
+    }
+
+    FString jsonData((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    json::JSON World = json::JSON::Load(jsonData);
+
+    CellSize = static_cast<float>(World["CellSize"].ToFloat());
+    if (CellSize <= 0.0f)
+    {
+        CellSize = 0.0f;
+        return false;
+    }
+
+    json::JSON Cells = World["Cells"];
+    for (auto& Cell : Cells.ArrayRange())
+    {
+        Levels.push_back(std::make_unique<ULevel>(
+            static_cast<int32>(Cell["X"].ToInt()),
+            static_cast<int32>(Cell["Y"].ToInt()),
+            Cell["File"].ToString()));
+    }
+
+    return true;
+}
+
+void UWorld::CloseWorld()
+{
+    for (std::unique_ptr<ULevel>& Level : Levels)
+    {
+        UnloadLevel(*Level);
+    }
+    Levels.clear();
+    CellSize = 0.0f;
+}
+
+void UWorld::Tick(const FVector& StreamingSource)
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+
+    LoadCandidates.clear();
+    LoadingLevels.clear();
+    uint32 NumParsing = 0;
+
+    for (std::unique_ptr<ULevel>& Level : Levels)
+    {
+        const float Distance = GetDistanceToCell(*Level, StreamingSource);
+
+        switch (Level->GetState())
+        {
+        case ELevelStreamingState::Unloaded:
+            if (Distance <= Settings.LoadRadius)
+            {
+                LoadCandidates.push_back({ Distance, Level.get() });
+            }
+            break;
+
+        case ELevelStreamingState::Parsing:
+            // 파싱 중에는 멀어져도 기다리지 않는다. 끝난 뒤에 버린다
+            if (Distance > Settings.UnloadRadius && Level->IsParseFinished())
+            {
+                UnloadLevel(*Level);
+            }
+            else
+            {
+                ++NumParsing;
+                LoadingLevels.push_back({ Distance, Level.get() });
+            }
+            break;
+
+        case ELevelStreamingState::Creating:
+        case ELevelStreamingState::Loaded:
+            if (Distance > Settings.UnloadRadius)
+            {
+                UnloadLevel(*Level);
+            }
+            else if (Level->GetState() == ELevelStreamingState::Creating)
+            {
+                LoadingLevels.push_back({ Distance, Level.get() });
+            }
+            break;
+        }
+    }
+
+    // 가까운 셀부터 백그라운드 파싱 시작
+    std::sort(LoadCandidates.begin(), LoadCandidates.end(),
+        [](const TPair<float, ULevel*>& A, const TPair<float, ULevel*>& B) { return A.first < B.first; });
+    for (const TPair<float, ULevel*>& Candidate : LoadCandidates)
+    {
+        if (NumParsing >= Settings.MaxConcurrentParses)
+        {
+            break;
+        }
+        Candidate.second->BeginLoad();
+        ++NumParsing;
+    }
+
+    // 오브젝트 생성은 게임 스레드에서 프레임당 예산만큼만, 가까운 셀부터
+    std::sort(LoadingLevels.begin(), LoadingLevels.end(),
+        [](const TPair<float, ULevel*>& A, const TPair<float, ULevel*>& B) { return A.first < B.first; });
+
+    const auto EndTime = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(static_cast<int64>(Settings.CreationBudgetMs * 1000.0f));
+    for (const TPair<float, ULevel*>& Loading : LoadingLevels)
+    {
+        if (std::chrono::steady_clock::now() >= EndTime)
+        {
+            break;
+        }
+        // 다 만들어진 셀의 정적 지오메트리는 다음 Scene Tick에서 병합
+        if (Loading.second->TickLoad(Renderer, EndTime) && Scene)
+        {
+            Scene->RequestMergeStaticMeshes();
+        }
+    }
+}
+
+uint32 UWorld::GetNumLoadedLevels() const
+{
+    uint32 NumLoaded = 0;
+    for (const std::unique_ptr<ULevel>& Level : Levels)
+    {
+        if (Level->GetState() == ELevelStreamingState::Loaded)
+        {
+            ++NumLoaded;
+        }
+    }
+    return NumLoaded;
+}
+
+float UWorld::GetDistanceToCell(const ULevel& Level, const FVector& Location) const
+{
+    const float MinX = Level.GetCellX() * CellSize;
+    const float MinY = Level.GetCellY() * CellSize;
+
+    const float DX = std::max(std::max(MinX - Location.X, 0.0f), Location.X - (MinX + CellSize));
+    const float DY = std::max(std::max(MinY - Location.Y, 0.0f), Location.Y - (MinY + CellSize));
+
+    return std::sqrt(DX * DX + DY * DY);
+}
+
+void UWorld::UnloadLevel(ULevel& Level)
+{
+    // 선택된 오브젝트가 사라지면 기즈모가 해제된 메모리를 가리키게 된다
+    if (Scene && Scene->GetSelectedObject() && Level.OwnsComponent(Scene->GetSelectedObject()))
+    {
+        Scene->SetSelectedObject(nullptr);
+    }
+
+    Level.Unload();
+}
+
+namespace
+{
+    void WriteLevelObject(json::JSON& Primitives, USceneComponent* Component)
+    {
+        const FString TypeName = ULevel::GetComponentTypeName(Component);
+        if (!TypeName.empty())
+        {
+            FString key = std::to_string(Component->UUID);
+            Primitives[key]["Location"] = json::FVectorToJSON(Component->GetRelativeLocation());
+            Primitives[key]["Rotation"] = json::FVectorToJSON(Component->GetRelativeRotation());
+            Primitives[key]["Scale"] = json::FVectorToJSON(Component->GetRelativeScale3D());
+            Primitives[key]["Type"] = TypeName;
+            if (USceneComponent* Parent = Component->GetAttachParent())
+            {
+                Primitives[key]["Parent"] = Parent->UUID;
+            }
+            if (UPrimitiveComponent* Primitive = dynamic_cast<UPrimitiveComponent*>(Component))
+            {
+                if (Primitive->Mobility == EComponentMobility::Movable)
+                {
+                    Primitives[key]["Mobility"] = "Movable";
+                }
+            }
+        }
+
+        for (USceneComponent* Child : Component->GetAttachChildren())
+        {
+            WriteLevelObject(Primitives, Child);
+        }
+    }
+}
+
+bool UWorld::SaveWorld(const FString& WorldName, float CellSize, const TArray<UObject*>& Objects)
+{
+    if (CellSize <= 0.0f)
+    {
+        return false;
+    }
+
+    // 루트 컴포넌트 위치로 셀을 정하고 자식은 루트와 같은 셀에 저장
+    TMap<uint64, json::JSON> CellPrimitives;
+    TMap<uint64, TPair<int32, int32>> CellCoords;
+    for (UObject* Object : Objects)
+    {
+        USceneComponent* Component = dynamic_cast<USceneComponent*>(Object);
+        if (!Component || Component->GetAttachParent() || ULevel::GetComponentTypeName(Component).empty())
+        {
+            continue;
+        }
+
+        const FVector& Location = Component->GetRelativeLocation();
+        const int32 CellX = static_cast<int32>(std::floor(Location.X / CellSize));
+        const int32 CellY = static_cast<int32>(std::floor(Location.Y / CellSize));
+        const uint64 CellKey = (static_cast<uint64>(static_cast<uint32>(CellX)) << 32) | static_cast<uint32>(CellY);
+
+        CellCoords[CellKey] = { CellX, CellY };
+        WriteLevelObject(CellPrimitives[CellKey], Component);
+    }
+
+    json::JSON World;
+    World["Version"] = 1;
+    World["CellSize"] = CellSize;
+    World["Cells"] = json::Array();
+
+    for (const auto& Cell : CellCoords)
+    {
+        const FString FileName = WorldName + "_" + std::to_string(Cell.second.first) + "_" + std::to_string(Cell.second.second) + ".Scene";
+
+        json::JSON Level;
+        Level["Version"] = 1;
+        Level["Primitives"] = CellPrimitives[Cell.first];
+
+        std::ofstream outFile(FileName);
+        if (!outFile.is_open())
+        {
+            return false;
+        }
+        outFile << Level.dump();
+
+        json::JSON CellEntry;
+        CellEntry["X"] = Cell.second.first;
+        CellEntry["Y"] = Cell.second.second;
+        CellEntry["File"] = FileName;
+        World["Cells"].append(CellEntry);
+    }
+
+    std::ofstream outFile(WorldName + ".World");
+    if (!outFile.is_open())
+    {
+        return false;
+    }
+    outFile << World.dump();
+
+    return true;
+}
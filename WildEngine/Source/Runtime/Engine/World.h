@@ -1,7 +1,84 @@
 ﻿#pragma once
 
-class World
+#include <memory>
+
+#include "Level.h"
+
+class UObject;
+class URenderer;
+class UScene;
+
+/** Tuning for UWorld streaming. */
+struct FWorldStreamingSettings
+{
+    /** Cells closer than this to the streaming source are loaded. */
+    float LoadRadius = 60.0f;
+
+    /** Loaded cells farther than this are unloaded. Larger than LoadRadius so cells on the border don't thrash. */
+    float UnloadRadius = 90.0f;
+
+    /** Game thread time per frame spent creating objects of loading cells. */
+    float CreationBudgetMs = 2.0f;
+
+    /** How many cells may be parsed in the background at once. */
+    uint32 MaxConcurrentParses = 2;
+};
+
+/**
+ * An open world split into square cells on the X/Y plane, one ULevel per cell.
+ *
+ * A world is described by "<Name>.World", which lists the cell size and the
+ * level file of every cell. Each frame Tick compares the streaming source
+ * (normally the camera) against the cells: near cells start parsing in the
+ * background, parsed cells create their objects under a per-frame time budget,
+ * and far cells are unloaded. Only the cells around the camera are ever in memory.
+ */
+class UWorld
 {
 public:
-    
+    UWorld(URenderer* InRenderer, UScene* InScene);
+    UWorld(const UWorld&) = delete;
+    UWorld& operator=(const UWorld&) = delete;
+    ~UWorld();
+
+    /** Reads <WorldName>.World. No cell is loaded until the next Tick. */
+    bool OpenWorld(const FString& WorldName);
+
+    /** Unloads every cell. */
+    void CloseWorld();
+
+    /** Streams cells in and out around StreamingSource. */
+    void Tick(const FVector& StreamingSource);
+
+    /**
+     * Splits the streamable primitives in Objects into cells of CellSize by the
+     * location of their root component and writes <WorldName>.World plus one level
+     * file per non-empty cell. Attached children are saved with their root.
+     */
+    static bool SaveWorld(const FString& WorldName, float CellSize, const TArray<UObject*>& Objects);
+
+    FWorldStreamingSettings& GetStreamingSettings() { return Settings; }
+
+    bool IsOpen() const { return CellSize > 0.0f; }
+    uint32 GetNumLevels() const { return static_cast<uint32>(Levels.size()); }
+    uint32 GetNumLoadedLevels() const;
+
+private:
+    /** Distance on the X/Y plane from Location to the nearest point of Level's cell. */
+    float GetDistanceToCell(const ULevel& Level, const FVector& Location) const;
+
+    void UnloadLevel(ULevel& Level);
+
+private:
+    URenderer* Renderer = nullptr;
+    UScene* Scene = nullptr;
+
+    FWorldStreamingSettings Settings;
+
+    float CellSize = 0.0f;
+    TArray<std::unique_ptr<ULevel>> Levels;
+
+    /** Scratch lists reused every Tick. */
+    TArray<TPair<float, ULevel*>> LoadCandidates;
+    TArray<TPair<float, ULevel*>> LoadingLevels;
 };
@@ -1,9 +1,12 @@
 ﻿#include "Renderer.h"
 
-#include "LaunchEngineLoop.h"
+#include <dxgi.h>
+
+#include "DynamicRHI.h"
+#include "WindowsApplication.h"
 #include "Window.h"
 
-URenderer::URenderer(LaunchEngineLoop* InApp) : Application(InApp) { }
+URenderer::URenderer(FWindowsApplication* InApp) : Application(InApp) { }
 
 void URenderer::Create()
 {
@@ -33,6 +36,13 @@ void URenderer::CreateSwapChain(int Width, int Height)
     ComPtr<IDXGIDevice> dxgiDevice = nullptr;
     DX::Check(Device.As(&dxgiDevice));
 
+    // 지연 삭제는 RHI 프레임 펜스로 하지만, CPU가 GPU보다 이 이상 앞서 나가지 않게 Present에서도 막는다
+    ComPtr<IDXGIDevice1> dxgiDevice1 = nullptr;
+    if (SUCCEEDED(Device.As(&dxgiDevice1)))
+    {
+        DX::Check(dxgiDevice1->SetMaximumFrameLatency(RHIMaxGpuFramesInFlight));
+    }
+
     ComPtr<IDXGIAdapter> dxgiAdapter = nullptr;
     DX::Check(dxgiDevice->GetAdapter(&dxgiAdapter));
 
@@ -95,12 +105,18 @@ void URenderer::SetViewport(int Width, int Height) const
     DeviceContext->RSSetViewports(1, &viewport);
 }
 
-void URenderer::Clear()
+void URenderer::SetRenderTargets(ID3D11RenderTargetView* ColorView, ID3D11DepthStencilView* DepthView, const FLOAT* InClearColor, const FLOAT* InClearDepth)
 {
-    DeviceContext->ClearRenderTargetView(RenderTargetView.Get(), ClearColor);
-    DeviceContext->ClearDepthStencilView(DepthStencilView.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+    if (ColorView && InClearColor)
+    {
+        DeviceContext->ClearRenderTargetView(ColorView, InClearColor);
+    }
+    if (DepthView && InClearDepth)
+    {
+        DeviceContext->ClearDepthStencilView(DepthView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, *InClearDepth, 0);
+    }
 
-    DeviceContext->OMSetRenderTargets(1, RenderTargetView.GetAddressOf(), DepthStencilView.Get());
+    DeviceContext->OMSetRenderTargets(ColorView ? 1 : 0, &ColorView, DepthView);
 }
 
 void URenderer::Present() const
@@ -10,7 +10,7 @@
 #include <wrl/client.h> // ComPtr
 using Microsoft::WRL::ComPtr;
 
-class LaunchEngineLoop;
+class FWindowsApplication;
 
 namespace DX
 {
@@ -43,16 +43,16 @@ public:
 
 class URenderer : public UGraphics
 {
-    LaunchEngineLoop* Application = nullptr;
+    FWindowsApplication* Application = nullptr;
 
 public:
-    URenderer(LaunchEngineLoop* InApp);
+    URenderer(FWindowsApplication* InApp);
     
     // Creates the rendering device and context
     void Create();
 
-    // Clear the buffers
-    void Clear();
+    // Binds the targets, clearing those given a clear value first (the render graph decides which)
+    void SetRenderTargets(ID3D11RenderTargetView* ColorView, ID3D11DepthStencilView* DepthView, const FLOAT* InClearColor, const FLOAT* InClearDepth);
 
     // Display the rendered scene
     void Present() const;
@@ -63,6 +63,10 @@ public:
 
     ID3D11DeviceContext* GetDeviceContext() const override { return DeviceContext.Get(); }
 
+    ID3D11RenderTargetView* GetBackBufferView() const { return RenderTargetView.Get(); }
+    ID3D11DepthStencilView* GetDepthStencilView() const { return DepthStencilView.Get(); }
+    const FLOAT* GetClearColor() const { return ClearColor; }
+
 private:
     FLOAT ClearColor[4] = { 0.025f, 0.025f, 0.025f, 1.0f }; // 화면을 초기화(clear) 할 때 사용할 색상(RGBA)
 
@@ -1,22 +1,95 @@
 #include "GizmoComponent.h"
 #include "Renderer/URenderer.h"
+#include "ResourceUploadQueue.h"
 #include "Templates/CommonTypes.h"
+#include "FramePacket.h"
+#include "GizmoPicking.h"
 #include <Input/InputManager.h>
 
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+    template<uint32 N>
+    constexpr uint32 GetNumVertices(const FVertexType (&)[N])
+    {
+        return N;
+    }
+}
+
 UGizmoComponent::UGizmoComponent(Renderer* InRenderer)
 {
 	Renderer = InRenderer;
 
     CurrentType = EGizmoType::Translation;
 
-    RelativeLocation.X = 1;
-    RelativeLocation.Y = 1;
-    RelativeLocation.Z = 1;
+    SetRelativeLocation(FVector(1.0f, 1.0f, 1.0f));
+
+    // 모드마다 세 축 메시를 버퍼 하나에 한 번만 올리고 축별 구간으로 그린다
+    CreateGizmoMesh(EGizmoType::Translation,
+        { translationX_vertices, translationY_vertices, translationZ_vertices },
+        { GetNumVertices(translationX_vertices), GetNumVertices(translationY_vertices), GetNumVertices(translationZ_vertices) });
+    CreateGizmoMesh(EGizmoType::Rotation,
+        { rotationX_vertices, rotationY_vertices, rotationZ_vertices },
+        { GetNumVertices(rotationX_vertices), GetNumVertices(rotationY_vertices), GetNumVertices(rotationZ_vertices) });
+    CreateGizmoMesh(EGizmoType::Scale,
+        { scaleX_vertices, scaleY_vertices, scaleZ_vertices },
+        { GetNumVertices(scaleX_vertices), GetNumVertices(scaleY_vertices), GetNumVertices(scaleZ_vertices) });
 }
 
 UGizmoComponent::~UGizmoComponent()
 {
+    // 버퍼는 지연 삭제 큐로 넘어가 이 기즈모를 그린 프레임이 끝난 뒤 해제된다
+    for (FGizmoMesh& Mesh : Meshes)
+    {
+        Mesh.VertexBuffer.SafeRelease();
+    }
+}
+
+void UGizmoComponent::CreateGizmoMesh(EGizmoType Type, const FVertexType* const (&Vertices)[NumAxes], const uint32 (&NumVertices)[NumAxes])
+{
+    FGizmoMesh& Mesh = Meshes[static_cast<uint32>(Type)];
 
+    TArray<FVertexType> AllVertices;
+    for (uint32 Axis = 0; Axis < NumAxes; ++Axis)
+    {
+        Mesh.FirstVertex[Axis] = static_cast<uint32>(AllVertices.size());
+        Mesh.NumVertices[Axis] = NumVertices[Axis];
+        AllVertices.insert(AllVertices.end(), Vertices[Axis], Vertices[Axis] + NumVertices[Axis]);
+    }
+    // 큐가 정점을 복사해 두고 다음 프레임 시작에 버퍼를 만든다
+    Mesh.VertexBuffer = FResourceUploadQueue::GetInst().CreateVertexBuffer(AllVertices.data(), static_cast<uint32>(AllVertices.size() * sizeof(FVertexType)));
+
+    // 피킹 모양은 X축 메시에서 잰다 (세 축은 같은 모양을 돌려놓은 것)
+    // 화살표/스케일 핸들: 축 방향 길이와 단면 반경, 회전 링: 축과 수직인 평면에서의 반경 범위
+    FGizmoHandleShape& Shape = HandleShapes[static_cast<uint32>(Type)];
+    Shape.bRing = Type == EGizmoType::Rotation;
+
+    float MinRadial = FLT_MAX;
+    float MaxRadial = 0.0f;
+    float MaxAlong = 0.0f;
+    for (uint32 Index = 0; Index < NumVertices[0]; ++Index)
+    {
+        const FVertexType& Vertex = Vertices[0][Index];
+        const float Radial = std::sqrt(Vertex.y * Vertex.y + Vertex.z * Vertex.z);
+        MinRadial = Radial < MinRadial ? Radial : MinRadial;
+        MaxRadial = Radial > MaxRadial ? Radial : MaxRadial;
+        MaxAlong = Vertex.x > MaxAlong ? Vertex.x : MaxAlong;
+    }
+
+    if (Shape.bRing)
+    {
+        // 납작한 띠라서 옆에서 봐도 잡히도록 관 반경에 하한을 둔다
+        Shape.Length = 0.5f * (MinRadial + MaxRadial);
+        Shape.Radius = 0.5f * (MaxRadial - MinRadial);
+        Shape.Radius = Shape.Radius > 0.05f ? Shape.Radius : 0.05f;
+    }
+    else
+    {
+        Shape.Length = MaxAlong;
+        Shape.Radius = MaxRadial;
+    }
 }
 
 UClass* UGizmoComponent::GetClass()
@@ -30,7 +103,7 @@ UClass* UGizmoComponent::GetInstanceClass() const
     return GetClass();
 }
 
-void UGizmoComponent::Render(FMatrix WorldMatrix, FMatrix ViewMatrix, FMatrix ProjectionMatrix)
+void UGizmoComponent::Tick()
 {
     if (FInputManager::GetInst().GetKey(0x31) == EKeyState::Pressed)
     {
@@ -46,56 +119,69 @@ void UGizmoComponent::Render(FMatrix WorldMatrix, FMatrix ViewMatrix, FMatrix Pr
     {
         CurrentType = EGizmoType::Scale;
     }
+}
 
-    switch (CurrentType)
-    {
-        case EGizmoType::Translation:
-            
-            NumVerticesX = sizeof(translationX_vertices) / sizeof(FVertexType);
-            VertexBufferX = Renderer->CreateVertexBuffer(translationX_vertices, sizeof(translationX_vertices));
-
-            NumVerticesY = sizeof(translationY_vertices) / sizeof(FVertexType);
-            VertexBufferY = Renderer->CreateVertexBuffer(translationY_vertices, sizeof(translationY_vertices));
-
-            NumVerticesZ = sizeof(translationZ_vertices) / sizeof(FVertexType);
-            VertexBufferZ = Renderer->CreateVertexBuffer(translationZ_vertices, sizeof(translationZ_vertices));
-
-            break;
-        case EGizmoType::Rotation:
-            NumVerticesX = sizeof(rotationX_vertices) / sizeof(FVertexType);
-            VertexBufferX = Renderer->CreateVertexBuffer(rotationX_vertices, sizeof(rotationX_vertices));
-
-            NumVerticesY = sizeof(rotationY_vertices) / sizeof(FVertexType);
-            VertexBufferY = Renderer->CreateVertexBuffer(rotationY_vertices, sizeof(rotationY_vertices));
-
-            NumVerticesZ = sizeof(rotationZ_vertices) / sizeof(FVertexType);
-            VertexBufferZ = Renderer->CreateVertexBuffer(rotationZ_vertices, sizeof(rotationZ_vertices));
-            break;
-        case EGizmoType::Scale:
-            NumVerticesX = sizeof(scaleX_vertices) / sizeof(FVertexType);
-            VertexBufferX = Renderer->CreateVertexBuffer(scaleX_vertices, sizeof(scaleX_vertices));
-
-            NumVerticesY = sizeof(scaleY_vertices) / sizeof(FVertexType);
-            VertexBufferY = Renderer->CreateVertexBuffer(scaleY_vertices, sizeof(scaleY_vertices));
-
-            NumVerticesZ = sizeof(scaleZ_vertices) / sizeof(FVertexType);
-            VertexBufferZ = Renderer->CreateVertexBuffer(scaleZ_vertices, sizeof(scaleZ_vertices));
-            break;
-        default:
+void UGizmoComponent::GatherDrawCommands(const FMatrix& WorldMatrix, FFramePacket& OutPacket) const
+{
+    const FGizmoMesh& Mesh = Meshes[static_cast<uint32>(CurrentType)];
 
-            break;
+    for (uint32 Axis = 0; Axis < NumAxes; ++Axis)
+    {
+        OutPacket.DrawCommands.push_back({ WorldMatrix, Mesh.VertexBuffer, Mesh.FirstVertex[Axis], Mesh.NumVertices[Axis], EMeshDrawType::Gizmo });
     }
+}
 
-    FMatrix localMatrix = FMatrix::Identity();
-
-    FMatrix FinalMatrix = localMatrix * WorldMatrix;
+EGizmoAxis UGizmoComponent::PickAxis(const FMatrix& WorldMatrix, const FVector& RayOrigin, const FVector& RayDirection, float& OutDistance) const
+{
+    // 광선을 기즈모 공간으로: 스케일이 있어도 모양을 그대로 쓸 수 있다
+    const FMatrix InverseWorld = WorldMatrix.Inverse();
+    const float (&M)[4][4] = InverseWorld.M;
+    const FVector LocalOrigin(
+        RayOrigin.X * M[0][0] + RayOrigin.Y * M[1][0] + RayOrigin.Z * M[2][0] + M[3][0],
+        RayOrigin.X * M[0][1] + RayOrigin.Y * M[1][1] + RayOrigin.Z * M[2][1] + M[3][1],
+        RayOrigin.X * M[0][2] + RayOrigin.Y * M[1][2] + RayOrigin.Z * M[2][2] + M[3][2]);
+    FVector LocalDirection(
+        RayDirection.X * M[0][0] + RayDirection.Y * M[1][0] + RayDirection.Z * M[2][0],
+        RayDirection.X * M[0][1] + RayDirection.Y * M[1][1] + RayDirection.Z * M[2][1],
+        RayDirection.X * M[0][2] + RayDirection.Y * M[1][2] + RayDirection.Z * M[2][2]);
+
+    // 로컬 방향을 정규화하고, 로컬 거리 / 배율 = 월드 거리
+    const float LocalScale = std::sqrt(LocalDirection.X * LocalDirection.X + LocalDirection.Y * LocalDirection.Y + LocalDirection.Z * LocalDirection.Z);
+    if (LocalScale <= 0.0f)
+    {
+        return EGizmoAxis::None;
+    }
+    LocalDirection = FVector(LocalDirection.X / LocalScale, LocalDirection.Y / LocalScale, LocalDirection.Z / LocalScale);
 
-    // ���̴� ��� ���� ������Ʈ
-    Renderer->UpdateShaderParameters(FinalMatrix, ViewMatrix, ProjectionMatrix);
+    const FGizmoHandleShape& Shape = HandleShapes[static_cast<uint32>(CurrentType)];
+    const FVector Origin(0.0f, 0.0f, 0.0f);
+    const FVector AxisEnds[NumAxes] =
+    {
+        FVector(Shape.Length, 0.0f, 0.0f),
+        FVector(0.0f, Shape.Length, 0.0f),
+        FVector(0.0f, 0.0f, Shape.Length),
+    };
+
+    EGizmoAxis HitAxis = EGizmoAxis::None;
+    float Nearest = FLT_MAX;
+    for (uint32 Axis = 0; Axis < NumAxes; ++Axis)
+    {
+        float Distance = 0.0f;
+        const bool bHit = Shape.bRing
+            ? RayTorusIntersection(LocalOrigin, LocalDirection, static_cast<int32>(Axis), Shape.Length, Shape.Radius, Distance)
+            : RayCapsuleIntersection(LocalOrigin, LocalDirection, Origin, AxisEnds[Axis], Shape.Radius, Distance);
+        if (bHit && Distance < Nearest)
+        {
+            Nearest = Distance;
+            HitAxis = static_cast<EGizmoAxis>(static_cast<uint32>(EGizmoAxis::X) + Axis);
+        }
+    }
 
-    Renderer->RenderGizmo(VertexBufferX, NumVerticesX);
-    Renderer->RenderGizmo(VertexBufferY, NumVerticesY);
-    Renderer->RenderGizmo(VertexBufferZ, NumVerticesZ);
+    if (HitAxis != EGizmoAxis::None)
+    {
+        OutDistance = Nearest / LocalScale;
+    }
+    return HitAxis;
 }
 
 void UGizmoComponent::SetGizmoType(EGizmoType NewType)
@@ -2,10 +2,22 @@
 
 #include "Gizmo.h"
 #include "SceneComponent.h"
+#include "Templates/RefCounting.h"
 
 class URenderer;
+class FRHIVertexBuffer;
+struct FFramePacket;
 enum class EGizmoType;
 
+/* Handle of the gizmo under the cursor */
+enum class EGizmoAxis : uint8
+{
+	None,
+	X,
+	Y,
+	Z,
+};
+
 class UGizmoComponent : public USceneComponent
 {
 public:
@@ -16,23 +28,55 @@ public:
 	static UClass* GetClass();
 	UClass* GetInstanceClass() const override;
 
-	void Render(FMatrix WorldMatrix, FMatrix ViewMatrix, FMatrix ProjectionMatrix);
+	/* Game thread: handles mode keys */
+	void Tick();
+
+	/* Appends the gizmo draws at WorldMatrix to the frame packet */
+	void GatherDrawCommands(const FMatrix& WorldMatrix, FFramePacket& OutPacket) const;
+
+	/*
+	 * Picks the handle of the current mode hit by a world space ray, with the gizmo at WorldMatrix.
+	 * Arrows and scale handles are capsules, rotation rings are tori, so no mesh triangles are touched.
+	 * @return The nearest hit axis (OutDistance along RayDirection) or EGizmoAxis::None
+	 */
+	EGizmoAxis PickAxis(const FMatrix& WorldMatrix, const FVector& RayOrigin, const FVector& RayDirection, float& OutDistance) const;
 
 	void SetGizmoType(EGizmoType NewType);
 
 	EGizmoType GetCurrentGizmo() { return CurrentType; }
+
+	void SetActiveAxis(EGizmoAxis NewAxis) { ActiveAxis = NewAxis; }
+	EGizmoAxis GetActiveAxis() const { return ActiveAxis; }
+
+private:
+	static constexpr uint32 NumGizmoTypes = 3;
+	static constexpr uint32 NumAxes = 3;
+
+	/* One mode's X, Y and Z meshes, uploaded once into a single buffer */
+	struct FGizmoMesh
+	{
+		TRefCountPtr<FRHIVertexBuffer> VertexBuffer;
+		uint32 FirstVertex[NumAxes] = {};
+		uint32 NumVertices[NumAxes] = {};
+	};
+
+	/* Pick shape of one axis handle in gizmo space, measured from the mesh data */
+	struct FGizmoHandleShape
+	{
+		/* Capsule from the origin along the axis, or torus around the axis */
+		bool bRing = false;
+		float Length = 0.0f;      // Capsule: handle length, torus: major radius
+		float Radius = 0.0f;      // Capsule radius or torus minor radius
+	};
+
+	void CreateGizmoMesh(EGizmoType Type, const FVertexType* const (&Vertices)[NumAxes], const uint32 (&NumVertices)[NumAxes]);
+
 private:
 	URenderer* Renderer;
 
 	EGizmoType CurrentType;
-	
-	UINT NumVerticesX;
-	ID3D11Buffer* VertexBufferX;
-
-	UINT NumVerticesY;
-	ID3D11Buffer* VertexBufferY;
+	EGizmoAxis ActiveAxis = EGizmoAxis::None;
 
-	UINT NumVerticesZ;
-	ID3D11Buffer* VertexBufferZ;
+	FGizmoMesh Meshes[NumGizmoTypes];
+	FGizmoHandleShape HandleShapes[NumGizmoTypes];
 };
-
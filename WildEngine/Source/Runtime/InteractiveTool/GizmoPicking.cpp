@@ -0,0 +1,160 @@
+#include "GizmoPicking.h"
+
+#include <cmath>
+
+namespace
+{
+    float Dot3(const FVector& A, const FVector& B)
+    {
+        return A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+    }
+
+    float GetAxisComponent(const FVector& V, int32 Axis)
+    {
+        return Axis == 0 ? V.X : (Axis == 1 ? V.Y : V.Z);
+    }
+
+    /* Ray vs sphere at the origin; the interval the ray spends inside */
+    bool RaySphereInterval(const FVector& RayOrigin, const FVector& RayDirection, float Radius, float& OutEnter, float& OutExit)
+    {
+        const float B = Dot3(RayOrigin, RayDirection);
+        const float C = Dot3(RayOrigin, RayOrigin) - Radius * Radius;
+        const float H = B * B - C;
+        if (H < 0.0f)
+        {
+            return false;
+        }
+        const float SqrtH = std::sqrt(H);
+        OutEnter = -B - SqrtH;
+        OutExit = -B + SqrtH;
+        return OutExit >= 0.0f;
+    }
+}
+
+bool RayCapsuleIntersection(const FVector& RayOrigin, const FVector& RayDirection, const FVector& Start, const FVector& End, float Radius, float& OutDistance)
+{
+    const FVector BA(End.X - Start.X, End.Y - Start.Y, End.Z - Start.Z);
+    const FVector OA(RayOrigin.X - Start.X, RayOrigin.Y - Start.Y, RayOrigin.Z - Start.Z);
+
+    const float BABA = Dot3(BA, BA);
+    const float BARD = Dot3(BA, RayDirection);
+    const float BAOA = Dot3(BA, OA);
+    const float RDOA = Dot3(RayDirection, OA);
+    const float OAOA = Dot3(OA, OA);
+
+    // 무한 원통을 빗나가면 캡슐도 빗나간다
+    const float A = BABA - BARD * BARD;
+    const float B = BABA * RDOA - BAOA * BARD;
+    const float C = BABA * OAOA - BAOA * BAOA - Radius * Radius * BABA;
+    const float H = B * B - A * C;
+    if (H < 0.0f)
+    {
+        return false;
+    }
+
+    // 원통 몸통에 맞은 점이 선분 범위 안이면 그것이 답
+    if (A > 1e-8f)
+    {
+        const float T = (-B - std::sqrt(H)) / A;
+        const float Y = BAOA + T * BARD;
+        if (Y > 0.0f && Y < BABA)
+        {
+            if (T < 0.0f)
+            {
+                return false;
+            }
+            OutDistance = T;
+            return true;
+        }
+    }
+
+    // 아니면 양 끝 반구 중 가까운 쪽
+    bool bHit = false;
+    float Nearest = 0.0f;
+    const FVector* Caps[2] = { &Start, &End };
+    for (const FVector* Cap : Caps)
+    {
+        const FVector OC(RayOrigin.X - Cap->X, RayOrigin.Y - Cap->Y, RayOrigin.Z - Cap->Z);
+        const float CapB = Dot3(RayDirection, OC);
+        const float CapC = Dot3(OC, OC) - Radius * Radius;
+        const float CapH = CapB * CapB - CapC;
+        if (CapH < 0.0f)
+        {
+            continue;
+        }
+        const float T = -CapB - std::sqrt(CapH);
+        if (T >= 0.0f && (!bHit || T < Nearest))
+        {
+            Nearest = T;
+            bHit = true;
+        }
+    }
+
+    if (bHit)
+    {
+        OutDistance = Nearest;
+    }
+    return bHit;
+}
+
+bool RayTorusIntersection(const FVector& RayOrigin, const FVector& RayDirection, int32 Axis, float MajorRadius, float MinorRadius, float& OutDistance)
+{
+    // 토러스를 감싸는 구 안의 구간에서만 음함수 부호 변화를 찾는다
+    float Enter = 0.0f;
+    float Exit = 0.0f;
+    if (MinorRadius <= 0.0f || !RaySphereInterval(RayOrigin, RayDirection, MajorRadius + MinorRadius, Enter, Exit))
+    {
+        return false;
+    }
+    Enter = Enter > 0.0f ? Enter : 0.0f;
+
+    // f(p) = (|p|^2 + R^2 - r^2)^2 - 4 R^2 (|p|^2 - h^2), 관 안쪽이 음수
+    const float R2 = MajorRadius * MajorRadius;
+    const float K = R2 - MinorRadius * MinorRadius;
+    auto Evaluate = [&](float T)
+    {
+        const FVector P(RayOrigin.X + RayDirection.X * T, RayOrigin.Y + RayDirection.Y * T, RayOrigin.Z + RayDirection.Z * T);
+        const float PP = Dot3(P, P);
+        const float H = GetAxisComponent(P, Axis);
+        const float S = PP + K;
+        return S * S - 4.0f * R2 * (PP - H * H);
+    };
+
+    // 관 지름보다 촘촘하게 걸어 첫 진입 구간을 찾고 이분법으로 좁힌다
+    const float Step = MinorRadius * 0.5f;
+    float Prev = Enter;
+    float PrevValue = Evaluate(Prev);
+    if (PrevValue <= 0.0f)
+    {
+        OutDistance = Prev;
+        return true;
+    }
+
+    for (float T = Enter + Step; Prev < Exit; T += Step)
+    {
+        T = T < Exit ? T : Exit;
+        const float Value = Evaluate(T);
+        if (Value <= 0.0f)
+        {
+            float Low = Prev;
+            float High = T;
+            for (int32 Iteration = 0; Iteration < 16; ++Iteration)
+            {
+                const float Mid = 0.5f * (Low + High);
+                if (Evaluate(Mid) <= 0.0f)
+                {
+                    High = Mid;
+                }
+                else
+                {
+                    Low = Mid;
+                }
+            }
+            OutDistance = High;
+            return true;
+        }
+        Prev = T;
+    }
+
+    return false;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Math/Matrix.h"
+
+/*
+ * Analytic ray tests for gizmo handles. Rays are given in the handle's local
+ * space with a normalized direction; the returned distance is along that ray.
+ */
+
+/* Ray vs capsule around the segment Start-End. @return true and the nearest entry distance on a hit */
+bool RayCapsuleIntersection(const FVector& RayOrigin, const FVector& RayDirection, const FVector& Start, const FVector& End, float Radius, float& OutDistance);
+
+/* Ray vs torus centered at the origin whose ring lies in the plane perpendicular to Axis (0 = X, 1 = Y, 2 = Z) */
+bool RayTorusIntersection(const FVector& RayOrigin, const FVector& RayDirection, int32 Axis, float MajorRadius, float MinorRadius, float& OutDistance);
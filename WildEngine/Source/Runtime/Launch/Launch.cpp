@@ -1,5 +1,95 @@
 ﻿#include "LaunchEngineLoop.h"
 
+#include <cstdlib>
+#include <cstring>
+
+// -onethread : 렌더 스레드 없이 게임 스레드에서 바로 그린다 (디버깅용)
+// -framesinflight=N : 렌더 스레드가 뒤처질 수 있는 최대 프레임 수
+static FRenderingThreadSettings ParseRenderingThreadSettings(int argc, char** argv)
+{
+    FRenderingThreadSettings Settings;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-onethread") == 0)
+        {
+            Settings.bSingleThreaded = true;
+        }
+        else if (std::strncmp(argv[i], "-framesinflight=", 16) == 0)
+        {
+            const int FramesInFlight = std::atoi(argv[i] + 16);
+            Settings.MaxFramesInFlight = FramesInFlight > 0 ? static_cast<uint32>(FramesInFlight) : 1;
+        }
+    }
+
+    return Settings;
+}
+
+// -world=Name : Name.World 를 열고 카메라 주변 셀을 스트리밍한다
+static FString ParseWorldName(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "-world=", 7) == 0)
+        {
+            return FString(argv[i] + 7);
+        }
+    }
+
+    return FString();
+}
+
+// -nullrhi : 창과 GPU 없이 Null RHI로 돈다 (프로파일링, CI 성능 측정용)
+// -softwarerhi : 창과 GPU 없이 CPU 래스터라이저로 그린다, -screenshot=File.tga 로 마지막 프레임을 저장
+// -frames=N : N 프레임 후 종료하고 RHI 통계를 출력한다
+// -rhicapture=File : RHI 명령을 File에 기록한다, -captureframe=N 이면 N번째 프레임만 (-nullrhi, -softwarerhi 전용)
+// -rhireplay=File : 씬 대신 캡처를 -replaypasses=N 번 재생하고 RHI 통계를 출력한다 (-nullrhi, -softwarerhi 전용)
+static FEngineLoopSettings ParseEngineLoopSettings(int argc, char** argv)
+{
+    FEngineLoopSettings Settings;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-nullrhi") == 0)
+        {
+            Settings.bNullRHI = true;
+        }
+        else if (std::strcmp(argv[i], "-softwarerhi") == 0)
+        {
+            Settings.bSoftwareRHI = true;
+        }
+        else if (std::strncmp(argv[i], "-screenshot=", 12) == 0)
+        {
+            Settings.ScreenshotFilename = FString(argv[i] + 12);
+        }
+        else if (std::strncmp(argv[i], "-frames=", 8) == 0)
+        {
+            const long long MaxFrames = std::atoll(argv[i] + 8);
+            Settings.MaxFrames = MaxFrames > 0 ? static_cast<uint64>(MaxFrames) : 0;
+        }
+        else if (std::strncmp(argv[i], "-rhicapture=", 12) == 0)
+        {
+            Settings.CaptureFilename = FString(argv[i] + 12);
+        }
+        else if (std::strncmp(argv[i], "-captureframe=", 14) == 0)
+        {
+            const long long CaptureFrame = std::atoll(argv[i] + 14);
+            Settings.CaptureFrame = CaptureFrame > 0 ? static_cast<uint64>(CaptureFrame) : 0;
+        }
+        else if (std::strncmp(argv[i], "-rhireplay=", 11) == 0)
+        {
+            Settings.ReplayFilename = FString(argv[i] + 11);
+        }
+        else if (std::strncmp(argv[i], "-replaypasses=", 14) == 0)
+        {
+            const int ReplayPasses = std::atoi(argv[i] + 14);
+            Settings.ReplayPasses = ReplayPasses > 0 ? static_cast<uint32>(ReplayPasses) : 1;
+        }
+    }
+
+    return Settings;
+}
+
 int main(int argc, char** argv)
 {
 #ifdef _DEBUG
@@ -8,6 +98,6 @@ int main(int argc, char** argv)
     // _CrtSetBreakAlloc(972);
 #endif
 
-    std::unique_ptr<LaunchEngineLoop> App = std::make_unique<LaunchEngineLoop>();
+    std::unique_ptr<LaunchEngineLoop> App = std::make_unique<LaunchEngineLoop>(ParseRenderingThreadSettings(argc, argv), ParseWorldName(argc, argv), ParseEngineLoopSettings(argc, argv));
     return App->Run();
 }
\ No newline at end of file
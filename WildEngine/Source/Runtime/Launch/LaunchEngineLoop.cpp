@@ -1,160 +1,365 @@
 ﻿#include "LaunchEngineLoop.h"
 #include "Misc/Timer.h"
-#include "Window.h"
-#include "Renderer.h"
-
-#include <windowsx.h>
-
+#include "Scene.h"
+#include "SceneRenderer.h"
+#include "World.h"
+#include "StaticMeshCache.h"
+#include "VertexBufferArena.h"
+#include "ResourceUploadQueue.h"
+#include "RHI.h"
+#include "NullRHI.h"
+#include "RHICapture.h"
+#include "SoftwareRHI.h"
+#include "Components/CameraComponent.h"
+#ifdef _WIN32
+#include "WindowsApplication.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+    // 헤드리스 백버퍼 기술자의 지우기 색, URenderer와 같다
+    constexpr float HeadlessClearColor[4] = { 0.025f, 0.025f, 0.025f, 1.0f };
+}
 
-LaunchEngineLoop::LaunchEngineLoop()
+LaunchEngineLoop::LaunchEngineLoop(const FRenderingThreadSettings& InRenderingSettings, const FString& InWorldName, const FEngineLoopSettings& InSettings)
+    : RenderingSettings(InRenderingSettings)
+    , RenderGraph(RenderGraphPool)
+    , Settings(InSettings)
 {
     const FString WindowTitle = "Wild Engine";
     constexpr int WindowWidth = 800;
     constexpr int WindowHeight = 600;
+    BackBufferWidth = WindowWidth;
+    BackBufferHeight = WindowHeight;
+
+    if (Settings.bNullRHI)
+    {
+        // 창도 디바이스도 없이 씬 갱신, 컬링, 제출만 돈다
+        DynamicRHI = std::make_unique<FNullDynamicRHI>();
+    }
+    else if (Settings.bSoftwareRHI)
+    {
+        // 창 크기 그대로 CPU에서 그려 스크린샷으로 남긴다
+        std::unique_ptr<FSoftwareDynamicRHI> Software = std::make_unique<FSoftwareDynamicRHI>(WindowWidth, WindowHeight);
+        SoftwareRHI = Software.get();
+        DynamicRHI = std::move(Software);
+    }
+    else
+    {
+#ifdef _WIN32
+        // 창, 디바이스, 스왑체인은 Win32 쪽이 만든다
+        Application = std::make_unique<FWindowsApplication>(this);
+        Application->Create(WindowTitle, WindowWidth, WindowHeight);
+        DynamicRHI = Application->CreateDynamicRHI();
+#else
+        std::printf("Windowed mode needs Windows, running on the Null RHI\n");
+        Settings.bNullRHI = true;
+        DynamicRHI = std::make_unique<FNullDynamicRHI>();
+#endif
+    }
+
+    // 캡처는 실제 RHI를 감싸서 호출을 그대로 넘기며 기록한다.
+    // D3D11 렌더러는 셰이더와 입력 레이아웃을 RHI 밖에서 바인딩하고 대부분 컨텍스트에 직접 그리므로 헤드리스 RHI만 감싼다
+    if (!Settings.CaptureFilename.empty())
+    {
+        if (Settings.IsHeadless())
+        {
+            DynamicRHI = std::make_unique<FRecordingDynamicRHI>(std::move(DynamicRHI), Settings.CaptureFilename, Settings.CaptureFrame);
+        }
+        else
+        {
+            std::printf("-rhicapture needs -nullrhi or -softwarerhi, %s will not be written\n", Settings.CaptureFilename.c_str());
+        }
+    }
 
-    // Create Window
-    ActiveWindow = std::make_unique<Window>(this);
-    bWindowCreated = ActiveWindow->Create(WindowTitle, WindowWidth, WindowHeight, false);
+    // 컴포넌트가 생성자에서 버퍼를 만들므로 씬보다 먼저
+    GDynamicRHI = DynamicRHI.get();
+    GDynamicRHI->Init();
+
+    // 헤드리스에는 URenderer가 없다. 컴포넌트는 버퍼를 GDynamicRHI로 만든다
+    URenderer* Renderer = nullptr;
+    SceneRenderer = std::make_unique<FSceneRenderer>();
+#ifdef _WIN32
+    if (Application)
+    {
+        Renderer = Application->GetRenderer();
+        SceneRenderer = Application->CreateSceneRenderer();
+    }
+#endif
+
+    FSceneViewport Viewport;
+    Viewport.Width = static_cast<float>(WindowWidth);
+    Viewport.Height = static_cast<float>(WindowHeight);
+    Scene = std::make_unique<UScene>(Renderer, Viewport);
+
+    if (!InWorldName.empty())
+    {
+        World = std::make_unique<UWorld>(Renderer, Scene.get());
+        World->OpenWorld(InWorldName);
+    }
+}
 
-    UEngineRenderer = std::make_unique<URenderer>(this);
-    UEngineRenderer->Create();
+LaunchEngineLoop::~LaunchEngineLoop()
+{
+    // 렌더 스레드가 씬 리소스를 쓰고 있을 수 있으므로 먼저 멈춘다
+    RenderingThread.Stop();
+
+    // 레벨이 씬의 선택 상태를 건드리므로 씬보다 먼저 정리
+    World.reset();
+    Scene.reset();
+
+    // 아무것도 그리지 않으니 지연 삭제 큐에 남은 버퍼까지 디바이스보다 먼저 해제한다
+    FStaticMeshCache::GetInst().ReleaseUnusedMeshes();
+    FResourceUploadQueue::GetInst().Flush();
+    RenderGraph.Reset();
+    RenderGraphPool.Empty();
+    FRHIResource::FlushAllPendingDeletes();
+
+    GDynamicRHI->Shutdown();
+    GDynamicRHI = nullptr;
 }
 
 int LaunchEngineLoop::Run()
 {
+    if (!Settings.ReplayFilename.empty())
+    {
+        return RunReplay();
+    }
+
     Timer timer;
     timer.Start();
 
+    RenderingThread.Start(RenderingSettings, [this](const FFramePacket& Packet) { RenderFrame(Packet); });
+
     while (bRunning)
     {
         timer.Tick();
         this->CalculateFrameStats(timer.GetDeltaTime());
 
-        MSG msg = {};
-        if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+#ifdef _WIN32
+        // 쌓인 메시지를 모두 처리한 뒤 프레임을 진행
+        if (Application && !Application->PumpMessages())
+        {
+            bRunning = false;
+        }
+#endif
+
+        if (!bRunning)
         {
-            if (msg.message == WM_QUIT)
-            {
-                bRunning = false;
-            }
+            break;
+        }
 
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
+        // 스트리밍으로 생성/삭제된 컴포넌트는 바로 아래 Scene->Tick에서 계층과 프록시에 반영된다
+        if (World)
+        {
+            World->Tick(Scene->GetPrimaryCamera()->GetPosition());
         }
 
-        // Clear the buffers
-        UEngineRenderer->Clear();
+        // Game thread: 이전 프레임이 렌더 스레드에서 제출되는 동안 다음 프레임을 시뮬레이션
+        Scene->Tick();
 
-        // Bind the shader to the pipeline
-        // m_Shader->Use();
+        // 방금 파괴된 컴포넌트들이 마지막으로 쓰던 메시 버퍼는 지연 삭제 큐로 넘긴다
+        FStaticMeshCache::GetInst().ReleaseUnusedMeshes();
 
-        // Update the model view projection constant buffer
-        // this->ComputeModelViewProjectionMatrix();
+        // 패킷 슬롯이 빌 때까지 (frames in flight 제한) 대기한 뒤 그릴 내용을 기록
+        FFramePacket& Packet = RenderingThread.BeginFrame();
+        Scene->BuildFramePacket(Packet);
+        RenderingThread.EndFrame();
 
-        // Bind the raster state (solid/wireframe) to the pipeline
-        // m_RasterState->Use();
+        if (Settings.MaxFrames > 0 && Packet.FrameNumber >= Settings.MaxFrames)
+        {
+            bRunning = false;
+        }
+    }
 
-        // Render the model
-        // m_Model->Render();
+    RenderingThread.Stop();
 
-        // Display the rendered scene
-        UEngineRenderer->Present();
+    if (Settings.MaxFrames > 0)
+    {
+        PrintRHIStats();
     }
-    
+    SaveScreenshot();
+
     return 0;
 }
 
-LRESULT LaunchEngineLoop::HandleMessage(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
+void LaunchEngineLoop::RenderFrame(const FFramePacket& Packet)
 {
-    switch (Msg)
-    {
-        case WM_DESTROY:
-            PostQuitMessage(0);
-        return 0;
-
-        case WM_SIZE:
-            this->OnResize(hWnd, Msg, wParam, lParam);
-        return 0;
-
-        case WM_MOUSEMOVE:
-            this->OnMouseMove(hWnd, Msg, wParam, lParam);
-        return 0;
-    
-        case WM_KEYDOWN:
-            this->OnKeyDown(hWnd, Msg, wParam, lParam);
-        return 0;
-    
-        default:
-            return DefWindowProc(hWnd, Msg, wParam, lParam);
+    // Render thread (single threaded 모드에서는 게임 스레드)
+    GDynamicRHI->RHIBeginFrame();
+
+    // 게임 스레드와 작업 스레드가 이 패킷을 만들기 전까지 요청한 버퍼 생성과 쓰기를 한 번에 처리한다
+    FResourceUploadQueue::GetInst().Flush();
+
+    // 패스는 읽고 쓰는 텍스처만 선언한다. 실행 순서, 컬링, 지우기와 바인딩은 그래프가 정한다
+    FRenderGraphTextureDesc BackBufferDesc;
+    BackBufferDesc.Width = BackBufferWidth;
+    BackBufferDesc.Height = BackBufferHeight;
+    BackBufferDesc.Format = PF_B8G8R8A8;
+    BackBufferDesc.Flags = TexCreate_RenderTargetable;
+    const float* ClearColor = HeadlessClearColor;
+#ifdef _WIN32
+    if (Application)
+    {
+        ClearColor = Application->GetClearColor();
     }
-}
+#endif
+    std::copy(ClearColor, ClearColor + 4, BackBufferDesc.ClearColor);
 
-void LaunchEngineLoop::CalculateFrameStats(float DeltaTime)
-{
-    static float Time = 0.0f;
+    FRenderGraphTextureDesc SceneDepthDesc = BackBufferDesc;
+    SceneDepthDesc.Format = PF_DepthStencil;
+    SceneDepthDesc.Flags = TexCreate_DepthStencilTargetable;
 
-    FrameCount++;
-    Time += DeltaTime;
+    RenderGraph.Reset();
+    const FRenderGraphTextureRef BackBuffer = RenderGraph.RegisterExternalTexture("BackBuffer", BackBufferDesc);
+    const FRenderGraphTextureRef SceneDepth = RenderGraph.RegisterExternalTexture("SceneDepth", SceneDepthDesc);
 
-    if (Time > 1.0f)
+    RenderGraph.AddPass("Scene", [this, &Packet](const FRenderGraph&) { SceneRenderer->Render(Packet); })
+        .SetRenderTargets(BackBuffer, SceneDepth);
+
+    // 소프트웨어 RHI는 RHIBeginFrame에서 자기 타깃을 지우고, Null RHI에는 그릴 곳이 없다
+    RenderGraph.Execute([this](const FRenderGraph& Graph, const FRenderGraphRenderTargets& Targets)
     {
-        // Do something 'FrameCount'
-        //
+#ifdef _WIN32
+        if (Application)
+        {
+            Application->BindRenderTargets(Graph, Targets);
+        }
+#endif
+    });
+    RenderGraphPool.Tick();
 
-        Time = 0.0f;
-        FrameCount = 0;
-    }
-}
+    GDynamicRHI->RHIEndFrame();
+    GDynamicRHI->RHISignalFrameFence(Packet.FrameNumber);
 
-void LaunchEngineLoop::OnResize(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
-{
-    if (!bWindowCreated)
+#ifdef _WIN32
+    // Display the rendered scene
+    if (Application)
     {
-        return;
+        Application->Present();
     }
+#endif
 
-    // Get window size
-    int Width = LOWORD(lParam);
-    int Height HIWORD(lParam);
+    // GPU가 펜스를 지난 프레임까지 쓰던 리소스를 한 번에 지운다
+    FRHIResource::FlushPendingDeletes(GDynamicRHI->RHIGetRetiredFrameNumber());
+}
+
+void LaunchEngineLoop::FlushRenderingThread()
+{
+    RenderingThread.Flush();
+}
 
-    // Resize renderer
-    // m_Renderer->Resize(Width, Height);
+void LaunchEngineLoop::SetViewportSize(uint32 Width, uint32 Height)
+{
+    BackBufferWidth = Width;
+    BackBufferHeight = Height;
 
-    // Update camera
-    // m_Camera->UpdateAspectRatio(Width, Height);
+    FSceneViewport Viewport;
+    Viewport.Width = static_cast<float>(Width);
+    Viewport.Height = static_cast<float>(Height);
+    if (Scene)
+    {
+        Scene->SetViewport(Viewport);
+    }
 }
 
-void LaunchEngineLoop::OnMouseMove(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
+void LaunchEngineLoop::PrintRHIStats() const
 {
-    static int PreviousMouseX = 0;
-    static int PreviousMouseY = 0;
+    // 렌더 스레드가 멈춘 뒤라 카운터를 그대로 읽어도 된다
+    const FRHIStats& Stats = DynamicRHI->GetStats();
+    std::printf("RHI: %s\n", DynamicRHI->GetName());
+    std::printf("  Frames:            %llu\n", Stats.NumFrames);
+    std::printf("  Vertex buffers:    %u (%llu bytes)\n", Stats.NumVertexBuffersCreated, Stats.NumVertexBufferBytes);
+    std::printf("  Buffer updates:    %llu (%llu bytes)\n", Stats.NumVertexBufferUpdates, Stats.NumVertexBufferUpdateBytes);
+    std::printf("  Textures:          %u\n", Stats.NumTexturesCreated);
+    std::printf("  Constant updates:  %llu (%llu bytes)\n", Stats.NumConstantUpdates, Stats.NumConstantBytes);
+    std::printf("  Draw calls:        %llu\n", Stats.NumDrawCalls);
+    std::printf("  Primitives:        %llu\n", Stats.NumPrimitives);
+    std::printf("  Instances:         %llu\n", Stats.NumInstances);
+
+    const FVertexBufferArenaStats ArenaStats = FVertexBufferArena::GetInst().GetStats();
+    std::printf("Vertex buffer arena: %u buffers, %u meshes\n", ArenaStats.NumBuffers, ArenaStats.NumAllocations);
+    std::printf("  Allocated:         %llu bytes\n", ArenaStats.AllocatedBytes);
+    std::printf("  Free:              %llu bytes (largest %llu, %.0f%% fragmented)\n", ArenaStats.FreeBytes, ArenaStats.LargestFreeBytes, ArenaStats.GetFragmentation() * 100.0f);
+    std::printf("  Moved:             %llu\n", ArenaStats.NumMovedAllocations);
+
+    const FResourceUploadQueueStats UploadStats = FResourceUploadQueue::GetInst().GetStats();
+    std::printf("Upload queue:        %llu flushes (largest %u requests)\n", UploadStats.NumFlushes, UploadStats.LargestBatch);
+    std::printf("  Created:           %llu buffers\n", UploadStats.NumBuffersCreated);
+    std::printf("  Updates:           %llu\n", UploadStats.NumUpdates);
+    std::printf("  Uploaded:          %llu bytes\n", UploadStats.UploadedBytes);
+    std::printf("  Staging:           %llu bytes (%llu overflowed)\n", UploadStats.StagingSize, UploadStats.OverflowBytes);
+}
 
-    int MouseX = GET_X_LPARAM(lParam);
-    int MouseY = GET_Y_LPARAM(lParam);
+int LaunchEngineLoop::RunReplay()
+{
+    // 캡처에는 셰이더가 없으므로 D3D11에 재생하면 아무것도 제대로 그려지지 않는다
+    if (!Settings.IsHeadless())
+    {
+        std::printf("-rhireplay needs -nullrhi or -softwarerhi\n");
+        return 1;
+    }
 
-    if (wParam & MK_LBUTTON)
+    FRHICaptureReplayer Replayer;
+    if (!Replayer.Load(Settings.ReplayFilename))
     {
-        float DeltaX = static_cast<float>(MouseX - PreviousMouseX);
-        float DeltaY = static_cast<float>(MouseY - PreviousMouseY);
+        std::printf("Failed to load RHI capture %s\n", Settings.ReplayFilename.c_str());
+        return 1;
+    }
 
-        // Rotate camera
-        float Yaw = DeltaX * 0.01f;
-        float Pitch = DeltaY * 0.01f;
+    // 씬 생성 중에 만든 버퍼는 빼고 캡처 스트림만 센다
+    DynamicRHI->ResetStats();
 
-        // m_Camera->Rotate(pitch, yaw);
+    const auto StartTime = std::chrono::steady_clock::now();
+    const bool bReplayed = Replayer.Replay(*DynamicRHI, Settings.ReplayPasses);
+    const auto EndTime = std::chrono::steady_clock::now();
+
+    // 리플레이가 만든 버퍼의 마지막 참조가 풀렸으니 디바이스보다 먼저 지운다
+    FRHIResource::FlushAllPendingDeletes();
+
+    const double Milliseconds = std::chrono::duration<double, std::milli>(EndTime - StartTime).count();
+    std::printf("Replayed %s: %u frames x %u passes, %u buffers, %.3f ms\n",
+        Settings.ReplayFilename.c_str(), Replayer.GetNumFrames(), Settings.ReplayPasses, Replayer.GetNumBuffers(), Milliseconds);
+    PrintRHIStats();
+    SaveScreenshot();
+
+    return bReplayed ? 0 : 1;
+}
+
+void LaunchEngineLoop::SaveScreenshot() const
+{
+    if (!SoftwareRHI || Settings.ScreenshotFilename.empty())
+    {
+        return;
     }
 
-    PreviousMouseX = MouseX;
-    PreviousMouseY = MouseY;
+    if (SoftwareRHI->GetRasterizer().SaveTGA(Settings.ScreenshotFilename))
+    {
+        std::printf("Saved %s\n", Settings.ScreenshotFilename.c_str());
+    }
+    else
+    {
+        std::printf("Failed to save %s\n", Settings.ScreenshotFilename.c_str());
+    }
 }
 
-void LaunchEngineLoop::OnKeyDown(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
+void LaunchEngineLoop::CalculateFrameStats(float DeltaTime)
 {
-    WORD Flags = HIWORD(lParam);
-    BOOL KeyRepeat = (Flags & KF_REPEAT) == KF_REPEAT;
+    static float Time = 0.0f;
+
+    FrameCount++;
+    Time += DeltaTime;
 
-    if (!KeyRepeat)
+    if (Time > 1.0f)
     {
-        // m_RasterState->ToggleWireframe();
+        // Do something 'FrameCount'
+        //
+
+        Time = 0.0f;
+        FrameCount = 0;
     }
 }
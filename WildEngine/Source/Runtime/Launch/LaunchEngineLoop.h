@@ -1,45 +1,108 @@
 ﻿#pragma once
 
-#define NOMINMAX
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-
 #include <memory>
 
-class URenderer;
-class Window;
+#include "RenderingThread.h"
+#include "RenderGraph.h"
+
+class FWindowsApplication;
+class FDynamicRHI;
+class FSoftwareDynamicRHI;
+class UScene;
+class FSceneRenderer;
+class UWorld;
+
+/** Command line options of the engine loop itself. */
+struct FEngineLoopSettings
+{
+    /** Runs without a window or GPU on the Null RHI, which only counts calls (-nullrhi). */
+    bool bNullRHI = false;
+
+    /** Runs without a window or GPU on the CPU rasterizer (-softwarerhi). */
+    bool bSoftwareRHI = false;
+
+    /** Writes the last software RHI frame to this TGA file on exit (-screenshot=File). */
+    FString ScreenshotFilename;
+
+    /** Quits after this many frames and prints the RHI stats; 0 runs until the window closes (-frames=N). */
+    uint64 MaxFrames = 0;
+
+    /** Records the RHI command stream to this file; headless RHIs only (-rhicapture=File). */
+    FString CaptureFilename;
+
+    /** 1-based frame to record; 0 records every frame (-captureframe=N). */
+    uint64 CaptureFrame = 0;
+
+    /** Plays this capture on the headless RHI instead of running the scene, then prints the stats (-rhireplay=File). */
+    FString ReplayFilename;
+
+    /** How many times the replay runs through the captured frames (-replaypasses=N). */
+    uint32 ReplayPasses = 1;
+
+    /** @return Whether the loop runs without a window, device or swap chain. */
+    bool IsHeadless() const { return bNullRHI || bSoftwareRHI; }
+};
 
 class LaunchEngineLoop
 {
 public:
-    LaunchEngineLoop();
-    virtual ~LaunchEngineLoop() = default;
+    LaunchEngineLoop(const FRenderingThreadSettings& InRenderingSettings = FRenderingThreadSettings(), const FString& InWorldName = FString(), const FEngineLoopSettings& InSettings = FEngineLoopSettings());
+    virtual ~LaunchEngineLoop();
     
     int Run();
 
-    LRESULT HandleMessage(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
+    /** Waits until the render thread has submitted every queued frame, before the swap chain changes. */
+    void FlushRenderingThread();
 
-    // Get Window
-    inline Window* GetWindow() const { return ActiveWindow.get(); }
+    /** Resizes the back buffer the render graph declares and the viewport the scene projects into. */
+    void SetViewportSize(uint32 Width, uint32 Height);
 
 private:
-    // Main Property
-    std::unique_ptr<Window> ActiveWindow = nullptr;
-    std::unique_ptr<URenderer> UEngineRenderer = nullptr;
+#ifdef _WIN32
+    // 창 모드에서만 만든다: 창, 메시지 펌프, D3D11 디바이스와 스왑체인
+    std::unique_ptr<FWindowsApplication> Application = nullptr;
+#endif
+
+    // 버퍼 생성과 제출이 거치는 RHI (D3D11 또는 Null), GDynamicRHI가 가리킨다
+    std::unique_ptr<FDynamicRHI> DynamicRHI = nullptr;
+    FEngineLoopSettings Settings;
+
+    // -softwarerhi 일 때 DynamicRHI(또는 그것을 감싼 캡처 RHI)가 소유한 CPU 래스터라이저 RHI
+    FSoftwareDynamicRHI* SoftwareRHI = nullptr;
+    std::unique_ptr<UScene> Scene = nullptr;
+
+    // 카메라 주변 셀만 비동기로 로드/언로드
+    std::unique_ptr<UWorld> World = nullptr;
+
+    // Rendering
+    // 게임 스레드가 프레임 패킷을 만들고 렌더 스레드가 제출한다
+    std::unique_ptr<FSceneRenderer> SceneRenderer = nullptr;
+    FRenderingThreadSettings RenderingSettings;
+    FRenderingThread RenderingThread;
+
+    // 렌더 스레드가 프레임마다 패스를 선언하고 실행한다. 임시 렌더 타깃은 풀에서 재사용
+    FRenderGraphTexturePool RenderGraphPool;
+    FRenderGraph RenderGraph;
+
+    // 스왑체인 크기. 창 크기가 바뀌면 렌더 스레드를 비운 뒤에 바꾼다
+    uint32 BackBufferWidth = 0;
+    uint32 BackBufferHeight = 0;
+
+    void RenderFrame(const FFramePacket& Packet);
+
+    void PrintRHIStats() const;
+
+    /** Runs Settings.ReplayFilename on DynamicRHI. @return The process exit code. */
+    int RunReplay();
+
+    /** Saves the software RHI image to Settings.ScreenshotFilename, if both are set. */
+    void SaveScreenshot() const;
 
     // Property
     bool bRunning = true;
-    bool bWindowCreated = false;
 
 
     // Tick
     void CalculateFrameStats(float DeltaTime);
     int FrameCount = 0;
-    
-    // Event
-    void OnResize(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
-
-    void OnMouseMove(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
-
-    void OnKeyDown(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
 };
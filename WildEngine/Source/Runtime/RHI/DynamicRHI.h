@@ -0,0 +1,191 @@
+﻿#pragma once
+
+#include "RHI.h"
+
+/**
+ * What an RHI was asked to do, counted by every implementation the same way.
+ * Creation counters are bumped by whichever thread creates the device
+ * resource and draw counters by the rendering thread, so read them while it
+ * is idle (FRenderingThread::Flush).
+ */
+struct FRHIStats
+{
+    uint64 NumFrames = 0;
+
+    uint32 NumVertexBuffersCreated = 0;
+    uint64 NumVertexBufferBytes = 0;
+
+    /** Ranges written into existing vertex buffers, on the rendering thread. */
+    uint64 NumVertexBufferUpdates = 0;
+    uint64 NumVertexBufferUpdateBytes = 0;
+
+    /** Render targets, created on the rendering thread by the render graph's pool. */
+    uint32 NumTexturesCreated = 0;
+
+    uint64 NumConstantUpdates = 0;
+    uint64 NumConstantBytes = 0;
+
+    uint64 NumDrawCalls = 0;
+    uint64 NumPrimitives = 0;
+    uint64 NumInstances = 0;
+};
+
+/**
+ * Shader constant slots of the ShaderW0 draws issued through the RHI. Slot 0
+ * holds the row-major MVP, or the view projection when slot 1 holds the
+ * FRHIInstanceData of an instanced draw. An empty slot 1 means not instanced.
+ */
+enum ERHIShaderConstantSlot : uint32
+{
+    SCS_Transform = 0,
+    SCS_Instances = 1,
+};
+
+/** Per-instance constants of an instanced draw; layout matches FPrimitiveInstance. */
+struct FRHIInstanceData
+{
+    float WorldMatrix[4][4];
+    float Color[4];
+};
+
+/** Instances one draw can take; a constant buffer holds at most 64 KB. */
+constexpr uint32 RHIMaxInstancesPerDraw = 65536 / sizeof(FRHIInstanceData);
+
+/**
+ * Frames the CPU may queue ahead of the GPU. The swap chain is held to it
+ * (IDXGIDevice1::SetMaximumFrameLatency), and an RHI with more unretired
+ * frame fences than this waits for the oldest.
+ */
+constexpr uint32 RHIMaxGpuFramesInFlight = 3;
+
+/**
+ * The interface the engine submits through, implemented once per graphics API.
+ *
+ * Only what frame code needs is here: buffer creation, shader constants,
+ * depth state and draws. Everything API specific (shaders, the rest of the
+ * pipeline state, swap chain) stays behind it, so the same scene, culling and
+ * submission code runs on D3D11 or, headless, on the Null RHI.
+ */
+class FDynamicRHI
+{
+public:
+    virtual ~FDynamicRHI() = default;
+
+    /** Called after the RHI has been created. */
+    virtual void Init() = 0;
+
+    /** Called before the RHI is destroyed. */
+    virtual void Shutdown() = 0;
+
+    virtual const char* GetName() const = 0;
+
+    /** Game thread. Creates a vertex buffer holding Size bytes of Data (may be null for BUF_Dynamic). */
+    virtual FRHIVertexBuffer* RHICreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage) = 0;
+
+    /**
+     * Any thread. Creates a vertex buffer of Size bytes without touching the
+     * device, so it can be referenced right away; nothing may draw from it
+     * before RHIInitVertexBuffer has run.
+     */
+    virtual FRHIVertexBuffer* RHIAllocVertexBuffer(uint32 Size, uint32 InUsage) = 0;
+
+    /** Rendering thread. Creates the device buffer behind one from RHIAllocVertexBuffer, holding Data (null leaves it for RHIUpdateVertexBuffer). */
+    virtual void RHIInitVertexBuffer(FRHIVertexBuffer* VertexBuffer, const void* Data) = 0;
+
+    /** Rendering thread. Copies Size bytes of Data to Offset of a BUF_Static buffer created without data. */
+    virtual void RHIUpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size) = 0;
+
+    /** Creates an uninitialized 2D texture; Flags (ETextureCreateFlags) say how it will be bound. */
+    virtual FRHITexture2D* RHICreateTexture2D(uint32 SizeX, uint32 SizeY, EPixelFormat Format, uint32 Flags) = 0;
+
+    /** Rendering thread. Replaces the contents of the vertex shader constant buffer in slot BufferIndex; 0 bytes unbinds it. */
+    virtual void RHISetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes) = 0;
+
+    virtual void RHISetStreamSource(uint32 StreamIndex, FRHIVertexBuffer* VertexBuffer, uint32 Stride, uint32 Offset) = 0;
+
+    /**
+     * Rendering thread. Sets how the following draws test and write depth until
+     * it is set again. Before the first call draws use LESS with depth writes.
+     */
+    virtual void RHISetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer) = 0;
+
+    virtual void RHIDrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances) = 0;
+
+    /** Draws vertices straight from CPU memory, copied into a transient buffer. */
+    virtual void RHIDrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride) = 0;
+
+    virtual void RHIBeginFrame() = 0;
+    virtual void RHIEndFrame() = 0;
+
+    /** Rendering thread, after RHIEndFrame. Marks the end of frame FrameNumber's GPU work. */
+    virtual void RHISignalFrameFence(uint64 FrameNumber) { SignaledFrameNumber = FrameNumber; }
+
+    /**
+     * Rendering thread. @return The newest frame whose fence the GPU has passed; resources
+     * last used by it or older can be deleted. CPU RHIs finish a frame before it is signaled.
+     */
+    virtual uint64 RHIGetRetiredFrameNumber() { return SignaledFrameNumber; }
+
+    /** Virtual so wrapping RHIs can report the stats of the RHI they forward to. */
+    virtual const FRHIStats& GetStats() const { return Stats; }
+    virtual void ResetStats() { Stats = FRHIStats(); }
+
+protected:
+    FRHIStats Stats;
+
+private:
+    uint64 SignaledFrameNumber = 0;
+};
+
+/** A global pointer to the dynamic RHI implementation. */
+extern FDynamicRHI* GDynamicRHI;
+
+inline FRHIVertexBuffer* RHICreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage = BUF_Static)
+{
+    return GDynamicRHI->RHICreateVertexBuffer(Data, Size, InUsage);
+}
+
+inline FRHIVertexBuffer* RHIAllocVertexBuffer(uint32 Size, uint32 InUsage = BUF_Static)
+{
+    return GDynamicRHI->RHIAllocVertexBuffer(Size, InUsage);
+}
+
+inline void RHIInitVertexBuffer(FRHIVertexBuffer* VertexBuffer, const void* Data)
+{
+    GDynamicRHI->RHIInitVertexBuffer(VertexBuffer, Data);
+}
+
+inline void RHIUpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size)
+{
+    GDynamicRHI->RHIUpdateVertexBuffer(VertexBuffer, Offset, Data, Size);
+}
+
+inline FRHITexture2D* RHICreateTexture2D(uint32 SizeX, uint32 SizeY, EPixelFormat Format, uint32 Flags)
+{
+    return GDynamicRHI->RHICreateTexture2D(SizeX, SizeY, Format, Flags);
+}
+
+inline void RHISetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes)
+{
+    GDynamicRHI->RHISetShaderConstants(BufferIndex, Data, NumBytes);
+}
+
+inline void RHISetStreamSource(uint32 StreamIndex, FRHIVertexBuffer* VertexBuffer, uint32 Stride, uint32 Offset)
+{
+    GDynamicRHI->RHISetStreamSource(StreamIndex, VertexBuffer, Stride, Offset);
+}
+
+inline void RHISetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer)
+{
+    GDynamicRHI->RHISetDepthStencilState(Initializer);
+}
+
+inline void RHIDrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances)
+{
+    GDynamicRHI->RHIDrawPrimitive(PrimitiveType, BaseVertexIndex, NumPrimitives, NumInstances);
+}
+
+inline void RHIDrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride)
+{
+    GDynamicRHI->RHIDrawPrimitiveUP(PrimitiveType, NumPrimitives, VertexData, VertexDataStride);
+}
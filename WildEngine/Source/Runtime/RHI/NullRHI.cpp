@@ -0,0 +1,56 @@
+﻿#include "NullRHI.h"
+
+FRHIVertexBuffer* FNullDynamicRHI::RHICreateVertexBuffer(const void* /*Data*/, uint32 Size, uint32 InUsage)
+{
+    ++Stats.NumVertexBuffersCreated;
+    Stats.NumVertexBufferBytes += Size;
+    return new FNullVertexBuffer(Size, InUsage);
+}
+
+FRHIVertexBuffer* FNullDynamicRHI::RHIAllocVertexBuffer(uint32 Size, uint32 InUsage)
+{
+    return new FNullVertexBuffer(Size, InUsage);
+}
+
+void FNullDynamicRHI::RHIInitVertexBuffer(FRHIVertexBuffer* VertexBuffer, const void* /*Data*/)
+{
+    ++Stats.NumVertexBuffersCreated;
+    Stats.NumVertexBufferBytes += VertexBuffer->GetSize();
+}
+
+void FNullDynamicRHI::RHIUpdateVertexBuffer(FRHIVertexBuffer* /*VertexBuffer*/, uint32 /*Offset*/, const void* /*Data*/, uint32 Size)
+{
+    ++Stats.NumVertexBufferUpdates;
+    Stats.NumVertexBufferUpdateBytes += Size;
+}
+
+FRHITexture2D* FNullDynamicRHI::RHICreateTexture2D(uint32 SizeX, uint32 SizeY, EPixelFormat Format, uint32 Flags)
+{
+    ++Stats.NumTexturesCreated;
+    return new FNullTexture2D(SizeX, SizeY, Format, Flags);
+}
+
+void FNullDynamicRHI::RHISetShaderConstants(uint32 /*BufferIndex*/, const void* /*Data*/, uint32 NumBytes)
+{
+    ++Stats.NumConstantUpdates;
+    Stats.NumConstantBytes += NumBytes;
+}
+
+void FNullDynamicRHI::RHIDrawPrimitive(EPrimitiveType /*PrimitiveType*/, uint32 /*BaseVertexIndex*/, uint32 NumPrimitives, uint32 NumInstances)
+{
+    ++Stats.NumDrawCalls;
+    Stats.NumPrimitives += static_cast<uint64>(NumPrimitives) * NumInstances;
+    Stats.NumInstances += NumInstances;
+}
+
+void FNullDynamicRHI::RHIDrawPrimitiveUP(EPrimitiveType /*PrimitiveType*/, uint32 NumPrimitives, const void* /*VertexData*/, uint32 /*VertexDataStride*/)
+{
+    ++Stats.NumDrawCalls;
+    Stats.NumPrimitives += NumPrimitives;
+    Stats.NumInstances += 1;
+}
+
+void FNullDynamicRHI::RHIEndFrame()
+{
+    ++Stats.NumFrames;
+}
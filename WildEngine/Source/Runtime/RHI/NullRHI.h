@@ -0,0 +1,49 @@
+﻿#pragma once
+
+#include "DynamicRHI.h"
+
+/** A vertex buffer with no storage; only its size and usage are kept. */
+class FNullVertexBuffer : public FRHIVertexBuffer
+{
+public:
+    FNullVertexBuffer(uint32 InSize, uint32 InUsage)
+    : FRHIVertexBuffer(InSize, InUsage)
+    {}
+};
+
+/** A texture with no storage; only its description is kept. */
+class FNullTexture2D : public FRHITexture2D
+{
+public:
+    FNullTexture2D(uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, uint32 InFlags)
+    : FRHITexture2D(InSizeX, InSizeY, 1, 1, InFormat, InFlags)
+    {}
+};
+
+/**
+ * A null implementation of the dynamic RHI: accepts everything, draws nothing.
+ *
+ * Lets the engine loop run without a GPU or a window (-nullrhi), e.g. to
+ * profile scene update, culling and submission on a build machine. Every
+ * call only updates FRHIStats, so runs can be compared by call counts.
+ */
+class FNullDynamicRHI : public FDynamicRHI
+{
+public:
+    void Init() override {}
+    void Shutdown() override {}
+    const char* GetName() const override { return "Null"; }
+
+    FRHIVertexBuffer* RHICreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage) override;
+    FRHIVertexBuffer* RHIAllocVertexBuffer(uint32 Size, uint32 InUsage) override;
+    void RHIInitVertexBuffer(FRHIVertexBuffer* VertexBuffer, const void* Data) override;
+    void RHIUpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size) override;
+    FRHITexture2D* RHICreateTexture2D(uint32 SizeX, uint32 SizeY, EPixelFormat Format, uint32 Flags) override;
+    void RHISetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes) override;
+    void RHISetStreamSource(uint32 /*StreamIndex*/, FRHIVertexBuffer* /*VertexBuffer*/, uint32 /*Stride*/, uint32 /*Offset*/) override {}
+    void RHISetDepthStencilState(const FDepthStencilStateInitializerRHI& /*Initializer*/) override {}
+    void RHIDrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances) override;
+    void RHIDrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride) override;
+    void RHIBeginFrame() override {}
+    void RHIEndFrame() override;
+};
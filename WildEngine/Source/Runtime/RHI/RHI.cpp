@@ -0,0 +1,83 @@
+﻿#include "RHI.h"
+#include "DynamicRHI.h"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+FDynamicRHI* GDynamicRHI = nullptr;
+
+namespace
+{
+    struct FPendingDelete
+    {
+        const FRHIResource* Resource;
+
+        /** Newest frame that may still reference Resource. */
+        uint64 FrameNumber;
+    };
+
+    // 함수 내 static이 아닌 전역이어야 종료 시 싱글턴 소멸자에서 Release해도 안전하다
+    std::mutex PendingDeletesMutex;
+    std::vector<FPendingDelete> PendingDeletes;
+    std::atomic<uint64> CurrentFrameNumber{ 0 };
+}
+
+uint32 FRHIResource::Release() const
+{
+    const int32 NewNumRefs = NumRefs.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    if (NewNumRefs == 0)
+    {
+        // GPU가 아직 읽고 있을 수 있으므로 프레임이 끝날 때까지 미룬다
+        std::lock_guard<std::mutex> Lock(PendingDeletesMutex);
+        PendingDeletes.push_back({ this, CurrentFrameNumber.load(std::memory_order_acquire) });
+    }
+    return static_cast<uint32>(NewNumRefs);
+}
+
+void FRHIResource::BeginFrame(uint64 FrameNumber)
+{
+    CurrentFrameNumber.store(FrameNumber, std::memory_order_release);
+}
+
+void FRHIResource::FlushPendingDeletes(uint64 RetiredFrameNumber)
+{
+    std::vector<const FRHIResource*> ToDelete;
+    {
+        std::lock_guard<std::mutex> Lock(PendingDeletesMutex);
+        for (size_t Index = 0; Index < PendingDeletes.size();)
+        {
+            if (PendingDeletes[Index].FrameNumber <= RetiredFrameNumber)
+            {
+                ToDelete.push_back(PendingDeletes[Index].Resource);
+                PendingDeletes[Index] = PendingDeletes.back();
+                PendingDeletes.pop_back();
+            }
+            else
+            {
+                ++Index;
+            }
+        }
+    }
+
+    // 소멸자가 다른 리소스를 Release할 수 있으므로 락 밖에서 지운다
+    for (const FRHIResource* Resource : ToDelete)
+    {
+        delete Resource;
+    }
+}
+
+void FRHIResource::FlushAllPendingDeletes()
+{
+    // 지우는 중에 새로 큐에 들어온 리소스까지 비운다
+    while (GetNumPendingDeletes() > 0)
+    {
+        FlushPendingDeletes(UINT64_MAX);
+    }
+}
+
+uint32 FRHIResource::GetNumPendingDeletes()
+{
+    std::lock_guard<std::mutex> Lock(PendingDeletesMutex);
+    return static_cast<uint32>(PendingDeletes.size());
+}
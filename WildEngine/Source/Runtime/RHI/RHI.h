@@ -1,6 +1,8 @@
 ﻿#pragma once
 
-#include "Core.h"
+// 플랫폼 SDK 헤더는 넣지 않는다. RHI와 Null/Software 구현은 Windows 없이도 빌드된다
+#include "HAL/PlatformTypes.h"
+#include "Templates/UnrealTypes.h"
 #include "PixelFormat.h"
 
 //
@@ -152,6 +154,25 @@ enum EResourceLockMode
 	RLM_Num
 };
 
+/** Resource usage flags - for vertex and index buffers. */
+enum EBufferUsageFlags
+{
+	BUF_None    = 0x0000,
+
+	// Mutually exclusive write-frequency flags
+	BUF_Static  = 0x0001, // The buffer will be written to once.
+	BUF_Dynamic = 0x0002, // The buffer will be written to occasionally, GPU read only, CPU write only.
+};
+
+/** Texture creation flags - how the texture will be bound. */
+enum ETextureCreateFlags
+{
+	TexCreate_None                   = 0x0000,
+	TexCreate_RenderTargetable       = 0x0001,
+	TexCreate_DepthStencilTargetable = 0x0002,
+	TexCreate_ShaderResource         = 0x0004,
+};
+
 
 enum EPrimitiveType
 {
@@ -164,6 +185,20 @@ enum EPrimitiveType
 	PT_NumBits = 6
 };
 
+/** @return The number of vertices NumPrimitives primitives of PrimitiveType take. */
+inline uint32 GetVertexCountForPrimitiveCount(uint32 NumPrimitives, EPrimitiveType PrimitiveType)
+{
+	switch (PrimitiveType)
+	{
+	case PT_TriangleList:  return NumPrimitives * 3;
+	case PT_TriangleStrip: return NumPrimitives + 2;
+	case PT_LineList:      return NumPrimitives * 2;
+	case PT_QuadList:      return NumPrimitives * 4;
+	case PT_PointList:     return NumPrimitives;
+	default:               return 0;
+	}
+}
+
 #define ENUM_RHI_RESOURCE_TYPES(EnumerationMacro) \
 	EnumerationMacro(SamplerState,None) \
 	EnumerationMacro(RasterizerState,None) \
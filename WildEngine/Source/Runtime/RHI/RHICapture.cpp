@@ -0,0 +1,561 @@
+﻿#include "RHICapture.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    /** Bounds checked reads over a loaded capture. */
+    class FCaptureReader
+    {
+    public:
+        FCaptureReader(const TArray<uint8>& InData, size_t InOffset)
+            : Data(InData), Offset(InOffset)
+        {
+        }
+
+        bool AtEnd() const { return Offset >= Data.size(); }
+
+        bool ReadUInt8(uint8& OutValue)
+        {
+            if (Offset + 1 > Data.size())
+            {
+                return false;
+            }
+            OutValue = Data[Offset++];
+            return true;
+        }
+
+        bool ReadUInt32(uint32& OutValue)
+        {
+            if (Offset + sizeof(uint32) > Data.size())
+            {
+                return false;
+            }
+            std::memcpy(&OutValue, Data.data() + Offset, sizeof(uint32));
+            Offset += sizeof(uint32);
+            return true;
+        }
+
+        /** @return The next NumBytes bytes in place, or null when the capture is shorter. */
+        const uint8* ReadBytes(size_t NumBytes)
+        {
+            if (NumBytes > Data.size() - Offset)
+            {
+                return nullptr;
+            }
+            const uint8* Bytes = Data.data() + Offset;
+            Offset += NumBytes;
+            return Bytes;
+        }
+
+    private:
+        const TArray<uint8>& Data;
+        size_t Offset;
+    };
+
+    /** Fills OutFields with the initializer's members as SetDepthStencilState writes them, in declaration order. */
+    void PackDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer, uint32 (&OutFields)[RHICaptureDepthStencilStateFields])
+    {
+        const uint32 Fields[RHICaptureDepthStencilStateFields] =
+        {
+            Initializer.bEnableDepthWrite, static_cast<uint32>(Initializer.DepthTest),
+            Initializer.bEnableFrontFaceStencil, static_cast<uint32>(Initializer.FrontFaceStencilTest),
+            static_cast<uint32>(Initializer.FrontFaceStencilFailStencilOp), static_cast<uint32>(Initializer.FrontFaceDepthFailStencilOp),
+            static_cast<uint32>(Initializer.FrontFacePassStencilOp),
+            Initializer.bEnableBackFaceStencil, static_cast<uint32>(Initializer.BackFaceStencilTest),
+            static_cast<uint32>(Initializer.BackFaceStencilFailStencilOp), static_cast<uint32>(Initializer.BackFaceDepthFailStencilOp),
+            static_cast<uint32>(Initializer.BackFacePassStencilOp),
+            Initializer.StencilReadMask, Initializer.StencilWriteMask,
+        };
+        std::memcpy(OutFields, Fields, sizeof(Fields));
+    }
+
+    FDepthStencilStateInitializerRHI UnpackDepthStencilState(const uint32 (&Fields)[RHICaptureDepthStencilStateFields])
+    {
+        FDepthStencilStateInitializerRHI Initializer;
+        Initializer.bEnableDepthWrite = Fields[0] != 0;
+        Initializer.DepthTest = static_cast<ECompareFunction>(Fields[1]);
+        Initializer.bEnableFrontFaceStencil = Fields[2] != 0;
+        Initializer.FrontFaceStencilTest = static_cast<ECompareFunction>(Fields[3]);
+        Initializer.FrontFaceStencilFailStencilOp = static_cast<EStencilOp>(Fields[4]);
+        Initializer.FrontFaceDepthFailStencilOp = static_cast<EStencilOp>(Fields[5]);
+        Initializer.FrontFacePassStencilOp = static_cast<EStencilOp>(Fields[6]);
+        Initializer.bEnableBackFaceStencil = Fields[7] != 0;
+        Initializer.BackFaceStencilTest = static_cast<ECompareFunction>(Fields[8]);
+        Initializer.BackFaceStencilFailStencilOp = static_cast<EStencilOp>(Fields[9]);
+        Initializer.BackFaceDepthFailStencilOp = static_cast<EStencilOp>(Fields[10]);
+        Initializer.BackFacePassStencilOp = static_cast<EStencilOp>(Fields[11]);
+        Initializer.StencilReadMask = static_cast<uint8>(Fields[12]);
+        Initializer.StencilWriteMask = static_cast<uint8>(Fields[13]);
+        return Initializer;
+    }
+
+    bool ReadDepthStencilState(FCaptureReader& Reader, uint32 (&OutFields)[RHICaptureDepthStencilStateFields])
+    {
+        for (uint32& Field : OutFields)
+        {
+            if (!Reader.ReadUInt32(Field))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+FRecordingDynamicRHI::FRecordingDynamicRHI(std::unique_ptr<FDynamicRHI> InInnerRHI, const FString& InFilename, uint64 InCaptureFrame)
+    : InnerRHI(std::move(InInnerRHI))
+    , Filename(InFilename)
+    , CaptureFrame(InCaptureFrame)
+{
+}
+
+void FRecordingDynamicRHI::Init()
+{
+    InnerRHI->Init();
+
+    File.open(Filename, std::ios::binary | std::ios::trunc);
+    if (!File.is_open())
+    {
+        std::printf("Failed to open RHI capture %s for writing, nothing will be recorded\n", Filename.c_str());
+    }
+
+    const FRHICaptureHeader Header;
+    std::lock_guard<std::mutex> Lock(Mutex);
+    WriteBytes(&Header, sizeof(Header));
+}
+
+void FRecordingDynamicRHI::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        FlushToFile();
+    }
+    File.close();
+
+    InnerRHI->Shutdown();
+}
+
+FRHIVertexBuffer* FRecordingDynamicRHI::RHICreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage)
+{
+    FRHIVertexBuffer* VertexBuffer = InnerRHI->RHICreateVertexBuffer(Data, Size, InUsage);
+
+    // 어느 프레임을 캡처하든 그 전에 만든 버퍼가 필요하므로 생성은 항상 기록한다
+    std::lock_guard<std::mutex> Lock(Mutex);
+    RecordCreateVertexBuffer(VertexBuffer, Data, Size, InUsage);
+    return VertexBuffer;
+}
+
+FRHIVertexBuffer* FRecordingDynamicRHI::RHIAllocVertexBuffer(uint32 Size, uint32 InUsage)
+{
+    // 아직 디바이스에 없는 버퍼다. 기록은 RHIInitVertexBuffer에서 한다
+    return InnerRHI->RHIAllocVertexBuffer(Size, InUsage);
+}
+
+void FRecordingDynamicRHI::RHIInitVertexBuffer(FRHIVertexBuffer* VertexBuffer, const void* Data)
+{
+    InnerRHI->RHIInitVertexBuffer(VertexBuffer, Data);
+
+    // 리플레이는 여기서 한 번에 만든다. 그 전에는 아무도 이 버퍼로 그리지 않는다
+    std::lock_guard<std::mutex> Lock(Mutex);
+    RecordCreateVertexBuffer(VertexBuffer, Data, VertexBuffer->GetSize(), VertexBuffer->GetUsage());
+}
+
+void FRecordingDynamicRHI::RecordCreateVertexBuffer(const FRHIVertexBuffer* VertexBuffer, const void* Data, uint32 Size, uint32 InUsage)
+{
+    WriteCommand(ERHICaptureCommand::CreateVertexBuffer);
+    WriteUInt32(Size);
+    WriteUInt32(InUsage);
+    Pending.push_back(Data ? 1 : 0);
+    if (Data)
+    {
+        WriteBytes(Data, Size);
+    }
+
+    // 해제된 버퍼의 주소를 새 버퍼가 받으면 새 id로 덮어쓴다
+    if (VertexBuffer)
+    {
+        BufferIds[VertexBuffer] = NumBuffers;
+    }
+    ++NumBuffers;
+}
+
+void FRecordingDynamicRHI::RHIUpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size)
+{
+    InnerRHI->RHIUpdateVertexBuffer(VertexBuffer, Offset, Data, Size);
+
+    // 생성처럼 항상 기록한다. 서브 할당된 메시는 생성이 아니라 갱신으로 내용이 들어간다
+    std::lock_guard<std::mutex> Lock(Mutex);
+    const auto It = BufferIds.find(VertexBuffer);
+    if (It != BufferIds.end())
+    {
+        WriteCommand(ERHICaptureCommand::UpdateVertexBuffer);
+        WriteUInt32(It->second);
+        WriteUInt32(Offset);
+        WriteUInt32(Size);
+        WriteBytes(Data, Size);
+    }
+}
+
+FRHITexture2D* FRecordingDynamicRHI::RHICreateTexture2D(uint32 SizeX, uint32 SizeY, EPixelFormat Format, uint32 Flags)
+{
+    // 렌더 타깃은 캡처 포맷에 없다. 리플레이는 대상 RHI의 백버퍼에 그린다
+    return InnerRHI->RHICreateTexture2D(SizeX, SizeY, Format, Flags);
+}
+
+void FRecordingDynamicRHI::RHISetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes)
+{
+    InnerRHI->RHISetShaderConstants(BufferIndex, Data, NumBytes);
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (bRecordingFrame)
+    {
+        WriteCommand(ERHICaptureCommand::SetShaderConstants);
+        WriteUInt32(BufferIndex);
+        WriteUInt32(NumBytes);
+        WriteBytes(Data, NumBytes);
+    }
+}
+
+void FRecordingDynamicRHI::RHISetStreamSource(uint32 StreamIndex, FRHIVertexBuffer* VertexBuffer, uint32 Stride, uint32 Offset)
+{
+    InnerRHI->RHISetStreamSource(StreamIndex, VertexBuffer, Stride, Offset);
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (bRecordingFrame)
+    {
+        const auto It = BufferIds.find(VertexBuffer);
+        WriteCommand(ERHICaptureCommand::SetStreamSource);
+        WriteUInt32(StreamIndex);
+        WriteUInt32(It != BufferIds.end() ? It->second : RHICaptureNullBufferId);
+        WriteUInt32(Stride);
+        WriteUInt32(Offset);
+    }
+}
+
+void FRecordingDynamicRHI::RHISetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer)
+{
+    InnerRHI->RHISetDepthStencilState(Initializer);
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (bRecordingFrame)
+    {
+        uint32 Fields[RHICaptureDepthStencilStateFields];
+        PackDepthStencilState(Initializer, Fields);
+        WriteCommand(ERHICaptureCommand::SetDepthStencilState);
+        WriteBytes(Fields, sizeof(Fields));
+    }
+}
+
+void FRecordingDynamicRHI::RHIDrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances)
+{
+    InnerRHI->RHIDrawPrimitive(PrimitiveType, BaseVertexIndex, NumPrimitives, NumInstances);
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (bRecordingFrame)
+    {
+        WriteCommand(ERHICaptureCommand::DrawPrimitive);
+        WriteUInt32(static_cast<uint32>(PrimitiveType));
+        WriteUInt32(BaseVertexIndex);
+        WriteUInt32(NumPrimitives);
+        WriteUInt32(NumInstances);
+    }
+}
+
+void FRecordingDynamicRHI::RHIDrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride)
+{
+    InnerRHI->RHIDrawPrimitiveUP(PrimitiveType, NumPrimitives, VertexData, VertexDataStride);
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (bRecordingFrame)
+    {
+        WriteCommand(ERHICaptureCommand::DrawPrimitiveUP);
+        WriteUInt32(static_cast<uint32>(PrimitiveType));
+        WriteUInt32(NumPrimitives);
+        WriteUInt32(VertexDataStride);
+        WriteBytes(VertexData, GetVertexCountForPrimitiveCount(NumPrimitives, PrimitiveType) * VertexDataStride);
+    }
+}
+
+void FRecordingDynamicRHI::RHIBeginFrame()
+{
+    InnerRHI->RHIBeginFrame();
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    ++NumFrames;
+    bRecordingFrame = CaptureFrame == 0 || NumFrames == CaptureFrame;
+    if (bRecordingFrame)
+    {
+        WriteCommand(ERHICaptureCommand::BeginFrame);
+    }
+}
+
+void FRecordingDynamicRHI::RHIEndFrame()
+{
+    InnerRHI->RHIEndFrame();
+
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (bRecordingFrame)
+    {
+        WriteCommand(ERHICaptureCommand::EndFrame);
+        ++NumCapturedFrames;
+        bRecordingFrame = false;
+
+        // 프레임 단위로 파일에 붙여 써서 중간에 죽어도 끝난 프레임은 남는다
+        FlushToFile();
+    }
+}
+
+void FRecordingDynamicRHI::WriteCommand(ERHICaptureCommand Command)
+{
+    Pending.push_back(static_cast<uint8>(Command));
+}
+
+void FRecordingDynamicRHI::WriteUInt32(uint32 Value)
+{
+    WriteBytes(&Value, sizeof(Value));
+}
+
+void FRecordingDynamicRHI::WriteBytes(const void* Data, uint32 NumBytes)
+{
+    const uint8* Bytes = static_cast<const uint8*>(Data);
+    Pending.insert(Pending.end(), Bytes, Bytes + NumBytes);
+}
+
+void FRecordingDynamicRHI::FlushToFile()
+{
+    if (IsCapturing() && !Pending.empty())
+    {
+        File.write(reinterpret_cast<const char*>(Pending.data()), static_cast<std::streamsize>(Pending.size()));
+        File.flush();
+        if (!File.good())
+        {
+            std::printf("Failed to write RHI capture %s, it ends after %llu frames\n", Filename.c_str(), NumCapturedFrames);
+        }
+    }
+    Pending.clear();
+}
+
+bool FRHICaptureReplayer::Load(const FString& Filename)
+{
+    Data.clear();
+    NumFrames = 0;
+    NumBuffers = 0;
+
+    std::ifstream File(Filename, std::ios::binary);
+    if (!File)
+    {
+        return false;
+    }
+    Data.assign(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+
+    FRHICaptureHeader Header;
+    if (Data.size() < sizeof(Header))
+    {
+        return false;
+    }
+    std::memcpy(&Header, Data.data(), sizeof(Header));
+    if (Header.Magic != FRHICaptureHeader::ExpectedMagic || Header.Version != FRHICaptureHeader::CurrentVersion)
+    {
+        Data.clear();
+        return false;
+    }
+
+    // 명령 하나씩 건너뛰며 프레임과 버퍼 수를 센다
+    FCaptureReader Reader(Data, sizeof(FRHICaptureHeader));
+    while (!Reader.AtEnd())
+    {
+        uint8 Command = 0;
+        uint32 Args[4] = {};
+        Reader.ReadUInt8(Command);
+        switch (static_cast<ERHICaptureCommand>(Command))
+        {
+        case ERHICaptureCommand::BeginFrame:
+            break;
+        case ERHICaptureCommand::EndFrame:
+            ++NumFrames;
+            break;
+        case ERHICaptureCommand::CreateVertexBuffer:
+        {
+            uint8 bHasData = 0;
+            if (!Reader.ReadUInt32(Args[0]) || !Reader.ReadUInt32(Args[1]) || !Reader.ReadUInt8(bHasData) ||
+                (bHasData && !Reader.ReadBytes(Args[0])))
+            {
+                return false;
+            }
+            ++NumBuffers;
+            break;
+        }
+        case ERHICaptureCommand::SetShaderConstants:
+            if (!Reader.ReadUInt32(Args[0]) || !Reader.ReadUInt32(Args[1]) || !Reader.ReadBytes(Args[1]))
+            {
+                return false;
+            }
+            break;
+        case ERHICaptureCommand::SetStreamSource:
+        case ERHICaptureCommand::DrawPrimitive:
+            if (!Reader.ReadUInt32(Args[0]) || !Reader.ReadUInt32(Args[1]) || !Reader.ReadUInt32(Args[2]) || !Reader.ReadUInt32(Args[3]))
+            {
+                return false;
+            }
+            break;
+        case ERHICaptureCommand::DrawPrimitiveUP:
+            if (!Reader.ReadUInt32(Args[0]) || !Reader.ReadUInt32(Args[1]) || !Reader.ReadUInt32(Args[2]) ||
+                !Reader.ReadBytes(static_cast<size_t>(GetVertexCountForPrimitiveCount(Args[1], static_cast<EPrimitiveType>(Args[0]))) * Args[2]))
+            {
+                return false;
+            }
+            break;
+        case ERHICaptureCommand::UpdateVertexBuffer:
+            if (!Reader.ReadUInt32(Args[0]) || !Reader.ReadUInt32(Args[1]) || !Reader.ReadUInt32(Args[2]) || !Reader.ReadBytes(Args[2]))
+            {
+                return false;
+            }
+            break;
+        case ERHICaptureCommand::SetDepthStencilState:
+            if (!Reader.ReadBytes(RHICaptureDepthStencilStateFields * sizeof(uint32)))
+            {
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FRHICaptureReplayer::Replay(FDynamicRHI& Target, uint32 NumPasses)
+{
+    // 캡처가 끝날 때까지 버퍼를 잡아 둔다 (id는 생성 순서)
+    TArray<TRefCountPtr<FRHIVertexBuffer>> Buffers;
+    Buffers.reserve(NumBuffers);
+
+    for (uint32 Pass = 0; Pass < NumPasses; ++Pass)
+    {
+        FCaptureReader Reader(Data, sizeof(FRHICaptureHeader));
+        while (!Reader.AtEnd())
+        {
+            uint8 Command = 0;
+            Reader.ReadUInt8(Command);
+            switch (static_cast<ERHICaptureCommand>(Command))
+            {
+            case ERHICaptureCommand::BeginFrame:
+                Target.RHIBeginFrame();
+                break;
+            case ERHICaptureCommand::EndFrame:
+                Target.RHIEndFrame();
+                break;
+            case ERHICaptureCommand::CreateVertexBuffer:
+            {
+                uint32 Size = 0;
+                uint32 Usage = 0;
+                uint8 bHasData = 0;
+                if (!Reader.ReadUInt32(Size) || !Reader.ReadUInt32(Usage) || !Reader.ReadUInt8(bHasData))
+                {
+                    return false;
+                }
+                const uint8* BufferData = bHasData ? Reader.ReadBytes(Size) : nullptr;
+                if (bHasData && !BufferData)
+                {
+                    return false;
+                }
+                if (Pass == 0)
+                {
+                    Buffers.emplace_back(Target.RHICreateVertexBuffer(BufferData, Size, Usage));
+                }
+                break;
+            }
+            case ERHICaptureCommand::SetShaderConstants:
+            {
+                uint32 BufferIndex = 0;
+                uint32 NumBytes = 0;
+                const uint8* Constants = nullptr;
+                if (!Reader.ReadUInt32(BufferIndex) || !Reader.ReadUInt32(NumBytes) || !(Constants = Reader.ReadBytes(NumBytes)))
+                {
+                    return false;
+                }
+                Target.RHISetShaderConstants(BufferIndex, Constants, NumBytes);
+                break;
+            }
+            case ERHICaptureCommand::SetStreamSource:
+            {
+                uint32 StreamIndex = 0;
+                uint32 BufferId = 0;
+                uint32 Stride = 0;
+                uint32 Offset = 0;
+                if (!Reader.ReadUInt32(StreamIndex) || !Reader.ReadUInt32(BufferId) || !Reader.ReadUInt32(Stride) || !Reader.ReadUInt32(Offset))
+                {
+                    return false;
+                }
+                FRHIVertexBuffer* VertexBuffer = BufferId < Buffers.size() ? Buffers[BufferId].GetReference() : nullptr;
+                Target.RHISetStreamSource(StreamIndex, VertexBuffer, Stride, Offset);
+                break;
+            }
+            case ERHICaptureCommand::DrawPrimitive:
+            {
+                uint32 PrimitiveType = 0;
+                uint32 BaseVertexIndex = 0;
+                uint32 NumPrimitives = 0;
+                uint32 NumInstances = 0;
+                if (!Reader.ReadUInt32(PrimitiveType) || !Reader.ReadUInt32(BaseVertexIndex) || !Reader.ReadUInt32(NumPrimitives) || !Reader.ReadUInt32(NumInstances))
+                {
+                    return false;
+                }
+                Target.RHIDrawPrimitive(static_cast<EPrimitiveType>(PrimitiveType), BaseVertexIndex, NumPrimitives, NumInstances);
+                break;
+            }
+            case ERHICaptureCommand::DrawPrimitiveUP:
+            {
+                uint32 PrimitiveType = 0;
+                uint32 NumPrimitives = 0;
+                uint32 Stride = 0;
+                if (!Reader.ReadUInt32(PrimitiveType) || !Reader.ReadUInt32(NumPrimitives) || !Reader.ReadUInt32(Stride))
+                {
+                    return false;
+                }
+                const size_t NumBytes = static_cast<size_t>(GetVertexCountForPrimitiveCount(NumPrimitives, static_cast<EPrimitiveType>(PrimitiveType))) * Stride;
+                const uint8* Vertices = Reader.ReadBytes(NumBytes);
+                if (!Vertices)
+                {
+                    return false;
+                }
+                Target.RHIDrawPrimitiveUP(static_cast<EPrimitiveType>(PrimitiveType), NumPrimitives, Vertices, Stride);
+                break;
+            }
+            case ERHICaptureCommand::UpdateVertexBuffer:
+            {
+                uint32 BufferId = 0;
+                uint32 Offset = 0;
+                uint32 Size = 0;
+                const uint8* BufferData = nullptr;
+                if (!Reader.ReadUInt32(BufferId) || !Reader.ReadUInt32(Offset) || !Reader.ReadUInt32(Size) || !(BufferData = Reader.ReadBytes(Size)))
+                {
+                    return false;
+                }
+                if (BufferId < Buffers.size() && Buffers[BufferId])
+                {
+                    Target.RHIUpdateVertexBuffer(Buffers[BufferId], Offset, BufferData, Size);
+                }
+                break;
+            }
+            case ERHICaptureCommand::SetDepthStencilState:
+            {
+                uint32 Fields[RHICaptureDepthStencilStateFields];
+                if (!ReadDepthStencilState(Reader, Fields))
+                {
+                    return false;
+                }
+                Target.RHISetDepthStencilState(UnpackDepthStencilState(Fields));
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
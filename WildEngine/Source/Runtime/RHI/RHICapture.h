@@ -0,0 +1,150 @@
+﻿#pragma once
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#include "DynamicRHI.h"
+#include "Templates/UnrealTypes.h"
+
+/**
+ * RHI capture files: a header followed by a flat stream of commands, each an
+ * ERHICaptureCommand byte and its arguments in native byte order. Buffers are
+ * referred to by the index of the CreateVertexBuffer command that made them;
+ * a buffer from RHIAllocVertexBuffer is recorded when RHIInitVertexBuffer runs.
+ */
+enum class ERHICaptureCommand : uint8
+{
+    BeginFrame,
+    EndFrame,
+    CreateVertexBuffer,     // uint32 Size, uint32 Usage, uint8 bHasData, [Size bytes]
+    SetShaderConstants,     // uint32 BufferIndex, uint32 NumBytes, [NumBytes bytes]
+    SetStreamSource,        // uint32 StreamIndex, uint32 BufferId, uint32 Stride, uint32 Offset
+    DrawPrimitive,          // uint32 PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances
+    DrawPrimitiveUP,        // uint32 PrimitiveType, uint32 NumPrimitives, uint32 Stride, [vertex bytes]
+    UpdateVertexBuffer,     // uint32 BufferId, uint32 Offset, uint32 Size, [Size bytes]
+    SetDepthStencilState,   // RHICaptureDepthStencilStateFields uint32s, in FDepthStencilStateInitializerRHI member order
+
+    Num,
+};
+
+struct FRHICaptureHeader
+{
+    /** "WRHC" */
+    static constexpr uint32 ExpectedMagic = 0x43485257;
+    static constexpr uint32 CurrentVersion = 3;
+
+    uint32 Magic = ExpectedMagic;
+    uint32 Version = CurrentVersion;
+};
+
+/** Buffer id of a null stream source. */
+constexpr uint32 RHICaptureNullBufferId = UINT32_MAX;
+
+/** Members of FDepthStencilStateInitializerRHI, each written as a uint32. */
+constexpr uint32 RHICaptureDepthStencilStateFields = 14;
+
+/**
+ * An RHI that forwards every call to another RHI and writes it to a capture file.
+ *
+ * Buffer creations and updates are always recorded, since any later frame
+ * may draw with them; everything else only for the captured frames. The file
+ * is appended at the end of each captured frame. Calls may come from the game
+ * thread (creation) and the rendering thread (everything else) at the same time.
+ *
+ * Only what goes through FDynamicRHI is recorded, so the engine loop wraps
+ * the headless RHIs only: the D3D11 renderer binds shaders and input layouts
+ * itself and submits most draws straight to the device context.
+ */
+class FRecordingDynamicRHI : public FDynamicRHI
+{
+public:
+    /** CaptureFrame is the 1-based RHIBeginFrame count to record; 0 records every frame. */
+    FRecordingDynamicRHI(std::unique_ptr<FDynamicRHI> InInnerRHI, const FString& InFilename, uint64 InCaptureFrame = 0);
+
+    /** Opens the file; when that fails it reports it, and IsCapturing stays false. */
+    void Init() override;
+    void Shutdown() override;
+    const char* GetName() const override { return InnerRHI->GetName(); }
+
+    FRHIVertexBuffer* RHICreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage) override;
+    FRHIVertexBuffer* RHIAllocVertexBuffer(uint32 Size, uint32 InUsage) override;
+    void RHIInitVertexBuffer(FRHIVertexBuffer* VertexBuffer, const void* Data) override;
+    void RHIUpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size) override;
+    FRHITexture2D* RHICreateTexture2D(uint32 SizeX, uint32 SizeY, EPixelFormat Format, uint32 Flags) override;
+    void RHISetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes) override;
+    void RHISetStreamSource(uint32 StreamIndex, FRHIVertexBuffer* VertexBuffer, uint32 Stride, uint32 Offset) override;
+    void RHISetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer) override;
+    void RHIDrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances) override;
+    void RHIDrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride) override;
+    void RHIBeginFrame() override;
+    void RHIEndFrame() override;
+    void RHISignalFrameFence(uint64 FrameNumber) override { InnerRHI->RHISignalFrameFence(FrameNumber); }
+    uint64 RHIGetRetiredFrameNumber() override { return InnerRHI->RHIGetRetiredFrameNumber(); }
+
+    const FRHIStats& GetStats() const override { return InnerRHI->GetStats(); }
+    void ResetStats() override { InnerRHI->ResetStats(); }
+
+    FDynamicRHI* GetInnerRHI() const { return InnerRHI.get(); }
+
+    /** @return Whether the capture file is open and nothing failed to be written to it. */
+    bool IsCapturing() const { return File.is_open() && File.good(); }
+
+    /** @return The number of frames written so far. */
+    uint64 GetNumCapturedFrames() const { return NumCapturedFrames; }
+
+private:
+    /** Writes the CreateVertexBuffer command and gives VertexBuffer the next id. Expects Mutex held. */
+    void RecordCreateVertexBuffer(const FRHIVertexBuffer* VertexBuffer, const void* Data, uint32 Size, uint32 InUsage);
+
+    void WriteCommand(ERHICaptureCommand Command);
+    void WriteUInt32(uint32 Value);
+    void WriteBytes(const void* Data, uint32 NumBytes);
+
+    /** Appends what was recorded so far to the file. */
+    void FlushToFile();
+
+private:
+    std::unique_ptr<FDynamicRHI> InnerRHI;
+    FString Filename;
+    uint64 CaptureFrame = 0;
+
+    std::ofstream File;
+
+    /** Guards everything below. */
+    std::mutex Mutex;
+    TArray<uint8> Pending;
+    TMap<const FRHIVertexBuffer*, uint32> BufferIds;
+    uint32 NumBuffers = 0;
+    uint64 NumFrames = 0;
+    uint64 NumCapturedFrames = 0;
+    bool bRecordingFrame = false;
+};
+
+/**
+ * Plays an RHI capture back into a headless RHI: the Null RHI to measure
+ * submission cost, or the software RHI to compare images. Replaying into
+ * D3D11 would draw without shaders, which the capture does not carry.
+ */
+class FRHICaptureReplayer
+{
+public:
+    /** @return false when the file is missing or not a capture of this version. */
+    bool Load(const FString& Filename);
+
+    /**
+     * Issues every captured command on Target. Buffers are created on the
+     * first pass only; the frames are then played NumPasses times in total,
+     * buffer updates included so every frame draws what it drew when captured.
+     * @return false when the capture ends in the middle of a command.
+     */
+    bool Replay(FDynamicRHI& Target, uint32 NumPasses = 1);
+
+    uint32 GetNumFrames() const { return NumFrames; }
+    uint32 GetNumBuffers() const { return NumBuffers; }
+
+private:
+    TArray<uint8> Data;
+    uint32 NumFrames = 0;
+    uint32 NumBuffers = 0;
+};
@@ -0,0 +1,82 @@
+﻿#include "RHICommandList.h"
+
+#include <cstring>
+
+void FRHICommandList::SetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes)
+{
+    const uint32 PayloadOffset = AddPayload(Data, NumBytes);
+    Commands.push_back({ ECommandType::SetShaderConstants, { BufferIndex, 0, 0, 0 }, nullptr, PayloadOffset, NumBytes });
+}
+
+void FRHICommandList::SetStreamSource(uint32 StreamIndex, FRHIVertexBuffer* VertexBuffer, uint32 Stride, uint32 Offset)
+{
+    Commands.push_back({ ECommandType::SetStreamSource, { StreamIndex, Stride, Offset, 0 }, VertexBuffer, 0, 0 });
+}
+
+void FRHICommandList::SetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer)
+{
+    const uint32 PayloadOffset = AddPayload(&Initializer, sizeof(Initializer));
+    Commands.push_back({ ECommandType::SetDepthStencilState, { 0, 0, 0, 0 }, nullptr, PayloadOffset, sizeof(Initializer) });
+}
+
+void FRHICommandList::DrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances)
+{
+    Commands.push_back({ ECommandType::DrawPrimitive, { static_cast<uint32>(PrimitiveType), BaseVertexIndex, NumPrimitives, NumInstances }, nullptr, 0, 0 });
+}
+
+void FRHICommandList::DrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride)
+{
+    const uint32 NumBytes = GetVertexCountForPrimitiveCount(NumPrimitives, PrimitiveType) * VertexDataStride;
+    const uint32 PayloadOffset = AddPayload(VertexData, NumBytes);
+    Commands.push_back({ ECommandType::DrawPrimitiveUP, { static_cast<uint32>(PrimitiveType), NumPrimitives, VertexDataStride, 0 }, nullptr, PayloadOffset, NumBytes });
+}
+
+void FRHICommandList::Execute(FDynamicRHI& RHI) const
+{
+    for (const FCommand& Command : Commands)
+    {
+        // 빈 페이로드는 nullptr 로 넘긴다. 0바이트 상수는 슬롯을 비우라는 뜻이고, 빈 배열의 data()는 nullptr 이 아닐 수 있다
+        const uint8* CommandPayload = Command.PayloadSize > 0 ? Payload.data() + Command.PayloadOffset : nullptr;
+        switch (Command.Type)
+        {
+        case ECommandType::SetShaderConstants:
+            RHI.RHISetShaderConstants(Command.Args[0], CommandPayload, Command.PayloadSize);
+            break;
+        case ECommandType::SetStreamSource:
+            RHI.RHISetStreamSource(Command.Args[0], Command.VertexBuffer, Command.Args[1], Command.Args[2]);
+            break;
+        case ECommandType::SetDepthStencilState:
+        {
+            // 페이로드는 정렬되어 있지 않으므로 복사해서 넘긴다
+            FDepthStencilStateInitializerRHI Initializer;
+            std::memcpy(&Initializer, CommandPayload, sizeof(Initializer));
+            RHI.RHISetDepthStencilState(Initializer);
+            break;
+        }
+        case ECommandType::DrawPrimitive:
+            RHI.RHIDrawPrimitive(static_cast<EPrimitiveType>(Command.Args[0]), Command.Args[1], Command.Args[2], Command.Args[3]);
+            break;
+        case ECommandType::DrawPrimitiveUP:
+            RHI.RHIDrawPrimitiveUP(static_cast<EPrimitiveType>(Command.Args[0]), Command.Args[1], CommandPayload, Command.Args[2]);
+            break;
+        }
+    }
+}
+
+void FRHICommandList::Reset()
+{
+    Commands.clear();
+    Payload.clear();
+}
+
+uint32 FRHICommandList::AddPayload(const void* Data, uint32 NumBytes)
+{
+    // 페이로드 배열이 커지며 옮겨질 수 있으므로 포인터 대신 오프셋을 저장한다
+    const uint32 PayloadOffset = static_cast<uint32>(Payload.size());
+    Payload.resize(Payload.size() + NumBytes);
+    if (NumBytes > 0)
+    {
+        std::memcpy(Payload.data() + PayloadOffset, Data, NumBytes);
+    }
+    return PayloadOffset;
+}
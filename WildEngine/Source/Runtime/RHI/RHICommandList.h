@@ -0,0 +1,63 @@
+﻿#pragma once
+
+#include "DynamicRHI.h"
+#include "Templates/UnrealTypes.h"
+
+/**
+ * Commands recorded for later execution on an FDynamicRHI.
+ *
+ * Any thread may record into its own list; Execute then issues the commands
+ * in recording order on the thread that owns the RHI. Splitting a frame's
+ * draws into slices, recording each slice on a worker and executing the lists
+ * in slice order submits exactly what recording them one after another would.
+ *
+ * Payloads (constants, depth state, UP vertices) are copied into the list.
+ * Vertex buffers are not referenced; they must stay alive until the list has
+ * been executed, which deferred deletion guarantees for anything drawn by the
+ * current frame.
+ */
+class FRHICommandList
+{
+public:
+    void SetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes);
+    void SetStreamSource(uint32 StreamIndex, FRHIVertexBuffer* VertexBuffer, uint32 Stride, uint32 Offset);
+    void SetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer);
+    void DrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances);
+    void DrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride);
+
+    /** Issues every recorded command on RHI in order. The list keeps its commands until Reset. */
+    void Execute(FDynamicRHI& RHI) const;
+
+    /** Drops the commands but keeps the allocations for the next frame. */
+    void Reset();
+
+    uint32 GetNumCommands() const { return static_cast<uint32>(Commands.size()); }
+    bool IsEmpty() const { return Commands.empty(); }
+
+private:
+    enum class ECommandType : uint8
+    {
+        SetShaderConstants,
+        SetStreamSource,
+        SetDepthStencilState,
+        DrawPrimitive,
+        DrawPrimitiveUP,
+    };
+
+    struct FCommand
+    {
+        ECommandType Type;
+        uint32 Args[4];
+        FRHIVertexBuffer* VertexBuffer;
+
+        /** Range of Payload. */
+        uint32 PayloadOffset;
+        uint32 PayloadSize;
+    };
+
+    uint32 AddPayload(const void* Data, uint32 NumBytes);
+
+private:
+    TArray<FCommand> Commands;
+    TArray<uint8> Payload;
+};
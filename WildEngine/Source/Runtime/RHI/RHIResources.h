@@ -1,9 +1,50 @@
 ﻿#pragma once
-/** The base type of RHI resources. */
+
+#include <atomic>
+#include <cfloat>
+
+#include "Templates/RefCounting.h"
+#include "Templates/TypeHash.h"
+
+/**
+ * The base type of RHI resources. Intrusively refcounted; hold them with TRefCountPtr.
+ *
+ * The GPU may still be reading a resource for a few frames after the last
+ * reference went away on the CPU, so the final Release does not delete it.
+ * The resource is queued with the newest frame started at that point and is
+ * deleted by FlushPendingDeletes once that frame has retired on the GPU.
+ */
 class FRHIResource
 {
 public:
+    FRHIResource() = default;
+    FRHIResource(const FRHIResource&) = delete;
+    FRHIResource& operator=(const FRHIResource&) = delete;
     virtual ~FRHIResource() = default;
+
+    uint32 AddRef() const
+    {
+        return static_cast<uint32>(NumRefs.fetch_add(1, std::memory_order_relaxed) + 1);
+    }
+
+    /** Drops a reference; the last one queues the resource for deletion. Any thread. */
+    uint32 Release() const;
+
+    uint32 GetRefCount() const { return static_cast<uint32>(NumRefs.load(std::memory_order_relaxed)); }
+
+    /** Game thread: frame N is being built; resources released from now on may be used by it. */
+    static void BeginFrame(uint64 FrameNumber);
+
+    /** Deletes, in one batch, every queued resource whose last frame is RetiredFrameNumber or older. */
+    static void FlushPendingDeletes(uint64 RetiredFrameNumber);
+
+    /** Deletes every queued resource, e.g. at shutdown once nothing renders anymore. */
+    static void FlushAllPendingDeletes();
+
+    static uint32 GetNumPendingDeletes();
+
+private:
+    mutable std::atomic<int32> NumRefs{ 0 };
 };
 
 /**
@@ -14,6 +55,209 @@ class FRHIRasterizerState : public FRHIResource {};
 class FRHIDepthStencilState : public FRHIResource {};
 class FRHIBlendState : public FRHIResource {};
 
+/**
+ * State initializers: everything that defines a state object, in RHI terms.
+ * Equal initializers describe the same state, so RHIs hash them to share one object.
+ */
+struct FSamplerStateInitializerRHI
+{
+    FSamplerStateInitializerRHI() {}
+    FSamplerStateInitializerRHI(
+        ESamplerFilter InFilter,
+        ESamplerAddressMode InAddressU = AM_Wrap,
+        ESamplerAddressMode InAddressV = AM_Wrap,
+        ESamplerAddressMode InAddressW = AM_Wrap,
+        float InMipBias = 0.0f,
+        int32 InMaxAnisotropy = 0,
+        float InMinMipLevel = 0.0f,
+        float InMaxMipLevel = FLT_MAX,
+        uint32 InBorderColor = 0,
+        ESamplerCompareFunction InSamplerComparisonFunction = SCF_Never)
+    : Filter(InFilter)
+    , AddressU(InAddressU)
+    , AddressV(InAddressV)
+    , AddressW(InAddressW)
+    , MipBias(InMipBias)
+    , MinMipLevel(InMinMipLevel)
+    , MaxMipLevel(InMaxMipLevel)
+    , MaxAnisotropy(InMaxAnisotropy)
+    , BorderColor(InBorderColor)
+    , SamplerComparisonFunction(InSamplerComparisonFunction)
+    {}
+
+    ESamplerFilter Filter = SF_Point;
+    ESamplerAddressMode AddressU = AM_Wrap;
+    ESamplerAddressMode AddressV = AM_Wrap;
+    ESamplerAddressMode AddressW = AM_Wrap;
+    float MipBias = 0.0f;
+    float MinMipLevel = 0.0f;
+    float MaxMipLevel = FLT_MAX;
+    int32 MaxAnisotropy = 0;
+    /** 0xAARRGGBB */
+    uint32 BorderColor = 0;
+    ESamplerCompareFunction SamplerComparisonFunction = SCF_Never;
+
+    bool operator==(const FSamplerStateInitializerRHI& Other) const
+    {
+        return Filter == Other.Filter && AddressU == Other.AddressU && AddressV == Other.AddressV && AddressW == Other.AddressW
+            && MipBias == Other.MipBias && MinMipLevel == Other.MinMipLevel && MaxMipLevel == Other.MaxMipLevel
+            && MaxAnisotropy == Other.MaxAnisotropy && BorderColor == Other.BorderColor
+            && SamplerComparisonFunction == Other.SamplerComparisonFunction;
+    }
+};
+
+struct FRasterizerStateInitializerRHI
+{
+    ERasterizerFillMode FillMode = FM_Solid;
+    ERasterizerCullMode CullMode = CM_None;
+    float DepthBias = 0.0f;
+    float SlopeScaleDepthBias = 0.0f;
+    bool bAllowMSAA = false;
+    bool bEnableLineAA = false;
+
+    bool operator==(const FRasterizerStateInitializerRHI& Other) const
+    {
+        return FillMode == Other.FillMode && CullMode == Other.CullMode
+            && DepthBias == Other.DepthBias && SlopeScaleDepthBias == Other.SlopeScaleDepthBias
+            && bAllowMSAA == Other.bAllowMSAA && bEnableLineAA == Other.bEnableLineAA;
+    }
+};
+
+struct FDepthStencilStateInitializerRHI
+{
+    bool bEnableDepthWrite = true;
+    ECompareFunction DepthTest = CF_Less;
+
+    bool bEnableFrontFaceStencil = false;
+    ECompareFunction FrontFaceStencilTest = CF_Always;
+    EStencilOp FrontFaceStencilFailStencilOp = SO_Keep;
+    EStencilOp FrontFaceDepthFailStencilOp = SO_Keep;
+    EStencilOp FrontFacePassStencilOp = SO_Keep;
+
+    bool bEnableBackFaceStencil = false;
+    ECompareFunction BackFaceStencilTest = CF_Always;
+    EStencilOp BackFaceStencilFailStencilOp = SO_Keep;
+    EStencilOp BackFaceDepthFailStencilOp = SO_Keep;
+    EStencilOp BackFacePassStencilOp = SO_Keep;
+
+    uint8 StencilReadMask = 0xFF;
+    uint8 StencilWriteMask = 0xFF;
+
+    bool operator==(const FDepthStencilStateInitializerRHI& Other) const
+    {
+        return bEnableDepthWrite == Other.bEnableDepthWrite && DepthTest == Other.DepthTest
+            && bEnableFrontFaceStencil == Other.bEnableFrontFaceStencil && FrontFaceStencilTest == Other.FrontFaceStencilTest
+            && FrontFaceStencilFailStencilOp == Other.FrontFaceStencilFailStencilOp && FrontFaceDepthFailStencilOp == Other.FrontFaceDepthFailStencilOp
+            && FrontFacePassStencilOp == Other.FrontFacePassStencilOp
+            && bEnableBackFaceStencil == Other.bEnableBackFaceStencil && BackFaceStencilTest == Other.BackFaceStencilTest
+            && BackFaceStencilFailStencilOp == Other.BackFaceStencilFailStencilOp && BackFaceDepthFailStencilOp == Other.BackFaceDepthFailStencilOp
+            && BackFacePassStencilOp == Other.BackFacePassStencilOp
+            && StencilReadMask == Other.StencilReadMask && StencilWriteMask == Other.StencilWriteMask;
+    }
+};
+
+enum { MaxSimultaneousRenderTargets = 8 };
+
+struct FBlendStateInitializerRHI
+{
+    struct FRenderTarget
+    {
+        EBlendOperation ColorBlendOp = BO_Add;
+        EBlendFactor ColorSrcBlend = BF_One;
+        EBlendFactor ColorDestBlend = BF_Zero;
+        EBlendOperation AlphaBlendOp = BO_Add;
+        EBlendFactor AlphaSrcBlend = BF_One;
+        EBlendFactor AlphaDestBlend = BF_Zero;
+        EColorWriteMask ColorWriteMask = CW_RGBA;
+
+        bool operator==(const FRenderTarget& Other) const
+        {
+            return ColorBlendOp == Other.ColorBlendOp && ColorSrcBlend == Other.ColorSrcBlend && ColorDestBlend == Other.ColorDestBlend
+                && AlphaBlendOp == Other.AlphaBlendOp && AlphaSrcBlend == Other.AlphaSrcBlend && AlphaDestBlend == Other.AlphaDestBlend
+                && ColorWriteMask == Other.ColorWriteMask;
+        }
+    };
+
+    FRenderTarget RenderTargets[MaxSimultaneousRenderTargets];
+
+    /** When false only RenderTargets[0] is used, for every target. */
+    bool bUseIndependentRenderTargetBlendStates = false;
+
+    bool operator==(const FBlendStateInitializerRHI& Other) const
+    {
+        if (bUseIndependentRenderTargetBlendStates != Other.bUseIndependentRenderTargetBlendStates)
+        {
+            return false;
+        }
+        const uint32 NumTargets = bUseIndependentRenderTargetBlendStates ? MaxSimultaneousRenderTargets : 1;
+        for (uint32 Index = 0; Index < NumTargets; ++Index)
+        {
+            if (!(RenderTargets[Index] == Other.RenderTargets[Index]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+inline uint32 GetTypeHash(const FSamplerStateInitializerRHI& Initializer)
+{
+    uint32 Hash = GetTypeHash(static_cast<uint32>(Initializer.Filter));
+    Hash = HashCombine(Hash, GetTypeHash(static_cast<uint32>(Initializer.AddressU) | (static_cast<uint32>(Initializer.AddressV) << 8) | (static_cast<uint32>(Initializer.AddressW) << 16)));
+    Hash = HashCombine(Hash, GetTypeHash(Initializer.MipBias));
+    Hash = HashCombine(Hash, GetTypeHash(Initializer.MinMipLevel));
+    Hash = HashCombine(Hash, GetTypeHash(Initializer.MaxMipLevel));
+    Hash = HashCombine(Hash, GetTypeHash(Initializer.MaxAnisotropy));
+    Hash = HashCombine(Hash, GetTypeHash(Initializer.BorderColor));
+    return HashCombine(Hash, GetTypeHash(static_cast<uint32>(Initializer.SamplerComparisonFunction)));
+}
+
+inline uint32 GetTypeHash(const FRasterizerStateInitializerRHI& Initializer)
+{
+    uint32 Hash = GetTypeHash(static_cast<uint32>(Initializer.FillMode) | (static_cast<uint32>(Initializer.CullMode) << 8)
+        | (Initializer.bAllowMSAA ? 1u << 16 : 0u) | (Initializer.bEnableLineAA ? 1u << 17 : 0u));
+    Hash = HashCombine(Hash, GetTypeHash(Initializer.DepthBias));
+    return HashCombine(Hash, GetTypeHash(Initializer.SlopeScaleDepthBias));
+}
+
+inline uint32 GetTypeHash(const FDepthStencilStateInitializerRHI& Initializer)
+{
+    // 필드가 모두 작은 열거형이라 비트로 묶는다
+    const uint32 Depth = static_cast<uint32>(Initializer.DepthTest) | (Initializer.bEnableDepthWrite ? 1u << 4 : 0u)
+        | (static_cast<uint32>(Initializer.StencilReadMask) << 8) | (static_cast<uint32>(Initializer.StencilWriteMask) << 16);
+    const uint32 FrontFace = static_cast<uint32>(Initializer.FrontFaceStencilTest) | (static_cast<uint32>(Initializer.FrontFaceStencilFailStencilOp) << 4)
+        | (static_cast<uint32>(Initializer.FrontFaceDepthFailStencilOp) << 8) | (static_cast<uint32>(Initializer.FrontFacePassStencilOp) << 12)
+        | (Initializer.bEnableFrontFaceStencil ? 1u << 16 : 0u);
+    const uint32 BackFace = static_cast<uint32>(Initializer.BackFaceStencilTest) | (static_cast<uint32>(Initializer.BackFaceStencilFailStencilOp) << 4)
+        | (static_cast<uint32>(Initializer.BackFaceDepthFailStencilOp) << 8) | (static_cast<uint32>(Initializer.BackFacePassStencilOp) << 12)
+        | (Initializer.bEnableBackFaceStencil ? 1u << 16 : 0u);
+    return HashCombine(HashCombine(GetTypeHash(Depth), GetTypeHash(FrontFace)), GetTypeHash(BackFace));
+}
+
+inline uint32 GetTypeHash(const FBlendStateInitializerRHI& Initializer)
+{
+    uint32 Hash = GetTypeHash(Initializer.bUseIndependentRenderTargetBlendStates);
+    const uint32 NumTargets = Initializer.bUseIndependentRenderTargetBlendStates ? MaxSimultaneousRenderTargets : 1;
+    for (uint32 Index = 0; Index < NumTargets; ++Index)
+    {
+        const FBlendStateInitializerRHI::FRenderTarget& Target = Initializer.RenderTargets[Index];
+        const uint32 Color = static_cast<uint32>(Target.ColorBlendOp) | (static_cast<uint32>(Target.ColorSrcBlend) << 4) | (static_cast<uint32>(Target.ColorDestBlend) << 8);
+        const uint32 Alpha = static_cast<uint32>(Target.AlphaBlendOp) | (static_cast<uint32>(Target.AlphaSrcBlend) << 4) | (static_cast<uint32>(Target.AlphaDestBlend) << 8);
+        Hash = HashCombine(Hash, GetTypeHash(Color | (Alpha << 12) | (static_cast<uint32>(Target.ColorWriteMask) << 24)));
+    }
+    return Hash;
+}
+
+/** Lets the initializers key TMap directly. */
+namespace std
+{
+    template<> struct hash<FSamplerStateInitializerRHI>      { size_t operator()(const FSamplerStateInitializerRHI& Initializer) const { return GetTypeHash(Initializer); } };
+    template<> struct hash<FRasterizerStateInitializerRHI>   { size_t operator()(const FRasterizerStateInitializerRHI& Initializer) const { return GetTypeHash(Initializer); } };
+    template<> struct hash<FDepthStencilStateInitializerRHI> { size_t operator()(const FDepthStencilStateInitializerRHI& Initializer) const { return GetTypeHash(Initializer); } };
+    template<> struct hash<FBlendStateInitializerRHI>        { size_t operator()(const FBlendStateInitializerRHI& Initializer) const { return GetTypeHash(Initializer); } };
+}
+
 /**
  * Shaders
  */
@@ -0,0 +1,234 @@
+﻿#include "SoftwareRHI.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    /** Vertex layout read from stream 0; matches FVertexType. */
+    struct FSoftwareVertexInput
+    {
+        float Position[3];
+        float Color[4];
+    };
+
+    const float IdentityColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+}
+
+FSoftwareVertexBuffer::FSoftwareVertexBuffer(const void* InData, uint32 InSize, uint32 InUsage)
+    : FRHIVertexBuffer(InSize, InUsage)
+    , Data(InSize, 0)
+{
+    if (InData)
+    {
+        std::memcpy(Data.data(), InData, InSize);
+    }
+}
+
+FSoftwareDynamicRHI::FSoftwareDynamicRHI(uint32 InWidth, uint32 InHeight)
+    : Width(InWidth)
+    , Height(InHeight)
+{
+}
+
+void FSoftwareDynamicRHI::Init()
+{
+    Rasterizer.Resize(Width, Height);
+    Rasterizer.Clear(ClearColor);
+}
+
+FRHIVertexBuffer* FSoftwareDynamicRHI::RHICreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage)
+{
+    ++Stats.NumVertexBuffersCreated;
+    Stats.NumVertexBufferBytes += Size;
+    return new FSoftwareVertexBuffer(Data, Size, InUsage);
+}
+
+FRHIVertexBuffer* FSoftwareDynamicRHI::RHIAllocVertexBuffer(uint32 Size, uint32 InUsage)
+{
+    return new FSoftwareVertexBuffer(nullptr, Size, InUsage);
+}
+
+void FSoftwareDynamicRHI::RHIInitVertexBuffer(FRHIVertexBuffer* VertexBuffer, const void* Data)
+{
+    FSoftwareVertexBuffer* Buffer = static_cast<FSoftwareVertexBuffer*>(VertexBuffer);
+    if (Data)
+    {
+        std::memcpy(Buffer->Data.data(), Data, Buffer->Data.size());
+    }
+
+    ++Stats.NumVertexBuffersCreated;
+    Stats.NumVertexBufferBytes += Buffer->GetSize();
+}
+
+void FSoftwareDynamicRHI::RHIUpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size)
+{
+    FSoftwareVertexBuffer* Buffer = static_cast<FSoftwareVertexBuffer*>(VertexBuffer);
+    // 캡처 리플레이로 임의의 값이 올 수 있으므로 더해서 넘치지 않게 비교한다
+    if (!Buffer || Size > Buffer->Data.size() || Offset > Buffer->Data.size() - Size)
+    {
+        return;
+    }
+    std::memcpy(Buffer->Data.data() + Offset, Data, Size);
+
+    ++Stats.NumVertexBufferUpdates;
+    Stats.NumVertexBufferUpdateBytes += Size;
+}
+
+FRHITexture2D* FSoftwareDynamicRHI::RHICreateTexture2D(uint32 SizeX, uint32 SizeY, EPixelFormat Format, uint32 Flags)
+{
+    ++Stats.NumTexturesCreated;
+    return new FSoftwareTexture2D(SizeX, SizeY, Format, Flags);
+}
+
+void FSoftwareDynamicRHI::RHISetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes)
+{
+    ++Stats.NumConstantUpdates;
+    Stats.NumConstantBytes += NumBytes;
+
+    if (BufferIndex == SCS_Transform && NumBytes >= sizeof(Transform))
+    {
+        std::memcpy(Transform, Data, sizeof(Transform));
+    }
+    else if (BufferIndex == SCS_Instances)
+    {
+        Instances.resize(NumBytes / sizeof(FRHIInstanceData));
+        if (!Instances.empty())
+        {
+            std::memcpy(Instances.data(), Data, Instances.size() * sizeof(FRHIInstanceData));
+        }
+    }
+}
+
+void FSoftwareDynamicRHI::RHISetStreamSource(uint32 StreamIndex, FRHIVertexBuffer* VertexBuffer, uint32 Stride, uint32 Offset)
+{
+    if (StreamIndex == 0)
+    {
+        StreamBuffer = static_cast<FSoftwareVertexBuffer*>(VertexBuffer);
+        StreamStride = Stride;
+        StreamOffset = Offset;
+    }
+}
+
+void FSoftwareDynamicRHI::RHISetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer)
+{
+    Rasterizer.SetDepthState(Initializer.DepthTest, Initializer.bEnableDepthWrite);
+}
+
+void FSoftwareDynamicRHI::RHIDrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances)
+{
+    ++Stats.NumDrawCalls;
+    Stats.NumPrimitives += static_cast<uint64>(NumPrimitives) * NumInstances;
+    Stats.NumInstances += NumInstances;
+
+    const uint32 NumVertices = GetVertexCountForPrimitiveCount(NumPrimitives, PrimitiveType);
+    const uint64 FirstByte = StreamOffset + static_cast<uint64>(BaseVertexIndex) * StreamStride;
+    const uint64 LastByte = FirstByte + static_cast<uint64>(NumVertices) * StreamStride;
+    if (!StreamBuffer || StreamStride < sizeof(FSoftwareVertexInput) || NumVertices == 0 || LastByte > StreamBuffer->Data.size())
+    {
+        return;
+    }
+
+    DrawVertices(PrimitiveType, StreamBuffer->Data.data() + FirstByte, StreamStride, NumVertices, NumInstances);
+}
+
+void FSoftwareDynamicRHI::RHIDrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride)
+{
+    ++Stats.NumDrawCalls;
+    Stats.NumPrimitives += NumPrimitives;
+    Stats.NumInstances += 1;
+
+    if (VertexDataStride < sizeof(FSoftwareVertexInput))
+    {
+        return;
+    }
+    DrawVertices(PrimitiveType, static_cast<const uint8*>(VertexData), VertexDataStride, GetVertexCountForPrimitiveCount(NumPrimitives, PrimitiveType), 1);
+}
+
+void FSoftwareDynamicRHI::RHIBeginFrame()
+{
+    Rasterizer.Clear(ClearColor);
+}
+
+void FSoftwareDynamicRHI::RHIEndFrame()
+{
+    Rasterizer.Flush();
+    ++Stats.NumFrames;
+}
+
+void FSoftwareDynamicRHI::DrawVertices(EPrimitiveType PrimitiveType, const uint8* VertexData, uint32 Stride, uint32 NumVertices, uint32 NumInstances)
+{
+    if (PrimitiveType != PT_TriangleList && PrimitiveType != PT_TriangleStrip && PrimitiveType != PT_LineList)
+    {
+        return;
+    }
+
+    // 슬롯 1이 비어 있으면 ShaderW0, 아니면 인스턴스마다 World * ViewProjection 인 ShaderW0Instanced
+    const bool bInstanced = !Instances.empty();
+    const uint32 NumDrawnInstances = bInstanced ? std::min(NumInstances, static_cast<uint32>(Instances.size())) : 1;
+
+    TransformedVertices.resize(NumVertices);
+    for (uint32 Instance = 0; Instance < NumDrawnInstances; ++Instance)
+    {
+        float Matrix[4][4];
+        const float* Tint = IdentityColor;
+        if (bInstanced)
+        {
+            const FRHIInstanceData& InstanceData = Instances[Instance];
+            for (uint32 Row = 0; Row < 4; ++Row)
+            {
+                for (uint32 Column = 0; Column < 4; ++Column)
+                {
+                    Matrix[Row][Column] =
+                        InstanceData.WorldMatrix[Row][0] * Transform[0][Column] + InstanceData.WorldMatrix[Row][1] * Transform[1][Column] +
+                        InstanceData.WorldMatrix[Row][2] * Transform[2][Column] + InstanceData.WorldMatrix[Row][3] * Transform[3][Column];
+                }
+            }
+            Tint = InstanceData.Color;
+        }
+        else
+        {
+            std::memcpy(Matrix, Transform, sizeof(Matrix));
+        }
+
+        // mul(float4(position, 1), MVP)
+        ParallelFor(NumVertices, [&](uint32 Index)
+        {
+            FSoftwareVertexInput Input;
+            std::memcpy(&Input, VertexData + static_cast<size_t>(Index) * Stride, sizeof(Input));
+
+            FSoftwareRasterVertex& Output = TransformedVertices[Index];
+            for (uint32 Column = 0; Column < 4; ++Column)
+            {
+                Output.Position[Column] =
+                    Input.Position[0] * Matrix[0][Column] + Input.Position[1] * Matrix[1][Column] +
+                    Input.Position[2] * Matrix[2][Column] + Matrix[3][Column];
+                Output.Color[Column] = Input.Color[Column] * Tint[Column];
+            }
+        }, 1024);
+
+        if (PrimitiveType == PT_LineList)
+        {
+            Rasterizer.AddLines(TransformedVertices.data(), NumVertices / 2);
+        }
+        else if (PrimitiveType == PT_TriangleList)
+        {
+            Rasterizer.AddTriangles(TransformedVertices.data(), NumVertices / 3);
+        }
+        else if (NumVertices >= 3)
+        {
+            // 스트립은 홀수 번째 삼각형의 감김을 뒤집어 리스트로 편다
+            ListVertices.clear();
+            for (uint32 Index = 2; Index < NumVertices; ++Index)
+            {
+                const bool bOdd = (Index & 1) != 0;
+                ListVertices.push_back(TransformedVertices[Index - 2]);
+                ListVertices.push_back(TransformedVertices[bOdd ? Index : Index - 1]);
+                ListVertices.push_back(TransformedVertices[bOdd ? Index - 1 : Index]);
+            }
+            Rasterizer.AddTriangles(ListVertices.data(), NumVertices - 2);
+        }
+    }
+}
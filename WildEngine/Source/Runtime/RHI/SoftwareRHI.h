@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include "DynamicRHI.h"
+#include "SoftwareRasterizer.h"
+
+/** A vertex buffer in system memory. */
+class FSoftwareVertexBuffer : public FRHIVertexBuffer
+{
+public:
+    FSoftwareVertexBuffer(const void* InData, uint32 InSize, uint32 InUsage);
+
+    TArray<uint8> Data;
+};
+
+/**
+ * A texture description without pixels. The rasterizer has a single target,
+ * so passes drawing into other render targets still draw into that one.
+ */
+class FSoftwareTexture2D : public FRHITexture2D
+{
+public:
+    FSoftwareTexture2D(uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, uint32 InFlags)
+    : FRHITexture2D(InSizeX, InSizeY, 1, 1, InFormat, InFlags)
+    {}
+};
+
+/**
+ * A dynamic RHI that draws on the CPU with FSoftwareRasterizer.
+ *
+ * Runs ShaderW0 (and its instanced variant, see ERHIShaderConstantSlot) on
+ * FVertexType streams: position and color, transformed by the row-major MVP.
+ * Depth state is honored, stencil is not (there is no stencil target).
+ * Gives an image without a GPU or a window (-softwarerhi), e.g. for golden
+ * image comparisons and thumbnails. The frame is complete after RHIEndFrame.
+ */
+class FSoftwareDynamicRHI : public FDynamicRHI
+{
+public:
+    FSoftwareDynamicRHI(uint32 InWidth, uint32 InHeight);
+
+    void Init() override;
+    void Shutdown() override {}
+    const char* GetName() const override { return "Software"; }
+
+    FRHIVertexBuffer* RHICreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage) override;
+    FRHIVertexBuffer* RHIAllocVertexBuffer(uint32 Size, uint32 InUsage) override;
+    void RHIInitVertexBuffer(FRHIVertexBuffer* VertexBuffer, const void* Data) override;
+    void RHIUpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size) override;
+    FRHITexture2D* RHICreateTexture2D(uint32 SizeX, uint32 SizeY, EPixelFormat Format, uint32 Flags) override;
+    void RHISetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes) override;
+    void RHISetStreamSource(uint32 StreamIndex, FRHIVertexBuffer* VertexBuffer, uint32 Stride, uint32 Offset) override;
+    void RHISetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer) override;
+    void RHIDrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances) override;
+    void RHIDrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride) override;
+    void RHIBeginFrame() override;
+    void RHIEndFrame() override;
+
+    const FSoftwareRasterizer& GetRasterizer() const { return Rasterizer; }
+
+private:
+    /** Transforms NumVertices vertices of VertexData once per instance and queues their primitives. */
+    void DrawVertices(EPrimitiveType PrimitiveType, const uint8* VertexData, uint32 Stride, uint32 NumVertices, uint32 NumInstances);
+
+private:
+    uint32 Width;
+    uint32 Height;
+    FSoftwareRasterizer Rasterizer;
+
+    /** Same as URenderer::ClearColor. */
+    float ClearColor[4] = { 0.025f, 0.025f, 0.025f, 1.0f };
+
+    float Transform[4][4] = {};
+    TArray<FRHIInstanceData> Instances;
+
+    /** Stream 0; only position and color are read. */
+    FSoftwareVertexBuffer* StreamBuffer = nullptr;
+    uint32 StreamStride = 0;
+    uint32 StreamOffset = 0;
+
+    /** Reused every draw to avoid reallocating. */
+    TArray<FSoftwareRasterVertex> TransformedVertices;
+    TArray<FSoftwareRasterVertex> ListVertices;
+};
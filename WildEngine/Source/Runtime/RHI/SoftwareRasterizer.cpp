@@ -0,0 +1,735 @@
+﻿#include "SoftwareRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "Async/ParallelFor.h"
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define SOFTWARE_RASTERIZER_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SOFTWARE_RASTERIZER_SSE 1
+#endif
+
+namespace
+{
+    /** Flush before the queue holds more than this, to bound setup memory. */
+    constexpr uint32 MaxQueuedPrimitives = 64 * 1024;
+
+    /** Vertices are snapped to 1/256 pixel like D3D11 rasterizers. */
+    constexpr float SubpixelScale = 256.0f;
+
+    /**
+     * Eight float lanes, one per pixel of a span: one AVX register, two SSE
+     * registers or plain floats. FMask8 holds a per-lane condition.
+     */
+#if SOFTWARE_RASTERIZER_AVX
+    struct FFloat8 { __m256 V; };
+    struct FMask8 { __m256 V; };
+
+    inline FFloat8 Splat(float Value) { return { _mm256_set1_ps(Value) }; }
+    inline FFloat8 LoadFloat8(const float* Src) { return { _mm256_loadu_ps(Src) }; }
+    inline void StoreFloat8(float* Dst, FFloat8 A) { _mm256_storeu_ps(Dst, A.V); }
+    inline FFloat8 operator+(FFloat8 A, FFloat8 B) { return { _mm256_add_ps(A.V, B.V) }; }
+    inline FFloat8 operator*(FFloat8 A, FFloat8 B) { return { _mm256_mul_ps(A.V, B.V) }; }
+    inline FFloat8 operator/(FFloat8 A, FFloat8 B) { return { _mm256_div_ps(A.V, B.V) }; }
+    inline FMask8 operator>(FFloat8 A, FFloat8 B) { return { _mm256_cmp_ps(A.V, B.V, _CMP_GT_OQ) }; }
+    inline FMask8 operator<(FFloat8 A, FFloat8 B) { return { _mm256_cmp_ps(A.V, B.V, _CMP_LT_OQ) }; }
+    inline FMask8 operator==(FFloat8 A, FFloat8 B) { return { _mm256_cmp_ps(A.V, B.V, _CMP_EQ_OQ) }; }
+    inline FMask8 operator&(FMask8 A, FMask8 B) { return { _mm256_and_ps(A.V, B.V) }; }
+    inline FMask8 operator|(FMask8 A, FMask8 B) { return { _mm256_or_ps(A.V, B.V) }; }
+    inline FMask8 SplatMask(bool bValue) { return { _mm256_castsi256_ps(_mm256_set1_epi32(bValue ? -1 : 0)) }; }
+    inline uint32 MaskBits(FMask8 A) { return static_cast<uint32>(_mm256_movemask_ps(A.V)); }
+    inline FFloat8 Select(FMask8 Mask, FFloat8 A, FFloat8 B) { return { _mm256_blendv_ps(B.V, A.V, Mask.V) }; }
+#elif SOFTWARE_RASTERIZER_SSE
+    struct FFloat8 { __m128 Lo, Hi; };
+    struct FMask8 { __m128 Lo, Hi; };
+
+    inline FFloat8 Splat(float Value) { return { _mm_set1_ps(Value), _mm_set1_ps(Value) }; }
+    inline FFloat8 LoadFloat8(const float* Src) { return { _mm_loadu_ps(Src), _mm_loadu_ps(Src + 4) }; }
+    inline void StoreFloat8(float* Dst, FFloat8 A) { _mm_storeu_ps(Dst, A.Lo); _mm_storeu_ps(Dst + 4, A.Hi); }
+    inline FFloat8 operator+(FFloat8 A, FFloat8 B) { return { _mm_add_ps(A.Lo, B.Lo), _mm_add_ps(A.Hi, B.Hi) }; }
+    inline FFloat8 operator*(FFloat8 A, FFloat8 B) { return { _mm_mul_ps(A.Lo, B.Lo), _mm_mul_ps(A.Hi, B.Hi) }; }
+    inline FFloat8 operator/(FFloat8 A, FFloat8 B) { return { _mm_div_ps(A.Lo, B.Lo), _mm_div_ps(A.Hi, B.Hi) }; }
+    inline FMask8 operator>(FFloat8 A, FFloat8 B) { return { _mm_cmpgt_ps(A.Lo, B.Lo), _mm_cmpgt_ps(A.Hi, B.Hi) }; }
+    inline FMask8 operator<(FFloat8 A, FFloat8 B) { return { _mm_cmplt_ps(A.Lo, B.Lo), _mm_cmplt_ps(A.Hi, B.Hi) }; }
+    inline FMask8 operator==(FFloat8 A, FFloat8 B) { return { _mm_cmpeq_ps(A.Lo, B.Lo), _mm_cmpeq_ps(A.Hi, B.Hi) }; }
+    inline FMask8 operator&(FMask8 A, FMask8 B) { return { _mm_and_ps(A.Lo, B.Lo), _mm_and_ps(A.Hi, B.Hi) }; }
+    inline FMask8 operator|(FMask8 A, FMask8 B) { return { _mm_or_ps(A.Lo, B.Lo), _mm_or_ps(A.Hi, B.Hi) }; }
+    inline FMask8 SplatMask(bool bValue)
+    {
+        const __m128 Value = _mm_castsi128_ps(_mm_set1_epi32(bValue ? -1 : 0));
+        return { Value, Value };
+    }
+    inline uint32 MaskBits(FMask8 A) { return static_cast<uint32>(_mm_movemask_ps(A.Lo) | (_mm_movemask_ps(A.Hi) << 4)); }
+    inline FFloat8 Select(FMask8 Mask, FFloat8 A, FFloat8 B)
+    {
+        return {
+            _mm_or_ps(_mm_and_ps(Mask.Lo, A.Lo), _mm_andnot_ps(Mask.Lo, B.Lo)),
+            _mm_or_ps(_mm_and_ps(Mask.Hi, A.Hi), _mm_andnot_ps(Mask.Hi, B.Hi)) };
+    }
+#else
+    struct FFloat8 { float V[8]; };
+    struct FMask8 { uint32 Bits; };
+
+    template <typename FunctionType>
+    inline FFloat8 MapFloat8(FunctionType Function)
+    {
+        FFloat8 Result;
+        for (uint32 Lane = 0; Lane < 8; ++Lane)
+        {
+            Result.V[Lane] = Function(Lane);
+        }
+        return Result;
+    }
+
+    template <typename FunctionType>
+    inline FMask8 MapMask8(FunctionType Function)
+    {
+        FMask8 Result = { 0 };
+        for (uint32 Lane = 0; Lane < 8; ++Lane)
+        {
+            Result.Bits |= Function(Lane) ? (1u << Lane) : 0u;
+        }
+        return Result;
+    }
+
+    inline FFloat8 Splat(float Value) { return MapFloat8([Value](uint32) { return Value; }); }
+    inline FFloat8 LoadFloat8(const float* Src) { return MapFloat8([Src](uint32 Lane) { return Src[Lane]; }); }
+    inline void StoreFloat8(float* Dst, FFloat8 A) { std::copy(A.V, A.V + 8, Dst); }
+    inline FFloat8 operator+(FFloat8 A, FFloat8 B) { return MapFloat8([&](uint32 Lane) { return A.V[Lane] + B.V[Lane]; }); }
+    inline FFloat8 operator*(FFloat8 A, FFloat8 B) { return MapFloat8([&](uint32 Lane) { return A.V[Lane] * B.V[Lane]; }); }
+    inline FFloat8 operator/(FFloat8 A, FFloat8 B) { return MapFloat8([&](uint32 Lane) { return A.V[Lane] / B.V[Lane]; }); }
+    inline FMask8 operator>(FFloat8 A, FFloat8 B) { return MapMask8([&](uint32 Lane) { return A.V[Lane] > B.V[Lane]; }); }
+    inline FMask8 operator<(FFloat8 A, FFloat8 B) { return MapMask8([&](uint32 Lane) { return A.V[Lane] < B.V[Lane]; }); }
+    inline FMask8 operator==(FFloat8 A, FFloat8 B) { return MapMask8([&](uint32 Lane) { return A.V[Lane] == B.V[Lane]; }); }
+    inline FMask8 operator&(FMask8 A, FMask8 B) { return { A.Bits & B.Bits }; }
+    inline FMask8 operator|(FMask8 A, FMask8 B) { return { A.Bits | B.Bits }; }
+    inline FMask8 SplatMask(bool bValue) { return { bValue ? 0xFFu : 0u }; }
+    inline uint32 MaskBits(FMask8 A) { return A.Bits; }
+    inline FFloat8 Select(FMask8 Mask, FFloat8 A, FFloat8 B) { return MapFloat8([&](uint32 Lane) { return (Mask.Bits >> Lane) & 1 ? A.V[Lane] : B.V[Lane]; }); }
+#endif
+
+    /** @return Lanes where Depth passes Test against the stored OldDepth. */
+    inline FMask8 TestDepth(ECompareFunction Test, FFloat8 Depth, FFloat8 OldDepth)
+    {
+        switch (Test)
+        {
+        case CF_Less:         return Depth < OldDepth;
+        case CF_LessEqual:    return (Depth < OldDepth) | (Depth == OldDepth);
+        case CF_Greater:      return Depth > OldDepth;
+        case CF_GreaterEqual: return (Depth > OldDepth) | (Depth == OldDepth);
+        case CF_Equal:        return Depth == OldDepth;
+        case CF_NotEqual:     return (Depth < OldDepth) | (Depth > OldDepth);
+        case CF_Never:        return SplatMask(false);
+        default:              return SplatMask(true);
+        }
+    }
+
+    inline bool TestDepth(ECompareFunction Test, float Depth, float OldDepth)
+    {
+        switch (Test)
+        {
+        case CF_Less:         return Depth < OldDepth;
+        case CF_LessEqual:    return Depth <= OldDepth;
+        case CF_Greater:      return Depth > OldDepth;
+        case CF_GreaterEqual: return Depth >= OldDepth;
+        case CF_Equal:        return Depth == OldDepth;
+        case CF_NotEqual:     return Depth != OldDepth;
+        case CF_Never:        return false;
+        default:              return true;
+        }
+    }
+
+    inline uint32 PackColor(float R, float G, float B, float A)
+    {
+        const auto ToByte = [](float Value)
+        {
+            return static_cast<uint32>(std::min(std::max(Value, 0.0f), 1.0f) * 255.0f + 0.5f);
+        };
+        return ToByte(R) | (ToByte(G) << 8) | (ToByte(B) << 16) | (ToByte(A) << 24);
+    }
+
+    FSoftwareRasterVertex LerpVertex(const FSoftwareRasterVertex& A, const FSoftwareRasterVertex& B, float T)
+    {
+        FSoftwareRasterVertex Result;
+        for (uint32 Index = 0; Index < 4; ++Index)
+        {
+            Result.Position[Index] = A.Position[Index] + (B.Position[Index] - A.Position[Index]) * T;
+            Result.Color[Index] = A.Color[Index] + (B.Color[Index] - A.Color[Index]) * T;
+        }
+        return Result;
+    }
+
+    constexpr uint32 MaxClippedVertices = 8;
+
+    inline float PlaneDistance(const float Plane[4], const FSoftwareRasterVertex& Vertex)
+    {
+        const float* P = Vertex.Position;
+        return Plane[0] * P[0] + Plane[1] * P[1] + Plane[2] * P[2] + Plane[3] * P[3];
+    }
+
+    /** Clips a convex polygon to the half space Plane . Position >= 0 (Sutherland-Hodgman). @return The vertices written to Out. */
+    uint32 ClipPolygon(const FSoftwareRasterVertex* In, uint32 NumIn, const float Plane[4], FSoftwareRasterVertex* Out)
+    {
+        uint32 NumOut = 0;
+        for (uint32 Index = 0; Index < NumIn; ++Index)
+        {
+            const FSoftwareRasterVertex& Current = In[Index];
+            const FSoftwareRasterVertex& Next = In[(Index + 1) % NumIn];
+            const float CurrentDistance = PlaneDistance(Plane, Current);
+            const float NextDistance = PlaneDistance(Plane, Next);
+
+            if (CurrentDistance >= 0.0f)
+            {
+                Out[NumOut++] = Current;
+            }
+            if ((CurrentDistance >= 0.0f) != (NextDistance >= 0.0f))
+            {
+                Out[NumOut++] = LerpVertex(Current, Next, CurrentDistance / (CurrentDistance - NextDistance));
+            }
+        }
+        return NumOut;
+    }
+
+    /** @return Whether every vertex lies outside the same clip plane (near, far, left, right, bottom, top). */
+    bool IsTriviallyOutside(const FSoftwareRasterVertex* Vertices, uint32 NumVertices)
+    {
+        uint32 OutsideAll = 0x3F;
+        for (uint32 Index = 0; Index < NumVertices; ++Index)
+        {
+            const float* P = Vertices[Index].Position;
+            const uint32 Outside =
+                (P[2] < 0.0f ? 1u : 0u) | (P[2] > P[3] ? 2u : 0u) |
+                (P[0] < -P[3] ? 4u : 0u) | (P[0] > P[3] ? 8u : 0u) |
+                (P[1] < -P[3] ? 16u : 0u) | (P[1] > P[3] ? 32u : 0u);
+            OutsideAll &= Outside;
+        }
+        return OutsideAll != 0;
+    }
+}
+
+void FSoftwareRasterizer::Resize(uint32 InWidth, uint32 InHeight)
+{
+    Width = InWidth;
+    Height = InHeight;
+    NumTilesX = (Width + TileSize - 1) / TileSize;
+    NumTilesY = (Height + TileSize - 1) / TileSize;
+    Pitch = NumTilesX * TileSize;
+
+    ColorTarget.assign(static_cast<size_t>(Pitch) * NumTilesY * TileSize, 0);
+    DepthTarget.assign(static_cast<size_t>(Pitch) * NumTilesY * TileSize, 1.0f);
+    TileBins.assign(static_cast<size_t>(NumTilesX) * NumTilesY, TArray<uint32>());
+    Primitives.clear();
+}
+
+void FSoftwareRasterizer::Clear(const float InColor[4], float InDepth)
+{
+    Flush();
+
+    std::fill(ColorTarget.begin(), ColorTarget.end(), PackColor(InColor[0], InColor[1], InColor[2], InColor[3]));
+    std::fill(DepthTarget.begin(), DepthTarget.end(), InDepth);
+}
+
+void FSoftwareRasterizer::AddTriangles(const FSoftwareRasterVertex* Vertices, uint32 NumTriangles)
+{
+    // 삼각형마다 클리핑 결과를 담을 두 칸을 두고 병렬로 셋업한 뒤 순서대로 모은다
+    SetupScratch.resize(static_cast<size_t>(NumTriangles) * 2);
+    SetupCounts.resize(NumTriangles);
+    ParallelFor(NumTriangles, [this, Vertices](uint32 Triangle)
+    {
+        SetupCounts[Triangle] = SetupTriangle(Vertices + Triangle * 3, &SetupScratch[Triangle * 2], 2);
+    }, 256);
+
+    for (uint32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+    {
+        // 가드 밴드에 잘려 두 칸을 넘는 드문 삼각형은 여기서 다시 셋업한다
+        if (SetupCounts[Triangle] == SetupNeedsMoreSlots)
+        {
+            FRasterPrimitive Clipped[MaxClippedTriangles];
+            const uint32 NumClipped = SetupTriangle(Vertices + Triangle * 3, Clipped, MaxClippedTriangles);
+            for (uint32 Index = 0; Index < NumClipped; ++Index)
+            {
+                QueuePrimitive(Clipped[Index]);
+            }
+            continue;
+        }
+
+        for (uint32 Index = 0; Index < SetupCounts[Triangle]; ++Index)
+        {
+            QueuePrimitive(SetupScratch[Triangle * 2 + Index]);
+        }
+    }
+}
+
+void FSoftwareRasterizer::AddLines(const FSoftwareRasterVertex* Vertices, uint32 NumLines)
+{
+    for (uint32 Line = 0; Line < NumLines; ++Line)
+    {
+        FRasterPrimitive Primitive;
+        if (SetupLine(Vertices[Line * 2], Vertices[Line * 2 + 1], Primitive))
+        {
+            QueuePrimitive(Primitive);
+        }
+    }
+}
+
+void FSoftwareRasterizer::Flush()
+{
+    if (Primitives.empty())
+    {
+        return;
+    }
+
+    for (TArray<uint32>& Bin : TileBins)
+    {
+        Bin.clear();
+    }
+
+    // 바운딩 박스가 걸치는 타일마다 제출 순서대로 넣는다
+    for (uint32 Index = 0; Index < Primitives.size(); ++Index)
+    {
+        const FRasterPrimitive& Primitive = Primitives[Index];
+        for (int32 TileY = Primitive.MinY / static_cast<int32>(TileSize); TileY <= Primitive.MaxY / static_cast<int32>(TileSize); ++TileY)
+        {
+            for (int32 TileX = Primitive.MinX / static_cast<int32>(TileSize); TileX <= Primitive.MaxX / static_cast<int32>(TileSize); ++TileX)
+            {
+                TileBins[TileY * NumTilesX + TileX].push_back(Index);
+            }
+        }
+    }
+
+    ParallelFor(NumTilesX * NumTilesY, [this](uint32 TileIndex)
+    {
+        RasterizeTile(TileIndex);
+    }, 1);
+
+    NumPrimitivesRasterized += Primitives.size();
+    Primitives.clear();
+}
+
+bool FSoftwareRasterizer::SaveTGA(const FString& Filename) const
+{
+    std::ofstream File(Filename, std::ios::binary);
+    if (!File)
+    {
+        return false;
+    }
+
+    // 무압축 트루컬러, 32비트, 좌상단 원점
+    const uint8 Header[18] =
+    {
+        0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        static_cast<uint8>(Width & 0xFF), static_cast<uint8>(Width >> 8),
+        static_cast<uint8>(Height & 0xFF), static_cast<uint8>(Height >> 8),
+        32, 0x28,
+    };
+    File.write(reinterpret_cast<const char*>(Header), sizeof(Header));
+
+    TArray<uint8> Row(Width * 4);
+    for (uint32 Y = 0; Y < Height; ++Y)
+    {
+        for (uint32 X = 0; X < Width; ++X)
+        {
+            const uint32 Color = GetPixel(X, Y);
+            Row[X * 4 + 0] = static_cast<uint8>(Color >> 16);
+            Row[X * 4 + 1] = static_cast<uint8>(Color >> 8);
+            Row[X * 4 + 2] = static_cast<uint8>(Color);
+            Row[X * 4 + 3] = static_cast<uint8>(Color >> 24);
+        }
+        File.write(reinterpret_cast<const char*>(Row.data()), static_cast<std::streamsize>(Row.size()));
+    }
+
+    return static_cast<bool>(File);
+}
+
+uint32 FSoftwareRasterizer::SetupTriangle(const FSoftwareRasterVertex* Vertices, FRasterPrimitive* OutPrimitives, uint32 MaxPrimitives) const
+{
+    if (IsTriviallyOutside(Vertices, 3))
+    {
+        return 0;
+    }
+
+    // 근평면(z >= 0)과 화면 둘레 가드 밴드(|x|, |y| <= G w)로 자른다. 가드 밴드 안에서는 스냅한 좌표가 int32와 float 정밀도 안에 든다
+    const float GuardBandX = 1.0f + 2.0f * GuardBandPixels / static_cast<float>(Width);
+    const float GuardBandY = 1.0f + 2.0f * GuardBandPixels / static_cast<float>(Height);
+    const float ClipPlanes[5][4] =
+    {
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { -1.0f, 0.0f, 0.0f, GuardBandX },
+        { 1.0f, 0.0f, 0.0f, GuardBandX },
+        { 0.0f, -1.0f, 0.0f, GuardBandY },
+        { 0.0f, 1.0f, 0.0f, GuardBandY },
+    };
+
+    FSoftwareRasterVertex Polygons[2][MaxClippedVertices];
+    std::copy(Vertices, Vertices + 3, Polygons[0]);
+    uint32 NumVertices = 3;
+    uint32 Current = 0;
+    for (const float* Plane : ClipPlanes)
+    {
+        // 평면 안쪽에 다 있으면 자르지 않는다. 보통 삼각형은 평면 검사만 하고 지나간다
+        bool bInside = true;
+        for (uint32 Index = 0; Index < NumVertices && bInside; ++Index)
+        {
+            bInside = PlaneDistance(Plane, Polygons[Current][Index]) >= 0.0f;
+        }
+        if (bInside)
+        {
+            continue;
+        }
+
+        NumVertices = ClipPolygon(Polygons[Current], NumVertices, Plane, Polygons[Current ^ 1]);
+        Current ^= 1;
+        if (NumVertices < 3)
+        {
+            return 0;
+        }
+    }
+
+    if (NumVertices - 2 > MaxPrimitives)
+    {
+        return SetupNeedsMoreSlots;
+    }
+
+    const FSoftwareRasterVertex* Clipped = Polygons[Current];
+    uint32 NumPrimitives = 0;
+    for (uint32 Index = 2; Index < NumVertices; ++Index)
+    {
+        if (SetupClippedTriangle(Clipped[0], Clipped[Index - 1], Clipped[Index], OutPrimitives[NumPrimitives]))
+        {
+            ++NumPrimitives;
+        }
+    }
+    return NumPrimitives;
+}
+
+bool FSoftwareRasterizer::SetupClippedTriangle(const FSoftwareRasterVertex& V0, const FSoftwareRasterVertex& V1, const FSoftwareRasterVertex& V2, FRasterPrimitive& OutPrimitive) const
+{
+    const FSoftwareRasterVertex* Vertices[3] = { &V0, &V1, &V2 };
+
+    float X[3], Y[3], Z[3], InvW[3];
+    for (uint32 Index = 0; Index < 3; ++Index)
+    {
+        const float* P = Vertices[Index]->Position;
+        InvW[Index] = 1.0f / P[3];
+        X[Index] = std::round((P[0] * InvW[Index] * 0.5f + 0.5f) * Width * SubpixelScale) / SubpixelScale;
+        Y[Index] = std::round((0.5f - P[1] * InvW[Index] * 0.5f) * Height * SubpixelScale) / SubpixelScale;
+        Z[Index] = P[2] * InvW[Index];
+    }
+
+    // 화면(y 아래 방향)에서 시계 방향이 앞면, 반시계와 퇴화 삼각형은 버린다 (D3D11 기본 CULL_BACK)
+    const float Area = (X[1] - X[0]) * (Y[2] - Y[0]) - (X[2] - X[0]) * (Y[1] - Y[0]);
+    if (!(Area > 0.0f))
+    {
+        return false;
+    }
+
+    OutPrimitive.bLine = false;
+    OutPrimitive.MinX = std::max(0, static_cast<int32>(std::floor(std::min({ X[0], X[1], X[2] }))));
+    OutPrimitive.MinY = std::max(0, static_cast<int32>(std::floor(std::min({ Y[0], Y[1], Y[2] }))));
+    OutPrimitive.MaxX = std::min(static_cast<int32>(Width) - 1, static_cast<int32>(std::ceil(std::max({ X[0], X[1], X[2] }))));
+    OutPrimitive.MaxY = std::min(static_cast<int32>(Height) - 1, static_cast<int32>(std::ceil(std::max({ Y[0], Y[1], Y[2] }))));
+    if (OutPrimitive.MinX > OutPrimitive.MaxX || OutPrimitive.MinY > OutPrimitive.MaxY)
+    {
+        return false;
+    }
+
+    for (uint32 Edge = 0; Edge < 3; ++Edge)
+    {
+        const uint32 A = Edge;
+        const uint32 B = (Edge + 1) % 3;
+        OutPrimitive.EdgeA[Edge] = Y[A] - Y[B];
+        OutPrimitive.EdgeB[Edge] = X[B] - X[A];
+        OutPrimitive.EdgeC[Edge] = -(OutPrimitive.EdgeA[Edge] * X[A] + OutPrimitive.EdgeB[Edge] * Y[A]);
+
+        // 경계에 걸친 픽셀은 왼쪽 변과 윗변만 가진다
+        OutPrimitive.bTopLeft[Edge] = OutPrimitive.EdgeA[Edge] > 0.0f || (OutPrimitive.EdgeA[Edge] == 0.0f && OutPrimitive.EdgeB[Edge] > 0.0f);
+    }
+
+    float Attributes[Plane_Num][3];
+    for (uint32 Index = 0; Index < 3; ++Index)
+    {
+        Attributes[Plane_Depth][Index] = Z[Index];
+        Attributes[Plane_InvW][Index] = InvW[Index];
+        for (uint32 Channel = 0; Channel < 4; ++Channel)
+        {
+            Attributes[Plane_ColorR + Channel][Index] = Vertices[Index]->Color[Channel] * InvW[Index];
+        }
+    }
+
+    const float InvArea = 1.0f / Area;
+    for (uint32 Plane = 0; Plane < Plane_Num; ++Plane)
+    {
+        const float* Value = Attributes[Plane];
+        const float DX = ((Value[1] - Value[0]) * (Y[2] - Y[0]) - (Value[2] - Value[0]) * (Y[1] - Y[0])) * InvArea;
+        const float DY = ((Value[2] - Value[0]) * (X[1] - X[0]) - (Value[1] - Value[0]) * (X[2] - X[0])) * InvArea;
+        OutPrimitive.Planes[Plane][0] = DX;
+        OutPrimitive.Planes[Plane][1] = DY;
+        OutPrimitive.Planes[Plane][2] = Value[0] - DX * X[0] - DY * Y[0];
+    }
+
+    return true;
+}
+
+bool FSoftwareRasterizer::SetupLine(const FSoftwareRasterVertex& V0, const FSoftwareRasterVertex& V1, FRasterPrimitive& OutPrimitive) const
+{
+    FSoftwareRasterVertex Vertices[2] = { V0, V1 };
+    if (IsTriviallyOutside(Vertices, 2))
+    {
+        return false;
+    }
+
+    // 근평면 뒤쪽 끝점을 평면 위로 당긴다
+    const float Z0 = Vertices[0].Position[2];
+    const float Z1 = Vertices[1].Position[2];
+    if (Z0 < 0.0f)
+    {
+        Vertices[0] = LerpVertex(Vertices[0], Vertices[1], Z0 / (Z0 - Z1));
+    }
+    else if (Z1 < 0.0f)
+    {
+        Vertices[1] = LerpVertex(Vertices[1], Vertices[0], Z1 / (Z1 - Z0));
+    }
+
+    float Screen[2][7];
+    for (uint32 Index = 0; Index < 2; ++Index)
+    {
+        const float* P = Vertices[Index].Position;
+        const float InvW = 1.0f / P[3];
+        Screen[Index][0] = (P[0] * InvW * 0.5f + 0.5f) * Width;
+        Screen[Index][1] = (0.5f - P[1] * InvW * 0.5f) * Height;
+        Screen[Index][2] = P[2] * InvW;
+        for (uint32 Channel = 0; Channel < 4; ++Channel)
+        {
+            Screen[Index][3 + Channel] = Vertices[Index].Color[Channel];
+        }
+    }
+
+    // 화면 사각형으로 잘라 화면 밖에서 걷는 일이 없게 한다 (Liang-Barsky)
+    float T0 = 0.0f;
+    float T1 = 1.0f;
+    const float Delta[2] = { Screen[1][0] - Screen[0][0], Screen[1][1] - Screen[0][1] };
+    const float Limit[2] = { static_cast<float>(Width), static_cast<float>(Height) };
+    for (uint32 Axis = 0; Axis < 2; ++Axis)
+    {
+        const float Start = Screen[0][Axis];
+        if (Delta[Axis] == 0.0f)
+        {
+            if (Start < 0.0f || Start >= Limit[Axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        float TEnter = (0.0f - Start) / Delta[Axis];
+        float TExit = (Limit[Axis] - Start) / Delta[Axis];
+        if (TEnter > TExit)
+        {
+            std::swap(TEnter, TExit);
+        }
+        T0 = std::max(T0, TEnter);
+        T1 = std::min(T1, TExit);
+    }
+    if (T0 > T1)
+    {
+        return false;
+    }
+
+    OutPrimitive.bLine = true;
+    for (uint32 Component = 0; Component < 7; ++Component)
+    {
+        const float Start = Screen[0][Component];
+        const float Span = Screen[1][Component] - Start;
+        OutPrimitive.LineVertices[0][Component] = Start + Span * T0;
+        OutPrimitive.LineVertices[1][Component] = Start + Span * T1;
+    }
+
+    const auto ClampPixel = [](float Value, uint32 Size)
+    {
+        return std::min(std::max(static_cast<int32>(std::floor(Value)), 0), static_cast<int32>(Size) - 1);
+    };
+    const int32 X0 = ClampPixel(OutPrimitive.LineVertices[0][0], Width);
+    const int32 X1 = ClampPixel(OutPrimitive.LineVertices[1][0], Width);
+    const int32 Y0 = ClampPixel(OutPrimitive.LineVertices[0][1], Height);
+    const int32 Y1 = ClampPixel(OutPrimitive.LineVertices[1][1], Height);
+    OutPrimitive.MinX = std::min(X0, X1);
+    OutPrimitive.MaxX = std::max(X0, X1);
+    OutPrimitive.MinY = std::min(Y0, Y1);
+    OutPrimitive.MaxY = std::max(Y0, Y1);
+    return true;
+}
+
+void FSoftwareRasterizer::QueuePrimitive(const FRasterPrimitive& Primitive)
+{
+    Primitives.push_back(Primitive);
+    Primitives.back().DepthTest = DepthTest;
+    Primitives.back().bDepthWrite = bDepthWrite;
+    if (Primitives.size() >= MaxQueuedPrimitives)
+    {
+        Flush();
+    }
+}
+
+void FSoftwareRasterizer::RasterizeTile(uint32 TileIndex)
+{
+    const int32 TileMinX = static_cast<int32>((TileIndex % NumTilesX) * TileSize);
+    const int32 TileMinY = static_cast<int32>((TileIndex / NumTilesX) * TileSize);
+    const int32 TileMaxX = TileMinX + static_cast<int32>(TileSize) - 1;
+    const int32 TileMaxY = TileMinY + static_cast<int32>(TileSize) - 1;
+
+    for (const uint32 PrimitiveIndex : TileBins[TileIndex])
+    {
+        const FRasterPrimitive& Primitive = Primitives[PrimitiveIndex];
+        if (Primitive.bLine)
+        {
+            RasterizeLine(Primitive, TileMinX, TileMinY, TileMaxX, TileMaxY);
+        }
+        else
+        {
+            RasterizeTriangle(Primitive, TileMinX, TileMinY, TileMaxX, TileMaxY);
+        }
+    }
+}
+
+void FSoftwareRasterizer::RasterizeTriangle(const FRasterPrimitive& Primitive, int32 TileMinX, int32 TileMinY, int32 TileMaxX, int32 TileMaxY)
+{
+    // 스팬은 8픽셀 경계에서 시작한다. 타일과 피치가 8의 배수라 행 밖으로 나가지 않는다
+    const int32 StartX = std::max(Primitive.MinX, TileMinX) & ~7;
+    const int32 EndX = std::min(Primitive.MaxX, TileMaxX);
+    const int32 StartY = std::max(Primitive.MinY, TileMinY);
+    const int32 EndY = std::min(Primitive.MaxY, TileMaxY);
+
+    const float LaneOffsetValues[8] = { 0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f };
+    const FFloat8 LaneOffsets = LoadFloat8(LaneOffsetValues);
+    const FFloat8 Zero = Splat(0.0f);
+    const FFloat8 One = Splat(1.0f);
+
+    FFloat8 EdgeA[3];
+    FMask8 TopLeft[3];
+    for (uint32 Edge = 0; Edge < 3; ++Edge)
+    {
+        EdgeA[Edge] = Splat(Primitive.EdgeA[Edge]);
+        TopLeft[Edge] = SplatMask(Primitive.bTopLeft[Edge]);
+    }
+    FFloat8 PlaneA[Plane_Num];
+    for (uint32 Plane = 0; Plane < Plane_Num; ++Plane)
+    {
+        PlaneA[Plane] = Splat(Primitive.Planes[Plane][0]);
+    }
+
+    float Colors[4][8];
+    for (int32 Y = StartY; Y <= EndY; ++Y)
+    {
+        const float PixelY = static_cast<float>(Y) + 0.5f;
+        float* DepthRow = &DepthTarget[static_cast<size_t>(Y) * Pitch];
+        uint32* ColorRow = &ColorTarget[static_cast<size_t>(Y) * Pitch];
+
+        // 행마다 상수인 B y + C 항은 미리 더해 둔다
+        float EdgeRow[3];
+        for (uint32 Edge = 0; Edge < 3; ++Edge)
+        {
+            EdgeRow[Edge] = Primitive.EdgeB[Edge] * PixelY + Primitive.EdgeC[Edge];
+        }
+        float PlaneRow[Plane_Num];
+        for (uint32 Plane = 0; Plane < Plane_Num; ++Plane)
+        {
+            PlaneRow[Plane] = Primitive.Planes[Plane][1] * PixelY + Primitive.Planes[Plane][2];
+        }
+
+        for (int32 X = StartX; X <= EndX; X += 8)
+        {
+            const FFloat8 PixelX = Splat(static_cast<float>(X)) + LaneOffsets;
+
+            FMask8 Covered = SplatMask(true);
+            for (uint32 Edge = 0; Edge < 3; ++Edge)
+            {
+                const FFloat8 Value = EdgeA[Edge] * PixelX + Splat(EdgeRow[Edge]);
+                Covered = Covered & ((Value > Zero) | ((Value == Zero) & TopLeft[Edge]));
+            }
+            if (MaskBits(Covered) == 0)
+            {
+                continue;
+            }
+
+            const FFloat8 Depth = PlaneA[Plane_Depth] * PixelX + Splat(PlaneRow[Plane_Depth]);
+            const FFloat8 OldDepth = LoadFloat8(DepthRow + X);
+            const FMask8 Passed = Covered & TestDepth(Primitive.DepthTest, Depth, OldDepth);
+            const uint32 PassedBits = MaskBits(Passed);
+            if (PassedBits == 0)
+            {
+                continue;
+            }
+            if (Primitive.bDepthWrite)
+            {
+                StoreFloat8(DepthRow + X, Select(Passed, Depth, OldDepth));
+            }
+            if (bDepthOnly)
+            {
+                continue;
+            }
+
+            // 원근 보정: color/w 와 1/w 를 선형 보간한 뒤 나눈다
+            const FFloat8 W = One / (PlaneA[Plane_InvW] * PixelX + Splat(PlaneRow[Plane_InvW]));
+            for (uint32 Channel = 0; Channel < 4; ++Channel)
+            {
+                const uint32 Plane = Plane_ColorR + Channel;
+                StoreFloat8(Colors[Channel], (PlaneA[Plane] * PixelX + Splat(PlaneRow[Plane])) * W);
+            }
+            for (uint32 Lane = 0; Lane < 8; ++Lane)
+            {
+                if (PassedBits & (1u << Lane))
+                {
+                    ColorRow[X + Lane] = PackColor(Colors[0][Lane], Colors[1][Lane], Colors[2][Lane], Colors[3][Lane]);
+                }
+            }
+        }
+    }
+}
+
+void FSoftwareRasterizer::RasterizeLine(const FRasterPrimitive& Primitive, int32 TileMinX, int32 TileMinY, int32 TileMaxX, int32 TileMaxY)
+{
+    const float* Start = Primitive.LineVertices[0];
+    const float* End = Primitive.LineVertices[1];
+    const float DeltaX = End[0] - Start[0];
+    const float DeltaY = End[1] - Start[1];
+    const uint32 NumSteps = std::max(1u, static_cast<uint32>(std::ceil(std::max(std::abs(DeltaX), std::abs(DeltaY)))));
+
+    // 선 전체를 걷되 이 타일에 떨어지는 픽셀만 쓴다 (디버그 선 용도라 충분하다)
+    for (uint32 Step = 0; Step <= NumSteps; ++Step)
+    {
+        const float T = static_cast<float>(Step) / static_cast<float>(NumSteps);
+        const int32 X = static_cast<int32>(std::floor(Start[0] + DeltaX * T));
+        const int32 Y = static_cast<int32>(std::floor(Start[1] + DeltaY * T));
+        if (X < TileMinX || X > TileMaxX || Y < TileMinY || Y > TileMaxY || X >= static_cast<int32>(Width) || Y >= static_cast<int32>(Height))
+        {
+            continue;
+        }
+
+        const size_t PixelIndex = static_cast<size_t>(Y) * Pitch + X;
+        const float Depth = Start[2] + (End[2] - Start[2]) * T;
+        if (!TestDepth(Primitive.DepthTest, Depth, DepthTarget[PixelIndex]))
+        {
+            continue;
+        }
+        if (Primitive.bDepthWrite)
+        {
+            DepthTarget[PixelIndex] = Depth;
+        }
+        if (bDepthOnly)
+        {
+            continue;
+        }
+
+        float Color[4];
+        for (uint32 Channel = 0; Channel < 4; ++Channel)
+        {
+            Color[Channel] = Start[3 + Channel] + (End[3 + Channel] - Start[3 + Channel]) * T;
+        }
+        ColorTarget[PixelIndex] = PackColor(Color[0], Color[1], Color[2], Color[3]);
+    }
+}
@@ -0,0 +1,151 @@
+﻿#pragma once
+
+#include "HAL/PlatformTypes.h"
+#include "Templates/UnrealTypes.h"
+#include "RHI.h"
+
+/** A vertex after the vertex shader: clip space position and color. */
+struct FSoftwareRasterVertex
+{
+    float Position[4];
+    float Color[4];
+};
+
+/**
+ * Tiled CPU rasterizer for ShaderW0 style draws.
+ *
+ * Interpolates vertex color (perspective correct), tests and writes depth
+ * (LESS by default, see SetDepthState) and culls back faces like the D3D11
+ * default rasterizer state. Primitives are clipped against the near plane
+ * and a guard band around the target, so snapped coordinates stay small,
+ * then set up and queued; Flush bins them into TileSize square tiles and
+ * rasterizes the tiles across the task pool, 8 pixels per SIMD step. A tile draws its primitives in
+ * submission order, so the image does not depend on the number of threads.
+ */
+class FSoftwareRasterizer
+{
+public:
+    static constexpr uint32 TileSize = 64;
+
+    /** Reallocates the color and depth targets. Drops queued primitives. */
+    void Resize(uint32 InWidth, uint32 InHeight);
+
+    /** Skips color interpolation and writes, e.g. for occlusion depth buffers. */
+    void SetDepthOnly(bool bInDepthOnly) { bDepthOnly = bInDepthOnly; }
+
+    /** Depth test and write of the primitives added from now on; queued ones keep theirs. */
+    void SetDepthState(ECompareFunction InDepthTest, bool bInDepthWrite)
+    {
+        DepthTest = InDepthTest;
+        bDepthWrite = bInDepthWrite;
+    }
+
+    /** Fills the targets; queued primitives are flushed first. */
+    void Clear(const float InColor[4], float InDepth = 1.0f);
+
+    /** Queues a triangle list, three vertices per triangle. */
+    void AddTriangles(const FSoftwareRasterVertex* Vertices, uint32 NumTriangles);
+
+    /** Queues a line list, two vertices per one pixel wide line. */
+    void AddLines(const FSoftwareRasterVertex* Vertices, uint32 NumLines);
+
+    /** Rasterizes everything queued so far. */
+    void Flush();
+
+    uint32 GetWidth() const { return Width; }
+    uint32 GetHeight() const { return Height; }
+
+    /** @return The RGBA8 color of a pixel, red in the low byte. */
+    uint32 GetPixel(uint32 X, uint32 Y) const { return ColorTarget[Y * Pitch + X]; }
+    float GetDepth(uint32 X, uint32 Y) const { return DepthTarget[Y * Pitch + X]; }
+
+    /** Writes the color target as an uncompressed 32 bit TGA. */
+    bool SaveTGA(const FString& Filename) const;
+
+    /** @return Primitives that survived clipping and culling and were rasterized. */
+    uint64 GetNumPrimitivesRasterized() const { return NumPrimitivesRasterized; }
+
+private:
+    /** Attribute planes a(x, y) = A x + B y + C: depth (z/w), 1/w and color/w. */
+    enum EPlane
+    {
+        Plane_Depth,
+        Plane_InvW,
+        Plane_ColorR,
+        Plane_ColorG,
+        Plane_ColorB,
+        Plane_ColorA,
+
+        Plane_Num,
+    };
+
+    struct FRasterPrimitive
+    {
+        bool bLine = false;
+
+        ECompareFunction DepthTest = CF_Less;
+        bool bDepthWrite = true;
+
+        /** Inclusive pixel bounds, clamped to the target. */
+        int32 MinX = 0;
+        int32 MinY = 0;
+        int32 MaxX = 0;
+        int32 MaxY = 0;
+
+        /** Triangle edges E(x, y) = A x + B y + C, positive inside. */
+        float EdgeA[3];
+        float EdgeB[3];
+        float EdgeC[3];
+        bool bTopLeft[3];
+
+        float Planes[Plane_Num][3];
+
+        /** Line endpoints in screen space: X, Y, depth and color. */
+        float LineVertices[2][7];
+    };
+
+    /** Screen space margin kept around the target before triangles are clipped. */
+    static constexpr float GuardBandPixels = 8192.0f;
+
+    /** Triangles a clipped triangle can become: one vertex more per clip plane (near and four guard band). */
+    static constexpr uint32 MaxClippedTriangles = 6;
+
+    /** SetupTriangle result when the clipped triangle needs more than MaxPrimitives slots. */
+    static constexpr uint32 SetupNeedsMoreSlots = ~0u;
+
+    /** @return How many primitives (up to MaxPrimitives) the clipped triangle became, or SetupNeedsMoreSlots. */
+    uint32 SetupTriangle(const FSoftwareRasterVertex* Vertices, FRasterPrimitive* OutPrimitives, uint32 MaxPrimitives) const;
+    bool SetupClippedTriangle(const FSoftwareRasterVertex& V0, const FSoftwareRasterVertex& V1, const FSoftwareRasterVertex& V2, FRasterPrimitive& OutPrimitive) const;
+    bool SetupLine(const FSoftwareRasterVertex& V0, const FSoftwareRasterVertex& V1, FRasterPrimitive& OutPrimitive) const;
+
+    void QueuePrimitive(const FRasterPrimitive& Primitive);
+    void RasterizeTile(uint32 TileIndex);
+    void RasterizeTriangle(const FRasterPrimitive& Primitive, int32 TileMinX, int32 TileMinY, int32 TileMaxX, int32 TileMaxY);
+    void RasterizeLine(const FRasterPrimitive& Primitive, int32 TileMinX, int32 TileMinY, int32 TileMaxX, int32 TileMaxY);
+
+private:
+    uint32 Width = 0;
+    uint32 Height = 0;
+
+    /** Targets are padded to whole tiles so SIMD spans never leave a row. */
+    uint32 Pitch = 0;
+    uint32 NumTilesX = 0;
+    uint32 NumTilesY = 0;
+
+    TArray<uint32> ColorTarget;
+    TArray<float> DepthTarget;
+
+    TArray<FRasterPrimitive> Primitives;
+
+    /** Indices into Primitives, per tile, in submission order. */
+    TArray<TArray<uint32>> TileBins;
+
+    /** Two setup slots per triangle, filled in parallel and compacted in order. */
+    TArray<FRasterPrimitive> SetupScratch;
+    TArray<uint32> SetupCounts;
+
+    uint64 NumPrimitivesRasterized = 0;
+    bool bDepthOnly = false;
+    ECompareFunction DepthTest = CF_Less;
+    bool bDepthWrite = true;
+};
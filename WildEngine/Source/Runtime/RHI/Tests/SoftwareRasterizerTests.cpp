@@ -0,0 +1,149 @@
+/*=============================================================================
+	SoftwareRasterizerTests.cpp: FSoftwareRasterizer images against references.
+
+	Needs no device or Windows SDK. Build and run from Source/Runtime:
+		g++ -std=c++17 -O1 -ICore -IRHI -IEngine RHI/Tests/SoftwareRasterizerTests.cpp RHI/SoftwareRasterizer.cpp Core/Async/TaskPool.cpp -lpthread -o SoftwareRasterizerTests && ./SoftwareRasterizerTests
+	Exits with the number of failed checks.
+=============================================================================*/
+
+#include <cstdio>
+#include <functional>
+
+#include "SoftwareRasterizer.h"
+#include "Tests/TestHarness.h"
+
+namespace
+{
+	constexpr uint32 TargetWidth = 64;
+	constexpr uint32 TargetHeight = 32;
+
+	const float Black[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	const float Red[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+	const float Green[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
+
+	/** Black, red and green as GetPixel returns them, red in the low byte. */
+	constexpr uint32 BlackPixel = 0xFF000000;
+	constexpr uint32 RedPixel = 0xFF0000FF;
+	constexpr uint32 GreenPixel = 0xFF00FF00;
+
+	/** A clip space vertex with w = 1, so x and y are NDC. */
+	FSoftwareRasterVertex MakeVertex(float X, float Y, float Z, const float Color[4])
+	{
+		return { { X, Y, Z, 1.0f }, { Color[0], Color[1], Color[2], Color[3] } };
+	}
+
+	/** NDC of a pixel corner. */
+	float PixelToNDCX(float X) { return X / TargetWidth * 2.0f - 1.0f; }
+	float PixelToNDCY(float Y) { return 1.0f - Y / TargetHeight * 2.0f; }
+
+	/** Queues the pixel rectangle [MinX, MaxX) x [MinY, MaxY) as two front facing triangles. */
+	void AddRectangle(FSoftwareRasterizer& Rasterizer, float MinX, float MinY, float MaxX, float MaxY, float Z, const float Color[4])
+	{
+		const FSoftwareRasterVertex TopLeft = MakeVertex(PixelToNDCX(MinX), PixelToNDCY(MinY), Z, Color);
+		const FSoftwareRasterVertex TopRight = MakeVertex(PixelToNDCX(MaxX), PixelToNDCY(MinY), Z, Color);
+		const FSoftwareRasterVertex BottomRight = MakeVertex(PixelToNDCX(MaxX), PixelToNDCY(MaxY), Z, Color);
+		const FSoftwareRasterVertex BottomLeft = MakeVertex(PixelToNDCX(MinX), PixelToNDCY(MaxY), Z, Color);
+		const FSoftwareRasterVertex Vertices[6] = { TopLeft, TopRight, BottomRight, TopLeft, BottomRight, BottomLeft };
+		Rasterizer.AddTriangles(Vertices, 2);
+	}
+
+	/** @return Whether every pixel is Reference(X, Y); reports the first mismatch. */
+	bool MatchesReference(const FSoftwareRasterizer& Rasterizer, const std::function<uint32(uint32, uint32)>& Reference)
+	{
+		for (uint32 Y = 0; Y < Rasterizer.GetHeight(); ++Y)
+		{
+			for (uint32 X = 0; X < Rasterizer.GetWidth(); ++X)
+			{
+				if (Rasterizer.GetPixel(X, Y) != Reference(X, Y))
+				{
+					std::printf("  pixel (%u, %u) is %08x, expected %08x\n", X, Y, Rasterizer.GetPixel(X, Y), Reference(X, Y));
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void TestRectangleMatchesReference()
+	{
+		FSoftwareRasterizer Rasterizer;
+		Rasterizer.Resize(TargetWidth, TargetHeight);
+		Rasterizer.Clear(Black);
+
+		// 변이 픽셀 경계에 놓이므로 중심이 안에 있는 픽셀만, 공유하는 대각선은 한 번만 칠해진다
+		AddRectangle(Rasterizer, 8.0f, 4.0f, 24.0f, 20.0f, 0.5f, Red);
+		Rasterizer.Flush();
+
+		Check(MatchesReference(Rasterizer, [](uint32 X, uint32 Y)
+		{
+			return X >= 8 && X < 24 && Y >= 4 && Y < 20 ? RedPixel : BlackPixel;
+		}), "a pixel aligned rectangle covers exactly its pixels");
+	}
+
+	void TestGuardBandClipping()
+	{
+		FSoftwareRasterizer Rasterizer;
+		Rasterizer.Resize(TargetWidth, TargetHeight);
+		Rasterizer.Clear(Black);
+
+		// 화면 좌표가 int32를 넘는 삼각형: 가드 밴드로 잘리지 않으면 바운딩 박스가 깨져 버려지거나 정의되지 않은 동작이 된다
+		const FSoftwareRasterVertex Vertices[3] =
+		{
+			MakeVertex(-1.0e9f, 1.0e9f, 0.5f, Red),
+			MakeVertex(3.0e9f, 1.0e9f, 0.5f, Red),
+			MakeVertex(-1.0e9f, -3.0e9f, 0.5f, Red),
+		};
+		Rasterizer.AddTriangles(Vertices, 1);
+		Rasterizer.Flush();
+
+		Check(MatchesReference(Rasterizer, [](uint32, uint32) { return RedPixel; }), "a triangle far beyond the guard band still covers the whole target");
+		Check(Rasterizer.GetNumPrimitivesRasterized() > 1, "the triangle was clipped into several primitives");
+
+		// 한 꼭짓점만 멀리 나간 삼각형도 화면 안쪽 변은 그대로다: 왼쪽 절반을 덮는다
+		Rasterizer.Clear(Black);
+		const FSoftwareRasterVertex HalfVertices[3] =
+		{
+			MakeVertex(-1.0e9f, 1.0f, 0.5f, Green),
+			MakeVertex(0.0f, 1.0f, 0.5f, Green),
+			MakeVertex(0.0f, -1.0e9f, 0.5f, Green),
+		};
+		Rasterizer.AddTriangles(HalfVertices, 1);
+		Rasterizer.Flush();
+
+		Check(MatchesReference(Rasterizer, [](uint32 X, uint32) { return X < TargetWidth / 2 ? GreenPixel : BlackPixel; }),
+			"clipping at the guard band keeps the on screen edge");
+	}
+
+	void TestDepthState()
+	{
+		FSoftwareRasterizer Rasterizer;
+		Rasterizer.Resize(TargetWidth, TargetHeight);
+		Rasterizer.Clear(Black);
+
+		AddRectangle(Rasterizer, 0.0f, 0.0f, 32.0f, 32.0f, 0.25f, Red);
+
+		// 뒤에 있어도 ALWAYS면 보이고, 깊이를 쓰지 않으므로 앞 사각형의 깊이가 남는다
+		Rasterizer.SetDepthState(CF_Always, false);
+		AddRectangle(Rasterizer, 16.0f, 0.0f, 48.0f, 32.0f, 0.75f, Green);
+
+		// 기본 LESS로 돌아오면 더 먼 사각형은 가려진다
+		Rasterizer.SetDepthState(CF_Less, true);
+		AddRectangle(Rasterizer, 0.0f, 0.0f, 64.0f, 32.0f, 0.5f, Red);
+		Rasterizer.Flush();
+
+		Check(MatchesReference(Rasterizer, [](uint32 X, uint32)
+		{
+			return X >= 16 && X < 32 ? GreenPixel : RedPixel;
+		}), "depth state applies to the primitives added after it");
+		Check(Rasterizer.GetDepth(20, 10) == 0.25f, "a draw without depth writes leaves the depth alone");
+	}
+}
+
+int main()
+{
+	TestRectangleMatchesReference();
+	TestGuardBandClipping();
+	TestDepthState();
+
+	return ReportTestResults("SoftwareRasterizerTests");
+}
@@ -0,0 +1,45 @@
+﻿/*=============================================================================
+    D3D11BoundShaderState.cpp: Vertex and pixel shader plus their input layout.
+=============================================================================*/
+
+#include "D3D11BoundShaderState.h"
+
+#include <d3dcompiler.h>
+
+#pragma comment(lib, "d3dcompiler")
+
+using Microsoft::WRL::ComPtr;
+
+bool FD3D11BoundShaderState::Initialize(ID3D11Device* Device, const wchar_t* ShaderFile, const D3D11_INPUT_ELEMENT_DESC* Layout, uint32 NumElements)
+{
+    ComPtr<ID3DBlob> VertexShaderCode;
+    ComPtr<ID3DBlob> PixelShaderCode;
+    ComPtr<ID3DBlob> ErrorMessages;
+    if (FAILED(D3DCompileFromFile(ShaderFile, nullptr, nullptr, "mainVS", "vs_5_0", 0, 0, VertexShaderCode.GetAddressOf(), ErrorMessages.ReleaseAndGetAddressOf())) ||
+        FAILED(D3DCompileFromFile(ShaderFile, nullptr, nullptr, "mainPS", "ps_5_0", 0, 0, PixelShaderCode.GetAddressOf(), ErrorMessages.ReleaseAndGetAddressOf())))
+    {
+        return false;
+    }
+
+    ComPtr<ID3D11VertexShader> NewVertexShader;
+    ComPtr<ID3D11PixelShader> NewPixelShader;
+    ComPtr<ID3D11InputLayout> NewInputLayout;
+    if (FAILED(Device->CreateVertexShader(VertexShaderCode->GetBufferPointer(), VertexShaderCode->GetBufferSize(), nullptr, NewVertexShader.GetAddressOf())) ||
+        FAILED(Device->CreatePixelShader(PixelShaderCode->GetBufferPointer(), PixelShaderCode->GetBufferSize(), nullptr, NewPixelShader.GetAddressOf())) ||
+        FAILED(Device->CreateInputLayout(Layout, NumElements, VertexShaderCode->GetBufferPointer(), VertexShaderCode->GetBufferSize(), NewInputLayout.GetAddressOf())))
+    {
+        return false;
+    }
+
+    VertexShader = NewVertexShader;
+    PixelShader = NewPixelShader;
+    InputLayout = NewInputLayout;
+    return true;
+}
+
+void FD3D11BoundShaderState::Bind(FD3D11StateCache& StateCache) const
+{
+    StateCache.SetInputLayout(InputLayout.Get());
+    StateCache.SetVertexShader(VertexShader.Get());
+    StateCache.SetPixelShader(PixelShader.Get());
+}
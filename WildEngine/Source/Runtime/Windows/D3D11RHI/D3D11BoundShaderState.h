@@ -0,0 +1,35 @@
+﻿/*=============================================================================
+    D3D11BoundShaderState.h: Vertex and pixel shader plus their input layout.
+=============================================================================*/
+
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+
+#include "HAL/PlatformTypes.h"
+#include "D3D11State.h"
+
+/**
+ * The vertex shader, pixel shader and input layout a pass draws with, built
+ * from the mainVS/mainPS entry points of one HLSL file.
+ */
+class FD3D11BoundShaderState
+{
+public:
+    /**
+     * Compiles ShaderFile and creates the input layout Layout against its vertex shader.
+     * @return false when compiling or any creation fails; the state stays uninitialized.
+     */
+    bool Initialize(ID3D11Device* Device, const wchar_t* ShaderFile, const D3D11_INPUT_ELEMENT_DESC* Layout, uint32 NumElements);
+
+    bool IsInitialized() const { return InputLayout != nullptr; }
+
+    /** Binds the input layout and both shaders through StateCache. */
+    void Bind(FD3D11StateCache& StateCache) const;
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11VertexShader> VertexShader;
+    Microsoft::WRL::ComPtr<ID3D11PixelShader> PixelShader;
+    Microsoft::WRL::ComPtr<ID3D11InputLayout> InputLayout;
+};
@@ -0,0 +1,75 @@
+﻿/*=============================================================================
+    D3D11BufferRing.cpp: Dynamic buffer streamed through as a ring.
+=============================================================================*/
+
+#include "D3D11BufferRing.h"
+
+bool FD3D11BufferRing::Initialize(ID3D11Device* InDevice, UINT InBindFlags, uint32 InElementSize, uint32 InitialNumElements)
+{
+    Device = InDevice;
+    BindFlags = InBindFlags;
+    ElementSize = InElementSize;
+    return CreateBuffer(InitialNumElements);
+}
+
+bool FD3D11BufferRing::CreateBuffer(uint32 NumElements)
+{
+    D3D11_BUFFER_DESC Desc = {};
+    Desc.ByteWidth = NumElements * ElementSize;
+    Desc.Usage = D3D11_USAGE_DYNAMIC;
+    Desc.BindFlags = BindFlags;
+    Desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> NewBuffer;
+    if (FAILED(Device->CreateBuffer(&Desc, nullptr, NewBuffer.GetAddressOf())))
+    {
+        return false;
+    }
+
+    Buffer = NewBuffer;
+    NumElementsCapacity = NumElements;
+    Head = 0;
+    bNeedsDiscard = true;
+    return true;
+}
+
+void* FD3D11BufferRing::Map(ID3D11DeviceContext* Context, uint32 NumElements, uint32& OutFirstElement)
+{
+    // 한 번의 요청이 통째로 안 들어가면 키운다
+    if (NumElements > NumElementsCapacity)
+    {
+        uint32 NewCapacity = NumElementsCapacity;
+        while (NewCapacity < NumElements)
+        {
+            NewCapacity *= 2;
+        }
+        if (!CreateBuffer(NewCapacity))
+        {
+            return nullptr;
+        }
+    }
+
+    // 끝에 닿으면 DISCARD 로 새 메모리를 받아 처음부터, 아니면 GPU가 읽는 앞부분을 건드리지 않고 이어 쓴다
+    D3D11_MAP MapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    if (bNeedsDiscard || Head + NumElements > NumElementsCapacity)
+    {
+        MapType = D3D11_MAP_WRITE_DISCARD;
+        Head = 0;
+        bNeedsDiscard = false;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE Mapped;
+    if (FAILED(Context->Map(Buffer.Get(), 0, MapType, 0, &Mapped)))
+    {
+        return nullptr;
+    }
+
+    OutFirstElement = Head;
+    Head += NumElements;
+    return static_cast<uint8*>(Mapped.pData) + OutFirstElement * ElementSize;
+}
+
+void FD3D11BufferRing::Unmap(ID3D11DeviceContext* Context)
+{
+    Context->Unmap(Buffer.Get(), 0);
+}
@@ -0,0 +1,55 @@
+﻿/*=============================================================================
+    D3D11BufferRing.h: Dynamic buffer streamed through as a ring.
+=============================================================================*/
+
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+
+#include "HAL/PlatformTypes.h"
+
+/**
+ * Dynamic buffer of fixed size elements that transient data is streamed into.
+ *
+ * Map hands out the next NumElements of the ring: appended with NO_OVERWRITE
+ * while there is room, so draws already issued keep reading their elements,
+ * and restarted at 0 with DISCARD when the ring is full. A single request
+ * larger than the whole ring grows it by doubling.
+ *
+ * Vertex buffers can always be mapped with NO_OVERWRITE; constant buffers
+ * need the D3D 11.1 MapNoOverwriteOnDynamicConstantBuffer feature, which the
+ * caller checks.
+ */
+class FD3D11BufferRing
+{
+public:
+    /** @param InBindFlags D3D11_BIND_VERTEX_BUFFER or D3D11_BIND_CONSTANT_BUFFER. */
+    bool Initialize(ID3D11Device* InDevice, UINT InBindFlags, uint32 InElementSize, uint32 InitialNumElements);
+
+    bool IsInitialized() const { return Buffer != nullptr; }
+
+    /**
+     * @param OutFirstElement Receives the element index the returned memory starts at.
+     * @return Write-only memory for NumElements elements, or nullptr. Must be followed by Unmap.
+     */
+    void* Map(ID3D11DeviceContext* Context, uint32 NumElements, uint32& OutFirstElement);
+    void Unmap(ID3D11DeviceContext* Context);
+
+    ID3D11Buffer* GetBuffer() const { return Buffer.Get(); }
+    uint32 GetElementSize() const { return ElementSize; }
+    uint32 GetCapacity() const { return NumElementsCapacity; }
+
+private:
+    bool CreateBuffer(uint32 NumElements);
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11Device> Device;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> Buffer;
+
+    UINT BindFlags = 0;
+    uint32 ElementSize = 0;
+    uint32 NumElementsCapacity = 0;
+    uint32 Head = 0;
+    bool bNeedsDiscard = true;
+};
@@ -0,0 +1,453 @@
+﻿/*=============================================================================
+    D3D11DynamicRHI.cpp: D3D11 implementation of the dynamic RHI.
+=============================================================================*/
+
+#include "D3D11DynamicRHI.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    D3D11_PRIMITIVE_TOPOLOGY GetD3D11PrimitiveType(EPrimitiveType PrimitiveType)
+    {
+        switch (PrimitiveType)
+        {
+        case PT_TriangleList:  return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+        case PT_TriangleStrip: return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+        case PT_LineList:      return D3D11_PRIMITIVE_TOPOLOGY_LINELIST;
+        case PT_PointList:     return D3D11_PRIMITIVE_TOPOLOGY_POINTLIST;
+        default:               return D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED; // 쿼드 리스트는 D3D11에 없다
+        }
+    }
+
+    /** Texture, render target/depth view and shader resource view formats of an RHI pixel format. */
+    struct FD3D11TextureFormat
+    {
+        DXGI_FORMAT Resource;
+        DXGI_FORMAT TargetView;
+        DXGI_FORMAT ShaderResourceView;
+    };
+
+    FD3D11TextureFormat GetD3D11TextureFormat(EPixelFormat Format)
+    {
+        switch (Format)
+        {
+        case PF_B8G8R8A8:         return { DXGI_FORMAT_B8G8R8A8_UNORM, DXGI_FORMAT_B8G8R8A8_UNORM, DXGI_FORMAT_B8G8R8A8_UNORM };
+        case PF_A32B32G32R32F:    return { DXGI_FORMAT_R32G32B32A32_FLOAT, DXGI_FORMAT_R32G32B32A32_FLOAT, DXGI_FORMAT_R32G32B32A32_FLOAT };
+        case PF_FloatRGBA:        return { DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R16G16B16A16_FLOAT };
+        case PF_R32_FLOAT:        return { DXGI_FORMAT_R32_FLOAT, DXGI_FORMAT_R32_FLOAT, DXGI_FORMAT_R32_FLOAT };
+        // 깊이는 셰이더에서도 읽을 수 있게 typeless로 만들고 뷰마다 해석을 정한다
+        case PF_DepthStencil:     return { DXGI_FORMAT_R24G8_TYPELESS, DXGI_FORMAT_D24_UNORM_S8_UINT, DXGI_FORMAT_R24_UNORM_X8_TYPELESS };
+        case PF_ShadowDepth:      return { DXGI_FORMAT_R32_TYPELESS, DXGI_FORMAT_D32_FLOAT, DXGI_FORMAT_R32_FLOAT };
+        default:                  return { DXGI_FORMAT_UNKNOWN, DXGI_FORMAT_UNKNOWN, DXGI_FORMAT_UNKNOWN };
+        }
+    }
+}
+
+FD3D11DynamicRHI::FD3D11DynamicRHI(ID3D11Device* InDevice, ID3D11DeviceContext* InContext)
+    : Device(InDevice)
+    , Context(InContext)
+    , StateObjects(InDevice)
+{
+    // 지원하지 않으면 슬롯마다 DISCARD 로 다시 쓰는 상수 버퍼를 쓴다
+    InitConstantRing();
+}
+
+bool FD3D11DynamicRHI::InitConstantRing()
+{
+    // 오프셋 바인딩과 상수 버퍼 NO_OVERWRITE 는 11.1 기능
+    D3D11_FEATURE_DATA_D3D11_OPTIONS Options = {};
+    if (FAILED(Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &Options, sizeof(Options))) ||
+        !Options.ConstantBufferOffsetting || !Options.MapNoOverwriteOnDynamicConstantBuffer)
+    {
+        return false;
+    }
+
+    if (FAILED(Context->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(Context1.ReleaseAndGetAddressOf()))))
+    {
+        return false;
+    }
+
+    if (!ConstantRing.Initialize(Device, D3D11_BIND_CONSTANT_BUFFER, ConstantRingSlotSize, 4096))
+    {
+        Context1.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FD3D11DynamicRHI::Shutdown()
+{
+    for (uint32 Index = 0; Index < D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT; ++Index)
+    {
+        ConstantBuffers[Index].Reset();
+        ConstantBufferSizes[Index] = 0;
+    }
+    ConstantRing = FD3D11BufferRing();
+    Context1.Reset();
+    UPVertexBuffer.Reset();
+    UPVertexBufferSize = 0;
+    StateObjects.Empty();
+    PendingFrameFences.clear();
+    FreeFrameFenceQueries.clear();
+}
+
+FRHIVertexBuffer* FD3D11DynamicRHI::RHICreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage)
+{
+    FD3D11VertexBuffer* VertexBuffer = ResourceCast(RHIAllocVertexBuffer(Size, InUsage));
+    RHIInitVertexBuffer(VertexBuffer, Data);
+    if (!VertexBuffer->Resource)
+    {
+        delete VertexBuffer;
+        return nullptr;
+    }
+    return VertexBuffer;
+}
+
+FRHIVertexBuffer* FD3D11DynamicRHI::RHIAllocVertexBuffer(uint32 Size, uint32 InUsage)
+{
+    // 디바이스 버퍼는 RHIInitVertexBuffer에서 만든다
+    return new FD3D11VertexBuffer(nullptr, Size, InUsage);
+}
+
+void FD3D11DynamicRHI::RHIInitVertexBuffer(FRHIVertexBuffer* VertexBuffer, const void* Data)
+{
+    FD3D11VertexBuffer* Buffer = ResourceCast(VertexBuffer);
+    if (Buffer->Resource)
+    {
+        return;
+    }
+
+    D3D11_BUFFER_DESC Desc = {};
+    Desc.ByteWidth = Buffer->GetSize();
+    Desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    if (Buffer->GetUsage() & BUF_Dynamic)
+    {
+        Desc.Usage = D3D11_USAGE_DYNAMIC;
+        Desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    }
+    else
+    {
+        // 정적 버퍼는 처음 데이터로 한 번만 채운다
+        Desc.Usage = Data ? D3D11_USAGE_IMMUTABLE : D3D11_USAGE_DEFAULT;
+    }
+
+    D3D11_SUBRESOURCE_DATA InitData = {};
+    InitData.pSysMem = Data;
+
+    // 실패하면 Resource가 null로 남아 그리기는 빈 버퍼를 묶는다
+    if (FAILED(Device->CreateBuffer(&Desc, Data ? &InitData : nullptr, &Buffer->Resource)))
+    {
+        Buffer->Resource = nullptr;
+        return;
+    }
+
+    ++Stats.NumVertexBuffersCreated;
+    Stats.NumVertexBufferBytes += Buffer->GetSize();
+}
+
+void FD3D11DynamicRHI::RHIUpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size)
+{
+    // 캡처 리플레이로 임의의 값이 올 수 있으므로 더해서 넘치지 않게 비교한다
+    if (!VertexBuffer || !ResourceCast(VertexBuffer)->Resource || Size > VertexBuffer->GetSize() || Offset > VertexBuffer->GetSize() - Size)
+    {
+        return;
+    }
+
+    // DEFAULT 버퍼의 일부만 덮어쓴다. 같은 버퍼의 다른 구간을 그리는 이전 드로우는 드라이버가 순서를 지킨다
+    D3D11_BOX Box = {};
+    Box.left = Offset;
+    Box.right = Offset + Size;
+    Box.bottom = 1;
+    Box.back = 1;
+    Context->UpdateSubresource(ResourceCast(VertexBuffer)->Resource, 0, &Box, Data, 0, 0);
+
+    ++Stats.NumVertexBufferUpdates;
+    Stats.NumVertexBufferUpdateBytes += Size;
+}
+
+FRHITexture2D* FD3D11DynamicRHI::RHICreateTexture2D(uint32 SizeX, uint32 SizeY, EPixelFormat Format, uint32 Flags)
+{
+    const FD3D11TextureFormat TextureFormat = GetD3D11TextureFormat(Format);
+    if (TextureFormat.Resource == DXGI_FORMAT_UNKNOWN)
+    {
+        return nullptr;
+    }
+
+    D3D11_TEXTURE2D_DESC Desc = {};
+    Desc.Width = SizeX;
+    Desc.Height = SizeY;
+    Desc.MipLevels = 1;
+    Desc.ArraySize = 1;
+    Desc.Format = TextureFormat.Resource;
+    Desc.SampleDesc.Count = 1;
+    Desc.Usage = D3D11_USAGE_DEFAULT;
+    Desc.BindFlags =
+        ((Flags & TexCreate_RenderTargetable) ? D3D11_BIND_RENDER_TARGET : 0) |
+        ((Flags & TexCreate_DepthStencilTargetable) ? D3D11_BIND_DEPTH_STENCIL : 0) |
+        ((Flags & TexCreate_ShaderResource) ? D3D11_BIND_SHADER_RESOURCE : 0);
+
+    ID3D11Texture2D* Texture = nullptr;
+    if (FAILED(Device->CreateTexture2D(&Desc, nullptr, &Texture)))
+    {
+        return nullptr;
+    }
+
+    ID3D11RenderTargetView* RenderTargetView = nullptr;
+    ID3D11DepthStencilView* DepthStencilView = nullptr;
+    ID3D11ShaderResourceView* ShaderResourceView = nullptr;
+    bool bViewsCreated = true;
+    if (Flags & TexCreate_RenderTargetable)
+    {
+        D3D11_RENDER_TARGET_VIEW_DESC ViewDesc = {};
+        ViewDesc.Format = TextureFormat.TargetView;
+        ViewDesc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
+        bViewsCreated &= SUCCEEDED(Device->CreateRenderTargetView(Texture, &ViewDesc, &RenderTargetView));
+    }
+    if (Flags & TexCreate_DepthStencilTargetable)
+    {
+        D3D11_DEPTH_STENCIL_VIEW_DESC ViewDesc = {};
+        ViewDesc.Format = TextureFormat.TargetView;
+        ViewDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+        bViewsCreated &= SUCCEEDED(Device->CreateDepthStencilView(Texture, &ViewDesc, &DepthStencilView));
+    }
+    if (Flags & TexCreate_ShaderResource)
+    {
+        D3D11_SHADER_RESOURCE_VIEW_DESC ViewDesc = {};
+        ViewDesc.Format = TextureFormat.ShaderResourceView;
+        ViewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+        ViewDesc.Texture2D.MipLevels = 1;
+        bViewsCreated &= SUCCEEDED(Device->CreateShaderResourceView(Texture, &ViewDesc, &ShaderResourceView));
+    }
+
+    // 실패한 뷰가 있어도 만든 것들은 소멸자가 해제한다
+    FD3D11Texture2D* Result = new FD3D11Texture2D(Texture, RenderTargetView, DepthStencilView, ShaderResourceView, SizeX, SizeY, Format, Flags);
+    if (!bViewsCreated)
+    {
+        delete Result;
+        return nullptr;
+    }
+
+    ++Stats.NumTexturesCreated;
+    return Result;
+}
+
+void FD3D11DynamicRHI::RHISetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes)
+{
+    if (BufferIndex >= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT)
+    {
+        return;
+    }
+
+    if (NumBytes == 0)
+    {
+        ID3D11Buffer* NullBuffer = nullptr;
+        Context->VSSetConstantBuffers(BufferIndex, 1, &NullBuffer);
+        return;
+    }
+
+    // 링에서 256바이트 슬롯 단위로 이어 받아 오프셋으로 바인딩한다. 앞서 기록한 드로우의 상수는 그대로 남는다
+    if (Context1)
+    {
+        const uint32 NumSlots = (NumBytes + ConstantRingSlotSize - 1) / ConstantRingSlotSize;
+        uint32 FirstSlot = 0;
+        void* Dest = ConstantRing.Map(Context, NumSlots, FirstSlot);
+        if (Dest == nullptr)
+        {
+            return;
+        }
+        std::memcpy(Dest, Data, NumBytes);
+        ConstantRing.Unmap(Context);
+
+        ID3D11Buffer* Buffer = ConstantRing.GetBuffer();
+        const UINT FirstConstant = FirstSlot * (ConstantRingSlotSize / 16);
+        const UINT NumConstants = NumSlots * (ConstantRingSlotSize / 16);
+        Context1->VSSetConstantBuffers1(BufferIndex, 1, &Buffer, &FirstConstant, &NumConstants);
+
+        ++Stats.NumConstantUpdates;
+        Stats.NumConstantBytes += NumBytes;
+        return;
+    }
+
+    // 상수 버퍼 크기는 16바이트 배수여야 한다
+    const uint32 AlignedSize = (NumBytes + 15) & ~15u;
+    if (!EnsureDynamicBuffer(ConstantBuffers[BufferIndex], ConstantBufferSizes[BufferIndex], AlignedSize, D3D11_BIND_CONSTANT_BUFFER))
+    {
+        return;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE Mapped;
+    if (FAILED(Context->Map(ConstantBuffers[BufferIndex].Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &Mapped)))
+    {
+        return;
+    }
+    std::memcpy(Mapped.pData, Data, NumBytes);
+    Context->Unmap(ConstantBuffers[BufferIndex].Get(), 0);
+
+    Context->VSSetConstantBuffers(BufferIndex, 1, ConstantBuffers[BufferIndex].GetAddressOf());
+
+    ++Stats.NumConstantUpdates;
+    Stats.NumConstantBytes += NumBytes;
+}
+
+void FD3D11DynamicRHI::RHISetStreamSource(uint32 StreamIndex, FRHIVertexBuffer* VertexBuffer, uint32 Stride, uint32 Offset)
+{
+    ID3D11Buffer* Buffer = VertexBuffer ? ResourceCast(VertexBuffer)->Resource : nullptr;
+    Context->IASetVertexBuffers(StreamIndex, 1, &Buffer, &Stride, &Offset);
+}
+
+void FD3D11DynamicRHI::RHISetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer)
+{
+    // 디바이스가 거부하면 기본 상태(null)로 그린다
+    const FD3D11DepthStencilState* DepthStencilState = StateObjects.GetDepthStencilState(Initializer);
+    Context->OMSetDepthStencilState(DepthStencilState ? DepthStencilState->Resource : nullptr, 0);
+}
+
+void FD3D11DynamicRHI::RHIDrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances)
+{
+    const D3D11_PRIMITIVE_TOPOLOGY Topology = GetD3D11PrimitiveType(PrimitiveType);
+    if (Topology == D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED || NumPrimitives == 0 || NumInstances == 0)
+    {
+        return;
+    }
+
+    const uint32 NumVertices = GetVertexCountForPrimitiveCount(NumPrimitives, PrimitiveType);
+    Context->IASetPrimitiveTopology(Topology);
+    if (NumInstances > 1)
+    {
+        Context->DrawInstanced(NumVertices, NumInstances, BaseVertexIndex, 0);
+    }
+    else
+    {
+        Context->Draw(NumVertices, BaseVertexIndex);
+    }
+
+    ++Stats.NumDrawCalls;
+    Stats.NumPrimitives += static_cast<uint64>(NumPrimitives) * NumInstances;
+    Stats.NumInstances += NumInstances;
+}
+
+void FD3D11DynamicRHI::RHIDrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride)
+{
+    const D3D11_PRIMITIVE_TOPOLOGY Topology = GetD3D11PrimitiveType(PrimitiveType);
+    if (Topology == D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED || NumPrimitives == 0)
+    {
+        return;
+    }
+
+    const uint32 NumVertices = GetVertexCountForPrimitiveCount(NumPrimitives, PrimitiveType);
+    const uint32 Size = NumVertices * VertexDataStride;
+    if (!EnsureDynamicBuffer(UPVertexBuffer, UPVertexBufferSize, Size, D3D11_BIND_VERTEX_BUFFER))
+    {
+        return;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE Mapped;
+    if (FAILED(Context->Map(UPVertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &Mapped)))
+    {
+        return;
+    }
+    std::memcpy(Mapped.pData, VertexData, Size);
+    Context->Unmap(UPVertexBuffer.Get(), 0);
+
+    const UINT Offset = 0;
+    Context->IASetVertexBuffers(0, 1, UPVertexBuffer.GetAddressOf(), &VertexDataStride, &Offset);
+    Context->IASetPrimitiveTopology(Topology);
+    Context->Draw(NumVertices, 0);
+
+    ++Stats.NumDrawCalls;
+    Stats.NumPrimitives += NumPrimitives;
+    Stats.NumInstances += 1;
+}
+
+void FD3D11DynamicRHI::RHIEndFrame()
+{
+    ++Stats.NumFrames;
+}
+
+void FD3D11DynamicRHI::RHISignalFrameFence(uint64 FrameNumber)
+{
+    Microsoft::WRL::ComPtr<ID3D11Query> Query;
+    if (!FreeFrameFenceQueries.empty())
+    {
+        Query = std::move(FreeFrameFenceQueries.back());
+        FreeFrameFenceQueries.pop_back();
+    }
+    else
+    {
+        D3D11_QUERY_DESC QueryDesc = {};
+        QueryDesc.Query = D3D11_QUERY_EVENT;
+        if (FAILED(Device->CreateQuery(&QueryDesc, Query.GetAddressOf())))
+        {
+            // 펜스를 못 만들면 스왑체인 최대 프레임 지연만 믿는다
+            if (FrameNumber > RHIMaxGpuFramesInFlight)
+            {
+                RetiredFrameNumber = std::max(RetiredFrameNumber, FrameNumber - RHIMaxGpuFramesInFlight);
+            }
+            return;
+        }
+    }
+
+    Context->End(Query.Get());
+    PendingFrameFences.push_back({ FrameNumber, std::move(Query) });
+}
+
+uint64 FD3D11DynamicRHI::RHIGetRetiredFrameNumber()
+{
+    // 앞선 펜스부터 끝났는지 본다. 너무 많이 쌓였으면 가장 오래된 것을 기다린다
+    uint32 NumRetired = 0;
+    for (; NumRetired < PendingFrameFences.size(); ++NumRetired)
+    {
+        FFrameFence& Fence = PendingFrameFences[NumRetired];
+        const bool bMustWait = PendingFrameFences.size() - NumRetired > RHIMaxGpuFramesInFlight;
+        HRESULT Result = Context->GetData(Fence.Query.Get(), nullptr, 0, bMustWait ? 0 : D3D11_ASYNC_GETDATA_DONOTFLUSH);
+        while (bMustWait && Result == S_FALSE)
+        {
+            std::this_thread::yield();
+            Result = Context->GetData(Fence.Query.Get(), nullptr, 0, 0);
+        }
+
+        // 디바이스 제거 같은 실패는 끝난 것으로 본다. GPU는 더 이상 아무것도 읽지 않는다
+        if (Result == S_FALSE)
+        {
+            break;
+        }
+        RetiredFrameNumber = std::max(RetiredFrameNumber, Fence.FrameNumber);
+        FreeFrameFenceQueries.push_back(std::move(Fence.Query));
+    }
+    PendingFrameFences.erase(PendingFrameFences.begin(), PendingFrameFences.begin() + NumRetired);
+
+    return RetiredFrameNumber;
+}
+
+bool FD3D11DynamicRHI::EnsureDynamicBuffer(Microsoft::WRL::ComPtr<ID3D11Buffer>& Buffer, uint32& BufferSize, uint32 Size, UINT BindFlags)
+{
+    if (Buffer && BufferSize >= Size)
+    {
+        return true;
+    }
+
+    // 자주 다시 만들지 않도록 두 배씩 키운다
+    uint32 NewSize = BufferSize > 0 ? BufferSize : 256;
+    while (NewSize < Size)
+    {
+        NewSize *= 2;
+    }
+
+    D3D11_BUFFER_DESC Desc = {};
+    Desc.ByteWidth = NewSize;
+    Desc.Usage = D3D11_USAGE_DYNAMIC;
+    Desc.BindFlags = BindFlags;
+    Desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    Buffer.Reset();
+    BufferSize = 0;
+    if (FAILED(Device->CreateBuffer(&Desc, nullptr, Buffer.GetAddressOf())))
+    {
+        return false;
+    }
+    BufferSize = NewSize;
+    return true;
+}
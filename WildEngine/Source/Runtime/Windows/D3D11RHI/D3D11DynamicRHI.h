@@ -0,0 +1,100 @@
+﻿/*=============================================================================
+    D3D11DynamicRHI.h: D3D11 implementation of the dynamic RHI.
+=============================================================================*/
+
+#pragma once
+
+#include <d3d11_1.h>
+#include <wrl/client.h>
+
+#include "DynamicRHI.h"
+#include "D3D11BufferRing.h"
+#include "D3D11Resources.h"
+#include "D3D11State.h"
+
+/**
+ * The D3D11 RHI, on top of the device and immediate context URenderer created.
+ *
+ * Buffers it creates are FD3D11VertexBuffers; D3D11 specific passes get the
+ * ID3D11Buffer back with ResourceCast.
+ *
+ * With the D3D 11.1 constant buffer offsetting feature, shader constants are
+ * appended to one constant ring with Map(NO_OVERWRITE) and bound by offset
+ * (VSSetConstantBuffers1), so a frame of per-draw updates never renames a
+ * buffer. Without it each slot has its own dynamic constant buffer,
+ * rewritten with Map(DISCARD).
+ */
+class FD3D11DynamicRHI : public FDynamicRHI
+{
+public:
+    FD3D11DynamicRHI(ID3D11Device* InDevice, ID3D11DeviceContext* InContext);
+
+    template<typename TRHIType>
+    static typename TD3D11ResourceTraits<TRHIType>::TConcreteType* ResourceCast(TRHIType* Resource)
+    {
+        return static_cast<typename TD3D11ResourceTraits<TRHIType>::TConcreteType*>(Resource);
+    }
+
+    void Init() override {}
+    void Shutdown() override;
+    const char* GetName() const override { return "D3D11"; }
+
+    FRHIVertexBuffer* RHICreateVertexBuffer(const void* Data, uint32 Size, uint32 InUsage) override;
+    FRHIVertexBuffer* RHIAllocVertexBuffer(uint32 Size, uint32 InUsage) override;
+    void RHIInitVertexBuffer(FRHIVertexBuffer* VertexBuffer, const void* Data) override;
+    void RHIUpdateVertexBuffer(FRHIVertexBuffer* VertexBuffer, uint32 Offset, const void* Data, uint32 Size) override;
+    FRHITexture2D* RHICreateTexture2D(uint32 SizeX, uint32 SizeY, EPixelFormat Format, uint32 Flags) override;
+    void RHISetShaderConstants(uint32 BufferIndex, const void* Data, uint32 NumBytes) override;
+    void RHISetStreamSource(uint32 StreamIndex, FRHIVertexBuffer* VertexBuffer, uint32 Stride, uint32 Offset) override;
+    void RHISetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer) override;
+    void RHIDrawPrimitive(EPrimitiveType PrimitiveType, uint32 BaseVertexIndex, uint32 NumPrimitives, uint32 NumInstances) override;
+    void RHIDrawPrimitiveUP(EPrimitiveType PrimitiveType, uint32 NumPrimitives, const void* VertexData, uint32 VertexDataStride) override;
+    void RHIBeginFrame() override {}
+    void RHIEndFrame() override;
+
+    /** Ends a D3D11_QUERY_EVENT after the frame's commands; the frame retires once the GPU passed it. */
+    void RHISignalFrameFence(uint64 FrameNumber) override;
+    uint64 RHIGetRetiredFrameNumber() override;
+
+private:
+    /** Bytes per constant ring slot; the offset granularity of VSSetConstantBuffers1 (16 constants). */
+    static constexpr uint32 ConstantRingSlotSize = 256;
+
+    /** Creates the constant ring when the device can offset and NO_OVERWRITE constant buffers. */
+    bool InitConstantRing();
+
+    /** Grows Buffer to at least Size bytes of a dynamic buffer bound as BindFlags. */
+    bool EnsureDynamicBuffer(Microsoft::WRL::ComPtr<ID3D11Buffer>& Buffer, uint32& BufferSize, uint32 Size, UINT BindFlags);
+
+private:
+    ID3D11Device* Device;
+    ID3D11DeviceContext* Context;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> ConstantBuffers[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+    uint32 ConstantBufferSizes[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT] = {};
+
+    /** Constant ring and the 11.1 context binding it by offset; unset without the feature. */
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext1> Context1;
+    FD3D11BufferRing ConstantRing;
+
+    /** Depth stencil states of RHISetDepthStencilState, one per distinct initializer. */
+    FD3D11StateObjectCache StateObjects;
+
+    /** Transient vertices of RHIDrawPrimitiveUP. */
+    Microsoft::WRL::ComPtr<ID3D11Buffer> UPVertexBuffer;
+    uint32 UPVertexBufferSize = 0;
+
+    struct FFrameFence
+    {
+        uint64 FrameNumber;
+        Microsoft::WRL::ComPtr<ID3D11Query> Query;
+    };
+
+    /** Signaled frames the GPU may not have finished, oldest first. */
+    TArray<FFrameFence> PendingFrameFences;
+
+    /** Event queries of retired frames, reused by the next fences. */
+    TArray<Microsoft::WRL::ComPtr<ID3D11Query>> FreeFrameFenceQueries;
+
+    uint64 RetiredFrameNumber = 0;
+};
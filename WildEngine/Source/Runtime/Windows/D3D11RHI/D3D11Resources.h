@@ -3,6 +3,7 @@
 #include "D3D11Shader.h"
 #include "GraphicType.h"
 #include "HAL/Platform.h"
+#include "RHI.h"
 
 class FD3D11VertexShader : public FD3D11Shader
 {
@@ -71,7 +72,7 @@ public:
 
 
 /** Index buffer resource class that stores stride information. */
-class FD3D11IndexBuffer
+class FD3D11IndexBuffer : public FRHIIndexBuffer
 {
 public:
 
@@ -79,60 +80,83 @@ public:
 	ID3D11Buffer* Resource;
 
 	FD3D11IndexBuffer(ID3D11Buffer* InResource, uint32 InStride, uint32 InSize, uint32 InUsage)
-	: Resource(InResource)
-	, Stride(InStride)
-	, Size(InSize)
-	, Usage(InUsage)
+	: FRHIIndexBuffer(InStride, InSize, InUsage)
+	, Resource(InResource)
 	{}
 
-	/** @return The stride in bytes of the index buffer; must be 2 or 4. */
-	uint32 GetStride() const { return Stride; }
-
-	/** @return The number of bytes in the index buffer. */
-	uint32 GetSize() const { return Size; }
-
-	/** @return The usage flags used to create the index buffer. */
-	uint32 GetUsage() const { return Usage; }
-
-	void Release() const
+	/** Runs from FRHIResource::FlushPendingDeletes, once no frame in flight uses the buffer. */
+	virtual ~FD3D11IndexBuffer()
 	{
-		Resource->Release();
+		if (Resource)
+		{
+			Resource->Release();
+		}
 	}
-	
-private:
-	uint32 Stride;
-	uint32 Size;
-	uint32 Usage;
 };
 
 
 /** Vertex buffer resource class. */
-class FD3D11VertexBuffer
+class FD3D11VertexBuffer : public FRHIVertexBuffer
 {
 public:
 
 	ID3D11Buffer* Resource;
 
 	FD3D11VertexBuffer(ID3D11Buffer* InResource, uint32 InSize, uint32 InUsage)
-	: Resource(InResource)
-	, Size(InSize)
-	, Usage(InUsage)
+	: FRHIVertexBuffer(InSize, InUsage)
+	, Resource(InResource)
 	{}
-	
-	/** @return The number of bytes in the index buffer. */
-	uint32 GetSize() const { return Size; }
 
-	/** @return The usage flags used to create the index buffer. */
-	uint32 GetUsage() const { return Usage; }
+	/** Runs from FRHIResource::FlushPendingDeletes, once no frame in flight uses the buffer. */
+	virtual ~FD3D11VertexBuffer()
+	{
+		if (Resource)
+		{
+			Resource->Release();
+		}
+	}
+};
+
+
+/** 2D texture resource class, with the views its creation flags asked for. */
+class FD3D11Texture2D : public FRHITexture2D
+{
+public:
+
+	ID3D11Texture2D* Resource;
+	ID3D11RenderTargetView* RenderTargetView;
+	ID3D11DepthStencilView* DepthStencilView;
+	ID3D11ShaderResourceView* ShaderResourceView;
+
+	FD3D11Texture2D(ID3D11Texture2D* InResource, ID3D11RenderTargetView* InRenderTargetView, ID3D11DepthStencilView* InDepthStencilView, ID3D11ShaderResourceView* InShaderResourceView,
+		uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, uint32 InFlags)
+	: FRHITexture2D(InSizeX, InSizeY, 1, 1, InFormat, InFlags)
+	, Resource(InResource)
+	, RenderTargetView(InRenderTargetView)
+	, DepthStencilView(InDepthStencilView)
+	, ShaderResourceView(InShaderResourceView)
+	{}
 
-	void Release() const
+	/** Runs from FRHIResource::FlushPendingDeletes, once no frame in flight uses the texture. */
+	virtual ~FD3D11Texture2D()
 	{
-		Resource->Release();
+		if (ShaderResourceView)
+		{
+			ShaderResourceView->Release();
+		}
+		if (DepthStencilView)
+		{
+			DepthStencilView->Release();
+		}
+		if (RenderTargetView)
+		{
+			RenderTargetView->Release();
+		}
+		if (Resource)
+		{
+			Resource->Release();
+		}
 	}
-	
-private:
-	uint32 Size;
-	uint32 Usage;
 };
 
 
@@ -145,4 +169,25 @@ public:
 	FD3D11ShaderResourceView(ID3D11ShaderResourceView* InView)
 	: View(InView)
 	{}
-};
\ No newline at end of file
+};
+
+
+template<class T>
+struct TD3D11ResourceTraits
+{
+};
+template<>
+struct TD3D11ResourceTraits<FRHIIndexBuffer>
+{
+	typedef FD3D11IndexBuffer TConcreteType;
+};
+template<>
+struct TD3D11ResourceTraits<FRHIVertexBuffer>
+{
+	typedef FD3D11VertexBuffer TConcreteType;
+};
+template<>
+struct TD3D11ResourceTraits<FRHITexture2D>
+{
+	typedef FD3D11Texture2D TConcreteType;
+};
@@ -0,0 +1,351 @@
+﻿/*=============================================================================
+    D3D11State.cpp: D3D state implementation.
+=============================================================================*/
+
+#include "D3D11State.h"
+
+#include <cmath>
+
+namespace
+{
+    D3D11_TEXTURE_ADDRESS_MODE TranslateAddressMode(ESamplerAddressMode AddressMode)
+    {
+        switch (AddressMode)
+        {
+        case AM_Clamp:  return D3D11_TEXTURE_ADDRESS_CLAMP;
+        case AM_Mirror: return D3D11_TEXTURE_ADDRESS_MIRROR;
+        case AM_Border: return D3D11_TEXTURE_ADDRESS_BORDER;
+        default:        return D3D11_TEXTURE_ADDRESS_WRAP;
+        }
+    }
+
+    D3D11_CULL_MODE TranslateCullMode(ERasterizerCullMode CullMode)
+    {
+        switch (CullMode)
+        {
+        case CM_CW:  return D3D11_CULL_BACK;
+        case CM_CCW: return D3D11_CULL_FRONT;
+        default:     return D3D11_CULL_NONE;
+        }
+    }
+
+    D3D11_FILL_MODE TranslateFillMode(ERasterizerFillMode FillMode)
+    {
+        // D3D11에는 점 채우기가 없다
+        return FillMode == FM_Solid ? D3D11_FILL_SOLID : D3D11_FILL_WIREFRAME;
+    }
+
+    D3D11_COMPARISON_FUNC TranslateCompareFunction(ECompareFunction CompareFunction)
+    {
+        switch (CompareFunction)
+        {
+        case CF_Less:         return D3D11_COMPARISON_LESS;
+        case CF_LessEqual:    return D3D11_COMPARISON_LESS_EQUAL;
+        case CF_Greater:      return D3D11_COMPARISON_GREATER;
+        case CF_GreaterEqual: return D3D11_COMPARISON_GREATER_EQUAL;
+        case CF_Equal:        return D3D11_COMPARISON_EQUAL;
+        case CF_NotEqual:     return D3D11_COMPARISON_NOT_EQUAL;
+        case CF_Never:        return D3D11_COMPARISON_NEVER;
+        default:              return D3D11_COMPARISON_ALWAYS;
+        }
+    }
+
+    D3D11_COMPARISON_FUNC TranslateSamplerCompareFunction(ESamplerCompareFunction SamplerComparisonFunction)
+    {
+        return SamplerComparisonFunction == SCF_Less ? D3D11_COMPARISON_LESS : D3D11_COMPARISON_NEVER;
+    }
+
+    D3D11_STENCIL_OP TranslateStencilOp(EStencilOp StencilOp)
+    {
+        switch (StencilOp)
+        {
+        case SO_Zero:               return D3D11_STENCIL_OP_ZERO;
+        case SO_Replace:            return D3D11_STENCIL_OP_REPLACE;
+        case SO_SaturatedIncrement: return D3D11_STENCIL_OP_INCR_SAT;
+        case SO_SaturatedDecrement: return D3D11_STENCIL_OP_DECR_SAT;
+        case SO_Invert:             return D3D11_STENCIL_OP_INVERT;
+        case SO_Increment:          return D3D11_STENCIL_OP_INCR;
+        case SO_Decrement:          return D3D11_STENCIL_OP_DECR;
+        default:                    return D3D11_STENCIL_OP_KEEP;
+        }
+    }
+
+    D3D11_BLEND_OP TranslateBlendOp(EBlendOperation BlendOp)
+    {
+        switch (BlendOp)
+        {
+        case BO_Subtract:        return D3D11_BLEND_OP_SUBTRACT;
+        case BO_Min:             return D3D11_BLEND_OP_MIN;
+        case BO_Max:             return D3D11_BLEND_OP_MAX;
+        case BO_ReverseSubtract: return D3D11_BLEND_OP_REV_SUBTRACT;
+        default:                 return D3D11_BLEND_OP_ADD;
+        }
+    }
+
+    D3D11_BLEND TranslateBlendFactor(EBlendFactor BlendFactor)
+    {
+        switch (BlendFactor)
+        {
+        case BF_One:                        return D3D11_BLEND_ONE;
+        case BF_SourceColor:                return D3D11_BLEND_SRC_COLOR;
+        case BF_InverseSourceColor:         return D3D11_BLEND_INV_SRC_COLOR;
+        case BF_SourceAlpha:                return D3D11_BLEND_SRC_ALPHA;
+        case BF_InverseSourceAlpha:         return D3D11_BLEND_INV_SRC_ALPHA;
+        case BF_DestAlpha:                  return D3D11_BLEND_DEST_ALPHA;
+        case BF_InverseDestAlpha:           return D3D11_BLEND_INV_DEST_ALPHA;
+        case BF_DestColor:                  return D3D11_BLEND_DEST_COLOR;
+        case BF_InverseDestColor:           return D3D11_BLEND_INV_DEST_COLOR;
+        case BF_ConstantBlendFactor:        return D3D11_BLEND_BLEND_FACTOR;
+        case BF_InverseConstantBlendFactor: return D3D11_BLEND_INV_BLEND_FACTOR;
+        default:                            return D3D11_BLEND_ZERO;
+        }
+    }
+
+    D3D11_FILTER TranslateFilter(const FSamplerStateInitializerRHI& Initializer)
+    {
+        const bool bComparison = Initializer.SamplerComparisonFunction != SCF_Never;
+        switch (Initializer.Filter)
+        {
+        case SF_AnisotropicPoint:
+        case SF_AnisotropicLinear:
+            if (Initializer.MaxAnisotropy > 1)
+            {
+                return bComparison ? D3D11_FILTER_COMPARISON_ANISOTROPIC : D3D11_FILTER_ANISOTROPIC;
+            }
+            return bComparison ? D3D11_FILTER_COMPARISON_MIN_MAG_MIP_LINEAR : D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+        case SF_Trilinear:
+            return bComparison ? D3D11_FILTER_COMPARISON_MIN_MAG_MIP_LINEAR : D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+        case SF_Bilinear:
+            return bComparison ? D3D11_FILTER_COMPARISON_MIN_MAG_LINEAR_MIP_POINT : D3D11_FILTER_MIN_MAG_LINEAR_MIP_POINT;
+        default:
+            return bComparison ? D3D11_FILTER_COMPARISON_MIN_MAG_MIP_POINT : D3D11_FILTER_MIN_MAG_MIP_POINT;
+        }
+    }
+}
+
+FD3D11StateObjectCache::FD3D11StateObjectCache(ID3D11Device* InDevice)
+    : Device(InDevice)
+{
+}
+
+FD3D11StateObjectCache::~FD3D11StateObjectCache()
+{
+    Empty();
+}
+
+void FD3D11StateObjectCache::Empty()
+{
+    for (auto& Pair : SamplerStates)
+    {
+        Pair.second->Resource->Release();
+    }
+    for (auto& Pair : RasterizerStates)
+    {
+        Pair.second->Resource->Release();
+    }
+    for (auto& Pair : DepthStencilStates)
+    {
+        Pair.second->Resource->Release();
+    }
+    for (auto& Pair : BlendStates)
+    {
+        Pair.second->Resource->Release();
+    }
+    SamplerStates.clear();
+    RasterizerStates.clear();
+    DepthStencilStates.clear();
+    BlendStates.clear();
+}
+
+FD3D11SamplerState* FD3D11StateObjectCache::GetSamplerState(const FSamplerStateInitializerRHI& Initializer)
+{
+    ++Stats.NumLookups;
+    auto Found = SamplerStates.find(Initializer);
+    if (Found != SamplerStates.end())
+    {
+        return Found->second.get();
+    }
+
+    D3D11_SAMPLER_DESC Desc = {};
+    Desc.Filter = TranslateFilter(Initializer);
+    Desc.AddressU = TranslateAddressMode(Initializer.AddressU);
+    Desc.AddressV = TranslateAddressMode(Initializer.AddressV);
+    Desc.AddressW = TranslateAddressMode(Initializer.AddressW);
+    Desc.MipLODBias = Initializer.MipBias;
+    Desc.MaxAnisotropy = Initializer.MaxAnisotropy > 1 ? Initializer.MaxAnisotropy : 1;
+    Desc.ComparisonFunc = TranslateSamplerCompareFunction(Initializer.SamplerComparisonFunction);
+    Desc.BorderColor[0] = ((Initializer.BorderColor >> 16) & 0xFF) / 255.0f;
+    Desc.BorderColor[1] = ((Initializer.BorderColor >> 8) & 0xFF) / 255.0f;
+    Desc.BorderColor[2] = (Initializer.BorderColor & 0xFF) / 255.0f;
+    Desc.BorderColor[3] = ((Initializer.BorderColor >> 24) & 0xFF) / 255.0f;
+    Desc.MinLOD = Initializer.MinMipLevel;
+    Desc.MaxLOD = Initializer.MaxMipLevel;
+
+    ID3D11SamplerState* Resource = nullptr;
+    if (FAILED(Device->CreateSamplerState(&Desc, &Resource)))
+    {
+        return nullptr;
+    }
+
+    ++Stats.NumCreated;
+    std::unique_ptr<FD3D11SamplerState> State = std::make_unique<FD3D11SamplerState>();
+    State->Resource = Resource;
+    return (SamplerStates[Initializer] = std::move(State)).get();
+}
+
+FD3D11RasterizerState* FD3D11StateObjectCache::GetRasterizerState(const FRasterizerStateInitializerRHI& Initializer)
+{
+    ++Stats.NumLookups;
+    auto Found = RasterizerStates.find(Initializer);
+    if (Found != RasterizerStates.end())
+    {
+        return Found->second.get();
+    }
+
+    D3D11_RASTERIZER_DESC Desc = {};
+    Desc.FillMode = TranslateFillMode(Initializer.FillMode);
+    Desc.CullMode = TranslateCullMode(Initializer.CullMode);
+    // 24비트 깊이 버퍼 기준 정수 바이어스
+    Desc.DepthBias = static_cast<INT>(std::floor(Initializer.DepthBias * static_cast<float>(1 << 24)));
+    Desc.SlopeScaledDepthBias = Initializer.SlopeScaleDepthBias;
+    Desc.DepthClipEnable = TRUE;
+    Desc.MultisampleEnable = Initializer.bAllowMSAA;
+    Desc.AntialiasedLineEnable = Initializer.bEnableLineAA;
+
+    ID3D11RasterizerState* Resource = nullptr;
+    if (FAILED(Device->CreateRasterizerState(&Desc, &Resource)))
+    {
+        return nullptr;
+    }
+
+    ++Stats.NumCreated;
+    std::unique_ptr<FD3D11RasterizerState> State = std::make_unique<FD3D11RasterizerState>();
+    State->Resource = Resource;
+    return (RasterizerStates[Initializer] = std::move(State)).get();
+}
+
+FD3D11DepthStencilState* FD3D11StateObjectCache::GetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer)
+{
+    ++Stats.NumLookups;
+    auto Found = DepthStencilStates.find(Initializer);
+    if (Found != DepthStencilStates.end())
+    {
+        return Found->second.get();
+    }
+
+    D3D11_DEPTH_STENCIL_DESC Desc = {};
+    Desc.DepthEnable = Initializer.DepthTest != CF_Always || Initializer.bEnableDepthWrite;
+    Desc.DepthWriteMask = Initializer.bEnableDepthWrite ? D3D11_DEPTH_WRITE_MASK_ALL : D3D11_DEPTH_WRITE_MASK_ZERO;
+    Desc.DepthFunc = TranslateCompareFunction(Initializer.DepthTest);
+
+    Desc.StencilEnable = Initializer.bEnableFrontFaceStencil || Initializer.bEnableBackFaceStencil;
+    Desc.StencilReadMask = Initializer.StencilReadMask;
+    Desc.StencilWriteMask = Initializer.StencilWriteMask;
+    Desc.FrontFace.StencilFunc = TranslateCompareFunction(Initializer.FrontFaceStencilTest);
+    Desc.FrontFace.StencilFailOp = TranslateStencilOp(Initializer.FrontFaceStencilFailStencilOp);
+    Desc.FrontFace.StencilDepthFailOp = TranslateStencilOp(Initializer.FrontFaceDepthFailStencilOp);
+    Desc.FrontFace.StencilPassOp = TranslateStencilOp(Initializer.FrontFacePassStencilOp);
+    if (Initializer.bEnableBackFaceStencil)
+    {
+        Desc.BackFace.StencilFunc = TranslateCompareFunction(Initializer.BackFaceStencilTest);
+        Desc.BackFace.StencilFailOp = TranslateStencilOp(Initializer.BackFaceStencilFailStencilOp);
+        Desc.BackFace.StencilDepthFailOp = TranslateStencilOp(Initializer.BackFaceDepthFailStencilOp);
+        Desc.BackFace.StencilPassOp = TranslateStencilOp(Initializer.BackFacePassStencilOp);
+    }
+    else
+    {
+        Desc.BackFace = Desc.FrontFace;
+    }
+
+    ID3D11DepthStencilState* Resource = nullptr;
+    if (FAILED(Device->CreateDepthStencilState(&Desc, &Resource)))
+    {
+        return nullptr;
+    }
+
+    ++Stats.NumCreated;
+    std::unique_ptr<FD3D11DepthStencilState> State = std::make_unique<FD3D11DepthStencilState>();
+    State->Resource = Resource;
+
+    // 스텐실을 쓰지 않으면 읽기 전용으로 볼 수 있다
+    const bool bStencilWrites = Desc.StencilEnable && Initializer.StencilWriteMask != 0;
+    const uint32 AccessType = (Initializer.bEnableDepthWrite ? 0u : static_cast<uint32>(DSAT_ReadOnlyDepth))
+        | (bStencilWrites ? 0u : static_cast<uint32>(DSAT_ReadOnlyStencil));
+    State->AccessType = static_cast<EDepthStencilAccessType>(AccessType);
+
+    return (DepthStencilStates[Initializer] = std::move(State)).get();
+}
+
+FD3D11BlendState* FD3D11StateObjectCache::GetBlendState(const FBlendStateInitializerRHI& Initializer)
+{
+    ++Stats.NumLookups;
+    auto Found = BlendStates.find(Initializer);
+    if (Found != BlendStates.end())
+    {
+        return Found->second.get();
+    }
+
+    D3D11_BLEND_DESC Desc = {};
+    Desc.AlphaToCoverageEnable = FALSE;
+    Desc.IndependentBlendEnable = Initializer.bUseIndependentRenderTargetBlendStates;
+    for (uint32 Index = 0; Index < MaxSimultaneousRenderTargets; ++Index)
+    {
+        const FBlendStateInitializerRHI::FRenderTarget& Target = Initializer.RenderTargets[Initializer.bUseIndependentRenderTargetBlendStates ? Index : 0];
+        D3D11_RENDER_TARGET_BLEND_DESC& TargetDesc = Desc.RenderTarget[Index];
+
+        // One/Zero/Add 는 블렌딩을 끈 것과 같다
+        TargetDesc.BlendEnable =
+            Target.ColorBlendOp != BO_Add || Target.ColorSrcBlend != BF_One || Target.ColorDestBlend != BF_Zero ||
+            Target.AlphaBlendOp != BO_Add || Target.AlphaSrcBlend != BF_One || Target.AlphaDestBlend != BF_Zero;
+        TargetDesc.BlendOp = TranslateBlendOp(Target.ColorBlendOp);
+        TargetDesc.SrcBlend = TranslateBlendFactor(Target.ColorSrcBlend);
+        TargetDesc.DestBlend = TranslateBlendFactor(Target.ColorDestBlend);
+        TargetDesc.BlendOpAlpha = TranslateBlendOp(Target.AlphaBlendOp);
+        TargetDesc.SrcBlendAlpha = TranslateBlendFactor(Target.AlphaSrcBlend);
+        TargetDesc.DestBlendAlpha = TranslateBlendFactor(Target.AlphaDestBlend);
+        TargetDesc.RenderTargetWriteMask =
+            ((Target.ColorWriteMask & CW_RED) ? D3D11_COLOR_WRITE_ENABLE_RED : 0) |
+            ((Target.ColorWriteMask & CW_GREEN) ? D3D11_COLOR_WRITE_ENABLE_GREEN : 0) |
+            ((Target.ColorWriteMask & CW_BLUE) ? D3D11_COLOR_WRITE_ENABLE_BLUE : 0) |
+            ((Target.ColorWriteMask & CW_ALPHA) ? D3D11_COLOR_WRITE_ENABLE_ALPHA : 0);
+    }
+
+    ID3D11BlendState* Resource = nullptr;
+    if (FAILED(Device->CreateBlendState(&Desc, &Resource)))
+    {
+        return nullptr;
+    }
+
+    ++Stats.NumCreated;
+    std::unique_ptr<FD3D11BlendState> State = std::make_unique<FD3D11BlendState>();
+    State->Resource = Resource;
+    return (BlendStates[Initializer] = std::move(State)).get();
+}
+
+FD3D11StateScope::FD3D11StateScope(FD3D11StateCache& InStateCache)
+    : StateCache(InStateCache)
+{
+    ID3D11DeviceContext* Context = StateCache.GetContext();
+    Context->IAGetInputLayout(InputLayout.GetAddressOf());
+    Context->IAGetPrimitiveTopology(&Topology);
+    Context->VSGetShader(VertexShader.GetAddressOf(), nullptr, nullptr);
+    Context->PSGetShader(PixelShader.GetAddressOf(), nullptr, nullptr);
+    Context->VSGetConstantBuffers(0, 1, VSConstantBuffer.GetAddressOf());
+    Context->OMGetDepthStencilState(DepthStencilState.GetAddressOf(), &StencilRef);
+
+    // 렌더러와 다른 패스가 컨텍스트를 건드렸으므로 캐시는 모르는 상태에서 시작
+    StateCache.ClearCache();
+}
+
+FD3D11StateScope::~FD3D11StateScope()
+{
+    ID3D11DeviceContext* Context = StateCache.GetContext();
+    Context->IASetInputLayout(InputLayout.Get());
+    Context->IASetPrimitiveTopology(Topology);
+    Context->VSSetShader(VertexShader.Get(), nullptr, 0);
+    Context->PSSetShader(PixelShader.Get(), nullptr, 0);
+    Context->VSSetConstantBuffers(0, 1, VSConstantBuffer.GetAddressOf());
+    Context->OMSetDepthStencilState(DepthStencilState.Get(), StencilRef);
+
+    StateCache.ClearCache();
+}
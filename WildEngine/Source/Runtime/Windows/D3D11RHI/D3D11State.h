@@ -6,6 +6,13 @@
 
 #pragma once
 
+#include <d3d11.h>
+#include <memory>
+#include <wrl/client.h>
+
+#include "RHI.h"
+#include "D3D11StateCache.h"
+
 class FD3D11SamplerState : public FRHISamplerState
 {
 public:
@@ -46,3 +53,100 @@ public:
     ID3D11BlendState* Resource;
 };
 
+/** Lookups and creations done by a state object cache. */
+struct FD3D11StateObjectCacheStats
+{
+    uint32 NumLookups = 0;
+    uint32 NumCreated = 0;
+};
+
+/**
+ * Creates D3D11 state objects from RHI initializers, one per distinct initializer.
+ *
+ * Initializers are hashed (GetTypeHash), so asking for a state that already
+ * exists is a map lookup and returns the same object; the device is only
+ * called the first time a combination is seen. Objects live until Empty or
+ * destruction, which must not happen while the GPU may still use them.
+ */
+class FD3D11StateObjectCache
+{
+public:
+    explicit FD3D11StateObjectCache(ID3D11Device* InDevice = nullptr);
+    FD3D11StateObjectCache(const FD3D11StateObjectCache&) = delete;
+    FD3D11StateObjectCache& operator=(const FD3D11StateObjectCache&) = delete;
+    ~FD3D11StateObjectCache();
+
+    void SetDevice(ID3D11Device* InDevice) { Device = InDevice; }
+
+    /** @return The state for Initializer, created on first use; nullptr if the device rejects it. */
+    FD3D11SamplerState* GetSamplerState(const FSamplerStateInitializerRHI& Initializer);
+    FD3D11RasterizerState* GetRasterizerState(const FRasterizerStateInitializerRHI& Initializer);
+    FD3D11DepthStencilState* GetDepthStencilState(const FDepthStencilStateInitializerRHI& Initializer);
+    FD3D11BlendState* GetBlendState(const FBlendStateInitializerRHI& Initializer);
+
+    /** Releases every cached state object. */
+    void Empty();
+
+    uint32 Num() const { return static_cast<uint32>(SamplerStates.size() + RasterizerStates.size() + DepthStencilStates.size() + BlendStates.size()); }
+    const FD3D11StateObjectCacheStats& GetStats() const { return Stats; }
+
+private:
+    ID3D11Device* Device;
+
+    TMap<FSamplerStateInitializerRHI, std::unique_ptr<FD3D11SamplerState>> SamplerStates;
+    TMap<FRasterizerStateInitializerRHI, std::unique_ptr<FD3D11RasterizerState>> RasterizerStates;
+    TMap<FDepthStencilStateInitializerRHI, std::unique_ptr<FD3D11DepthStencilState>> DepthStencilStates;
+    TMap<FBlendStateInitializerRHI, std::unique_ptr<FD3D11BlendState>> BlendStates;
+
+    FD3D11StateObjectCacheStats Stats;
+};
+
+/** The D3D11 types TD3D11StateCache binds through a device context. */
+struct FD3D11StateCacheTypes
+{
+    using FContext = ID3D11DeviceContext;
+    using FBuffer = ID3D11Buffer;
+    using FInputLayout = ID3D11InputLayout;
+    using FVertexShader = ID3D11VertexShader;
+    using FPixelShader = ID3D11PixelShader;
+    using FRasterizerState = ID3D11RasterizerState;
+    using FBlendState = ID3D11BlendState;
+    using FDepthStencilState = ID3D11DepthStencilState;
+    using FFormat = DXGI_FORMAT;
+    using FTopology = D3D11_PRIMITIVE_TOPOLOGY;
+};
+
+using FD3D11StateCache = TD3D11StateCache<FD3D11StateCacheTypes>;
+
+/**
+ * Lets a pass bind its own pipeline through a state cache and puts back what
+ * was bound before it when the scope ends.
+ *
+ * Saves the input layout, topology, vertex and pixel shader, vertex shader
+ * constant buffer 0 and depth stencil state URenderer and earlier passes left
+ * on the context. The cache is cleared on entry, since that code bound around
+ * it, and again on exit, since the restore bypasses it.
+ */
+class FD3D11StateScope
+{
+public:
+    explicit FD3D11StateScope(FD3D11StateCache& InStateCache);
+    FD3D11StateScope(const FD3D11StateScope&) = delete;
+    FD3D11StateScope& operator=(const FD3D11StateScope&) = delete;
+    ~FD3D11StateScope();
+
+    /** The depth stencil state bound on entry, for passes that switch away from it per draw. */
+    ID3D11DepthStencilState* GetSavedDepthStencilState() const { return DepthStencilState.Get(); }
+    uint32 GetSavedStencilRef() const { return StencilRef; }
+
+private:
+    FD3D11StateCache& StateCache;
+
+    Microsoft::WRL::ComPtr<ID3D11InputLayout> InputLayout;
+    Microsoft::WRL::ComPtr<ID3D11VertexShader> VertexShader;
+    Microsoft::WRL::ComPtr<ID3D11PixelShader> PixelShader;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> VSConstantBuffer;
+    Microsoft::WRL::ComPtr<ID3D11DepthStencilState> DepthStencilState;
+    UINT StencilRef = 0;
+    D3D11_PRIMITIVE_TOPOLOGY Topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+};
@@ -0,0 +1,273 @@
+﻿/*=============================================================================
+    D3D11StateCache.h: Shadow copy of the pipeline state bound on a D3D11 context.
+=============================================================================*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "HAL/PlatformTypes.h"
+
+/** Set calls seen by a state cache and how many of them reached the context. */
+struct FD3D11StateCacheStats
+{
+    uint32 NumSetCalls = 0;
+    uint32 NumSetCallsSkipped = 0;
+
+    uint32 GetNumSetCallsForwarded() const { return NumSetCalls - NumSetCallsSkipped; }
+};
+
+/**
+ * Sits in front of a device context and drops set calls that would bind
+ * what is already bound: vertex and index buffers, input layout, topology,
+ * vertex/pixel shaders and constant buffers, rasterizer, blend and
+ * depth stencil state. With sorted draws most binds are repeats, and each
+ * one that reaches the context costs a runtime and driver call.
+ *
+ * Types names the context and the object and enum types it binds; in the
+ * engine that is FD3D11StateCacheTypes (D3D11State.h), giving FD3D11StateCache.
+ * The header itself includes no D3D11 or Windows header, so the cache logic
+ * can be tested against a recording mock context without a device
+ * (Tests/D3D11StateCacheTests.cpp).
+ *
+ * The shadow copy is only right while every bind goes through the cache.
+ * Call ClearCache after anything else (URenderer, ImGui, state save/restore)
+ * touched the context; the next set of each kind is then forwarded.
+ */
+template<typename Types>
+class TD3D11StateCache
+{
+public:
+    using ContextType = typename Types::FContext;
+    using FBuffer = typename Types::FBuffer;
+    using FInputLayout = typename Types::FInputLayout;
+    using FVertexShader = typename Types::FVertexShader;
+    using FPixelShader = typename Types::FPixelShader;
+    using FRasterizerState = typename Types::FRasterizerState;
+    using FBlendState = typename Types::FBlendState;
+    using FDepthStencilState = typename Types::FDepthStencilState;
+    using FFormat = typename Types::FFormat;
+    using FTopology = typename Types::FTopology;
+
+    static constexpr uint32 MaxVertexStreams = 16;
+    static constexpr uint32 MaxConstantBuffers = 14; // D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT
+
+    explicit TD3D11StateCache(ContextType* InContext = nullptr)
+        : Context(InContext)
+    {
+        ClearCache();
+    }
+
+    void SetContext(ContextType* InContext)
+    {
+        Context = InContext;
+        ClearCache();
+    }
+
+    /** Forgets everything; the next set of every kind goes to the context. */
+    void ClearCache()
+    {
+        for (uint32 Slot = 0; Slot < MaxVertexStreams; ++Slot)
+        {
+            VertexBuffers[Slot] = { GetUnknown<FBuffer>(), 0, 0 };
+        }
+        IndexBuffer = GetUnknown<FBuffer>();
+        IndexFormat = UnknownValue;
+        IndexOffset = 0;
+        InputLayout = GetUnknown<FInputLayout>();
+        Topology = UnknownValue;
+        VertexShader = GetUnknown<FVertexShader>();
+        PixelShader = GetUnknown<FPixelShader>();
+        for (uint32 Slot = 0; Slot < MaxConstantBuffers; ++Slot)
+        {
+            VSConstantBuffers[Slot] = GetUnknown<FBuffer>();
+            PSConstantBuffers[Slot] = GetUnknown<FBuffer>();
+        }
+        RasterizerState = GetUnknown<FRasterizerState>();
+        BlendState = GetUnknown<FBlendState>();
+        for (float& Factor : BlendFactor)
+        {
+            Factor = -1.0f;
+        }
+        SampleMask = 0;
+        DepthStencilState = GetUnknown<FDepthStencilState>();
+        StencilRef = 0;
+    }
+
+    void SetStreamSource(uint32 Slot, FBuffer* Buffer, uint32 Stride, uint32 Offset)
+    {
+        FVertexStream& Stream = VertexBuffers[Slot];
+        if (ShouldSet(Stream.Buffer == Buffer && Stream.Stride == Stride && Stream.Offset == Offset))
+        {
+            Stream = { Buffer, Stride, Offset };
+            const uint32 D3DStride = Stride;
+            const uint32 D3DOffset = Offset;
+            Context->IASetVertexBuffers(Slot, 1, &Buffer, &D3DStride, &D3DOffset);
+        }
+    }
+
+    void SetIndexBuffer(FBuffer* Buffer, FFormat Format, uint32 Offset)
+    {
+        if (ShouldSet(IndexBuffer == Buffer && IndexFormat == static_cast<uint32>(Format) && IndexOffset == Offset))
+        {
+            IndexBuffer = Buffer;
+            IndexFormat = static_cast<uint32>(Format);
+            IndexOffset = Offset;
+            Context->IASetIndexBuffer(Buffer, Format, Offset);
+        }
+    }
+
+    void SetInputLayout(FInputLayout* InInputLayout)
+    {
+        if (ShouldSet(InputLayout == InInputLayout))
+        {
+            InputLayout = InInputLayout;
+            Context->IASetInputLayout(InInputLayout);
+        }
+    }
+
+    void SetPrimitiveTopology(FTopology InTopology)
+    {
+        if (ShouldSet(Topology == static_cast<uint32>(InTopology)))
+        {
+            Topology = static_cast<uint32>(InTopology);
+            Context->IASetPrimitiveTopology(InTopology);
+        }
+    }
+
+    void SetVertexShader(FVertexShader* Shader)
+    {
+        if (ShouldSet(VertexShader == Shader))
+        {
+            VertexShader = Shader;
+            Context->VSSetShader(Shader, nullptr, 0);
+        }
+    }
+
+    void SetPixelShader(FPixelShader* Shader)
+    {
+        if (ShouldSet(PixelShader == Shader))
+        {
+            PixelShader = Shader;
+            Context->PSSetShader(Shader, nullptr, 0);
+        }
+    }
+
+    void SetVSConstantBuffer(uint32 Slot, FBuffer* Buffer)
+    {
+        if (ShouldSet(VSConstantBuffers[Slot] == Buffer))
+        {
+            VSConstantBuffers[Slot] = Buffer;
+            Context->VSSetConstantBuffers(Slot, 1, &Buffer);
+        }
+    }
+
+    void SetPSConstantBuffer(uint32 Slot, FBuffer* Buffer)
+    {
+        if (ShouldSet(PSConstantBuffers[Slot] == Buffer))
+        {
+            PSConstantBuffers[Slot] = Buffer;
+            Context->PSSetConstantBuffers(Slot, 1, &Buffer);
+        }
+    }
+
+    /** For binds the cache cannot see (e.g. VSSetConstantBuffers1 with offsets): the slot's content is unknown from now on. */
+    void InvalidateVSConstantBuffer(uint32 Slot)
+    {
+        VSConstantBuffers[Slot] = GetUnknown<FBuffer>();
+    }
+
+    void SetRasterizerState(FRasterizerState* State)
+    {
+        if (ShouldSet(RasterizerState == State))
+        {
+            RasterizerState = State;
+            Context->RSSetState(State);
+        }
+    }
+
+    void SetBlendState(FBlendState* State, const float InBlendFactor[4], uint32 InSampleMask)
+    {
+        static const float DefaultBlendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        const float* Factor = InBlendFactor ? InBlendFactor : DefaultBlendFactor;
+        const bool bSameFactor = BlendFactor[0] == Factor[0] && BlendFactor[1] == Factor[1] && BlendFactor[2] == Factor[2] && BlendFactor[3] == Factor[3];
+        if (ShouldSet(BlendState == State && bSameFactor && SampleMask == InSampleMask))
+        {
+            BlendState = State;
+            for (uint32 Index = 0; Index < 4; ++Index)
+            {
+                BlendFactor[Index] = Factor[Index];
+            }
+            SampleMask = InSampleMask;
+            Context->OMSetBlendState(State, BlendFactor, InSampleMask);
+        }
+    }
+
+    void SetDepthStencilState(FDepthStencilState* State, uint32 InStencilRef)
+    {
+        if (ShouldSet(DepthStencilState == State && StencilRef == InStencilRef))
+        {
+            DepthStencilState = State;
+            StencilRef = InStencilRef;
+            Context->OMSetDepthStencilState(State, InStencilRef);
+        }
+    }
+
+    ContextType* GetContext() const { return Context; }
+
+    const FD3D11StateCacheStats& GetStats() const { return Stats; }
+    void ResetStats() { Stats = FD3D11StateCacheStats(); }
+
+private:
+    /** Enum values (format, topology) are shadowed as uint32 so they have room for an "unknown" value. */
+    static constexpr uint32 UnknownValue = ~0u;
+
+    /** Marker for "not known": never a real object, unlike nullptr which is a valid (unbound) state. */
+    template<typename T>
+    static T* GetUnknown()
+    {
+        return reinterpret_cast<T*>(~static_cast<uintptr_t>(0));
+    }
+
+    bool ShouldSet(bool bAlreadyBound)
+    {
+        ++Stats.NumSetCalls;
+        if (bAlreadyBound)
+        {
+            ++Stats.NumSetCallsSkipped;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    struct FVertexStream
+    {
+        FBuffer* Buffer;
+        uint32 Stride;
+        uint32 Offset;
+    };
+
+    ContextType* Context;
+
+    FVertexStream VertexBuffers[MaxVertexStreams];
+    FBuffer* IndexBuffer;
+    uint32 IndexFormat;
+    uint32 IndexOffset;
+    FInputLayout* InputLayout;
+    uint32 Topology;
+
+    FVertexShader* VertexShader;
+    FPixelShader* PixelShader;
+    FBuffer* VSConstantBuffers[MaxConstantBuffers];
+    FBuffer* PSConstantBuffers[MaxConstantBuffers];
+
+    FRasterizerState* RasterizerState;
+    FBlendState* BlendState;
+    float BlendFactor[4];
+    uint32 SampleMask;
+    FDepthStencilState* DepthStencilState;
+    uint32 StencilRef;
+
+    FD3D11StateCacheStats Stats;
+};
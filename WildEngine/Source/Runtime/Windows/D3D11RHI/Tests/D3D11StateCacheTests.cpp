@@ -0,0 +1,151 @@
+/*=============================================================================
+	D3D11StateCacheTests.cpp: TD3D11StateCache against a recording mock context.
+
+	Needs no device or Windows SDK. Build and run from Source/Runtime:
+		g++ -std=c++17 -ICore -IWindows/D3D11RHI Windows/D3D11RHI/Tests/D3D11StateCacheTests.cpp -o D3D11StateCacheTests && ./D3D11StateCacheTests
+	Exits with the number of failed checks.
+=============================================================================*/
+
+#include <string>
+#include <vector>
+
+#include "D3D11StateCache.h"
+#include "Tests/TestHarness.h"
+
+namespace
+{
+	struct FMockObject {};
+
+	enum EMockFormat { MockFormat_R16, MockFormat_R32 };
+	enum EMockTopology { MockTopology_TriangleList, MockTopology_LineList };
+
+	/** Records every call that reaches it, by name. */
+	class FMockContext
+	{
+	public:
+		void IASetVertexBuffers(uint32 Slot, uint32, FMockObject* const*, const uint32*, const uint32*) { Record("IASetVertexBuffers", Slot); }
+		void IASetIndexBuffer(FMockObject*, EMockFormat, uint32) { Record("IASetIndexBuffer"); }
+		void IASetInputLayout(FMockObject*) { Record("IASetInputLayout"); }
+		void IASetPrimitiveTopology(EMockTopology) { Record("IASetPrimitiveTopology"); }
+		void VSSetShader(FMockObject*, void*, uint32) { Record("VSSetShader"); }
+		void PSSetShader(FMockObject*, void*, uint32) { Record("PSSetShader"); }
+		void VSSetConstantBuffers(uint32 Slot, uint32, FMockObject* const*) { Record("VSSetConstantBuffers", Slot); }
+		void PSSetConstantBuffers(uint32 Slot, uint32, FMockObject* const*) { Record("PSSetConstantBuffers", Slot); }
+		void RSSetState(FMockObject*) { Record("RSSetState"); }
+		void OMSetBlendState(FMockObject*, const float*, uint32) { Record("OMSetBlendState"); }
+		void OMSetDepthStencilState(FMockObject*, uint32) { Record("OMSetDepthStencilState"); }
+
+		std::vector<std::string> Calls;
+
+	private:
+		void Record(const char* Name, uint32 Slot = 0)
+		{
+			Calls.push_back(std::string(Name) + "/" + std::to_string(Slot));
+		}
+	};
+
+	struct FMockStateCacheTypes
+	{
+		using FContext = FMockContext;
+		using FBuffer = FMockObject;
+		using FInputLayout = FMockObject;
+		using FVertexShader = FMockObject;
+		using FPixelShader = FMockObject;
+		using FRasterizerState = FMockObject;
+		using FBlendState = FMockObject;
+		using FDepthStencilState = FMockObject;
+		using FFormat = EMockFormat;
+		using FTopology = EMockTopology;
+	};
+
+	using FMockStateCache = TD3D11StateCache<FMockStateCacheTypes>;
+
+	/** Binds one of everything the cache shadows. */
+	void BindAll(FMockStateCache& Cache, FMockObject* Object, EMockTopology Topology)
+	{
+		static const float BlendFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		Cache.SetStreamSource(0, Object, 28, 0);
+		Cache.SetIndexBuffer(Object, MockFormat_R16, 0);
+		Cache.SetInputLayout(Object);
+		Cache.SetPrimitiveTopology(Topology);
+		Cache.SetVertexShader(Object);
+		Cache.SetPixelShader(Object);
+		Cache.SetVSConstantBuffer(0, Object);
+		Cache.SetPSConstantBuffer(0, Object);
+		Cache.SetRasterizerState(Object);
+		Cache.SetBlendState(Object, BlendFactor, 0xffffffff);
+		Cache.SetDepthStencilState(Object, 0);
+	}
+
+	void TestRedundantBindsAreSkipped()
+	{
+		FMockContext Context;
+		FMockStateCache Cache(&Context);
+		FMockObject Object;
+
+		BindAll(Cache, &Object, MockTopology_TriangleList);
+		const size_t NumFirstCalls = Context.Calls.size();
+		Check(NumFirstCalls == 11, "first bind of every kind reaches the context");
+
+		BindAll(Cache, &Object, MockTopology_TriangleList);
+		Check(Context.Calls.size() == NumFirstCalls, "binding the same state again reaches the context no more");
+		Check(Cache.GetStats().NumSetCalls == 22 && Cache.GetStats().NumSetCallsSkipped == 11, "stats count the skipped binds");
+
+		// null은 알 수 없는 상태가 아니라 유효한 상태다
+		FMockContext NullContext;
+		FMockStateCache NullCache(&NullContext);
+		NullCache.SetVertexShader(nullptr);
+		NullCache.SetVertexShader(nullptr);
+		Check(NullContext.Calls.size() == 1, "unbinding is forwarded once, then skipped");
+	}
+
+	void TestChangedBindsAreForwarded()
+	{
+		FMockContext Context;
+		FMockStateCache Cache(&Context);
+		FMockObject First;
+		FMockObject Second;
+
+		BindAll(Cache, &First, MockTopology_TriangleList);
+		Context.Calls.clear();
+
+		BindAll(Cache, &Second, MockTopology_LineList);
+		Check(Context.Calls.size() == 11, "binding different objects reaches the context for every kind");
+
+		Context.Calls.clear();
+		Cache.SetStreamSource(0, &Second, 28, 64);
+		Cache.SetStreamSource(1, &Second, 28, 64);
+		Cache.SetVSConstantBuffer(1, &Second);
+		Cache.SetDepthStencilState(&Second, 1);
+		Check(Context.Calls.size() == 4, "changed offsets, other slots and stencil ref are forwarded");
+		Check(!Context.Calls.empty() && Context.Calls[1] == "IASetVertexBuffers/1", "the slot that changed is the one bound");
+	}
+
+	void TestClearCacheInvalidates()
+	{
+		FMockContext Context;
+		FMockStateCache Cache(&Context);
+		FMockObject Object;
+
+		BindAll(Cache, &Object, MockTopology_TriangleList);
+		Context.Calls.clear();
+
+		Cache.ClearCache();
+		BindAll(Cache, &Object, MockTopology_TriangleList);
+		Check(Context.Calls.size() == 11, "after ClearCache the same state is bound again");
+
+		Context.Calls.clear();
+		Cache.InvalidateVSConstantBuffer(0);
+		BindAll(Cache, &Object, MockTopology_TriangleList);
+		Check(Context.Calls.size() == 1 && Context.Calls[0] == "VSSetConstantBuffers/0", "invalidating a constant slot forwards only that slot");
+	}
+}
+
+int main()
+{
+	TestRedundantBindsAreSkipped();
+	TestChangedBindsAreForwarded();
+	TestClearCacheInvalidates();
+
+	return ReportTestResults("D3D11StateCacheTests");
+}
@@ -1,11 +1,11 @@
 ﻿#include "Window.h"
-#include "LaunchEngineLoop.h"
+#include "WindowsApplication.h"
 
 namespace
 {
-    static LaunchEngineLoop* GetApplication(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+    static FWindowsApplication* GetApplication(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
     {
-        LaunchEngineLoop* App;
+        FWindowsApplication* App;
         
         if (uMsg == WM_NCCREATE)
         {
@@ -15,7 +15,7 @@ namespace
         }
         else
         {
-            App = reinterpret_cast<LaunchEngineLoop*>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
+            App = reinterpret_cast<FWindowsApplication*>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
         }
 
         return App;
@@ -24,7 +24,7 @@ namespace
     LRESULT CALLBACK MainWndProc(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
     {
         // Application handling
-        LaunchEngineLoop* App = GetApplication(hWnd, Msg, wParam, lParam);
+        FWindowsApplication* App = GetApplication(hWnd, Msg, wParam, lParam);
         if (App == nullptr)
         {
             return DefWindowProc(hWnd, Msg, wParam, lParam);
@@ -60,7 +60,7 @@ FString ConvertToFString(const FWString& str)
     return conversion;
 }
 
-Window::Window(LaunchEngineLoop* App) : App(App)
+Window::Window(FWindowsApplication* App) : App(App)
 {
 }
 
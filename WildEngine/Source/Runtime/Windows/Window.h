@@ -2,17 +2,17 @@
 #include <Windows.h>
 #include "Templates/UnrealTypes.h"
 
-class LaunchEngineLoop;
+class FWindowsApplication;
 
 FWString ConvertToFWString(const FString& str);
 FString ConvertToFString(const FWString& str);
 
 class Window final
 {
-    LaunchEngineLoop* App = nullptr;
+    FWindowsApplication* App = nullptr;
     
 public:
-    Window(LaunchEngineLoop* App);
+    Window(FWindowsApplication* App);
     virtual ~Window();
 
     // Create the Window
@@ -26,7 +26,7 @@ public:
 
     inline HWND GetHWND() const { return hWnd; }
 
-    inline LaunchEngineLoop* GetApp() const { return App; }
+    inline FWindowsApplication* GetApp() const { return App; }
 
     void SetTitle(const FString& Title) const;
 
@@ -0,0 +1,177 @@
+﻿#include "WindowsApplication.h"
+#include "LaunchEngineLoop.h"
+#include "Window.h"
+#include "Renderer.h"
+#include "RenderGraph.h"
+#include "D3D11SceneRenderer.h"
+#include "D3D11RHI/D3D11DynamicRHI.h"
+
+#include <windowsx.h>
+
+FWindowsApplication::FWindowsApplication(LaunchEngineLoop* InLoop) : Loop(InLoop)
+{
+}
+
+FWindowsApplication::~FWindowsApplication()
+{
+    // 창보다 스왑체인을 먼저 해제한다
+    Renderer.reset();
+    ActiveWindow.reset();
+}
+
+bool FWindowsApplication::Create(const FString& Title, int Width, int Height)
+{
+    // Create Window
+    ActiveWindow = std::make_unique<Window>(this);
+    bWindowCreated = ActiveWindow->Create(Title, Width, Height, false);
+
+    Renderer = std::make_unique<URenderer>(this);
+    Renderer->Create();
+
+    return bWindowCreated;
+}
+
+std::unique_ptr<FDynamicRHI> FWindowsApplication::CreateDynamicRHI() const
+{
+    return std::make_unique<FD3D11DynamicRHI>(Renderer->GetDevice(), Renderer->GetDeviceContext());
+}
+
+std::unique_ptr<FSceneRenderer> FWindowsApplication::CreateSceneRenderer() const
+{
+    return std::make_unique<FD3D11SceneRenderer>(Renderer.get());
+}
+
+bool FWindowsApplication::PumpMessages()
+{
+    bool bQuit = false;
+
+    MSG msg = {};
+    while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+    {
+        if (msg.message == WM_QUIT)
+        {
+            bQuit = true;
+        }
+
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+
+    return !bQuit;
+}
+
+void FWindowsApplication::BindRenderTargets(const FRenderGraph& Graph, const FRenderGraphRenderTargets& Targets)
+{
+    // 리소스가 없는 외부 텍스처는 URenderer가 가진 스왑체인 백버퍼와 깊이 버퍼다
+    ID3D11RenderTargetView* ColorView = nullptr;
+    const FLOAT* ClearColor = nullptr;
+    if (Targets.Color.IsValid())
+    {
+        const FRenderGraphTexture& Color = Graph.GetTexture(Targets.Color);
+        ColorView = Color.Resource ? FD3D11DynamicRHI::ResourceCast(Color.Resource)->RenderTargetView : Renderer->GetBackBufferView();
+        ClearColor = Targets.ColorLoadAction == ERenderTargetLoadAction::Clear ? Color.Desc.ClearColor : nullptr;
+    }
+
+    ID3D11DepthStencilView* DepthView = nullptr;
+    const FLOAT* ClearDepth = nullptr;
+    if (Targets.Depth.IsValid())
+    {
+        const FRenderGraphTexture& Depth = Graph.GetTexture(Targets.Depth);
+        DepthView = Depth.Resource ? FD3D11DynamicRHI::ResourceCast(Depth.Resource)->DepthStencilView : Renderer->GetDepthStencilView();
+        ClearDepth = Targets.DepthLoadAction == ERenderTargetLoadAction::Clear ? &Depth.Desc.ClearDepth : nullptr;
+    }
+
+    Renderer->SetRenderTargets(ColorView, DepthView, ClearColor, ClearDepth);
+}
+
+void FWindowsApplication::Present() const
+{
+    Renderer->Present();
+}
+
+const float* FWindowsApplication::GetClearColor() const
+{
+    return Renderer->GetClearColor();
+}
+
+LRESULT FWindowsApplication::HandleMessage(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
+{
+    switch (Msg)
+    {
+        case WM_DESTROY:
+            PostQuitMessage(0);
+        return 0;
+
+        case WM_SIZE:
+            this->OnResize(hWnd, Msg, wParam, lParam);
+        return 0;
+
+        case WM_MOUSEMOVE:
+            this->OnMouseMove(hWnd, Msg, wParam, lParam);
+        return 0;
+    
+        case WM_KEYDOWN:
+            this->OnKeyDown(hWnd, Msg, wParam, lParam);
+        return 0;
+    
+        default:
+            return DefWindowProc(hWnd, Msg, wParam, lParam);
+    }
+}
+
+void FWindowsApplication::OnResize(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
+{
+    if (!bWindowCreated)
+    {
+        return;
+    }
+
+    // Get window size
+    int Width = LOWORD(lParam);
+    int Height = HIWORD(lParam);
+
+    // 스왑체인은 렌더 스레드가 쓰고 있으므로 비운 뒤에 크기를 바꾼다
+    Loop->FlushRenderingThread();
+
+    // Resize renderer
+    Renderer->Resize(Width, Height);
+    if (Width > 0 && Height > 0)
+    {
+        Loop->SetViewportSize(static_cast<uint32>(Width), static_cast<uint32>(Height));
+    }
+}
+
+void FWindowsApplication::OnMouseMove(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
+{
+    static int PreviousMouseX = 0;
+    static int PreviousMouseY = 0;
+
+    int MouseX = GET_X_LPARAM(lParam);
+    int MouseY = GET_Y_LPARAM(lParam);
+
+    if (wParam & MK_LBUTTON)
+    {
+        float DeltaX = static_cast<float>(MouseX - PreviousMouseX);
+        float DeltaY = static_cast<float>(MouseY - PreviousMouseY);
+
+        // Rotate camera
+        float Yaw = DeltaX * 0.01f;
+        float Pitch = DeltaY * 0.01f;
+
+        // m_Camera->Rotate(pitch, yaw);
+    }
+
+    PreviousMouseX = MouseX;
+    PreviousMouseY = MouseY;
+}
+
+void FWindowsApplication::OnKeyDown(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam)
+{
+    WORD Flags = HIWORD(lParam);
+    BOOL KeyRepeat = (Flags & KF_REPEAT) == KF_REPEAT;
+
+    if (!KeyRepeat)
+    {
+        // m_RasterState->ToggleWireframe();
+    }
+}
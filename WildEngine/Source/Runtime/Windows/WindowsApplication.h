@@ -0,0 +1,70 @@
+﻿#pragma once
+
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include <memory>
+
+#include "Templates/UnrealTypes.h"
+
+class LaunchEngineLoop;
+class Window;
+class URenderer;
+class FDynamicRHI;
+class FSceneRenderer;
+class FRenderGraph;
+struct FRenderGraphRenderTargets;
+
+/**
+ * The Win32 side of the windowed engine loop: the window, its message pump and
+ * the D3D11 device and swap chain URenderer owns.
+ *
+ * Headless runs (-nullrhi, -softwarerhi) never create one, so LaunchEngineLoop
+ * itself stays free of Win32 and D3D11 headers.
+ */
+class FWindowsApplication final
+{
+public:
+    FWindowsApplication(LaunchEngineLoop* InLoop);
+    ~FWindowsApplication();
+
+    /** Opens the window and creates the device and swap chain for it. @return Whether the window was created. */
+    bool Create(const FString& Title, int Width, int Height);
+
+    /** @return The D3D11 RHI on the device Create made. */
+    std::unique_ptr<FDynamicRHI> CreateDynamicRHI() const;
+
+    /** @return The scene renderer drawing into the swap chain. */
+    std::unique_ptr<FSceneRenderer> CreateSceneRenderer() const;
+
+    /** Dispatches every queued window message. @return false once WM_QUIT arrived. */
+    bool PumpMessages();
+
+    /** Render graph callback: binds and clears the D3D11 views behind Targets. */
+    void BindRenderTargets(const FRenderGraph& Graph, const FRenderGraphRenderTargets& Targets);
+
+    // Display the rendered scene
+    void Present() const;
+
+    const float* GetClearColor() const;
+
+    LRESULT HandleMessage(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
+
+    inline Window* GetWindow() const { return ActiveWindow.get(); }
+    inline URenderer* GetRenderer() const { return Renderer.get(); }
+
+private:
+    LaunchEngineLoop* Loop = nullptr;
+
+    std::unique_ptr<Window> ActiveWindow = nullptr;
+    std::unique_ptr<URenderer> Renderer = nullptr;
+    bool bWindowCreated = false;
+
+    // Event
+    void OnResize(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
+
+    void OnMouseMove(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
+
+    void OnKeyDown(HWND hWnd, UINT Msg, WPARAM wParam, LPARAM lParam);
+};